@@ -467,8 +467,28 @@ union CmdBufferBuildFlags
         uint32 reserved0                     :  1;  ///< Reserved for future use.
 #endif
 
+        /// Requests that PAL record the set of GPU memory objects referenced by the commands recorded into this
+        /// command buffer (e.g., the source and destination of copies and the memory bound to images and query pools)
+        /// and add them to the residency list of any submit which includes this command buffer.  Every command which
+        /// takes an IGpuMemory, IImage or IQueryPool object is tracked, but memory which is only referenced by GPU
+        /// virtual address (index buffers, vertex buffers, descriptors, etc.) must still be made resident through the
+        /// queue's global references or the per-submit GpuMemoryRef list.  Ignored on platforms which don't build a
+        /// residency list for each submit.
+        uint32 trackMemoryReferences        :  1;
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+        /// Records every location in command memory where PAL writes the value of a patchable user-data entry (see
+        /// CmdBufferBuildInfo::patchableUserDataFirstEntry), so that @ref ICmdBuffer::PatchUserData can rewrite those
+        /// values after the command buffer is built instead of recording it again.  This disables the PM4 optimizer
+        /// and forces the CPU update path for user-data tables.  Ignored for nested command buffers and on hardware
+        /// which doesn't support user-data patching.
+        uint32 enableUserDataPatching       :  1;
+#else
+        uint32 reserved1                     :  1;  ///< Reserved for future use.
+#endif
+
         /// Reserved for future use.
-        uint32 reserved                      : 23;
+        uint32 reserved                      : 21;
     };
 
     /// Flags packed as 32-bit uint.
@@ -505,6 +525,15 @@ struct CmdBufferBuildInfo
     uint64 execMarkerClientHandle; ///< Client/app data handle. This can have an arbitrary value and is used to uniquely
                                    ///  identify this command buffer.
 #endif
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    /// First of the consecutive user-data entries which can be rewritten by @ref ICmdBuffer::PatchUserData.  The range
+    /// applies to both the graphics and the compute user-data entries.  Ignored unless the enableUserDataPatching flag
+    /// is set.
+    uint32 patchableUserDataFirstEntry;
+    /// Number of patchable user-data entries.  User-data patching is disabled if this is zero.
+    uint32 patchableUserDataEntryCount;
+#endif
 };
 
 /// Specifies info on how a compute shader should use resources.
@@ -1742,6 +1771,34 @@ public:
     /// @returns How many DWORDs of embedded data the command buffer can allocate at once.
     virtual uint32 GetEmbeddedDataLimit() const = 0;
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    /// Rewrites the values of patchable user-data entries in an _executable_ command buffer which was built with the
+    /// enableUserDataPatching flag, without recording it again.  Every location where PAL wrote one of the given
+    /// entries while building the command buffer (user-SGPR's and spill tables) receives the new value, so each
+    /// patchable entry must hold a single value for the whole command buffer, such as a per-frame constant or a GPU
+    /// virtual address split across two entries.  Values consumed by GPU-generated commands (@ref
+    /// CmdExecuteIndirectCmds) are not patched.
+    ///
+    /// @warning The client must guarantee that this command buffer is not queued for execution and is not currently
+    ///          being executed.
+    ///
+    /// @param [in] bindPoint    Specifies which type of user-data is patched (i.e., compute or graphics).
+    /// @param [in] firstEntry   First user-data entry to patch.
+    /// @param [in] entryCount   Number of user-data entries to patch.
+    /// @param [in] pEntryValues Array of entryCount values.
+    ///
+    /// @returns Success if the entries were patched.  Otherwise, one of the following errors may be returned:
+    ///          + ErrorUnavailable if the command buffer doesn't record user-data patch points.
+    ///          + ErrorIncompleteCommandBuffer if the command buffer is not _executable_.
+    ///          + ErrorInvalidValue if the entries aren't within the patchable range given to Begin(), or if
+    ///            pEntryValues is null.
+    virtual Result PatchUserData(
+        PipelineBindPoint bindPoint,
+        uint32            firstEntry,
+        uint32            entryCount,
+        const uint32*     pEntryValues) = 0;
+#endif
+
     /// Binds a graphics or compute pipeline to the current command buffer state.
     ///
     /// @param [in] params Parameters necessary to manage dynamic pipeline shader information.
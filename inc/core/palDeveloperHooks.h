@@ -416,10 +416,14 @@ struct BindPipelineData
 /// Information for DrawDispatchValidation callbacks
 struct DrawDispatchValidationData
 {
-    ICmdBuffer* pCmdBuffer;         ///< The command buffer which is recording the triggering draw or dispatch.
-    uint32      pipelineCmdSize;    ///< Size of PM4 commands used to validate the current pipeline state (bytes).
-    uint32      userDataCmdSize;    ///< Size of PM4 commands used to validate the current user-data entries (bytes).
-    uint32      miscCmdSize;        ///< Size of PM4 commands for all other draw- or dispatch-time validation (bytes).
+    ICmdBuffer* pCmdBuffer;           ///< The command buffer which is recording the triggering draw or dispatch.
+    uint32      pipelineCmdSize;      ///< Size of PM4 commands used to validate the current pipeline state (bytes).
+    uint32      userDataCmdSize;      ///< Size of PM4 commands used to validate the current user-data entries (bytes).
+    uint32      miscCmdSize;          ///< Size of PM4 commands for all other draw- or dispatch-time validation
+                                      ///  (bytes).
+    uint32      pipelineDeltaCmdSize; ///< Size of PM4 commands used to validate the current pipeline state when only
+                                      ///  the registers which differ from the previous pipeline were written (bytes).
+                                      ///  Not included in pipelineCmdSize.
 };
 
 /// Information for OptimizedRegisters callbacks
@@ -1329,6 +1329,13 @@ struct DeviceProperties
     BigSoftwareReleaseInfo bigSoftwareReleaseInfo;   ///< Big Software (BigSW) Release Version information
 };
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+/// Defines callback function to notify client that a fence registered with IDevice::RegisterFenceCallback() has been
+/// signaled.  The result is Success if the fence was signaled, otherwise it is the error which ended the wait (e.g.,
+/// ErrorDeviceLost) or ErrorUnavailable if the device was destroyed first.
+typedef void (PAL_STDCALL *FenceCallbackFunc)(void* pUserData, Result result);
+#endif
+
 /// Defines callback function to notify client of private screen changes.
 typedef void (PAL_STDCALL *TopologyChangeNotificationFunc)(void* pClient);
 
@@ -1552,6 +1559,19 @@ struct GpuMemoryHeapProperties
     float    cpuWritePerfRating;           ///< Relative GPU write performance rating for this heap.
 };
 
+/// Reports the state of the device-wide pool from which command allocators suballocate their GPU memory.  Returned by
+/// IDevice::GetCmdChunkPoolStats().
+struct CmdChunkPoolStats
+{
+    uint32  blockCount;            ///< Number of large GPU memory blocks owned by the pool.
+    gpusize blockBytes;            ///< Total size of those blocks, in bytes.
+    gpusize suballocatedBytes;     ///< Bytes currently suballocated out to command allocators.
+    gpusize peakSuballocatedBytes; ///< Largest value suballocatedBytes has reached.
+    uint64  suballocCount;         ///< Number of command stream allocations served by the pool.
+    uint64  fallbackCount;         ///< Number of command stream allocations which couldn't be pooled, e.g., because
+                                   ///  their command allocator reached its quota.
+};
+
 /// Flags structure reporting available capabilities of a particular format.
 enum FormatFeatureFlags : uint32
 {
@@ -2812,6 +2832,62 @@ public:
         bool                waitAll,
         uint64              timeoutNs) const = 0;
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    /// Registers a callback to be invoked once the specified fence has been signaled.
+    ///
+    /// All fences with pending callbacks on a device are waited on together by a single internal thread, which is
+    /// cheaper than having several threads each wait on (or poll) their own fences.  That thread is created by the
+    /// first registration which has to wait.  The callback is invoked on that internal thread, or immediately on the
+    /// calling thread if the fence is already signaled, so it should return quickly.  Callbacks whose fences are
+    /// signaled together are invoked in the order they were registered.  A callback may register or unregister other
+    /// callbacks.  The fence must not be reset or destroyed until its callback has been invoked or unregistered.
+    ///
+    /// @param [in] pFence      Fence to wait on.  It must have been submitted at least once.
+    /// @param [in] pfnCallback Function to call when the fence is signaled.
+    /// @param [in] pUserData   Opaque value passed to pfnCallback.
+    ///
+    /// @returns Success if the callback was registered (or already invoked).  Otherwise, one of the following errors
+    ///          may be returned:
+    ///          + ErrorInvalidPointer if pFence or pfnCallback is null.
+    ///          + ErrorFenceNeverSubmitted if the fence hasn't been submitted.
+    ///          + ErrorOutOfMemory if the registration could not be stored.
+    virtual Result RegisterFenceCallback(
+        const IFence*     pFence,
+        FenceCallbackFunc pfnCallback,
+        void*             pUserData) = 0;
+
+    /// Cancels a callback previously registered with @ref RegisterFenceCallback.
+    ///
+    /// If the callback is being invoked on the internal thread when this is called, this waits for it to return, so
+    /// once this returns the callback won't be running or invoked again and its user data may be freed.  A callback may
+    /// unregister itself or other callbacks without waiting.  If the same callback and user data were registered
+    /// several times on one fence, only one of the registrations is removed.
+    ///
+    /// @param [in] pFence      Fence the callback was registered on.
+    /// @param [in] pfnCallback Function which was registered.
+    /// @param [in] pUserData   Opaque value which was registered with pfnCallback.
+    ///
+    /// @returns Success if the callback was removed before being invoked.  Otherwise, one of the following may be
+    ///          returned:
+    ///          + NotFound if no such callback is pending, e.g. because it has already been invoked.
+    ///          + ErrorInvalidPointer if pFence or pfnCallback is null.
+    virtual Result UnregisterFenceCallback(
+        const IFence*     pFence,
+        FenceCallbackFunc pfnCallback,
+        void*             pUserData) = 0;
+#endif
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 551
+    /// Reports the state of the pool from which command allocators suballocate their command, embedded-data and
+    /// scratch GPU memory.  The pool is disabled by default, in which case every count is zero.
+    ///
+    /// @param [out] pStats Snapshot of the pool's statistics.
+    ///
+    /// @returns Success if the statistics were returned, or ErrorInvalidPointer if pStats is null.
+    virtual Result GetCmdChunkPoolStats(
+        CmdChunkPoolStats* pStats) = 0;
+#endif
+
     /// Stalls the current thread until one or all of the specified Semaphores have been reached by the device.
     ///
     /// Using a zero timeout value returns immediately and can be used to determine the status of a set of semaphores
@@ -43,7 +43,7 @@
 ///            compatible, it is not assumed that the client will initialize all input structs to 0.
 ///
 /// @ingroup LibInit
-#define PAL_INTERFACE_MAJOR_VERSION 547
+#define PAL_INTERFACE_MAJOR_VERSION 551
 
 /// Minor interface version.  Note that the interface version is distinct from the PAL version itself, which is returned
 /// in @ref Pal::PlatformProperties.
@@ -176,8 +176,20 @@ struct PlatformCreateInfo
 #else
             uint32 reserved0                      :  1; ///< Reserved for future use.
 #endif
+            uint32 enableAllocProfiler            :  1; ///< Samples PAL's system memory allocations with
+                                                        ///  @ref Util::AllocProfiler so that the client can call
+                                                        ///  IPlatform::WriteAllocProfilerReport() to find out where
+                                                        ///  live memory was allocated.  Cheap enough for release
+                                                        ///  builds.
+            uint32 enableSlabAllocator            :  1; ///< Serves PAL's small internal allocations from
+                                                        ///  thread-cached slabs (see @ref Util::SlabAllocator) instead
+                                                        ///  of calling the client's allocation callbacks each time.
+            uint32 enablePm4AllocCounts           :  1; ///< Counts PAL's system memory allocations per command buffer
+                                                        ///  call for the PM4 instrumentor's CPU time report.  Ignored
+                                                        ///  unless PAL was built with the PM4 instrumentor layer; set
+                                                        ///  it only when that layer will be enabled.
 
-            uint32 reserved                       : 25; ///< Reserved for future use.
+            uint32 reserved                       : 22; ///< Reserved for future use.
         };
         uint32 u32All;                                  ///< Flags packed as 32-bit uint.
     } flags;                                            ///< Platform-wide creation flags.
@@ -190,6 +202,12 @@ struct PlatformCreateInfo
                                                         ///  set by client based on their contract with RGP.
     gpusize                      maxSvmSize;            ///  Maximum amount of virtual address space that will be
                                                         ///  reserved for SVM
+    size_t                       allocProfilerSampleInterval; ///< Mean number of bytes allocated between samples of
+                                                              ///  the allocation profiler, or zero for the default.
+                                                              ///  Ignored unless flags.enableAllocProfiler is set.
+    size_t                       slabAllocatorMemoryCeiling;  ///< Maximum number of bytes the slab allocator may take
+                                                              ///  from the client's callbacks, or zero for the default.
+                                                              ///  Ignored unless flags.enableSlabAllocator is set.
 };
 
 /**
@@ -43,6 +43,11 @@ namespace DevDriver
     class DevDriverServer;
 }
 
+namespace Util
+{
+struct SlabAllocatorStats;
+}
+
 namespace Pal
 {
 
@@ -396,6 +401,30 @@ public:
     virtual Result GetProperties(
         PlatformProperties* pProperties) = 0;
 
+    /// Writes a text report of the system memory which the platform's allocation profiler estimates is still live.
+    /// See @ref Util::AllocProfiler for details.
+    ///
+    /// @param [in] pFilename Name of the file to write; an existing file is overwritten.
+    ///
+    /// @returns Success if the report was written.  Otherwise, one of the following errors may be returned:
+    ///          + ErrorInvalidPointer if pFilename is null.
+    ///          + ErrorUnavailable if the platform wasn't created with PlatformCreateInfo::flags.enableAllocProfiler.
+    ///          + An appropriate error if the file couldn't be written.
+    virtual Result WriteAllocProfilerReport(
+        const char* pFilename) = 0;
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 550
+    /// Reports the statistics of the platform's slab allocator.  See @ref Util::SlabAllocator for details.
+    ///
+    /// @param [out] pStats Snapshot of the slab allocator's statistics.
+    ///
+    /// @returns Success if the statistics were returned.  Otherwise, one of the following errors may be returned:
+    ///          + ErrorInvalidPointer if pStats is null.
+    ///          + ErrorUnavailable if the platform wasn't created with PlatformCreateInfo::flags.enableSlabAllocator.
+    virtual Result GetSlabAllocatorStats(
+        Util::SlabAllocatorStats* pStats) = 0;
+#endif
+
     /// Installs the callback into the specified platform.
     ///
     /// @param [in] pPlatform        The platform to install the callback into.
@@ -700,23 +700,37 @@ private:
     Util::Vector<SampleItem*, 16, GpaAllocator> m_sampleItemArray;
     PerfExpMemDeque* m_pAvailablePerfExpMem;
 
-    // Unique pipelines registered with this GpaSession.
-    Util::HashSet<Pal::uint64, GpaAllocator, Util::JenkinsHashFunc> m_registeredPipelines;
-    // Unique API PSOs registered with this GpaSession.
-    Util::HashSet<Pal::uint64, GpaAllocator, Util::JenkinsHashFunc> m_registeredApiPsos;
+    // Pipeline registration state is split into shards, selected by pipeline hash (or API PSO hash), so that threads
+    // registering different pipelines rarely wait on each other.
+    static constexpr Pal::uint32 RegistrationShardCount = 16;
+
+    struct RegistrationShard
+    {
+        explicit RegistrationShard(GpaAllocator* pAllocator);
+
+        Util::Mutex lock;
+
+        // Unique pipelines registered with this GpaSession.
+        Util::HashSet<Pal::uint64, GpaAllocator, Util::JenkinsHashFunc> registeredPipelines;
+        // Unique API PSOs registered with this GpaSession.
+        Util::HashSet<Pal::uint64, GpaAllocator, Util::JenkinsHashFunc> registeredApiPsos;
+
+        // Cached code object load event and PSO correlation records that will be merged into the final database at
+        // the end of a trace.
+        Util::Deque<CodeObjectLoadEventRecord, GpaAllocator> loadEventRecords;
+        Util::Deque<PsoCorrelationRecord, GpaAllocator>      psoCorrelationRecords;
+    };
+
+    RegistrationShard* m_pRegistrationShards; // Array of RegistrationShardCount shards.
 
     // List of cached pipeline code object records that will be copied to the final database at the end of a trace
     Util::Deque<SqttCodeObjectDatabaseRecord*, GpaAllocator>  m_codeObjectRecordsCache;
     // List of pipeline code object records that were registered during a trace
     Util::Deque<SqttCodeObjectDatabaseRecord*, GpaAllocator>  m_curCodeObjectRecords;
 
-    // List of cached code object load event records that will be copied to the final database at the end of a trace
-    Util::Deque<CodeObjectLoadEventRecord, GpaAllocator>  m_codeObjectLoadEventRecordsCache;
     // List of code object load event records that were registered during a trace
     Util::Deque<CodeObjectLoadEventRecord, GpaAllocator>  m_curCodeObjectLoadEventRecords;
 
-    // List of cached PSO correlation records that will be copied to the final database at the end of a trace
-    Util::Deque<PsoCorrelationRecord, GpaAllocator>  m_psoCorrelationRecordsCache;
     // List of PSO correlation records that were registered during a trace
     Util::Deque<PsoCorrelationRecord, GpaAllocator>  m_curPsoCorrelationRecords;
 
@@ -725,6 +739,7 @@ private:
     // List of shader isa records that were registered during a trace
     Util::Deque<ShaderRecord, GpaAllocator>  m_curShaderRecords;
 
+    // Protects m_codeObjectRecordsCache and m_shaderRecordsCache. Never taken while a registration shard lock is held.
     Util::RWLock m_registerPipelineLock;
 
     // Event type for timed queue events
@@ -760,19 +775,41 @@ private:
         };
     };
 
+    // Number of timing slots in each block of a timed queue's timestamp ring. Each slot holds a top-of-pipe and a
+    // bottom-of-pipe timestamp.
+    static constexpr Pal::uint32 TimedQueueSlotsPerBlock = 256;
+
+    // Maximum number of slot blocks in a timed queue's timestamp ring. Every slot's timestamps are read back when the
+    // session's results are gathered, so slots can't be recycled within a session; once the ring is full, the rest of
+    // the session's submits on that queue are passed through untimed.
+    static constexpr Pal::uint32 TimedQueueMaxSlotBlocks = 16;
+
+    // A block of timing slots whose timestamps live in one contiguous, perma-mapped GPU allocation. The command buffers
+    // which write each timestamp are recorded the first time their slot is used and are simply resubmitted afterwards
+    // because the address they write never changes.
+    struct TimedQueueSlotBlock
+    {
+        GpuMemoryInfo    memInfo;                                  // Timestamp memory for every slot in the block
+        Pal::ICmdBuffer* pPreCmdBuffers[TimedQueueSlotsPerBlock];  // Write each slot's top-of-pipe timestamp
+        Pal::ICmdBuffer* pPostCmdBuffers[TimedQueueSlotsPerBlock]; // Write each slot's bottom-of-pipe timestamp
+    };
+
     // Struct for keeping track of timed operation on a specific queue
     struct TimedQueueState
     {
-        Pal::IQueue*                                 pQueue;               // Pal Queue
-        Pal::uint64                                  queueId;              // Api specific queue id
-        Pal::uint64                                  queueContext;         // Api specific queue context
-        Pal::QueueType                               queueType;            // Queue type
-        Pal::EngineType                              engineType;           // Engine type
-        bool                                         valid;                // Used to track if the queue is valid
-        Util::Deque<Pal::ICmdBuffer*, GpaAllocator>* pAvailableCmdBuffers; // List of available cmdbuffers
-        Util::Deque<Pal::ICmdBuffer*, GpaAllocator>* pBusyCmdBuffers;      // List of busy cmdbuffers
-        Pal::IFence*                                 pFence;               // Used to track queue
-                                                                           // operations
+        Pal::IQueue*                                          pQueue;       // Pal Queue
+        Pal::uint64                                           queueId;      // Api specific queue id
+        Pal::uint64                                           queueContext; // Api specific queue context
+        Pal::QueueType                                        queueType;    // Queue type
+        Pal::EngineType                                       engineType;   // Engine type
+        bool                                                  valid;        // Used to track if the queue is valid
+        Util::Vector<TimedQueueSlotBlock*, 4, GpaAllocator>*  pSlotBlocks;  // Blocks making up the timestamp ring
+        Pal::uint32                                           nextSlot;     // Next unused slot, counted across all
+                                                                            // blocks, in the current session
+        Pal::IFence*                                          pFence;       // Used to track queue operations
+        bool                                                  fenceCallback; // The device reports pFence's
+                                                                             // completion through fenceSignaled
+        volatile Pal::uint32                                  fenceSignaled; // Set once pFence has been signaled
     };
 
     // Flags for the current session.
@@ -792,7 +829,8 @@ private:
     // The most recent gpu clocks sample
     GpuClocksSample m_lastGpuClocksSample;
 
-    // Internal command allocator used for timing command buffers
+    // Internal command allocator used for timing command buffers. It is never reset because the timing command buffers
+    // are recorded once and reused by every session.
     Pal::ICmdAllocator* m_pCmdAllocator;
 
     // Finds the TimedQueueState associated with pQueue.
@@ -823,16 +861,39 @@ private:
     Pal::Result CreateCmdBufferForQueue(Pal::IQueue* pQueue,
                                         Pal::ICmdBuffer** ppCmdBuffer);
 
-    // Acquires a command buffer from the TimedQueueState's command buffer pool
-    Pal::Result AcquireTimedQueueCmdBuffer(TimedQueueState* pQueueState,
-                                           Pal::ICmdBuffer** ppCmdBuffer);
+    // Adds a block of timing slots to the end of pQueueState's timestamp ring
+    Pal::Result GrowTimedQueueSlots(TimedQueueState* pQueueState);
 
-    // Recycles busy command buffers in pQueueState
-    Pal::Result RecycleTimedQueueCmdBuffers(TimedQueueState* pQueueState);
+    // Returns true if pQueueState's timestamp ring can still provide slotCount timing slots in the current session
+    bool HasFreeTimedQueueSlots(const TimedQueueState* pQueueState, Pal::uint32 slotCount) const
+    {
+        return (pQueueState->nextSlot + slotCount) <= (TimedQueueMaxSlotBlocks * TimedQueueSlotsPerBlock);
+    }
+
+    // Acquires the next unused timing slot of pQueueState, growing its timestamp ring if necessary
+    Pal::Result AcquireTimedQueueSlot(TimedQueueState*      pQueueState,
+                                      TimedQueueSlotBlock** ppBlock,
+                                      Pal::uint32*          pSlotIndex);
+
+    // Returns the command buffer which writes one of the timestamps of a timing slot, recording it on first use
+    Pal::Result GetTimedQueueSlotCmdBuffer(TimedQueueState*     pQueueState,
+                                           TimedQueueSlotBlock* pBlock,
+                                           Pal::uint32          slotIndex,
+                                           bool                 isPostTimestamp,
+                                           Pal::ICmdBuffer**    ppCmdBuffer);
+
+    // Returns the offset of one of the timestamps of a timing slot within its block's GPU memory
+    Pal::gpusize TimedQueueSlotOffset(Pal::uint32 slotIndex, bool isPostTimestamp) const
+    {
+        return ((slotIndex * 2) + (isPostTimestamp ? 1 : 0)) *
+               Util::Max<Pal::gpusize>(sizeof(Pal::uint64), m_timestampAlignment);
+    }
+
+    // Destroys the timestamp command buffers of every slot in pBlock
+    void DestroyTimedQueueSlotCmdBuffers(TimedQueueSlotBlock* pBlock);
 
-    // Preallocates a fixed number of command buffers for pQueueState and adds them to the command buffer pool
-    Pal::Result PreallocateTimedQueueCmdBuffers(TimedQueueState* pQueueState,
-                                                Pal::uint32 numCmdBuffers);
+    // Destroys pBlock along with its timestamp memory and command buffers
+    void DestroyTimedQueueSlotBlock(TimedQueueSlotBlock* pBlock);
 
     // Resets all per session state in pQueueState
     Pal::Result ResetTimedQueueState(TimedQueueState* pQueueState);
@@ -840,6 +901,16 @@ private:
     // Destroys the memory and resources for pQueueState
     void DestroyTimedQueueState(TimedQueueState* pQueueState);
 
+    // Asks the device to flag pQueueState once its fence is signaled, so that IsReady() doesn't have to poll the fence
+    void TrackTimedQueueFence(TimedQueueState* pQueueState);
+
+    // Cancels TrackTimedQueueFence(); this must be done before pQueueState's fence is reset or destroyed
+    void UntrackTimedQueueFence(TimedQueueState* pQueueState);
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    static void PAL_STDCALL TimedQueueFenceCallback(void* pUserData, Pal::Result result);
+#endif
+
     // Helper function to import one sample item from a source session to copy session.
     Pal::Result ImportSampleItem(const SampleItem* pSrcSampleItem);
 
@@ -880,6 +951,18 @@ private:
 
     Pal::Result AddCodeObjectLoadEvent(const Pal::IPipeline* pPipeline, CodeObjectLoadEventType eventType);
 
+    RegistrationShard* GetRegistrationShard(Pal::uint64 hash) const
+        { return &m_pRegistrationShards[(hash ^ (hash >> 32)) % RegistrationShardCount]; }
+
+    Pal::Result InitRegistrationShards();
+    void DestroyRegistrationShards();
+
+    // Copies a registered pipeline's binary and shader ISA into the code object and shader record caches.
+    Pal::Result CachePipelineBinary(const Pal::IPipeline* pPipeline);
+
+    void MergeLoadEventRecords();
+    static int CompareLoadEventTimestamps(const void* pLhs, const void* pRhs);
+
     // recycle used Gart rafts and put back to available pool
     void RecycleGartGpuMem();
 
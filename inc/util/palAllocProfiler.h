@@ -0,0 +1,138 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palAllocProfiler.h
+ * @brief PAL utility collection AllocProfiler class declaration.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palHashMap.h"
+#include "palMutex.h"
+#include "palSysMemory.h"
+#include "palThread.h"
+
+namespace Util
+{
+
+/**
+ ***********************************************************************************************************************
+ * @brief Sampling heap profiler which sits between PAL and a set of system memory allocation callbacks.
+ *
+ * Unlike MemTracker, which is compiled in only when PAL_MEMTRACK is set and tracks every allocation, the profiler is
+ * cheap enough to leave running in release builds.  It samples allocations with a Poisson process: on average one
+ * sample is taken per sampleInterval bytes allocated, so larger allocations are more likely to be sampled.  Each
+ * thread keeps its own countdown to its next sample, so allocations which aren't sampled never take a lock.  The stack
+ * of each sampled allocation is captured and kept until the allocation is freed.
+ *
+ * A report can be written at any time.  It estimates the bytes and number of allocations which are still live, both
+ * per SystemAllocType and per unique allocating call stack.  Each sample of size s stands for s / (1 - e^(-s/interval))
+ * bytes, which keeps the estimates unbiased.
+ *
+ * Each profiler wraps one set of allocation callbacks and is owned by whoever allocates through the wrapped callbacks
+ * (the Platform, in PAL's case).  The profiler and its sample records are allocated from the OS default allocation
+ * callbacks, so none of the profiler's own memory is charged to, or sampled from, the callbacks it wraps.
+ ***********************************************************************************************************************
+ */
+class AllocProfiler
+{
+public:
+    /// Mean number of bytes allocated between two samples if the caller doesn't specify one.
+    static constexpr size_t DefaultSampleInterval = 512 * 1024;
+
+    /// Maximum number of stack frames captured for each sampled allocation.
+    static constexpr uint32 MaxStackFrames = 24;
+
+    /// Creates a profiler which samples the allocations made through the callbacks returned by GetAllocCallbacks().
+    ///
+    /// @param [in]  clientCb       Callbacks which actually allocate and free the memory.
+    /// @param [in]  sampleInterval Mean number of bytes allocated between samples, or zero to use the default.
+    /// @param [out] ppProfiler     The new profiler.
+    ///
+    /// @returns Success if the profiler was created, or an appropriate error (e.g., ErrorOutOfMemory) otherwise.
+    static Result Create(const AllocCallbacks& clientCb, size_t sampleInterval, AllocProfiler** ppProfiler);
+
+    /// Destroys the profiler.  Every allocation made through its callbacks must have been freed by now.
+    void Destroy();
+
+    /// Returns callbacks which sample allocations before passing them on to the client's callbacks.  Every allocation
+    /// made through them must also be freed through them, or the frees of sampled allocations won't be seen.
+    ///
+    /// @param [out] pAllocCb Filled with the sampling callbacks.
+    void GetAllocCallbacks(AllocCallbacks* pAllocCb);
+
+    /// Writes a text report of the estimated live system memory to a file.  Sampled allocations and frees on other
+    /// threads are briefly blocked while the report is gathered.
+    ///
+    /// @param [in] pFilename Name of the file to write; an existing file is overwritten.
+    ///
+    /// @returns Success if the report was written, or an appropriate error if the file couldn't be written.
+    Result WriteReport(const char* pFilename);
+
+private:
+    // Number of independently locked tables holding the records of live sampled allocations.  Records are assigned to
+    // a shard by address, so the free of an allocation finds its record no matter which thread allocated it.
+    static constexpr uint32 NumSampleShards = 16;
+
+    // Number of address buckets which count the live samples whose address falls into them.  A free only locks a
+    // shard if the freed address's bucket holds a sample, so frees of unsampled allocations don't take any lock.
+    static constexpr uint32 NumAddrBuckets = 4096;
+
+    struct SampleRecord;
+    typedef HashMap<const void*, SampleRecord*, ForwardAllocator> SampleMap;
+
+    AllocProfiler(const AllocCallbacks& clientCb, const AllocCallbacks& internalCb, size_t sampleInterval);
+    ~AllocProfiler();
+
+    Result Init();
+
+    size_t NextSampleInterval();
+    void RecordSample(const void* pMem, size_t size, SystemAllocType allocType);
+
+    static void* PAL_STDCALL ProfilingAlloc(
+        void*           pClientData,
+        size_t          size,
+        size_t          alignment,
+        SystemAllocType allocType);
+    static void PAL_STDCALL ProfilingFree(void* pClientData, void* pMem);
+
+    const AllocCallbacks m_clientCb;       // Callbacks which actually allocate the profiled memory.
+    const AllocCallbacks m_internalCb;     // OS default callbacks used for the profiler's own memory.
+    ForwardAllocator     m_allocator;      // Allocator wrapping m_internalCb.
+    const double         m_sampleInterval; // Mean number of bytes allocated between samples.
+    ThreadLocalKey       m_countdownKey;   // Number of bytes each thread has left to allocate before its next sample.
+    bool                 m_keyCreated;
+    volatile uint64      m_rngSequence;    // Advanced once per sample to seed the next sample interval.
+    volatile uint32      m_bucketCounts[NumAddrBuckets];
+    Mutex                m_shardLocks[NumSampleShards];
+    SampleMap*           m_pShards[NumSampleShards];
+
+    PAL_DISALLOW_DEFAULT_CTOR(AllocProfiler);
+    PAL_DISALLOW_COPY_AND_ASSIGN(AllocProfiler);
+};
+
+} // Util
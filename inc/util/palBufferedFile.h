@@ -0,0 +1,199 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palBufferedFile.h
+ * @brief PAL utility collection BufferedFile class declaration.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palFile.h"
+#include <cstdarg>
+
+namespace Util
+{
+
+/// Describes a single contiguous span of bytes for a vectored write.
+struct FileSpan
+{
+    const void* pData;  ///< Bytes to write.
+    size_t      size;   ///< Number of bytes to write.
+};
+
+/**
+ ***********************************************************************************************************************
+ * @brief Write-only file stream tuned for high-volume logging.
+ *
+ * Unlike File, which forwards every call to the C runtime, BufferedFile accumulates output in a large page-aligned
+ * staging buffer and only calls into the OS when that buffer fills up or Flush() is called.  Large payloads are
+ * combined with any pending staged data and written with a single vectored write instead of being copied.  The Put*()
+ * functions format common integer and floating-point values directly into the staging buffer without going through
+ * printf.
+ *
+ * If asynchronous flushing is requested when the file is opened, a second staging buffer is created.  When one buffer
+ * fills up it is handed to a background write-behind thread and the caller continues writing into the other one, so the
+ * caller only blocks when it outpaces the disk.  A single write-behind thread is shared by every open BufferedFile; it
+ * is started when the first asynchronous file is opened and stopped when the last one is destroyed.
+ *
+ * BufferedFile is not thread-safe; a single thread must own each object.
+ ***********************************************************************************************************************
+ */
+class BufferedFile
+{
+public:
+    /// Default size of each staging buffer in bytes.
+    static constexpr size_t DefaultBufferSize = 256 * 1024;
+
+    BufferedFile();
+
+    /// Flushes and closes the file if it is still open, releases the write-behind thread and frees the staging buffers.
+    ~BufferedFile();
+
+    /// Opens a file stream for write or append access.
+    ///
+    /// @param [in] pFilename   Name of file to open.
+    /// @param [in] accessFlags Bitmask of FileAccessMode values indicating the usage of the file.  Read access is not
+    ///                         supported.
+    /// @param [in] bufferSize  Size of each staging buffer in bytes.  Ignored if the staging buffers were already
+    ///                         allocated by a previous Open() call.
+    /// @param [in] asyncFlush  If true, full staging buffers are written to disk by a background thread.  Ignored if
+    ///                         the object was already opened once before with a different setting.
+    ///
+    /// @returns Success if successful, otherwise an appropriate error.
+    Result Open(
+        const char* pFilename,
+        uint32      accessFlags,
+        size_t      bufferSize = DefaultBufferSize,
+        bool        asyncFlush = false);
+
+    /// Writes any staged data to the file and closes the file handle.  The staging buffers are kept alive so that the
+    /// object can be cheaply reopened.
+    void Close();
+
+    /// Writes a stream of bytes to the file.
+    ///
+    /// @param [in] pBuffer    Byte stream to be written to the file.
+    /// @param [in] bufferSize Number of bytes to write.
+    ///
+    /// @returns Success if successful, otherwise an appropriate error.
+    Result Write(const void* pBuffer, size_t bufferSize);
+
+    /// Writes a list of byte streams to the file, in order, with as few OS calls as possible.
+    ///
+    /// @param [in] pSpans    Array of spans to write.
+    /// @param [in] spanCount Number of entries in pSpans.
+    ///
+    /// @returns Success if successful, otherwise an appropriate error.
+    Result WriteVectored(const FileSpan* pSpans, uint32 spanCount);
+
+    /// Prints a formatted string to the file.
+    ///
+    /// @param [in] pFormatStr Printf-style format string.
+    ///
+    /// @returns Success if successful, otherwise an appropriate error.
+    Result Printf(const char* pFormatStr, ...);
+
+    /// Prints a formatted string to the file.
+    ///
+    /// @param [in] pFormatStr Printf-style format string.
+    /// @param [in] argList    Variable argument list.
+    ///
+    /// @returns Success if successful, otherwise an appropriate error.
+    Result VPrintf(const char* pFormatStr, va_list argList);
+
+    /// Writes a single character to the file.
+    Result PutChar(char c);
+
+    /// Writes a null-terminated string to the file, without the terminator.
+    Result PutString(const char* pString);
+
+    /// Writes an unsigned integer in decimal.  Equivalent to printf's "%llu".
+    Result PutUint(uint64 value);
+
+    /// Writes a signed integer in decimal.  Equivalent to printf's "%lld".
+    Result PutInt(int64 value);
+
+    /// Writes an unsigned integer in lowercase hexadecimal, zero-padded to at least minDigits digits and without any
+    /// "0x" prefix.  Equivalent to printf's "%0*llx".
+    Result PutHex(uint64 value, uint32 minDigits);
+
+    /// Writes a floating-point value in fixed-point notation with the given number of fractional digits.  Equivalent
+    /// to printf's "%.*f"; values too large for the fast path fall back to the C runtime.
+    Result PutFloat(double value, uint32 fracDigits);
+
+    /// Writes all staged data to the OS.  If asynchronous flushing is enabled, the staged data is handed to the
+    /// write-behind thread and this call only waits for previously handed-off data.
+    ///
+    /// @returns Success if successful, otherwise the first error encountered since the last Flush().
+    Result Flush();
+
+    /// Returns true if the file is presently open.
+    bool IsOpen() const { return (m_fd >= 0); }
+
+private:
+    // Finds at least size bytes of free staging space, handing off the current buffer if needed.
+    Result Reserve(size_t size, char** ppSpace);
+    void   Commit(size_t size) { m_usedSize += size; }
+
+    Result InitBuffers(size_t bufferSize, bool asyncFlush);
+    Result SubmitActiveBuffer();
+    void   WaitForIdle();
+    void   RecordIoResult(Result result);
+
+    // OS-specific file access, implemented alongside the other OS abstractions.
+    Result OpenFile(const char* pFilename, uint32 accessFlags);
+    void   CloseFile();
+    Result WriteSpans(const FileSpan* pSpans, uint32 spanCount);
+    Result WriteFormatted(const char* pFormatStr, va_list argList);
+
+    // Shared write-behind thread management.
+    static Result AcquireWriteBehindThread();
+    static void   ReleaseWriteBehindThread();
+    static void   WriteBehindThreadFunc(void* pParameter);
+    void          WritePendingData();
+
+    static constexpr uint32 NumBuffers = 2;
+
+    int32   m_fd;                       // OS file descriptor, -1 when closed.
+    char*   m_pBuffers[NumBuffers];     // Staging buffers; the second is only used with asynchronous flushing.
+    size_t  m_bufferSize;               // Size of each staging buffer in bytes.
+    size_t  m_allocSize;                // Total size of the virtual allocation backing the staging buffers.
+    uint32  m_activeBuffer;             // Index of the buffer currently being written by the caller.
+    size_t  m_usedSize;                 // Number of bytes staged in the active buffer.
+    Result  m_ioResult;                 // First I/O error encountered since the last Flush().
+
+    // Asynchronous flush state.  Everything below m_asyncFlush, and m_ioResult when m_asyncFlush is set, is protected
+    // by the write-behind thread's lock.
+    bool          m_asyncFlush;
+    const char*   m_pPendingData;       // Buffer handed off to the write-behind thread, or null if there is none.
+    size_t        m_pendingSize;
+    BufferedFile* m_pNextPending;       // Next file in the write-behind thread's queue.
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(BufferedFile);
+};
+
+} // Util
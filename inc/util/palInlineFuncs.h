@@ -250,6 +250,115 @@ void WideBitfieldAndBits(
     }
 }
 
+/// Returns the bits of a single integer in a "wide bitfield" which fall within a range of flags. A "wide bifield" is a
+/// bitfield which spans an array of integers because there are more flags than bits in one integer.
+///
+/// @param [in] index        Index of the integer within the wide bitfield
+/// @param [in] startingBit  Index of the first flag in the range
+/// @param [in] numBits      Number of flags in the range
+///
+/// @returns Mask of the bits of integer "index" which belong to the range.
+template <typename T>
+T WideBitfieldRangeMask(
+    uint32 index,
+    uint32 startingBit,
+    uint32 numBits)
+{
+    constexpr uint32 BitsPerInt = (sizeof(T) << 3);
+
+    const uint32 intFirstBit = (index * BitsPerInt);
+    const uint32 endBit      = (startingBit + numBits);
+
+    T mask = 0;
+
+    if ((startingBit < (intFirstBit + BitsPerInt)) && (endBit > intFirstBit))
+    {
+        const uint32 first = (startingBit > intFirstBit) ? (startingBit - intFirstBit) : 0;
+        const uint32 end   = (endBit < (intFirstBit + BitsPerInt)) ? (endBit - intFirstBit) : BitsPerInt;
+
+        const T allBits = static_cast<T>(~static_cast<T>(0));
+
+        mask = static_cast<T>(static_cast<T>(allBits >> (BitsPerInt - (end - first))) << first);
+    }
+
+    return mask;
+}
+
+/// Sets a range of bits in a "wide bitfield" to one. A "wide bifield" is a bitfield which spans an array of integers
+/// because there are more flags than bits in one integer.
+///
+/// @param [in] bitfield     Reference to the bitfield being modified
+/// @param [in] startingBit  Index of the first flag to set
+/// @param [in] numBits      Number of flags to set
+template <typename T, size_t N>
+void WideBitfieldSetRange(
+    T      (&bitfield)[N],
+    uint32 startingBit,
+    uint32 numBits)
+{
+    if (numBits > 0)
+    {
+        const uint32 lastIndex = ((startingBit + numBits - 1) / (sizeof(T) << 3));
+
+        for (uint32 index = (startingBit / (sizeof(T) << 3)); index <= lastIndex; ++index)
+        {
+            bitfield[index] |= WideBitfieldRangeMask<T>(index, startingBit, numBits);
+        }
+    }
+}
+
+/// Clears a range of bits in a "wide bitfield" to zero. A "wide bifield" is a bitfield which spans an array of
+/// integers because there are more flags than bits in one integer.
+///
+/// @param [in] bitfield     Reference to the bitfield being modified
+/// @param [in] startingBit  Index of the first flag to clear
+/// @param [in] numBits      Number of flags to clear
+template <typename T, size_t N>
+void WideBitfieldClearRange(
+    T      (&bitfield)[N],
+    uint32 startingBit,
+    uint32 numBits)
+{
+    if (numBits > 0)
+    {
+        const uint32 lastIndex = ((startingBit + numBits - 1) / (sizeof(T) << 3));
+
+        for (uint32 index = (startingBit / (sizeof(T) << 3)); index <= lastIndex; ++index)
+        {
+            bitfield[index] &= ~WideBitfieldRangeMask<T>(index, startingBit, numBits);
+        }
+    }
+}
+
+/// Tests if any bit within a range of a "wide bitfield" is set. A "wide bifield" is a bitfield which spans an array of
+/// integers because there are more flags than bits in one integer.
+///
+/// @param [in] bitfield     Reference to the bitfield being tested
+/// @param [in] startingBit  Index of the first flag to test
+/// @param [in] numBits      Number of flags to test
+///
+/// @returns True if any flag in the range is set.
+template <typename T, size_t N>
+bool WideBitfieldIsAnySetInRange(
+    const T (&bitfield)[N],
+    uint32  startingBit,
+    uint32  numBits)
+{
+    bool isSet = false;
+
+    if (numBits > 0)
+    {
+        const uint32 lastIndex = ((startingBit + numBits - 1) / (sizeof(T) << 3));
+
+        for (uint32 index = (startingBit / (sizeof(T) << 3)); (index <= lastIndex) && (isSet == false); ++index)
+        {
+            isSet = ((bitfield[index] & WideBitfieldRangeMask<T>(index, startingBit, numBits)) != 0);
+        }
+    }
+
+    return isSet;
+}
+
 /// Scans the specified bit-mask for the least-significant '1' bit.
 ///
 /// @returns True if the input was nonzero; false otherwise.
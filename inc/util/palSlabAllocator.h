@@ -0,0 +1,194 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palSlabAllocator.h
+ * @brief PAL utility collection SlabAllocator class declaration.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palMutex.h"
+#include "palSysMemory.h"
+#include "palThread.h"
+
+namespace Util
+{
+
+/// Statistics reported by @ref SlabAllocator::GetStats.
+struct SlabAllocatorStats
+{
+    size_t memoryCeiling;      ///< Maximum number of bytes of slabs the allocator may hold.
+    size_t slabBytes;          ///< Number of bytes of slabs currently allocated from the wrapped callbacks.
+    uint32 threadCacheCount;   ///< Number of threads which have been given a cache of free objects.
+    uint64 refillCount;        ///< Number of batches of objects moved from the shared free lists to a thread cache.
+    uint64 flushCount;         ///< Number of batches of objects returned from a thread cache to the shared free lists.
+    uint64 fallbackAllocCount; ///< Number of allocations passed on to the wrapped callbacks because they were too
+                               ///  large or too strictly aligned for any size class, or the ceiling was reached.
+    bool   passThrough;        ///< True if the wrapped callbacks returned a slab which wasn't aligned to SlabSize.  No
+                               ///  further slabs are allocated and every new allocation the free lists can't serve is
+                               ///  passed on to the wrapped callbacks.
+};
+
+/**
+ ***********************************************************************************************************************
+ * @brief Size-class slab allocator with per-thread caches which sits between PAL and a set of system memory allocation
+ *        callbacks.
+ *
+ * Most of PAL's internal allocations are small, long-lived objects such as hash groups, list nodes and layer
+ * decorators.  This allocator serves allocations of up to MaxObjectSize bytes from fixed-size slabs instead of calling
+ * the wrapped callbacks each time.  Each slab is carved into objects of a single size class.
+ *
+ * Every thread keeps a small cache of free objects per size class, so most allocations and frees neither lock nor
+ * call into the wrapped callbacks.  When a thread's cache runs dry it takes a batch of objects from the size class's
+ * shared free list; when it grows too large it returns a batch.
+ *
+ * Slabs are only allocated until the memory ceiling is reached, after which small allocations which can't be served
+ * from the free lists are passed on to the wrapped callbacks.  The same happens for good if the wrapped callbacks
+ * ever return a slab which isn't aligned to SlabSize, because frees find an object's slab by masking its address.
+ *
+ * Each allocator wraps one set of allocation callbacks and is owned by whoever allocates through the wrapped callbacks
+ * (the Platform, in PAL's case).  No thread-exit hook is installed: the caches of at most MaxThreadCaches threads are
+ * kept until the allocator is destroyed, and any further threads use the shared free lists directly.  Destroying the
+ * allocator frees every thread cache and returns every slab to the wrapped callbacks.
+ ***********************************************************************************************************************
+ */
+class SlabAllocator
+{
+public:
+    /// Size in bytes of each slab.  Slabs are aligned to their size.
+    static constexpr size_t SlabSize = 64 * 1024;
+
+    /// Largest allocation in bytes which is served from a slab.
+    static constexpr size_t MaxObjectSize = 1024;
+
+    /// Memory ceiling used if the caller doesn't specify one.
+    static constexpr size_t DefaultMemoryCeiling = 64 * 1024 * 1024;
+
+    /// Maximum number of threads which get their own cache of free objects.
+    static constexpr uint32 MaxThreadCaches = 64;
+
+    /// Creates an allocator which serves small allocations made through the callbacks returned by GetAllocCallbacks()
+    /// from slabs, passing everything else on to the client's callbacks.
+    ///
+    /// @param [in]  clientCb      Callbacks from which slabs, the allocator's own state and all other allocations
+    ///                            are allocated.
+    /// @param [in]  memoryCeiling Maximum number of bytes of slabs to allocate, or zero to use the default.
+    /// @param [out] ppAllocator   The new allocator.
+    ///
+    /// @returns Success if the allocator was created, or an appropriate error (e.g., ErrorOutOfMemory) otherwise.
+    static Result Create(const AllocCallbacks& clientCb, size_t memoryCeiling, SlabAllocator** ppAllocator);
+
+    /// Destroys the allocator, freeing every thread cache and returning every slab to the client's callbacks.  Every
+    /// allocation made through the allocator's callbacks must have been freed by now.
+    void Destroy();
+
+    /// Returns callbacks which serve small allocations from slabs.  Every allocation made through them must also be
+    /// freed through them.
+    ///
+    /// @param [out] pAllocCb Filled with the slab allocator's callbacks.
+    void GetAllocCallbacks(AllocCallbacks* pAllocCb);
+
+    /// Gets a snapshot of the allocator's statistics.
+    ///
+    /// @param [out] pStats Statistics.
+    void GetStats(SlabAllocatorStats* pStats) const;
+
+private:
+    static constexpr uint32 NumSizeClasses        = 12;
+    static constexpr size_t SizeLookupGranularity = 16; // Granularity of the table mapping sizes to size classes.
+    static constexpr uint32 NumSizeLookups        = (MaxObjectSize / SizeLookupGranularity) + 1;
+
+    // A free object.  The link to the next free object is stored in the object itself.
+    struct FreeObject
+    {
+        FreeObject* pNext;
+    };
+
+    // Shared state of one size class.
+    struct SizeClass
+    {
+        Mutex       lock;         // Protects the members below.
+        FreeObject* pFreeList;
+        uint32      freeCount;
+        uint8*      pCarveCursor; // Next object of the newest slab which has never been handed out.
+        uint8*      pCarveEnd;
+    };
+
+    struct ThreadCache;
+
+    SlabAllocator(const AllocCallbacks& clientCb, size_t memoryCeiling);
+    ~SlabAllocator();
+
+    Result Init();
+
+    uint32 SlabTableSlot(uintptr_t slabBase) const;
+    uint32 FindSlabSizeClass(const void* pMem) const;
+    uint32 SizeClassIndex(size_t size, size_t alignment) const;
+
+    bool AllocSlab(uint32 sizeClass);
+    void* AllocShared(uint32 sizeClass);
+    ThreadCache* GetThreadCache();
+    void RefillThreadCache(ThreadCache* pCache, uint32 sizeClass);
+    void FlushThreadCache(ThreadCache* pCache, uint32 sizeClass, uint32 count);
+
+    static void* PAL_STDCALL SlabAlloc(
+        void*           pClientData,
+        size_t          size,
+        size_t          alignment,
+        SystemAllocType allocType);
+    static void PAL_STDCALL SlabFree(void* pClientData, void* pMem);
+
+    const AllocCallbacks m_clientCb;
+    const size_t         m_memoryCeiling;
+    ThreadLocalKey       m_cacheKey;        // Each thread's ThreadCache.
+    bool                 m_keyCreated;
+    uint8                m_sizeLookup[NumSizeLookups];
+    uint32               m_batchSizes[NumSizeClasses];
+
+    // Open-addressed set of the base addresses of all slabs, each tagged with its size class plus one in its low bits.
+    // Slots are only ever filled, so frees can look up slabs without a lock.
+    volatile uintptr_t*  m_pSlabTable;
+    uint32               m_slabTableMask;
+    Mutex                m_slabLock;        // Serializes slab allocation.
+    volatile bool        m_passThrough;     // Set if a slab was misaligned; no more slabs are allocated.
+
+    Mutex                m_cacheListLock;   // Serializes the creation of thread caches.
+    ThreadCache*         m_pCacheList;      // Every thread cache, so that they can be freed with the allocator.
+
+    volatile uint64      m_slabBytes;
+    volatile uint32      m_threadCacheCount;
+    volatile uint64      m_refillCount;
+    volatile uint64      m_flushCount;
+    volatile uint64      m_fallbackAllocCount;
+
+    SizeClass            m_classes[NumSizeClasses];
+
+    PAL_DISALLOW_DEFAULT_CTOR(SlabAllocator);
+    PAL_DISALLOW_COPY_AND_ASSIGN(SlabAllocator);
+};
+
+} // Util
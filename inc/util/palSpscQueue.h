@@ -0,0 +1,178 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+/**
+ ***********************************************************************************************************************
+ * @file  palSpscQueue.h
+ * @brief PAL utility collection SpscQueue class declaration.
+ ***********************************************************************************************************************
+ */
+
+#pragma once
+
+#include "palInlineFuncs.h"
+#include "palMutex.h"
+#include "palSysMemory.h"
+
+namespace Util
+{
+
+/**
+ ***********************************************************************************************************************
+ * @brief Bounded, lock-free, single-producer/single-consumer FIFO queue.
+ *
+ * Exactly one thread may call Push() and exactly one (possibly different) thread may call Pop().  Neither call ever
+ * blocks: Push() fails if the queue is full and Pop() fails if it is empty, leaving it up to the caller to decide how
+ * to wait.  The read and write indices live on separate cache lines and each side caches the other side's index, so
+ * the shared cache lines are only touched when the cached view suggests the queue is full or empty.
+ *
+ * T must be trivially copyable; elements are copied in and out with plain assignment.
+ ***********************************************************************************************************************
+ */
+template <typename T, typename Allocator>
+class SpscQueue
+{
+public:
+    /// Constructor.
+    ///
+    /// @param [in] pAllocator The allocator that will allocate the element storage in Init().
+    explicit SpscQueue(Allocator*const pAllocator)
+        :
+        m_pSlots(nullptr),
+        m_mask(0),
+        m_pAllocator(pAllocator),
+        m_tail(0),
+        m_headCache(0),
+        m_head(0),
+        m_tailCache(0)
+    {
+    }
+
+    ~SpscQueue() { PAL_SAFE_FREE(m_pSlots, m_pAllocator); }
+
+    /// Allocates storage for the queue.  Must be called once before any other method.
+    ///
+    /// @param [in] capacity Minimum number of elements the queue must hold; rounded up to a power of two.
+    ///
+    /// @returns Success if successful, otherwise ErrorOutOfMemory.
+    Result Init(uint32 capacity)
+    {
+        PAL_ASSERT((m_pSlots == nullptr) && (capacity > 0));
+
+        const uint32 slotCount = Pow2Pad(capacity);
+        m_pSlots = static_cast<T*>(PAL_MALLOC(sizeof(T) * slotCount, m_pAllocator, AllocInternal));
+        m_mask   = slotCount - 1;
+
+        return (m_pSlots != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+    }
+
+    /// Appends an element to the back of the queue.  May only be called from the producer thread.
+    ///
+    /// @param [in] data Element to copy into the queue.
+    ///
+    /// @returns True if the element was queued, or false if the queue is full.
+    bool Push(const T& data)
+    {
+        const uint32 tail = m_tail;
+
+        if ((tail - m_headCache) > m_mask)
+        {
+            // Looks full; refresh our view of the consumer's progress.
+            m_headCache = AtomicAdd(&m_head, 0);
+        }
+
+        const bool pushed = ((tail - m_headCache) <= m_mask);
+
+        if (pushed)
+        {
+            m_pSlots[tail & m_mask] = data;
+
+            // The atomic add is a full barrier, so the element is visible before the new tail is.
+            AtomicIncrement(&m_tail);
+        }
+
+        return pushed;
+    }
+
+    /// Removes the element at the front of the queue.  May only be called from the consumer thread.
+    ///
+    /// @param [out] pData Receives the removed element.
+    ///
+    /// @returns True if an element was removed, or false if the queue is empty.
+    bool Pop(T* pData)
+    {
+        const uint32 head = m_head;
+
+        if (head == m_tailCache)
+        {
+            // Looks empty; refresh our view of the producer's progress.
+            m_tailCache = AtomicAdd(&m_tail, 0);
+        }
+
+        const bool popped = (head != m_tailCache);
+
+        if (popped)
+        {
+            *pData = m_pSlots[head & m_mask];
+
+            // The atomic add is a full barrier, so the slot is read before the producer may overwrite it.
+            AtomicIncrement(&m_head);
+        }
+
+        return popped;
+    }
+
+    /// Returns true if the queue was empty at some point during the call.  Safe to call from either thread, but the
+    /// answer may be stale by the time the caller acts on it.
+    bool IsEmpty() const
+    {
+        return (AtomicAdd(const_cast<volatile uint32*>(&m_head), 0) ==
+                AtomicAdd(const_cast<volatile uint32*>(&m_tail), 0));
+    }
+
+    /// Returns the number of elements the queue can hold.
+    uint32 Capacity() const { return (m_mask + 1); }
+
+private:
+    static constexpr size_t CacheLineSize = 64;
+
+    T*              m_pSlots;
+    uint32          m_mask;
+    Allocator*const m_pAllocator;
+
+    // Producer-owned state.
+    uint8           m_producerPad[CacheLineSize];
+    volatile uint32 m_tail;       // Index of the next slot to write.
+    uint32          m_headCache;  // Producer's last observed value of m_head.
+
+    // Consumer-owned state.
+    uint8           m_consumerPad[CacheLineSize];
+    volatile uint32 m_head;       // Index of the next slot to read.
+    uint32          m_tailCache;  // Consumer's last observed value of m_tail.
+
+    PAL_DISALLOW_DEFAULT_CTOR(SpscQueue);
+    PAL_DISALLOW_COPY_AND_ASSIGN(SpscQueue);
+};
+
+} // Util
@@ -356,6 +356,29 @@ extern size_t DumpStackTrace(
     size_t  bufSize,
     uint32  skipFrames);
 
+/// OS-specific wrapper for capturing the return addresses of the calling thread's stack frames.
+///
+/// @param [out] ppFrames   Array of maxFrames return addresses, innermost frame first.
+/// @param [in]  maxFrames  Number of entries in ppFrames.
+/// @param [in]  skipFrames Number of innermost stack frames to skip, not counting this function itself.
+///
+/// @returns The number of frames written to ppFrames.
+extern uint32 CaptureStackFrames(
+    void**  ppFrames,
+    uint32  maxFrames,
+    uint32  skipFrames);
+
+/// OS-specific wrapper for describing a code address captured by @ref CaptureStackFrames as a module and symbol
+/// name plus offset.  Falls back to the raw address if no symbol information is available.
+///
+/// @param [in]  pAddress Code address to describe.
+/// @param [out] pOutput  Output string.
+/// @param [in]  bufSize  Available space in pOutput.
+extern void DescribeCodeAddress(
+    const void* pAddress,
+    char*       pOutput,
+    size_t      bufSize);
+
 /// Flushes CPU cached writes to memory.
 PAL_INLINE void FlushCpuWrites()
 {
@@ -503,6 +503,41 @@ private:
     DD_DISALLOW_COPY_AND_ASSIGN(Library);
 };
 
+// A named region of memory that other processes on the same machine can map, used to hand large payloads to a local
+// client without splitting them into messages. The name must not contain path separators; the platform adds any
+// prefix its namespace requires.
+class SharedBuffer
+{
+public:
+    static constexpr size_t kMaxNameLength = 64;
+
+    SharedBuffer() : m_pData(nullptr), m_size(0), m_isOwner(false) { m_name[0] = '\0'; }
+    ~SharedBuffer() { Close(); }
+
+    // Creates a new buffer of the given size and maps it for writing. Fails if a buffer with this name exists.
+    Result Create(const char* pName, size_t size);
+
+    // Maps a buffer created by another process for reading. Fails if the buffer is smaller than size.
+    Result Open(const char* pName, size_t size);
+
+    // Unmaps the buffer. If this object created the buffer its name is released, but processes which have already
+    // opened it keep their mappings.
+    void Close();
+
+    bool   IsOpen() const { return (m_pData != nullptr); }
+    void*  GetData() const { return m_pData; }
+    size_t GetSize() const { return m_size; }
+    const char* GetName() const { return m_name; }
+
+private:
+    void*  m_pData;
+    size_t m_size;
+    bool   m_isOwner;
+    char   m_name[kMaxNameLength];
+
+    DD_DISALLOW_COPY_AND_ASSIGN(SharedBuffer);
+};
+
 ProcessId GetProcessId();
 
 uint64 GetCurrentTimeInMs();
@@ -38,6 +38,9 @@
 #include <cstdarg>
 #include <time.h>
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 namespace DevDriver
 {
@@ -209,6 +212,115 @@ namespace DevDriver
             return reinterpret_cast<void*>(dlsym(m_hLib, pName));
         }
 
+        /////////////////////////////////////////////////////
+        // Shared Buffer
+        /////////////////////////////////////////////////////
+
+        // Shared memory object names must start with a single slash.
+        static void GetSharedBufferPath(const char* pName, char* pPath, size_t pathSize)
+        {
+            Snprintf(pPath, pathSize, "/%s", pName);
+        }
+
+        Result SharedBuffer::Create(
+            const char* pName,
+            size_t      size)
+        {
+            Result result = Result::Error;
+
+            if ((m_pData == nullptr) && (size > 0))
+            {
+                char path[kMaxNameLength + 1];
+                GetSharedBufferPath(pName, path, sizeof(path));
+
+                const int fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+                if (fd != -1)
+                {
+                    if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+                    {
+                        void* pData = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                        if (pData != MAP_FAILED)
+                        {
+                            m_pData   = pData;
+                            m_size    = size;
+                            m_isOwner = true;
+                            Strncpy(m_name, pName, sizeof(m_name));
+                            result = Result::Success;
+                        }
+                    }
+
+                    // The mapping keeps the object alive so the descriptor isn't needed any more.
+                    close(fd);
+
+                    if (result != Result::Success)
+                    {
+                        shm_unlink(path);
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        Result SharedBuffer::Open(
+            const char* pName,
+            size_t      size)
+        {
+            Result result = Result::Error;
+
+            if ((m_pData == nullptr) && (size > 0))
+            {
+                char path[kMaxNameLength + 1];
+                GetSharedBufferPath(pName, path, sizeof(path));
+
+                const int fd = shm_open(path, O_RDONLY, 0);
+                if (fd != -1)
+                {
+                    struct stat info = {};
+                    if ((fstat(fd, &info) == 0) && (static_cast<size_t>(info.st_size) >= size))
+                    {
+                        void* pData = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+                        if (pData != MAP_FAILED)
+                        {
+                            m_pData   = pData;
+                            m_size    = size;
+                            m_isOwner = false;
+                            Strncpy(m_name, pName, sizeof(m_name));
+                            result = Result::Success;
+                        }
+                    }
+
+                    close(fd);
+                }
+                else
+                {
+                    result = Result::Unavailable;
+                }
+            }
+
+            return result;
+        }
+
+        void SharedBuffer::Close()
+        {
+            if (m_pData != nullptr)
+            {
+                munmap(m_pData, m_size);
+
+                if (m_isOwner)
+                {
+                    char path[kMaxNameLength + 1];
+                    GetSharedBufferPath(m_name, path, sizeof(path));
+                    shm_unlink(path);
+                }
+
+                m_pData   = nullptr;
+                m_size    = 0;
+                m_isOwner = false;
+                m_name[0] = '\0';
+            }
+        }
+
         /////////////////////////////////////////////////////
         // Memory Management
         /////////////////////////////////////////////////////
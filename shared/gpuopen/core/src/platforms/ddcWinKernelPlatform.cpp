@@ -398,6 +398,26 @@ namespace DevDriver
             m_prevState = (seed.LowPart ^ seed.HighPart);
         }
 
+        // Shared buffers are only used between user mode clients, so the KMD never provides them. Callers are expected
+        // to fall back to sending their data through messages.
+        Result SharedBuffer::Create(const char* pName, size_t size)
+        {
+            DD_UNUSED(pName);
+            DD_UNUSED(size);
+            return Result::Unavailable;
+        }
+
+        Result SharedBuffer::Open(const char* pName, size_t size)
+        {
+            DD_UNUSED(pName);
+            DD_UNUSED(size);
+            return Result::Unavailable;
+        }
+
+        void SharedBuffer::Close()
+        {
+        }
+
         // Determining the process ID inside the kernel is a bit complicated as kernel threads don't have a process
         // ID of their own, whereas code executed during an escape call is executing inside the address space of the
         // invoking process. As a result we default to assuming all code in the KMD has a process ID of 0, and
@@ -268,6 +268,107 @@ namespace DevDriver
             return reinterpret_cast<void*>(GetProcAddress(m_hLib, pName));
         }
 
+        /////////////////////////////////////////////////////
+        // Shared Buffer
+        /////////////////////////////////////////////////////
+
+        // Keep shared buffers in the session namespace so that no special privileges are required to create them.
+        static void GetSharedBufferPath(const char* pName, char* pPath, size_t pathSize)
+        {
+            Snprintf(pPath, pathSize, "Local\\%s", pName);
+        }
+
+        Result SharedBuffer::Create(
+            const char* pName,
+            size_t      size)
+        {
+            Result result = Result::Error;
+
+            if ((m_pData == nullptr) && (size > 0))
+            {
+                char path[kMaxNameLength + 8];
+                GetSharedBufferPath(pName, path, sizeof(path));
+
+                const uint64 size64  = static_cast<uint64>(size);
+                HANDLE       hObject = CreateFileMappingA(INVALID_HANDLE_VALUE,
+                                                          nullptr,
+                                                          PAGE_READWRITE,
+                                                          static_cast<DWORD>(size64 >> 32),
+                                                          static_cast<DWORD>(size64),
+                                                          path);
+
+                if ((hObject != nullptr) && (GetLastError() != ERROR_ALREADY_EXISTS))
+                {
+                    void* pData = MapViewOfFile(hObject, FILE_MAP_WRITE, 0, 0, size);
+                    if (pData != nullptr)
+                    {
+                        m_pData   = pData;
+                        m_size    = size;
+                        m_isOwner = true;
+                        Strncpy(m_name, pName, sizeof(m_name));
+                        result = Result::Success;
+                    }
+                }
+
+                // The view keeps the mapping object alive so the handle isn't needed any more.
+                if (hObject != nullptr)
+                {
+                    CloseHandle(hObject);
+                }
+            }
+
+            return result;
+        }
+
+        Result SharedBuffer::Open(
+            const char* pName,
+            size_t      size)
+        {
+            Result result = Result::Error;
+
+            if ((m_pData == nullptr) && (size > 0))
+            {
+                char path[kMaxNameLength + 8];
+                GetSharedBufferPath(pName, path, sizeof(path));
+
+                HANDLE hObject = OpenFileMappingA(FILE_MAP_READ, FALSE, path);
+                if (hObject != nullptr)
+                {
+                    void* pData = MapViewOfFile(hObject, FILE_MAP_READ, 0, 0, size);
+                    if (pData != nullptr)
+                    {
+                        m_pData   = pData;
+                        m_size    = size;
+                        m_isOwner = false;
+                        Strncpy(m_name, pName, sizeof(m_name));
+                        result = Result::Success;
+                    }
+
+                    CloseHandle(hObject);
+                }
+                else
+                {
+                    result = Result::Unavailable;
+                }
+            }
+
+            return result;
+        }
+
+        void SharedBuffer::Close()
+        {
+            // Windows releases the name along with the last view of the mapping.
+            if (m_pData != nullptr)
+            {
+                UnmapViewOfFile(m_pData);
+
+                m_pData   = nullptr;
+                m_size    = 0;
+                m_isOwner = false;
+                m_name[0] = '\0';
+            }
+        }
+
         /////////////////////////////////////////////////////
         // Memory Management
         /////////////////////////////////////////////////////
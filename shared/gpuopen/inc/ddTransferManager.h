@@ -49,9 +49,14 @@ namespace DevDriver
         class TransferManager;
         class TransferServer;
 
-        // Size of an individual "chunk" within a transfer operation.
+        // Size of an individual "chunk" within a transfer operation. This is also the size of the first storage
+        // chunk of a server block.
         static const size_t kTransferChunkSizeInBytes = 4096;
 
+        // Default limit on the size of the storage chunks of a server block. Each new chunk doubles the capacity of
+        // the block until chunks reach this size.
+        static const size_t kDefaultMaxServerChunkSizeInBytes = (1024 * 1024);
+
         // A struct that represents a single transfer chunk
         struct TransferChunk
         {
@@ -82,20 +87,19 @@ namespace DevDriver
         };
 
         // A server transfer block.
-        // Only supports writes and must be closed before the data can be accessed.
-        // Writes can only be performed on blocks that have not been closed.
+        // Only supports writes. Remote clients can pull the block once it has been closed, or stream it while it is
+        // still being written. Writes can only be performed on blocks that have not been closed.
+        //
+        // The data is stored in a list of chunks which never move once allocated, so growing a block never copies
+        // the data already written and streaming readers can access it while the owner keeps writing.
         class ServerBlock final : public TransferBlock
         {
             friend class TransferServer;
         public:
-            explicit ServerBlock(const AllocCb& allocCb, BlockId blockId)
-                : TransferBlock(blockId)
-                , m_isClosed(false)
-                , m_chunks(allocCb)
-                , m_numPendingTransfers(0)
-                , m_transfersCompletedEvent(true)
-                , m_crc32(0)
-                {}
+            explicit ServerBlock(const AllocCb& allocCb,
+                                 BlockId        blockId,
+                                 size_t         maxChunkSizeInBytes = kDefaultMaxServerChunkSizeInBytes);
+            ~ServerBlock();
 
             // Writes numBytes bytes from pSrcBuffer into the block.
             void Write(const void* pSrcBuffer, size_t numBytes);
@@ -110,10 +114,13 @@ namespace DevDriver
             bool IsClosed() const { return m_isClosed; }
 
             // Returns a const pointer to the underlying data contained within the block, or null if it contains
-            // no data.
-            const uint8* GetBlockData() const {
-                return (m_blockDataSize > 0) ? reinterpret_cast<const uint8*>(m_chunks.Data()) : nullptr;
-            }
+            // no data or its data isn't contiguous. Blocks filled by a push transfer, sized up front with Reserve or
+            // shared with a local client are always contiguous. Use ReadBlockData to access any block.
+            const uint8* GetBlockData() const;
+
+            // Copies up to numBytes bytes of the block's data starting at offset into pDstBuffer. Returns the number
+            // of bytes copied. Safe to call while another thread is writing to the block.
+            size_t ReadBlockData(size_t offset, void* pDstBuffer, size_t numBytes);
 
             // Returns a boolean indicating whether the block has any transfers in progress.
             bool HasPendingTransfers();
@@ -127,22 +134,51 @@ namespace DevDriver
             // Returns a CRC32 for the current block
             uint32 GetCrc32() const { return m_crc32; };
 
-            // Reserves at least the specified number of bytes in the internal storage.
+            // Reserves at least the specified number of bytes in the internal storage. If the block is empty the
+            // whole reservation is made contiguous.
             void Reserve(size_t bytes);
 
         private:
+            // A single allocation holding part of the block's data.
+            struct DataChunk
+            {
+                uint8* pData;    // Storage for this chunk
+                size_t offset;   // Offset of this chunk's first byte within the block
+                size_t capacity; // Size of the storage in bytes
+            };
+
             // Notifies the block that a new transfer has begun.
             void BeginTransfer();
 
             // Notifies the block that an existing transfer has ended.
             void EndTransfer();
 
-            bool                  m_isClosed;                // A bool that indicates if the block is closed
-            Vector<TransferChunk> m_chunks;                  // A list of transfer chunks used to store data
+            // Returns the size of the data and whether the block is closed, consistently with concurrent writes.
+            size_t QueryWriteState(bool* pIsClosed);
+
+            // Moves the data of a closed block into a named shared buffer, if it isn't there already, and returns the
+            // buffer's name. The buffer becomes the block's storage so it is only created once no matter how many
+            // local clients pull the block. It is released when the block is reset or destroyed.
+            Result ShareBlockData(const char** ppName);
+
+            // Appends a chunk of at least minCapacity bytes. Must be called with m_dataMutex held.
+            bool AddChunk(size_t minCapacity);
+
+            // Frees all chunks. Must be called with m_dataMutex held.
+            void FreeChunks();
+
+            AllocCb               m_allocCb;
+            const size_t          m_maxChunkSize;            // Largest chunk allocated when growing the block
+            volatile bool         m_isClosed;                // A bool that indicates if the block is closed
+            Vector<DataChunk>     m_chunks;                  // The chunks storing the block's data, in block order
+            size_t                m_capacity;                // Total capacity of all chunks
+            uint32                m_writeChunk;              // Index of the chunk the next write starts in
+            Platform::Mutex       m_dataMutex;               // Protects m_chunks, m_blockDataSize and m_isClosed
             Platform::Mutex       m_pendingTransfersMutex;   // A mutex used to control access to the pending transfers counter
             uint32                m_numPendingTransfers;     // A counter used to track the number of pending transfers
             Platform::Event       m_transfersCompletedEvent; // An event that is signaled when all pendings transfers are completed
             uint32                m_crc32;                   // CRC covering all data stored in this block
+            Platform::SharedBuffer m_sharedStorage;          // Storage of a block shared with local clients
         };
 
         // Backwards compatibility type alias. This will be removed with a future interface version change.
@@ -155,15 +191,19 @@ namespace DevDriver
         public:
             // Reads up to bufferSize bytes into pDstBuffer from the block.
             // Returns the number of bytes read in pBytesRead.
+            // Blocks opened with OpenStreamingPullBlock return NotReady if no data arrived in time, and their size is
+            // only known once Read has returned EndOfStream.
             Result Read(uint8* pDstBuffer, size_t bufferSize, size_t* pBytesRead);
 
         private:
             explicit PullBlock(IMsgChannel* pMsgChannel, BlockId blockId)
                 : TransferBlock(blockId)
                 , m_transferClient(pMsgChannel)
+                , m_isStreaming(false)
             {}
 
             TransferClient m_transferClient;
+            bool           m_isStreaming;    // The block size is accumulated as data is read
         };
 
         // A transfer block for sending data to a remote server block
@@ -202,7 +242,8 @@ namespace DevDriver
             // Returns a shared pointer to a server block or nullptr in the case of an error.
             // Shared pointers are always used with server blocks to make sure they aren't destroyed
             // while a remote download is in progress.
-            SharedPointer<ServerBlock> OpenServerBlock();
+            // Producers of large blocks can raise maxChunkSizeInBytes to reduce the number of allocations.
+            SharedPointer<ServerBlock> OpenServerBlock(size_t maxChunkSizeInBytes = kDefaultMaxServerChunkSizeInBytes);
 
             // Returns a shared pointer to a server block matching the requested block ID, or nullptr if it does
             // not exist.
@@ -216,6 +257,10 @@ namespace DevDriver
             // Returns a valid PullBlock pointer on success and nullptr on failure.
             PullBlock* OpenPullBlock(ClientId clientId, BlockId blockId);
 
+            // Like OpenPullBlock, but the remote block doesn't need to be closed yet: data is received as the remote
+            // client writes it. Returns nullptr if the remote client doesn't support streaming.
+            PullBlock* OpenStreamingPullBlock(ClientId clientId, BlockId blockId);
+
             // Closes a pull block and deletes the underlying resources.
             // This will null out the pull block pointer that is passed in as ppBlock.
             void ClosePullBlock(PullBlock** ppBlock);
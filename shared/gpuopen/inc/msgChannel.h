@@ -129,6 +129,23 @@ namespace DevDriver
         virtual Result Receive(MessageBuffer& message, uint32 timeoutInMs) = 0;
         virtual Result Forward(const MessageBuffer& messageBuffer) = 0;
 
+        // Forwards several messages in order, stopping at the first one that can't be sent and returning its result.
+        // pNumForwarded receives the number of messages sent.
+        virtual Result ForwardMessages(const MessageBuffer* const* ppMessages, uint32 count, uint32* pNumForwarded)
+        {
+            Result result = Result::Success;
+            uint32 numForwarded = 0;
+
+            while ((result == Result::Success) && (numForwarded < count))
+            {
+                result = Forward(*ppMessages[numForwarded]);
+                numForwarded += (result == Result::Success) ? 1 : 0;
+            }
+
+            *pNumForwarded = numForwarded;
+            return result;
+        }
+
         // Register, unregister, and retrieve IProtocolServer objects
         virtual Result RegisterProtocolServer(IProtocolServer* pServer) = 0;
         virtual Result UnregisterProtocolServer(IProtocolServer* pServer) = 0;
@@ -161,6 +178,9 @@ namespace DevDriver
         // Get a human-readable string describing the connection type.
         virtual const char* GetTransportName() const = 0;
 
+        // Get the type of the connection. Clients connected through a local transport share a machine with the bus.
+        virtual TransportType GetTransportType() const = 0;
+
         // Set and get all client status flags.
         virtual Result SetStatusFlags(StatusFlags flags) = 0;
         virtual StatusFlags GetStatusFlags() const = 0;
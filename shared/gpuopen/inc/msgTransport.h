@@ -48,9 +48,30 @@ namespace DevDriver
         virtual Result WriteMessage(const MessageBuffer &messageBuffer) = 0;
         virtual Result ReadMessage(MessageBuffer &messageBuffer, uint32 timeoutInMs) = 0;
 
+        // Writes several messages in order, stopping at the first one that can't be written and returning its result.
+        // pNumWritten receives the number of messages written. Transports that can send a group of messages more
+        // cheaply than one at a time should override this.
+        virtual Result WriteMessages(const MessageBuffer* const* ppMessages, uint32 count, uint32* pNumWritten)
+        {
+            Result result = Result::Success;
+            uint32 numWritten = 0;
+
+            while ((result == Result::Success) && (numWritten < count))
+            {
+                result = WriteMessage(*ppMessages[numWritten]);
+                numWritten += (result == Result::Success) ? 1 : 0;
+            }
+
+            *pNumWritten = numWritten;
+            return result;
+        }
+
         // Get a human-readable string describing the connection type.
         virtual const char* GetTransportName() const = 0;
 
+        // Get the type of the connection. Local transports only connect clients on the same machine.
+        virtual TransportType GetTransportType() const = 0;
+
         // Static method to be implemented by individual transports
         // true indicates that the transport is incapable of detecting
         //   dropped connections and some form of keep-alive is required
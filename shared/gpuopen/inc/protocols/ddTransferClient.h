@@ -51,7 +51,12 @@ namespace DevDriver
             // pTransferSizeInBytes.
             Result RequestPullTransfer(BlockId blockId, size_t* pTransferSizeInBytes);
 
+            // Requests a streaming transfer on the remote client. The block doesn't need to be closed: data is sent as
+            // it is written. Returns VersionMismatch if the remote client doesn't support streaming transfers.
+            Result RequestStreamingPullTransfer(BlockId blockId);
+
             // Reads transfer data from a previous transfer that completed successfully.
+            // For streaming transfers this returns NotReady if no data arrived in time; the caller can retry.
             Result ReadPullTransferData(uint8* pDstBuffer, size_t bufferSize, size_t* pBytesRead);
 
             // Aborts a pull transfer in progress.
@@ -81,6 +86,16 @@ namespace DevDriver
         private:
             void ResetState() override;
 
+            // Attempts to pull the block through a shared buffer created by the server. Returns Unavailable if the
+            // server couldn't provide one, in which case the session is idle again and a regular pull can be issued.
+            Result RequestSharedPullTransfer(BlockId blockId, size_t* pTransferSizeInBytes);
+
+            // Copies data out of the shared buffer of a shared pull transfer.
+            Result ReadSharedPullTransferData(uint8* pDstBuffer, size_t bufferSize, size_t* pBytesRead);
+
+            // Receives data of a streaming pull transfer, which has no size known up front.
+            Result ReadStreamingPullTransferData(uint8* pDstBuffer, size_t bufferSize, size_t* pBytesRead);
+
             // Helper method to send a payload, handling backwards compatibility and retrying.
             Result SendTransferPayload(const SizedPayloadContainer& container,
                                        uint32                       timeoutInMs = kDefaultCommunicationTimeoutInMs,
@@ -110,10 +125,13 @@ namespace DevDriver
                 uint32 crc32;
                 size_t dataChunkSizeInBytes;
                 size_t dataChunkBytesTransfered;
+                uint32 expectedCrc32;             // CRC of the whole block for shared pulls.
+                size_t sharedBytesRead;           // Number of bytes already read from the shared buffer.
                 SizedPayloadContainer scratchPayload;
             };
 
-            ClientTransferContext m_transferContext;
+            ClientTransferContext  m_transferContext;
+            Platform::SharedBuffer m_sharedBuffer; // Mapping of the server's copy of the block during a shared pull.
 
             DD_STATIC_CONST uint32 kTransferChunkTimeoutInMs = 3000;
         };
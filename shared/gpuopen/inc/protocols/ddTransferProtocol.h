@@ -40,7 +40,7 @@
 ***********************************************************************************************************************
 */
 
-#define TRANSFER_PROTOCOL_VERSION 2
+#define TRANSFER_PROTOCOL_VERSION 4
 
 #define TRANSFER_PROTOCOL_MINIMUM_VERSION 1
 
@@ -48,11 +48,15 @@
 ***********************************************************************************************************************
 *| Version | Change Description                                                                                       |
 *| ------- | ---------------------------------------------------------------------------------------------------------|
+*|  4.0    | Streaming pull transfers, which may start before the server block is closed                              |
+*|  3.0    | Pull transfers between clients on the same machine may go through a shared buffer                        |
 *|  2.0    | Refactor for variably sized messages + push transfers                                                    |
 *|  1.0    | Initial version                                                                                          |
 ***********************************************************************************************************************
 */
 
+#define TRANSFER_STREAMING_VERSION 4
+#define TRANSFER_SHARED_BUFFER_VERSION 3
 #define TRANSFER_REFACTOR_VERSION 2
 #define TRANSFER_INITIAL_VERSION 1
 
@@ -70,6 +74,7 @@ namespace DevDriver
             TransferDataChunk,
             TransferDataSentinel,
             TransferStatus,
+            TransferSharedDataHeader,
             Count,
         };
 
@@ -77,6 +82,10 @@ namespace DevDriver
         {
             Pull = 0,
             Push,
+            SharedPull,
+            // Like Pull, but the block may still be open. The size in the data header only covers the data written so
+            // far; data chunks follow as the block grows and the sentinel is sent once the block has been closed.
+            StreamingPull,
             Count,
         };
 
@@ -150,6 +159,32 @@ namespace DevDriver
 
         DD_CHECK_SIZE(TransferDataHeaderV2, 8);
 
+        // Size of the name field in TransferSharedDataHeader, including the null terminator.
+        DD_STATIC_CONST size_t kMaxSharedBufferNameSize = 64;
+
+        // Response to a SharedPull request. The block's data is stored in the named shared buffer, which the client
+        // maps for reading. The client must answer with a TransferStatus once it has opened the buffer (or failed to)
+        // so that the server can release the block. SharedPull is only requested over local transports. If the server
+        // can't provide a shared buffer it responds with a failing TransferStatus instead and the client falls back to
+        // a regular pull.
+        DD_NETWORK_STRUCT(TransferSharedDataHeader, 4)
+        {
+            TransferMessage command;
+            uint32          sizeInBytes;
+            uint32          crc32;
+            char            name[kMaxSharedBufferNameSize];
+
+            TransferSharedDataHeader(uint32 size, uint32 crc, const char* pName)
+                : command(TransferMessage::TransferSharedDataHeader)
+                , sizeInBytes(size)
+                , crc32(crc)
+            {
+                Platform::Strncpy(name, pName, sizeof(name));
+            }
+        };
+
+        DD_CHECK_SIZE(TransferSharedDataHeader, 76);
+
         DD_NETWORK_STRUCT(TransferDataChunk, 4)
         {
             TransferMessage command;
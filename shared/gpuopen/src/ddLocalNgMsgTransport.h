@@ -57,6 +57,11 @@ namespace DevDriver
             return "Local Ng";
         }
 
+        TransportType GetTransportType() const override
+        {
+            return TransportType::Local;
+        }
+
         DD_STATIC_CONST bool RequiresKeepAlive()
         {
             return false;
@@ -57,6 +57,9 @@ namespace DevDriver
     class Socket
     {
     public:
+        /// Maximum number of datagrams transferred by a single SendBatch or ReceiveBatch call.
+        DD_STATIC_CONST uint32 kMaxBatchSize = 16;
+
         Socket();
 
         /// Releases any OS-specific objects if they haven't previously been released in an explicit Destroy() call.
@@ -85,6 +88,23 @@ namespace DevDriver
 
         Result Receive(uint8* pBuffer, size_t bufferSize, size_t* pBytesReceived);
 
+        /// Sends up to kMaxBatchSize datagrams, using a single system call where the platform allows it.
+        ///
+        /// @returns Success if at least one datagram was sent, in which case pNumSent receives the number of leading
+        ///          datagrams that were sent.  Otherwise returns the error of the first datagram.
+        Result SendBatch(const uint8* const* ppData, const size_t* pDataSizes, uint32 count, uint32* pNumSent);
+
+        /// Receives up to kMaxBatchSize datagrams into consecutive buffers of bufferSize bytes each, using a single
+        /// system call where the platform allows it.  Does not wait for more datagrams once one has been received.
+        ///
+        /// @returns Success if at least one datagram was received, in which case pNumReceived receives the number of
+        ///          datagrams and pBytesReceived the size of each.  Otherwise returns the error of the first receive.
+        Result ReceiveBatch(uint8*  pBuffers,
+                            size_t  bufferSize,
+                            uint32  count,
+                            size_t* pBytesReceived,
+                            uint32* pNumReceived);
+
         Result ReceiveFrom(void *pSockAddr, size_t *addrSize, uint8* pBuffer, size_t bufferSize);
 
         Result Close();
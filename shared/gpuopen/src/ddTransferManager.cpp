@@ -31,6 +31,9 @@ namespace DevDriver
 {
     namespace TransferProtocol
     {
+        // Used to give every shared buffer created by this process a unique name.
+        static Platform::Atomic s_nextSharedBufferId = 0;
+
         // ============================================================================================================
         TransferManager::TransferManager(const AllocCb& allocCb)
             : m_pMessageChannel(nullptr)
@@ -79,7 +82,7 @@ namespace DevDriver
         }
 
         // ============================================================================================================
-        SharedPointer<ServerBlock> TransferManager::OpenServerBlock()
+        SharedPointer<ServerBlock> TransferManager::OpenServerBlock(size_t maxChunkSizeInBytes)
         {
             Platform::LockGuard<Platform::Mutex> lock(m_mutex);
 
@@ -92,7 +95,8 @@ namespace DevDriver
             // Attempt to allocate a new server block
             SharedPointer<ServerBlock> pBlock = SharedPointer<ServerBlock>::Create(m_allocCb,
                                                                                    m_allocCb,
-                                                                                   newBlockId);
+                                                                                   newBlockId,
+                                                                                   maxChunkSizeInBytes);
             if (!pBlock.IsNull())
             {
                 m_registeredServerBlocks.Create(newBlockId, pBlock);
@@ -152,6 +156,33 @@ namespace DevDriver
             return pBlock;
         }
 
+        // ============================================================================================================
+        PullBlock* TransferManager::OpenStreamingPullBlock(ClientId clientId, BlockId blockId)
+        {
+            PullBlock* pBlock = DD_NEW(PullBlock, m_allocCb)(m_pMessageChannel, blockId);
+            if (pBlock != nullptr)
+            {
+                // The size of the block isn't known until the whole stream has been read.
+                pBlock->m_isStreaming = true;
+
+                // Connect to the remote client and request a transfer.
+                Result result = pBlock->m_transferClient.Connect(clientId);
+                if (result == Result::Success)
+                {
+                    result = pBlock->m_transferClient.RequestStreamingPullTransfer(blockId);
+                }
+
+                // If we fail the transfer or connection, destroy the block.
+                if (result != Result::Success)
+                {
+                    pBlock->m_transferClient.Disconnect();
+                    DD_DELETE(pBlock, m_allocCb);
+                    pBlock = nullptr;
+                }
+            }
+            return pBlock;
+        }
+
         // ============================================================================================================
         void TransferManager::ClosePullBlock(PullBlock** ppBlock)
         {
@@ -213,32 +244,65 @@ namespace DevDriver
             *ppBlock = nullptr;
         }
 
+        // ============================================================================================================
+        ServerBlock::ServerBlock(const AllocCb& allocCb, BlockId blockId, size_t maxChunkSizeInBytes)
+            : TransferBlock(blockId)
+            , m_allocCb(allocCb)
+            , m_maxChunkSize(Platform::Max(maxChunkSizeInBytes, kTransferChunkSizeInBytes))
+            , m_isClosed(false)
+            , m_chunks(allocCb)
+            , m_capacity(0)
+            , m_writeChunk(0)
+            , m_numPendingTransfers(0)
+            , m_transfersCompletedEvent(true)
+            , m_crc32(0)
+            , m_sharedStorage()
+        {
+        }
+
+        // ============================================================================================================
+        ServerBlock::~ServerBlock()
+        {
+            FreeChunks();
+        }
+
         // ============================================================================================================
         void ServerBlock::Write(const void* pSrcBuffer, size_t numBytes)
         {
             // Writes can only be performed on blocks that are not closed.
             DD_ASSERT(m_isClosed == false);
 
-            if (numBytes > 0)
+            Platform::LockGuard<Platform::Mutex> lock(m_dataMutex);
+
+            const uint8* pSrcData = static_cast<const uint8*>(pSrcBuffer);
+
+            while (numBytes > 0)
             {
-                // Calculate how many bytes we have available.
-                const size_t blockCapacityInBytes = (m_chunks.Size() * kTransferChunkSizeInBytes);
-                const size_t bytesAvailable = (blockCapacityInBytes - m_blockDataSize);
+                // Move on to the next chunk once the current one is full, allocating more storage if necessary.
+                if ((m_writeChunk < m_chunks.Size()) &&
+                    (m_blockDataSize == (m_chunks[m_writeChunk].offset + m_chunks[m_writeChunk].capacity)))
+                {
+                    ++m_writeChunk;
+                }
 
-                // Allocate more chunks if necessary.
-                if (bytesAvailable < numBytes)
+                if ((m_writeChunk == m_chunks.Size()) && (AddChunk(numBytes) == false))
                 {
-                    const size_t additionalBytesRequired = (numBytes - bytesAvailable);
-                    const size_t numChunksRequired =
-                        (Platform::Pow2Align(additionalBytesRequired, kTransferChunkSizeInBytes) / kTransferChunkSizeInBytes);
-                    m_chunks.Resize(m_chunks.Size() + numChunksRequired);
+                    DD_ASSERT_REASON("Failed to allocate server block storage");
+                    break;
                 }
 
+                const DataChunk& chunk = m_chunks[m_writeChunk];
+                const size_t chunkOffset = (m_blockDataSize - chunk.offset);
+                const size_t bytesToWrite = Platform::Min(numBytes, (chunk.capacity - chunkOffset));
+
                 // Copy the new data into the block
-                uint8* pData = (reinterpret_cast<uint8*>(m_chunks.Data()) + m_blockDataSize);
-                memcpy(pData, pSrcBuffer, numBytes);
-                m_crc32 = CRC32(pData, numBytes, m_crc32);
-                m_blockDataSize += numBytes;
+                uint8* pData = (chunk.pData + chunkOffset);
+                memcpy(pData, pSrcData, bytesToWrite);
+                m_crc32 = CRC32(pData, bytesToWrite, m_crc32);
+                m_blockDataSize += bytesToWrite;
+
+                pSrcData += bytesToWrite;
+                numBytes -= bytesToWrite;
             }
         }
 
@@ -247,15 +311,24 @@ namespace DevDriver
         {
             DD_ASSERT(m_isClosed == false);
 
+            Platform::LockGuard<Platform::Mutex> lock(m_dataMutex);
             m_isClosed = true;
         }
 
         // ============================================================================================================
         void ServerBlock::Reset()
         {
+            Platform::LockGuard<Platform::Mutex> lock(m_dataMutex);
             m_isClosed = false;
             m_blockDataSize = 0;
+            m_writeChunk = 0;
             m_crc32 = 0;
+
+            // Local clients may still be reading a shared block, so it must not be written again.
+            if (m_sharedStorage.IsOpen())
+            {
+                FreeChunks();
+            }
         }
 
         // ============================================================================================================
@@ -263,10 +336,200 @@ namespace DevDriver
         {
             if (!m_isClosed)
             {
-                m_chunks.Reserve(Platform::Pow2Align(bytes, kTransferChunkSizeInBytes) / kTransferChunkSizeInBytes);
+                Platform::LockGuard<Platform::Mutex> lock(m_dataMutex);
+
+                if (m_blockDataSize == 0)
+                {
+                    // Replace any existing storage with a single chunk so that GetBlockData can be used.
+                    if ((m_chunks.Size() == 0) || (m_chunks[0].capacity < bytes))
+                    {
+                        FreeChunks();
+                        AddChunk(bytes);
+                    }
+                }
+                else if (m_capacity < bytes)
+                {
+                    AddChunk(bytes - m_capacity);
+                }
             }
         }
 
+        // ============================================================================================================
+        const uint8* ServerBlock::GetBlockData() const
+        {
+            const uint8* pData = nullptr;
+
+            if ((m_blockDataSize > 0) && (m_blockDataSize <= m_chunks[0].capacity))
+            {
+                pData = m_chunks[0].pData;
+            }
+
+            return pData;
+        }
+
+        // ============================================================================================================
+        size_t ServerBlock::ReadBlockData(size_t offset, void* pDstBuffer, size_t numBytes)
+        {
+            Platform::LockGuard<Platform::Mutex> lock(m_dataMutex);
+
+            size_t bytesRead = 0;
+
+            if (offset < m_blockDataSize)
+            {
+                numBytes = Platform::Min(numBytes, (m_blockDataSize - offset));
+
+                // Find the last chunk that starts at or before the offset.
+                size_t first = 0;
+                size_t last  = (m_chunks.Size() - 1);
+                while (first < last)
+                {
+                    const size_t middle = ((first + last + 1) / 2);
+                    if (m_chunks[middle].offset <= offset)
+                    {
+                        first = middle;
+                    }
+                    else
+                    {
+                        last = (middle - 1);
+                    }
+                }
+
+                for (size_t index = first; bytesRead < numBytes; ++index)
+                {
+                    const DataChunk& chunk = m_chunks[index];
+                    const size_t chunkOffset = ((offset + bytesRead) - chunk.offset);
+                    const size_t bytesToRead = Platform::Min((numBytes - bytesRead), (chunk.capacity - chunkOffset));
+
+                    memcpy(static_cast<uint8*>(pDstBuffer) + bytesRead, (chunk.pData + chunkOffset), bytesToRead);
+                    bytesRead += bytesToRead;
+                }
+            }
+
+            return bytesRead;
+        }
+
+        // ============================================================================================================
+        size_t ServerBlock::QueryWriteState(bool* pIsClosed)
+        {
+            Platform::LockGuard<Platform::Mutex> lock(m_dataMutex);
+            *pIsClosed = m_isClosed;
+            return m_blockDataSize;
+        }
+
+        // ============================================================================================================
+        Result ServerBlock::ShareBlockData(const char** ppName)
+        {
+            DD_ASSERT(ppName != nullptr);
+
+            Platform::LockGuard<Platform::Mutex> lock(m_dataMutex);
+
+            Result result = Result::Success;
+
+            if (m_sharedStorage.IsOpen() == false)
+            {
+                result = Result::Unavailable;
+
+                if (m_isClosed && (m_blockDataSize > 0) && (m_chunks.Size() > 0))
+                {
+                    const uint32 bufferId = static_cast<uint32>(Platform::AtomicIncrement(&s_nextSharedBufferId));
+
+                    char name[Platform::SharedBuffer::kMaxNameLength];
+                    Platform::Snprintf(name,
+                                       sizeof(name),
+                                       "ddxfer-%u-%u-%u",
+                                       Platform::GetProcessId(),
+                                       m_blockId,
+                                       bufferId);
+
+                    result = m_sharedStorage.Create(name, m_blockDataSize);
+                }
+
+                if (result == Result::Success)
+                {
+                    // Move the data into the shared buffer and replace the chunks with it. The first chunk's entry is
+                    // reused so that this can't fail part way through.
+                    uint8* pSharedData = static_cast<uint8*>(m_sharedStorage.GetData());
+
+                    for (size_t index = 0; index < m_chunks.Size(); ++index)
+                    {
+                        const DataChunk& chunk = m_chunks[index];
+                        if (chunk.offset < m_blockDataSize)
+                        {
+                            const size_t bytesToCopy = Platform::Min(chunk.capacity, (m_blockDataSize - chunk.offset));
+                            memcpy(pSharedData + chunk.offset, chunk.pData, bytesToCopy);
+                        }
+
+                        DD_FREE(chunk.pData, m_allocCb);
+                    }
+
+                    m_chunks.Resize(1);
+                    m_chunks[0].pData    = pSharedData;
+                    m_chunks[0].offset   = 0;
+                    m_chunks[0].capacity = m_blockDataSize;
+                    m_capacity   = m_blockDataSize;
+                    m_writeChunk = 0;
+                }
+            }
+
+            if (result == Result::Success)
+            {
+                *ppName = m_sharedStorage.GetName();
+            }
+
+            return result;
+        }
+
+        // ============================================================================================================
+        bool ServerBlock::AddChunk(size_t minCapacity)
+        {
+            // Each chunk doubles the capacity of the block until chunks reach the maximum size, which keeps the number
+            // of allocations logarithmic for small blocks and bounds the memory wasted at the end of large ones.
+            size_t capacity = Platform::Max(kTransferChunkSizeInBytes, Platform::Min(m_capacity, m_maxChunkSize));
+            capacity = Platform::Max(capacity, Platform::Pow2Align(minCapacity, kTransferChunkSizeInBytes));
+
+            DataChunk chunk = {};
+            chunk.pData    = static_cast<uint8*>(DD_MALLOC(capacity, alignof(uint64), m_allocCb));
+            chunk.offset   = m_capacity;
+            chunk.capacity = capacity;
+
+            bool result = (chunk.pData != nullptr);
+            if (result)
+            {
+                result = m_chunks.PushBack(chunk);
+                if (result)
+                {
+                    m_capacity += capacity;
+                }
+                else
+                {
+                    DD_FREE(chunk.pData, m_allocCb);
+                }
+            }
+
+            return result;
+        }
+
+        // ============================================================================================================
+        void ServerBlock::FreeChunks()
+        {
+            // A shared block's only chunk is the mapping of its shared buffer.
+            if (m_sharedStorage.IsOpen())
+            {
+                m_sharedStorage.Close();
+            }
+            else
+            {
+                for (size_t index = 0; index < m_chunks.Size(); ++index)
+                {
+                    DD_FREE(m_chunks[index].pData, m_allocCb);
+                }
+            }
+
+            m_chunks.Reset();
+            m_capacity = 0;
+            m_writeChunk = 0;
+        }
+
         // ============================================================================================================
         void ServerBlock::BeginTransfer()
         {
@@ -323,7 +586,16 @@ namespace DevDriver
         // ============================================================================================================
         Result PullBlock::Read(uint8* pDstBuffer, size_t bufferSize, size_t* pBytesRead)
         {
-            return m_transferClient.ReadPullTransferData(pDstBuffer, bufferSize, pBytesRead);
+            const Result result = m_transferClient.ReadPullTransferData(pDstBuffer, bufferSize, pBytesRead);
+
+            if (m_isStreaming &&
+                (pBytesRead != nullptr) &&
+                ((result == Result::Success) || (result == Result::EndOfStream)))
+            {
+                m_blockDataSize += *pBytesRead;
+            }
+
+            return result;
         }
 
         // ============================================================================================================
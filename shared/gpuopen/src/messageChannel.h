@@ -76,6 +76,9 @@ namespace DevDriver
 
         Result Receive(MessageBuffer& message, uint32 timeoutInMs) override final;
         Result Forward(const MessageBuffer& messageBuffer) override final;
+        Result ForwardMessages(const MessageBuffer* const* ppMessages,
+                               uint32                      count,
+                               uint32*                     pNumForwarded) override final;
 
         Result EstablishSessionForClient(SharedPointer<ISession>*    ppSession,
                                          const EstablishSessionInfo& sessionInfo) override final;
@@ -95,6 +98,11 @@ namespace DevDriver
             return m_msgTransport.GetTransportName();
         }
 
+        TransportType GetTransportType() const override
+        {
+            return m_msgTransport.GetTransportType();
+        }
+
         Result FindFirstClient(const ClientMetadata& filter,
                                ClientId*             pClientId,
                                uint32                timeoutInMs,
@@ -178,6 +186,23 @@ namespace DevDriver
             return m_msgTransport.WriteMessage(messageBuffer);
         }
 
+        // Write several messages into the internal transport
+        Result WriteTransportMessages(const MessageBuffer* const* ppMessages, uint32 count, uint32* pNumWritten)
+        {
+            // Go through WriteTransportMessage so that each message can be dropped individually.
+            Result result = Result::Success;
+            uint32 numWritten = 0;
+
+            while ((result == Result::Success) && (numWritten < count))
+            {
+                result = WriteTransportMessage(*ppMessages[numWritten]);
+                numWritten += (result == Result::Success) ? 1 : 0;
+            }
+
+            *pNumWritten = numWritten;
+            return result;
+        }
+
         // Reads a message from the internal transport
         Result ReadTransportMessage(MessageBuffer& messageBuffer, uint32 timeoutInMs)
         {
@@ -199,6 +224,12 @@ namespace DevDriver
             return m_msgTransport.WriteMessage(messageBuffer);
         }
 
+        // Write several messages into the internal transport
+        Result WriteTransportMessages(const MessageBuffer* const* ppMessages, uint32 count, uint32* pNumWritten)
+        {
+            return m_msgTransport.WriteMessages(ppMessages, count, pNumWritten);
+        }
+
         // Reads a message from the internal transport
         Result ReadTransportMessage(MessageBuffer& messageBuffer, uint32 timeoutInMs)
         {
@@ -515,6 +515,24 @@ namespace DevDriver
         return result;
     }
 
+    template <class MsgTransport>
+    Result MessageChannel<MsgTransport>::ForwardMessages(const MessageBuffer* const* ppMessages,
+                                                         uint32                      count,
+                                                         uint32*                     pNumForwarded)
+    {
+        Result result = Result::Error;
+        *pNumForwarded = 0;
+        if (m_clientId != kBroadcastClientId)
+        {
+            result = WriteTransportMessages(ppMessages, count, pNumForwarded);
+            if ((result != Result::Success) & (result != Result::NotReady))
+            {
+                Disconnect();
+            }
+        }
+        return result;
+    }
+
     template <class MsgTransport>
     Result MessageChannel<MsgTransport>::Receive(MessageBuffer& message, uint32 timeoutInMs)
     {
@@ -35,6 +35,8 @@
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <sys/fcntl.h>
+#include <sys/uio.h>
+#include <poll.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <netdb.h>
@@ -188,28 +190,18 @@ namespace DevDriver
     {
         Result result = Result::Error;
 
-        fd_set readSet = {};
-        fd_set writeSet = {};
-        fd_set exceptSet = {};
+        // We only ever wait on a single socket, so poll() is as cheap as epoll without the extra descriptor, and unlike
+        // select() it isn't limited to descriptors below FD_SETSIZE.
+        pollfd pollInfo = {};
+        pollInfo.fd = m_osSocket;
+        pollInfo.events = (((pReadState != nullptr) ? POLLIN : 0)  |
+                           ((pWriteState != nullptr) ? POLLOUT : 0) |
+                           ((pExceptState != nullptr) ? POLLPRI : 0));
 
-        FD_SET(m_osSocket, &readSet);
-        FD_SET(m_osSocket, &writeSet);
-        FD_SET(m_osSocket, &exceptSet);
-
-        timeval timeoutValue = {};
-        timeoutValue.tv_sec = static_cast<int32>(timeoutInMs) / 1000;
-        timeoutValue.tv_usec = (static_cast<int32>(timeoutInMs) % 1000) * 1000;
-
-        fd_set* pReadSet = ((pReadState != nullptr) ? &readSet : nullptr);
-        fd_set* pWriteSet = ((pWriteState != nullptr) ? &writeSet : nullptr);
-        fd_set* pExceptSet = ((pExceptState != nullptr) ? &exceptSet : nullptr);
-
-        const int retval = Platform::RetryTemporaryFailure(select,
-                                                           m_osSocket + 1,
-                                                           pReadSet,
-                                                           pWriteSet,
-                                                           pExceptSet,
-                                                           &timeoutValue);
+        const int retval = Platform::RetryTemporaryFailure(poll,
+                                                           &pollInfo,
+                                                           1,
+                                                           static_cast<int>(timeoutInMs));
 
         if (retval > 0)
         {
@@ -218,21 +210,24 @@ namespace DevDriver
         else
         {
             result = (retval == 0) ? Result::NotReady : Result::Error;
+            pollInfo.revents = 0;
         }
 
+        // Errors and hang-ups are reported as readable, like select() does, so the caller picks them up from the next
+        // receive.
         if (pReadState != nullptr)
         {
-            *pReadState = (FD_ISSET(m_osSocket, pReadSet) != 0);
+            *pReadState = ((pollInfo.revents & (POLLIN | POLLERR | POLLHUP)) != 0);
         }
 
         if (pWriteState != nullptr)
         {
-            *pWriteState = (FD_ISSET(m_osSocket, pWriteSet) != 0);
+            *pWriteState = ((pollInfo.revents & (POLLOUT | POLLERR | POLLHUP)) != 0);
         }
 
         if (pExceptState != nullptr)
         {
-            *pExceptState = (FD_ISSET(m_osSocket, pExceptSet) != 0);
+            *pExceptState = ((pollInfo.revents & POLLPRI) != 0);
         }
 
         DD_ASSERT(result != Result::Error);
@@ -515,6 +510,121 @@ namespace DevDriver
         return result;
     }
 
+    Result Socket::SendBatch(const uint8* const* ppData, const size_t* pDataSizes, uint32 count, uint32* pNumSent)
+    {
+        DD_ASSERT((count > 0) && (count <= kMaxBatchSize));
+
+        Result result = Result::Error;
+
+#if defined(DD_PLATFORM_LINUX_UM)
+        iovec   vectors[kMaxBatchSize];
+        mmsghdr messages[kMaxBatchSize] = {};
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            vectors[i].iov_base = const_cast<uint8*>(ppData[i]);
+            vectors[i].iov_len  = pDataSizes[i];
+
+            messages[i].msg_hdr.msg_iov    = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        const int retVal = Platform::RetryTemporaryFailure(sendmmsg, m_osSocket, &messages[0], count, 0);
+
+        if (retVal > 0)
+        {
+            *pNumSent = static_cast<uint32>(retVal);
+            result = Result::Success;
+        }
+        else
+        {
+            *pNumSent = 0;
+            result = (retVal == 0) ? Result::NotReady : GetDataError(m_isNonBlocking);
+        }
+#else
+        uint32 numSent = 0;
+        Result sendResult = Result::Success;
+
+        while ((sendResult == Result::Success) && (numSent < count))
+        {
+            size_t bytesSent = 0;
+            sendResult = Send(ppData[numSent], pDataSizes[numSent], &bytesSent);
+            numSent += (sendResult == Result::Success) ? 1 : 0;
+        }
+
+        *pNumSent = numSent;
+        result = (numSent > 0) ? Result::Success : sendResult;
+#endif
+
+        return result;
+    }
+
+    Result Socket::ReceiveBatch(uint8*  pBuffers,
+                                size_t  bufferSize,
+                                uint32  count,
+                                size_t* pBytesReceived,
+                                uint32* pNumReceived)
+    {
+        DD_ASSERT((count > 0) && (count <= kMaxBatchSize));
+
+        Result result = Result::Error;
+
+#if defined(DD_PLATFORM_LINUX_UM)
+        iovec   vectors[kMaxBatchSize];
+        mmsghdr messages[kMaxBatchSize] = {};
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            vectors[i].iov_base = (pBuffers + (i * bufferSize));
+            vectors[i].iov_len  = bufferSize;
+
+            messages[i].msg_hdr.msg_iov    = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // MSG_WAITFORONE makes the call return whatever is queued once the first datagram has arrived, even on a
+        // blocking socket.
+        const int retVal = Platform::RetryTemporaryFailure(recvmmsg,
+                                                           m_osSocket,
+                                                           &messages[0],
+                                                           count,
+                                                           MSG_WAITFORONE,
+                                                           nullptr);
+        if (retVal > 0)
+        {
+            for (int i = 0; i < retVal; ++i)
+            {
+                pBytesReceived[i] = messages[i].msg_len;
+            }
+
+            *pNumReceived = static_cast<uint32>(retVal);
+            result = Result::Success;
+        }
+        else
+        {
+            *pNumReceived = 0;
+            result = (retVal == 0) ? Result::Unavailable : GetDataError(m_isNonBlocking);
+        }
+#else
+        // Without a batched receive we can only drain datagrams that are already queued on a non-blocking socket.
+        const uint32 maxCount = m_isNonBlocking ? count : 1;
+
+        uint32 numReceived = 0;
+        Result receiveResult = Result::Success;
+
+        while ((receiveResult == Result::Success) && (numReceived < maxCount))
+        {
+            receiveResult = Receive(pBuffers + (numReceived * bufferSize), bufferSize, &pBytesReceived[numReceived]);
+            numReceived += (receiveResult == Result::Success) ? 1 : 0;
+        }
+
+        *pNumReceived = numReceived;
+        result = (numReceived > 0) ? Result::Success : receiveResult;
+#endif
+
+        return result;
+    }
+
     Result Socket::ReceiveFrom(void *pSockAddr, size_t *addrSize, uint8 *pBuffer, size_t bufferSize)
     {
         DD_ASSERT((m_socketType == SocketType::Udp) || (m_socketType == SocketType::Local));
@@ -24,9 +24,10 @@
  **********************************************************************************************************************/
 
 #include "protocols/ddTransferClient.h"
+#include "msgChannel.h"
 
 #define TRANSFER_CLIENT_MIN_VERSION 1
-#define TRANSFER_CLIENT_MAX_VERSION 2
+#define TRANSFER_CLIENT_MAX_VERSION 4
 
 namespace DevDriver
 {
@@ -55,32 +56,29 @@ namespace DevDriver
             if ((m_transferContext.state == TransferState::Idle) &&
                 (pTransferSizeInBytes != nullptr))
             {
-                SizedPayloadContainer container = {};
-                container.CreatePayload<TransferRequest>(blockId, TransferType::Pull, 0);
-
-                result = TransactTransferPayload(&container);
+                // Clients on the same machine as the server can map the block instead of receiving it as messages.
+                // Only a local transport guarantees that, so don't spend a round trip on it otherwise.
+                if ((m_pSession->GetVersion() >= TRANSFER_SHARED_BUFFER_VERSION) &&
+                    (m_pMsgChannel->GetTransportType() == TransportType::Local))
+                {
+                    result = RequestSharedPullTransfer(blockId, pTransferSizeInBytes);
+                }
 
-                if ((result == Result::Success) &&
-                    (container.GetPayload<TransferHeader>().command == TransferMessage::TransferDataHeader))
+                if ((result != Result::Success) && (m_transferContext.state == TransferState::Idle))
                 {
-                    // We've successfully received the transfer data header. Check if the transfer request was successful.
-                    if (m_pSession->GetVersion() >= TRANSFER_REFACTOR_VERSION)
-                    {
-                        const TransferDataHeaderV2& receivedHeader = container.GetPayload<TransferDataHeaderV2>();
-                        m_transferContext.state = TransferState::TransferInProgress;
-                        m_transferContext.totalBytes = receivedHeader.sizeInBytes;
-                        m_transferContext.crc32 = 0;
-                        m_transferContext.dataChunkSizeInBytes = 0;
-                        m_transferContext.dataChunkBytesTransfered = 0;
+                    SizedPayloadContainer container = {};
+                    container.CreatePayload<TransferRequest>(blockId, TransferType::Pull, 0);
 
-                        *pTransferSizeInBytes = receivedHeader.sizeInBytes;
-                    }
-                    else
+                    result = TransactTransferPayload(&container);
+
+                    if ((result == Result::Success) &&
+                        (container.GetPayload<TransferHeader>().command == TransferMessage::TransferDataHeader))
                     {
-                        const TransferDataHeader& receivedHeader = container.GetPayload<TransferDataHeader>();
-                        result = receivedHeader.result;
-                        if (result == Result::Success)
+                        // We've successfully received the transfer data header.
+                        // Check if the transfer request was successful.
+                        if (m_pSession->GetVersion() >= TRANSFER_REFACTOR_VERSION)
                         {
+                            const TransferDataHeaderV2& receivedHeader = container.GetPayload<TransferDataHeaderV2>();
                             m_transferContext.state = TransferState::TransferInProgress;
                             m_transferContext.totalBytes = receivedHeader.sizeInBytes;
                             m_transferContext.crc32 = 0;
@@ -92,20 +90,269 @@ namespace DevDriver
                         }
                         else
                         {
-                            // The transfer failed on the remote server.
-                            m_transferContext.state = TransferState::Error;
-                            result = Result::Error;
+                            const TransferDataHeader& receivedHeader = container.GetPayload<TransferDataHeader>();
+                            result = receivedHeader.result;
+                            if (result == Result::Success)
+                            {
+                                m_transferContext.state = TransferState::TransferInProgress;
+                                m_transferContext.totalBytes = receivedHeader.sizeInBytes;
+                                m_transferContext.crc32 = 0;
+                                m_transferContext.dataChunkSizeInBytes = 0;
+                                m_transferContext.dataChunkBytesTransfered = 0;
+                                m_transferContext.type = TransferType::Pull;
+
+                                *pTransferSizeInBytes = receivedHeader.sizeInBytes;
+                            }
+                            else
+                            {
+                                // The transfer failed on the remote server.
+                                m_transferContext.state = TransferState::Error;
+                                result = Result::Error;
+                            }
                         }
                     }
+                    else
+                    {
+                        // We either didn't receive a response, or we received an invalid response.
+                        m_transferContext.state = TransferState::Error;
+                        result = Result::Error;
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        // ============================================================================================================
+        Result TransferClient::RequestStreamingPullTransfer(BlockId blockId)
+        {
+            Result result = Result::Error;
+
+            if (m_transferContext.state == TransferState::Idle)
+            {
+                if (m_pSession->GetVersion() >= TRANSFER_STREAMING_VERSION)
+                {
+                    SizedPayloadContainer container = {};
+                    container.CreatePayload<TransferRequest>(blockId, TransferType::StreamingPull, 0);
+
+                    result = TransactTransferPayload(&container);
+
+                    if ((result == Result::Success) &&
+                        (container.GetPayload<TransferHeader>().command == TransferMessage::TransferDataHeader))
+                    {
+                        // The size in the header only covers the data written so far, so we don't track it.
+                        m_transferContext.state = TransferState::TransferInProgress;
+                        m_transferContext.type = TransferType::StreamingPull;
+                        m_transferContext.totalBytes = 0;
+                        m_transferContext.crc32 = 0;
+                        m_transferContext.dataChunkSizeInBytes = 0;
+                        m_transferContext.dataChunkBytesTransfered = 0;
+                    }
+                    else if (result == Result::Success)
+                    {
+                        // The block doesn't exist on the remote client.
+                        result = Result::Error;
+                    }
+                    else
+                    {
+                        m_transferContext.state = TransferState::Error;
+                    }
                 }
                 else
                 {
-                    // We either didn't receive a response, or we received an invalid response.
+                    result = Result::VersionMismatch;
+                }
+            }
+
+            return result;
+        }
+
+        // ============================================================================================================
+        Result TransferClient::RequestSharedPullTransfer(BlockId blockId, size_t* pTransferSizeInBytes)
+        {
+            SizedPayloadContainer container = {};
+            container.CreatePayload<TransferRequest>(blockId, TransferType::SharedPull, 0);
+
+            Result result = TransactTransferPayload(&container);
+
+            if ((result == Result::Success) &&
+                (container.GetPayload<TransferHeader>().command == TransferMessage::TransferSharedDataHeader))
+            {
+                const TransferSharedDataHeader& header = container.GetPayload<TransferSharedDataHeader>();
+                const uint32 sizeInBytes = header.sizeInBytes;
+                const uint32 crc32       = header.crc32;
+
+                // Don't trust the name to be terminated.
+                char name[kMaxSharedBufferNameSize];
+                Platform::Strncpy(name, header.name, sizeof(name));
+
+                result = m_sharedBuffer.Open(name, sizeInBytes);
+
+                // The server keeps its copy until we tell it whether we managed to map it.
+                container.CreatePayload<TransferStatus>(result);
+                const Result ackResult = SendTransferPayload(container);
+
+                if (ackResult != Result::Success)
+                {
+                    m_sharedBuffer.Close();
                     m_transferContext.state = TransferState::Error;
                     result = Result::Error;
                 }
+                else if (result == Result::Success)
+                {
+                    m_transferContext.state = TransferState::TransferInProgress;
+                    m_transferContext.type = TransferType::SharedPull;
+                    m_transferContext.totalBytes = sizeInBytes;
+                    m_transferContext.crc32 = 0;
+                    m_transferContext.expectedCrc32 = crc32;
+                    m_transferContext.sharedBytesRead = 0;
+                    m_transferContext.dataChunkSizeInBytes = 0;
+                    m_transferContext.dataChunkBytesTransfered = 0;
+
+                    *pTransferSizeInBytes = sizeInBytes;
+                }
+                else
+                {
+                    // Most likely the server isn't on this machine.
+                    result = Result::Unavailable;
+                }
+            }
+            else if (result == Result::Success)
+            {
+                // The server couldn't share the block and has returned to idle.
+                DD_ASSERT(container.GetPayload<TransferHeader>().command == TransferMessage::TransferStatus);
+                result = Result::Unavailable;
+            }
+            else
+            {
+                m_transferContext.state = TransferState::Error;
+            }
+
+            return result;
+        }
+
+        // ============================================================================================================
+        Result TransferClient::ReadSharedPullTransferData(uint8* pDstBuffer, size_t bufferSize, size_t* pBytesRead)
+        {
+            Result result = Result::Success;
+
+            const size_t bytesRemaining = (m_transferContext.totalBytes - m_transferContext.sharedBytesRead);
+            const size_t bytesToRead    = Platform::Min(bufferSize, bytesRemaining);
+
+            if (bytesToRead > 0)
+            {
+                const uint8* pData =
+                    static_cast<const uint8*>(m_sharedBuffer.GetData()) + m_transferContext.sharedBytesRead;
+                memcpy(pDstBuffer, pData, bytesToRead);
+
+                m_transferContext.crc32 = CRC32(pData, bytesToRead, m_transferContext.crc32);
+                m_transferContext.sharedBytesRead += bytesToRead;
+            }
+
+            *pBytesRead = bytesToRead;
+
+            if (m_transferContext.sharedBytesRead == m_transferContext.totalBytes)
+            {
+                m_sharedBuffer.Close();
+
+                if (m_transferContext.crc32 == m_transferContext.expectedCrc32)
+                {
+                    result = Result::EndOfStream;
+                    m_transferContext.state = TransferState::Idle;
+                }
+                else
+                {
+                    DD_WARN_REASON("Shared pull transfer data failed CRC check");
+                    result = Result::Error;
+                    m_transferContext.state = TransferState::Error;
+                }
+            }
+
+            return result;
+        }
+
+        // ============================================================================================================
+        Result TransferClient::ReadStreamingPullTransferData(uint8* pDstBuffer, size_t bufferSize, size_t* pBytesRead)
+        {
+            Result result = Result::Success;
+            size_t bytesRead = 0;
+
+            SizedPayloadContainer& scratchPayload = m_transferContext.scratchPayload;
+
+            while ((bytesRead < bufferSize) && (result == Result::Success))
+            {
+                const size_t dataChunkBytesAvailable =
+                    (m_transferContext.dataChunkSizeInBytes - m_transferContext.dataChunkBytesTransfered);
+
+                if (dataChunkBytesAvailable > 0)
+                {
+                    const TransferDataChunk& chunk = scratchPayload.GetPayload<TransferDataChunk>();
+                    const uint8* pData = &chunk.data[m_transferContext.dataChunkBytesTransfered];
+
+                    const size_t bytesToRead = Platform::Min((bufferSize - bytesRead), dataChunkBytesAvailable);
+                    memcpy(pDstBuffer + bytesRead, pData, bytesToRead);
+                    m_transferContext.dataChunkBytesTransfered += bytesToRead;
+                    bytesRead += bytesToRead;
+                }
+                else
+                {
+                    // Wait for the first chunk, but once there's data for the caller only take what has already
+                    // arrived rather than holding it back until the server writes more.
+                    result = (bytesRead == 0) ? ReceiveTransferPayload(&scratchPayload, kTransferChunkTimeoutInMs)
+                                              : ReceiveTransferPayload(&scratchPayload, kNoWait, 1);
+
+                    if (result == Result::Success)
+                    {
+                        const TransferMessage command = scratchPayload.GetPayload<TransferHeader>().command;
+
+                        if (command == TransferMessage::TransferDataChunk)
+                        {
+                            const size_t receivedSize = (scratchPayload.payloadSize - sizeof(TransferHeader));
+                            const size_t chunkSize = Platform::Min(receivedSize, kMaxTransferDataChunkSize);
+
+                            m_transferContext.dataChunkSizeInBytes = chunkSize;
+                            m_transferContext.dataChunkBytesTransfered = 0;
+                            m_transferContext.crc32 = CRC32(&scratchPayload.GetPayload<TransferDataChunk>().data[0],
+                                                            chunkSize,
+                                                            m_transferContext.crc32);
+                        }
+                        else if (command == TransferMessage::TransferDataSentinel)
+                        {
+                            const TransferDataSentinel& sentinel = scratchPayload.GetPayload<TransferDataSentinel>();
+
+                            if ((sentinel.result == Result::Success) && (sentinel.crc32 == m_transferContext.crc32))
+                            {
+                                result = Result::EndOfStream;
+                                m_transferContext.state = TransferState::Idle;
+                            }
+                            else
+                            {
+                                result = Result::Error;
+                                m_transferContext.state = TransferState::Error;
+                            }
+                        }
+                        else
+                        {
+                            DD_WARN_REASON("Streaming pull transfer session received invalid data");
+                            result = Result::Error;
+                            m_transferContext.state = TransferState::Error;
+                        }
+                    }
+                    else if (result != Result::NotReady)
+                    {
+                        m_transferContext.state = TransferState::Error;
+                    }
+                }
+            }
+
+            // Running out of queued data isn't a problem as long as we have something for the caller.
+            if ((result == Result::NotReady) && (bytesRead > 0))
+            {
+                result = Result::Success;
             }
 
+            *pBytesRead = bytesRead;
+
             return result;
         }
 
@@ -114,7 +361,19 @@ namespace DevDriver
         {
             Result result = Result::Error;
 
-            if ((m_transferContext.state == TransferState::TransferInProgress) && (pBytesRead != nullptr))
+            if ((m_transferContext.state == TransferState::TransferInProgress) &&
+                (m_transferContext.type == TransferType::SharedPull) &&
+                (pBytesRead != nullptr))
+            {
+                result = ReadSharedPullTransferData(pDstBuffer, bufferSize, pBytesRead);
+            }
+            else if ((m_transferContext.state == TransferState::TransferInProgress) &&
+                     (m_transferContext.type == TransferType::StreamingPull) &&
+                     (pBytesRead != nullptr))
+            {
+                result = ReadStreamingPullTransferData(pDstBuffer, bufferSize, pBytesRead);
+            }
+            else if ((m_transferContext.state == TransferState::TransferInProgress) && (pBytesRead != nullptr))
             {
                 result = Result::Success;
 
@@ -342,7 +601,16 @@ namespace DevDriver
             Result result = Result::Error;
 
             if ((m_transferContext.state == TransferState::TransferInProgress) &&
-                (m_transferContext.type == TransferType::Pull))
+                (m_transferContext.type == TransferType::SharedPull))
+            {
+                // The server finished with a shared pull as soon as we mapped the buffer, so there's nothing to cancel.
+                m_sharedBuffer.Close();
+                m_transferContext.state = TransferState::Idle;
+                result = Result::Success;
+            }
+            else if ((m_transferContext.state == TransferState::TransferInProgress) &&
+                     ((m_transferContext.type == TransferType::Pull) ||
+                      (m_transferContext.type == TransferType::StreamingPull)))
             {
                 SizedPayloadContainer container = {};
 
@@ -385,6 +653,7 @@ namespace DevDriver
         // ============================================================================================================
         void TransferClient::ResetState()
         {
+            m_sharedBuffer.Close();
             memset(&m_transferContext, 0, sizeof(m_transferContext));
         }
 
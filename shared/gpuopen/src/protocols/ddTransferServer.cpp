@@ -28,7 +28,7 @@
 #include "msgChannel.h"
 
 #define TRANSFER_SERVER_MIN_VERSION 1
-#define TRANSFER_SERVER_MAX_VERSION 2
+#define TRANSFER_SERVER_MAX_VERSION 4
 
 namespace DevDriver
 {
@@ -42,20 +42,26 @@ namespace DevDriver
             ProcessPullTransfer,
             StartPushTransfer,
             ReceivePushTransferData,
+            SendSharedPullHeader,
+            WaitForSharedPullAck,
         };
 
         class TransferServer::TransferSession
         {
         public:
             // ========================================================================================================
-            TransferSession(TransferManager* pTransferManager, const SharedPointer<ISession>& pSession)
+            TransferSession(TransferManager*               pTransferManager,
+                            const SharedPointer<ISession>& pSession,
+                            bool                           isLocalTransport)
                 : m_scratchPayload()
                 , m_pTransferManager(pTransferManager)
                 , m_pSession(pSession)
+                , m_isLocalTransport(isLocalTransport)
                 , m_pBlock()
                 , m_totalBytes(0)
                 , m_bytesTransferred(0)
                 , m_crc32(0)
+                , m_isStreaming(false)
                 , m_state(SessionState::Idle)
             {
             }
@@ -125,6 +131,7 @@ namespace DevDriver
                             m_totalBytes = pBlock->GetBlockDataSize();
                             m_bytesTransferred = 0;
                             m_crc32 = pBlock->GetCrc32();
+                            m_isStreaming = false;
                             m_state = SessionState::StartPullTransfer;
 
                             const uint32 blockSizeInBytes = static_cast<uint32>(m_pBlock->GetBlockDataSize());
@@ -191,6 +198,41 @@ namespace DevDriver
                         }
                         break;
                     }
+                    case TransferType::SharedPull:
+                    {
+                        StartSharedPullTransfer(request.blockId);
+                        break;
+                    }
+                    case TransferType::StreamingPull:
+                    {
+                        // Streaming pulls only need the block to exist. Whatever has been written so far is sent
+                        // right away and the rest follows as the owner writes it.
+                        SharedPointer<ServerBlock> pBlock = m_pTransferManager->GetServerBlock(request.blockId);
+                        const bool blockIsAvailable =
+                            (!pBlock.IsNull() && (m_pSession->GetVersion() >= TRANSFER_STREAMING_VERSION));
+                        if (blockIsAvailable && (m_state == SessionState::Idle))
+                        {
+                            pBlock->BeginTransfer();
+
+                            bool isClosed = false;
+                            m_pBlock = pBlock;
+                            m_totalBytes = pBlock->QueryWriteState(&isClosed);
+                            m_bytesTransferred = 0;
+                            m_crc32 = 0;
+                            m_isStreaming = true;
+                            m_state = SessionState::StartPullTransfer;
+
+                            m_scratchPayload.CreatePayload<TransferDataHeaderV2>(static_cast<uint32>(m_totalBytes));
+                            SendPullTransferHeader();
+                        }
+                        else
+                        {
+                            m_scratchPayload.CreatePayload<TransferStatus>(Result::Error);
+                            m_state = SessionState::SendPayload;
+                            SendScratchPayloadAndMoveToIdle();
+                        }
+                        break;
+                    }
                     default:
                     {
                         m_scratchPayload.CreatePayload<TransferStatus>(Result::Error);
@@ -257,13 +299,24 @@ namespace DevDriver
                 // If we haven't received any messages from the client, then continue transferring data to them.
                 if (result == Result::NotReady)
                 {
+                    // Streaming transfers send whatever the owner has written since the last update.
+                    bool isClosed = true;
+                    if (m_isStreaming)
+                    {
+                        m_totalBytes = m_pBlock->QueryWriteState(&isClosed);
+                    }
+
                     while (m_bytesTransferred < m_totalBytes)
                     {
-                        const uint8* pData = (m_pBlock->GetBlockData() + m_bytesTransferred);
                         const size_t bytesRemaining = (m_totalBytes - m_bytesTransferred);
                         const size_t bytesToSend = Platform::Min(kMaxTransferDataChunkSize, bytesRemaining);
 
-                        TransferDataChunk::WritePayload(pData, bytesToSend, &m_scratchPayload);
+                        // Read straight into the payload since the block's data may be split across chunks.
+                        m_scratchPayload.payloadSize =
+                            static_cast<uint32>(bytesToSend + offsetof(TransferDataChunk, data));
+                        TransferDataChunk& chunk = m_scratchPayload.GetPayload<TransferDataChunk>();
+                        chunk.command = TransferMessage::TransferDataChunk;
+                        m_pBlock->ReadBlockData(m_bytesTransferred, &chunk.data[0], bytesToSend);
 
                         const Result sendResult = SendPayload(m_scratchPayload, kNoWait);
                         if (sendResult == Result::Success)
@@ -277,8 +330,14 @@ namespace DevDriver
                     }
 
                     // If we've finished transferring all block data, send the sentinel and free the block.
-                    if (m_bytesTransferred == m_totalBytes)
+                    if ((m_bytesTransferred == m_totalBytes) && isClosed)
                     {
+                        if (m_isStreaming)
+                        {
+                            // The CRC is final now that the block has been closed.
+                            m_crc32 = m_pBlock->GetCrc32();
+                        }
+
                         SendSentinel(Result::Success, m_crc32);
                     }
                 }
@@ -314,6 +373,77 @@ namespace DevDriver
                 }
             }
 
+            // ========================================================================================================
+            // Hands the client the name of a shared buffer holding the block, which the client maps directly so that
+            // the data doesn't need to be split into messages. The block's storage is moved into the buffer the first
+            // time it is shared and is never copied again. This is only an optimization: if we aren't connected
+            // through a local transport or the buffer can't be created, the client is told so and falls back to a
+            // regular pull on the same session.
+            void StartSharedPullTransfer(BlockId blockId)
+            {
+                DD_ASSERT(m_state == SessionState::Idle);
+
+                Result result = Result::Unavailable;
+
+                SharedPointer<ServerBlock> pBlock = m_pTransferManager->GetServerBlock(blockId);
+                const bool blockIsAvailable =
+                    (!pBlock.IsNull() && pBlock->IsClosed() && (pBlock->GetBlockDataSize() > 0));
+
+                if (blockIsAvailable &&
+                    m_isLocalTransport &&
+                    (m_pSession->GetVersion() >= TRANSFER_SHARED_BUFFER_VERSION))
+                {
+                    const char* pName = nullptr;
+                    result = pBlock->ShareBlockData(&pName);
+
+                    if (result == Result::Success)
+                    {
+                        // Keep the block, and with it the buffer's name, alive until the client has opened it.
+                        pBlock->BeginTransfer();
+                        m_pBlock = pBlock;
+
+                        m_scratchPayload.CreatePayload<TransferSharedDataHeader>(
+                            static_cast<uint32>(pBlock->GetBlockDataSize()),
+                            pBlock->GetCrc32(),
+                            pName);
+                        m_state = SessionState::SendSharedPullHeader;
+                        SendSharedPullHeader();
+                    }
+                }
+
+                if (result != Result::Success)
+                {
+                    m_scratchPayload.CreatePayload<TransferStatus>(Result::Unavailable);
+                    m_state = SessionState::SendPayload;
+                    SendScratchPayloadAndMoveToIdle();
+                }
+            }
+
+            // ========================================================================================================
+            void SendSharedPullHeader()
+            {
+                DD_ASSERT(m_state == SessionState::SendSharedPullHeader);
+                if (SendPayload(m_scratchPayload, kNoWait) == Result::Success)
+                {
+                    m_state = SessionState::WaitForSharedPullAck;
+                }
+            }
+
+            // ========================================================================================================
+            void WaitForSharedPullAck()
+            {
+                DD_ASSERT(m_state == SessionState::WaitForSharedPullAck);
+                if (ReceivePayload(&m_scratchPayload, kNoWait) == Result::Success)
+                {
+                    // Whether or not the client managed to open the buffer, it no longer needs the block. A client
+                    // which did open it keeps its own mapping even if the block is released or reset.
+                    DD_WARN(m_scratchPayload.GetPayload<TransferHeader>().command == TransferMessage::TransferStatus);
+                    m_pBlock->EndTransfer();
+                    m_pBlock.Clear();
+                    m_state = SessionState::Idle;
+                }
+            }
+
             // ========================================================================================================
             void StartPushTransferSession()
             {
@@ -445,6 +575,18 @@ namespace DevDriver
                     break;
                 }
 
+                case SessionState::SendSharedPullHeader:
+                {
+                    SendSharedPullHeader();
+                    break;
+                }
+
+                case SessionState::WaitForSharedPullAck:
+                {
+                    WaitForSharedPullAck();
+                    break;
+                }
+
                 default:
                 {
                     DD_UNREACHABLE();
@@ -457,10 +599,12 @@ namespace DevDriver
             SizedPayloadContainer      m_scratchPayload;
             TransferManager*           m_pTransferManager;
             SharedPointer<ISession>    m_pSession;
+            const bool                 m_isLocalTransport; // Whether clients on this session can map shared buffers
             SharedPointer<ServerBlock> m_pBlock;
             size_t                     m_totalBytes;
             size_t                     m_bytesTransferred;
             uint32                     m_crc32;
+            bool                       m_isStreaming;  // The block may still be written to during the pull.
             SessionState               m_state;
         };
 
@@ -493,7 +637,11 @@ namespace DevDriver
         void TransferServer::SessionEstablished(const SharedPointer<ISession>& pSession)
         {
             // Allocate session data for the newly established session
-            TransferSession* pSessionData = DD_NEW(TransferSession, m_pMsgChannel->GetAllocCb())(m_pTransferManager, pSession);
+            // Shared buffers can only be handed to clients on this machine, which we can only be sure of when connected
+            // through a local transport.
+            const bool isLocalTransport = (m_pMsgChannel->GetTransportType() == TransportType::Local);
+            TransferSession* pSessionData =
+                DD_NEW(TransferSession, m_pMsgChannel->GetAllocCb())(m_pTransferManager, pSession, isLocalTransport);
             pSession->SetUserData(pSessionData);
         }
 
@@ -859,40 +859,60 @@ namespace DevDriver
             }
         }
 
-        // proceed to transmit any data we haven't sent yet
+        // proceed to transmit any data we haven't sent yet, handing it to the message channel in batches so that
+        // transports which support it can send several messages with one system call
         const WindowSize& windowSize = m_sendWindow.GetWindowSize();
 
         Sequence seq = m_sendWindow.lastSentSequence + 1;
         while ((seq < m_sendWindow.nextSequence) & (m_sendWindow.lastAvailableSize > 0))
         {
-            const uint32 index = seq % windowSize;
-            if (m_sendWindow.valid[index] & (seq == m_sendWindow.sequence[index]))
-            {
-                MessageBuffer& messageBuffer = m_sendWindow.messages[index];
-                messageBuffer.header.windowSize = m_receiveWindow.currentAvailableSize;
+            const MessageBuffer* pBatch[kMaxTransmitBatchSize];
+            uint32 batchCount = 0;
 
-                const Result sendResult = m_pMsgChannel->Forward(messageBuffer);
-                if (sendResult == Result::Success)
+            while (((seq + batchCount) < m_sendWindow.nextSequence) &
+                   (batchCount < m_sendWindow.lastAvailableSize) &
+                   (batchCount < kMaxTransmitBatchSize))
+            {
+                const Sequence batchSeq = (seq + batchCount);
+                const uint32 index = batchSeq % windowSize;
+                if (m_sendWindow.valid[index] & (batchSeq == m_sendWindow.sequence[index]))
                 {
-                    const uint64 currentTime = Platform::GetCurrentTimeInMs();
-                    m_sendWindow.initialTransmitTimeInMs[index] = currentTime;
-                    m_sendWindow.lastSentSequence = messageBuffer.header.sequence;
-                    m_sendWindow.lastAvailableSize -= 1;
+                    MessageBuffer& messageBuffer = m_sendWindow.messages[index];
+                    messageBuffer.header.windowSize = m_receiveWindow.currentAvailableSize;
+                    pBatch[batchCount++] = &messageBuffer;
                 }
                 else
                 {
-                    if (sendResult != Result::NotReady)
-                    {
-                        Shutdown(Result::Error);
-                    }
-                    // packet dropped, abort transmitting
+                    DD_ASSERT_REASON("Transmit window data corruption detected");
                     break;
                 }
-                seq++;
             }
-            else
+
+            if (batchCount == 0)
             {
-                DD_ASSERT_REASON("Transmit window data corruption detected");
+                break;
+            }
+
+            uint32 numSent = 0;
+            const Result sendResult = m_pMsgChannel->ForwardMessages(&pBatch[0], batchCount, &numSent);
+
+            const uint64 currentTime = Platform::GetCurrentTimeInMs();
+            for (uint32 i = 0; i < numSent; ++i)
+            {
+                m_sendWindow.initialTransmitTimeInMs[(seq + i) % windowSize] = currentTime;
+                m_sendWindow.lastSentSequence = pBatch[i]->header.sequence;
+                m_sendWindow.lastAvailableSize -= 1;
+            }
+            seq += numSent;
+
+            if (sendResult != Result::Success)
+            {
+                if (sendResult != Result::NotReady)
+                {
+                    Shutdown(Result::Error);
+                }
+                // packet dropped, abort transmitting
+                break;
             }
         }
     }
@@ -67,6 +67,9 @@ namespace DevDriver
     DD_STATIC_CONST WindowSize kDefaultWindowSize = 128;
     DD_STATIC_CONST float kInitialRoundTripTimeInMs = 50.0f;
 
+    // Maximum number of new messages handed to the message channel at once when transmitting the send window.
+    DD_STATIC_CONST uint32 kMaxTransmitBatchSize = 16;
+
     class Session : public ISession
     {
     public:
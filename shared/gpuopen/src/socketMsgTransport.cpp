@@ -53,7 +53,9 @@ namespace DevDriver
     SocketMsgTransport::SocketMsgTransport(const HostInfo& hostInfo) :
         m_connected(false),
         m_hostInfo(hostInfo),
-        m_socketType(TransportToSocketType(hostInfo.type))
+        m_socketType(TransportToSocketType(hostInfo.type)),
+        m_receiveBatchCount(0),
+        m_receiveBatchIndex(0)
     {
         if ((m_socketType != SocketType::Udp) && (m_socketType != SocketType::Local))
         {
@@ -98,6 +100,8 @@ namespace DevDriver
         if (m_connected)
         {
             m_connected = false;
+            m_receiveBatchCount = 0;
+            m_receiveBatchIndex = 0;
             result = m_clientSocket.Close();
         }
         return result;
@@ -105,31 +109,51 @@ namespace DevDriver
 
     Result SocketMsgTransport::ReadMessage(MessageBuffer &messageBuffer, uint32 timeoutInMs)
     {
-        bool canRead = m_connected;
-        bool exceptState = false;
         Result result = Result::Success;
 
-        if (canRead & (timeoutInMs > 0))
+        // Only go to the socket once every message from the previous batch has been handed out. The message thread
+        // reads until the transport runs dry, so draining the socket a batch at a time saves most of the system calls.
+        if (m_receiveBatchIndex == m_receiveBatchCount)
         {
-            result = m_clientSocket.Select(&canRead, nullptr, &exceptState, timeoutInMs);
-        }
+            bool canRead = m_connected;
+            bool exceptState = false;
 
-        if (result == Result::Success)
-        {
-            if (canRead)
-            {
-                size_t bytesReceived;
-                result = m_clientSocket.Receive(reinterpret_cast<uint8*>(&messageBuffer), sizeof(MessageBuffer), &bytesReceived);
-            }
-            else if (exceptState)
+            if (canRead & (timeoutInMs > 0))
             {
-                result = Result::Error;
+                result = m_clientSocket.Select(&canRead, nullptr, &exceptState, timeoutInMs);
             }
-            else
+
+            if (result == Result::Success)
             {
-                result = Result::NotReady;
+                if (canRead)
+                {
+                    uint32 numReceived = 0;
+                    result = m_clientSocket.ReceiveBatch(reinterpret_cast<uint8*>(&m_receiveBatch[0]),
+                                                         sizeof(MessageBuffer),
+                                                         Socket::kMaxBatchSize,
+                                                         &m_receiveBatchSizes[0],
+                                                         &numReceived);
+
+                    m_receiveBatchCount = numReceived;
+                    m_receiveBatchIndex = 0;
+                }
+                else if (exceptState)
+                {
+                    result = Result::Error;
+                }
+                else
+                {
+                    result = Result::NotReady;
+                }
             }
         }
+
+        if (result == Result::Success)
+        {
+            const uint32 index = m_receiveBatchIndex++;
+            memcpy(&messageBuffer, &m_receiveBatch[index], m_receiveBatchSizes[index]);
+        }
+
         return result;
     }
 
@@ -141,6 +165,37 @@ namespace DevDriver
         return m_clientSocket.Send(reinterpret_cast<const uint8*>(&messageBuffer), totalMsgSize, &bytesSent);
     }
 
+    Result SocketMsgTransport::WriteMessages(const MessageBuffer* const* ppMessages, uint32 count, uint32* pNumWritten)
+    {
+        DD_ASSERT(m_connected);
+
+        Result result = Result::Success;
+        uint32 numWritten = 0;
+
+        // Each message is still sent as its own datagram, so peers see exactly the same traffic as with WriteMessage.
+        while ((result == Result::Success) && (numWritten < count))
+        {
+            const uint32 batchCount = Platform::Min(count - numWritten, Socket::kMaxBatchSize);
+
+            const uint8* pData[Socket::kMaxBatchSize];
+            size_t       dataSizes[Socket::kMaxBatchSize];
+
+            for (uint32 i = 0; i < batchCount; ++i)
+            {
+                const MessageBuffer& messageBuffer = *ppMessages[numWritten + i];
+                pData[i]     = reinterpret_cast<const uint8*>(&messageBuffer);
+                dataSizes[i] = (sizeof(MessageHeader) + messageBuffer.header.payloadSize);
+            }
+
+            uint32 numSent = 0;
+            result = m_clientSocket.SendBatch(&pData[0], &dataSizes[0], batchCount, &numSent);
+            numWritten += numSent;
+        }
+
+        *pNumWritten = numWritten;
+        return result;
+    }
+
     // ================================================================================================================
     // Tests to see if the client can connect to RDS through this transport
     Result SocketMsgTransport::TestConnection(const HostInfo& hostInfo, uint32 timeoutInMs)
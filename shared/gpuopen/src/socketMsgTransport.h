@@ -47,6 +47,7 @@ namespace DevDriver
 
         Result ReadMessage(MessageBuffer& messageBuffer, uint32 timeoutInMs) override;
         Result WriteMessage(const MessageBuffer& messageBuffer) override;
+        Result WriteMessages(const MessageBuffer* const* ppMessages, uint32 count, uint32* pNumWritten) override;
 
         const char* GetTransportName() const override
         {
@@ -69,6 +70,11 @@ namespace DevDriver
             return pName;
         }
 
+        TransportType GetTransportType() const override
+        {
+            return m_hostInfo.type;
+        }
+
         static Result TestConnection(const HostInfo& connectionInfo, uint32 timeoutInMs);
 
         DD_STATIC_CONST bool RequiresKeepAlive()
@@ -86,6 +92,12 @@ namespace DevDriver
         bool                m_connected;
         const HostInfo      m_hostInfo;
         const SocketType    m_socketType;
+
+        // Messages received by the last batched receive that haven't been read yet.
+        MessageBuffer       m_receiveBatch[Socket::kMaxBatchSize];
+        size_t              m_receiveBatchSizes[Socket::kMaxBatchSize];
+        uint32              m_receiveBatchCount;
+        uint32              m_receiveBatchIndex;
     };
 
 } // DevDriver
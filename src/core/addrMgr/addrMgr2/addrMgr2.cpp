@@ -226,22 +226,51 @@ Result AddrMgr2::InitSubresourcesForImage(
             SubresId subRes = pBaseSubRes->subresId;
             for (subRes.mipLevel = 0; subRes.mipLevel < createInfo.mipLevels; ++subRes.mipLevel)
             {
-                for (subRes.arraySlice = 0; subRes.arraySlice < createInfo.arraySize; ++subRes.arraySlice)
+                subRes.arraySlice = 0;
+
+                const uint32          slice0Idx       = pImage->CalcSubresourceId(subRes);
+                SubResourceInfo*const pSlice0SubRes   = (pSubResInfoList + slice0Idx);
+                TileInfo*const        pSlice0TileInfo = NonConstTileInfo(pSubResTileInfoList, slice0Idx);
+
+                // Each subresource in the plane uses the same tiling info as the base subresource.
+                *pSlice0TileInfo = *pBaseTileInfo;
+
+                result = InitSubresourceInfo(pImage, pSlice0SubRes, pSlice0TileInfo, surfSettingOut, surfInfoOut);
+
+                // Every array slice of a mip level has the same layout, so the remaining slices are derived from the
+                // first one instead of repeating the full computation for each of them. Stereo images are the
+                // exception because only the first subresource includes the right eye in its extent.
+                for (subRes.arraySlice = 1;
+                     (subRes.arraySlice < createInfo.arraySize) && (result == Result::Success);
+                     ++subRes.arraySlice)
                 {
                     const uint32          subResIdx = pImage->CalcSubresourceId(subRes);
                     SubResourceInfo*const pSubRes   = (pSubResInfoList + subResIdx);
                     TileInfo*const        pTileInfo = NonConstTileInfo(pSubResTileInfoList, subResIdx);
 
-                    // Each subresource in the plane uses the same tiling info as the base subresource.
-                    *pTileInfo = *pBaseTileInfo;
-
-                    result = InitSubresourceInfo(pImage, pSubRes, pTileInfo, surfSettingOut, surfInfoOut);
-                    if (result != Result::Success)
+                    if (createInfo.flags.stereo == 0)
                     {
-                        break;
+                        result = InitSubresourceSlice(pImage,
+                                                      *pSlice0SubRes,
+                                                      *pSlice0TileInfo,
+                                                      pSubRes,
+                                                      pTileInfo,
+                                                      surfSettingOut,
+                                                      surfInfoOut);
+                    }
+                    else
+                    {
+                        *pTileInfo = *pBaseTileInfo;
+
+                        result = InitSubresourceInfo(pImage, pSubRes, pTileInfo, surfSettingOut, surfInfoOut);
                     }
                 } // End loop over slices
 
+                if (result != Result::Success)
+                {
+                    break;
+                }
+
                 // Update the memory layout's swizzle equation information. These propagate down from index 0 to index
                 // 1 so this check should skip this logic once we're found both swizzle equations.
                 subRes.arraySlice = 0;
@@ -1009,38 +1038,7 @@ Result AddrMgr2::InitSubresourceInfo(
         pSubResInfo->blockSize.height = surfaceInfo.blockHeight;
         pSubResInfo->blockSize.depth  = surfaceInfo.blockSlices;
 
-        // In order to support Parameterized Swizzle for mipmapped arrays and for mipmapped tex2d resources,
-        // we must call into AddrLib to calculate a special offset for this subresource. This offset should
-        // not be altered outside of AddrLib.
-        if ((createInfo.mipLevels > 1) &&
-            ((createInfo.arraySize > 1) || (createInfo.imageType == Pal::ImageType::Tex2d)))
-        {
-            ADDR2_COMPUTE_SUBRESOURCE_OFFSET_FORSWIZZLEPATTERN_INPUT  addr2Input  = {};
-            ADDR2_COMPUTE_SUBRESOURCE_OFFSET_FORSWIZZLEPATTERN_OUTPUT addr2Output = {};
-
-            addr2Input.size             = sizeof(ADDR2_COMPUTE_SUBRESOURCE_OFFSET_FORSWIZZLEPATTERN_INPUT);
-            addr2Input.resourceType     = GetAddrResourceType(pImage);
-            addr2Input.pipeBankXor      = pTileInfo->pipeBankXor;
-            addr2Input.swizzleMode      = surfaceSetting.swizzleMode;
-            addr2Input.slice            = pSubResInfo->subresId.arraySlice;
-            addr2Input.sliceSize        = surfaceInfo.sliceSize;
-            addr2Input.macroBlockOffset = mipInfo.macroBlockOffset;
-            addr2Input.mipTailOffset    = mipInfo.mipTailOffset;
-
-            addr2Output.size = sizeof(ADDR2_COMPUTE_SUBRESOURCE_OFFSET_FORSWIZZLEPATTERN_OUTPUT);
-
-            ADDR_E_RETURNCODE addrRet = Addr2ComputeSubResourceOffsetForSwizzlePattern(AddrLibHandle(),
-                                                                                       &addr2Input,
-                                                                                       &addr2Output);
-            if (addrRet == ADDR_OK)
-            {
-                pSubResInfo->swizzleOffset = addr2Output.offset;
-            }
-            else
-            {
-                result = Result::ErrorUnknown;
-            }
-        }
+        result = ComputeSwizzleOffset(pImage, pSubResInfo, *pTileInfo, surfaceSetting, surfaceInfo);
     }
 
     if (result == Result::Success)
@@ -1097,5 +1095,90 @@ Result AddrMgr2::InitSubresourceInfo(
     return result;
 }
 
+// =====================================================================================================================
+// Initializes a subresource in a non-zero array slice from the already initialized subresource in array slice zero of
+// the same mip level.  Only the parameterized swizzle offset differs between the slices at this point; the final
+// offsets are computed later for every subresource.
+Result AddrMgr2::InitSubresourceSlice(
+    const Image*                                   pImage,
+    const SubResourceInfo&                         slice0SubResInfo,
+    const TileInfo&                                slice0TileInfo,
+    SubResourceInfo*                               pSubResInfo,
+    TileInfo*                                      pTileInfo,
+    const ADDR2_GET_PREFERRED_SURF_SETTING_OUTPUT& surfaceSetting,
+    const ADDR2_COMPUTE_SURFACE_INFO_OUTPUT&       surfaceInfo
+    ) const
+{
+    PAL_ASSERT((pSubResInfo->subresId.aspect   == slice0SubResInfo.subresId.aspect) &&
+               (pSubResInfo->subresId.mipLevel == slice0SubResInfo.subresId.mipLevel));
+
+    const uint32 arraySlice = pSubResInfo->subresId.arraySlice;
+
+    *pSubResInfo = slice0SubResInfo;
+    *pTileInfo   = slice0TileInfo;
+
+    pSubResInfo->subresId.arraySlice = arraySlice;
+
+    Result result = Result::Success;
+
+    if (IsLinearSwizzleMode(surfaceSetting.swizzleMode) == false)
+    {
+        result = ComputeSwizzleOffset(pImage, pSubResInfo, *pTileInfo, surfaceSetting, surfaceInfo);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// In order to support Parameterized Swizzle for mipmapped arrays and for mipmapped tex2d resources, we must call into
+// AddrLib to calculate a special offset for each tiled subresource. This offset should not be altered outside of
+// AddrLib.
+Result AddrMgr2::ComputeSwizzleOffset(
+    const Image*                                   pImage,
+    SubResourceInfo*                               pSubResInfo,
+    const TileInfo&                                tileInfo,
+    const ADDR2_GET_PREFERRED_SURF_SETTING_OUTPUT& surfaceSetting,
+    const ADDR2_COMPUTE_SURFACE_INFO_OUTPUT&       surfaceInfo
+    ) const
+{
+    Result result = Result::Success;
+
+    const ImageCreateInfo& createInfo = pImage->GetImageCreateInfo();
+
+    if ((createInfo.mipLevels > 1) &&
+        ((createInfo.arraySize > 1) || (createInfo.imageType == Pal::ImageType::Tex2d)))
+    {
+        const ADDR2_MIP_INFO& mipInfo = surfaceInfo.pMipInfo[pSubResInfo->subresId.mipLevel];
+
+        ADDR2_COMPUTE_SUBRESOURCE_OFFSET_FORSWIZZLEPATTERN_INPUT  addr2Input  = {};
+        ADDR2_COMPUTE_SUBRESOURCE_OFFSET_FORSWIZZLEPATTERN_OUTPUT addr2Output = {};
+
+        addr2Input.size             = sizeof(ADDR2_COMPUTE_SUBRESOURCE_OFFSET_FORSWIZZLEPATTERN_INPUT);
+        addr2Input.resourceType     = GetAddrResourceType(pImage);
+        addr2Input.pipeBankXor      = tileInfo.pipeBankXor;
+        addr2Input.swizzleMode      = surfaceSetting.swizzleMode;
+        addr2Input.slice            = pSubResInfo->subresId.arraySlice;
+        addr2Input.sliceSize        = surfaceInfo.sliceSize;
+        addr2Input.macroBlockOffset = mipInfo.macroBlockOffset;
+        addr2Input.mipTailOffset    = mipInfo.mipTailOffset;
+
+        addr2Output.size = sizeof(ADDR2_COMPUTE_SUBRESOURCE_OFFSET_FORSWIZZLEPATTERN_OUTPUT);
+
+        ADDR_E_RETURNCODE addrRet = Addr2ComputeSubResourceOffsetForSwizzlePattern(AddrLibHandle(),
+                                                                                   &addr2Input,
+                                                                                   &addr2Output);
+        if (addrRet == ADDR_OK)
+        {
+            pSubResInfo->swizzleOffset = addr2Output.offset;
+        }
+        else
+        {
+            result = Result::ErrorUnknown;
+        }
+    }
+
+    return result;
+}
+
 } // AddrMgr2
 } // Pal
@@ -385,6 +385,22 @@ private:
         const ADDR2_GET_PREFERRED_SURF_SETTING_OUTPUT& surfaceSetting,
         const ADDR2_COMPUTE_SURFACE_INFO_OUTPUT&       surfaceInfo) const;
 
+    Result InitSubresourceSlice(
+        const Image*                                   pImage,
+        const SubResourceInfo&                         slice0SubResInfo,
+        const TileInfo&                                slice0TileInfo,
+        SubResourceInfo*                               pSubResInfo,
+        TileInfo*                                      pTileInfo,
+        const ADDR2_GET_PREFERRED_SURF_SETTING_OUTPUT& surfaceSetting,
+        const ADDR2_COMPUTE_SURFACE_INFO_OUTPUT&       surfaceInfo) const;
+
+    Result ComputeSwizzleOffset(
+        const Image*                                   pImage,
+        SubResourceInfo*                               pSubResInfo,
+        const TileInfo&                                tileInfo,
+        const ADDR2_GET_PREFERRED_SURF_SETTING_OUTPUT& surfaceSetting,
+        const ADDR2_COMPUTE_SURFACE_INFO_OUTPUT&       surfaceInfo) const;
+
     void Gfx9InitSubresource(
         const SubResIterator&  subResIt,
         SubResourceInfo*       pSubResInfoList,
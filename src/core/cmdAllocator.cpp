@@ -90,6 +90,7 @@ CmdAllocator::CmdAllocator(
     m_pDevice(pDevice),
     m_pChunkLock(nullptr),
     m_lastPagingFence(0),
+    m_pooledBytes(0),
     m_pLinearAllocLock(nullptr),
     m_pDummyChunkAllocation(nullptr)
 {
@@ -324,6 +325,8 @@ void CmdAllocator::FreeAllChunks()
             PAL_SAFE_FREE(pAlloc, m_pDevice->GetPlatform());
         }
     }
+
+    m_pooledBytes = 0;
 }
 
 // =====================================================================================================================
@@ -617,6 +620,21 @@ Result CmdAllocator::CreateAllocation(
     // that piece of memory
     allocCreateInfo.flags.dummyAllocation = dummyAlloc;
 
+    // Suballocate GPU memory allocations from the device-wide chunk pool until this allocator reaches its quota.
+    const gpusize poolQuota = m_pDevice->Settings().cmdChunkPoolAllocatorQuota;
+
+    if ((dummyAlloc == false) && (allocCreateInfo.memObjCreateInfo.heapCount > 0) && (poolQuota > 0))
+    {
+        if ((m_pooledBytes + allocCreateInfo.memObjCreateInfo.size) <= poolQuota)
+        {
+            allocCreateInfo.flags.usePool = 1;
+        }
+        else
+        {
+            m_pDevice->GetCmdChunkPool()->RecordFallback();
+        }
+    }
+
     void*const pPlacementAddr = PAL_MALLOC(CmdStreamAllocation::GetSize(allocCreateInfo),
                                            m_pDevice->GetPlatform(),
                                            AllocInternal);
@@ -639,6 +657,11 @@ Result CmdAllocator::CreateAllocation(
         PAL_ASSERT(result == Result::Success);
         pAllocInfo->allocList.PushBack(pAlloc->ListNode());
 
+        if (pAlloc->IsPooled())
+        {
+            m_pooledBytes += allocCreateInfo.memObjCreateInfo.size;
+        }
+
         pChunk = pAlloc->Chunks();
         for (uint32 idx = 1; idx < allocCreateInfo.numChunks; ++idx)
         {
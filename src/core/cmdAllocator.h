@@ -140,6 +140,10 @@ private:
     // Most-recent paging fence value returned from the OS when allocating command-chunk allocations
     uint64          m_lastPagingFence;
 
+    // Bytes of GPU memory this allocator has suballocated from the device's CmdChunkPool. Allocations beyond the
+    // CmdChunkPoolAllocatorQuota setting get their own GPU memory objects. Protected by the chunk lock.
+    gpusize         m_pooledBytes;
+
     Util::Mutex*    m_pLinearAllocLock;    // If non-null, this protects the allocator's linear allocator state.
     LinearAllocList m_linearAllocFreeList; // Unordered list of allocators that are reset and not in use.
     LinearAllocList m_linearAllocBusyList; // Unordered list of allocators that are being used by command buffers.
@@ -26,9 +26,12 @@
 #include "core/cmdBuffer.h"
 #include "core/device.h"
 #include "core/gpuEvent.h"
+#include "core/hw/gfxip/queryPool.h"
+#include "core/image.h"
 #include "core/platform.h"
 #include "core/queue.h"
 #include "palAutoBuffer.h"
+#include "palHashSetImpl.h"
 #include "palLinearAllocator.h"
 #include "palSysUtil.h"
 #include "palVectorImpl.h"
@@ -99,6 +102,9 @@ static void PAL_STDCALL CmdDispatchOffsetInvalid(
     uint32      yDim,
     uint32      zDim);
 
+// Number of buckets in the hash table of memory references. Command buffers typically reference a few dozen objects.
+constexpr uint32 MemRefTableBuckets = 64;
+
 #if PAL_ENABLE_PRINTS_ASSERTS
 uint32 CmdBuffer::s_numCreated[QueueTypeCount] = {};
 #endif
@@ -123,6 +129,7 @@ CmdBuffer::CmdBuffer(
     m_gpuScratchMem(device.GetPlatform()),
     m_gpuScratchMemAllocLimit(0),
     m_lastPagingFence(0),
+    m_memRefs(MemRefTableBuckets, device.GetPlatform()),
     m_p2pBltWaInfo(device.GetPlatform()),
     m_p2pBltWaLastChunkAddr(0),
     m_device(device),
@@ -259,6 +266,24 @@ Result CmdBuffer::Begin(
                 m_buildFlags.disallowNestedLaunchViaIb2 = 0;
             }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+            // User-data patch points are CPU addresses of the final command memory, so they can't be recorded when
+            // commands are written to staging buffers. Nested command buffers can't be patched because their commands
+            // may be copied into their callers.
+            if (IsNested()                              ||
+                (SupportsUserDataPatching() == false)   ||
+                settings.cmdBufChunkEnableStagingBuffer ||
+                (info.patchableUserDataEntryCount == 0))
+            {
+                m_buildFlags.enableUserDataPatching = 0;
+            }
+            else if (m_buildFlags.enableUserDataPatching != 0)
+            {
+                // CE RAM copies of the spill tables are never visible in command memory, so they can't be patched.
+                m_buildFlags.useCpuPathForTableUpdates = 1;
+            }
+#endif
+
             // Obtain a linear allocator for this command building session. It should be impossible for us to have a
             // non-null linear allocator at this time.
             PAL_ASSERT(m_pMemAllocator == nullptr);
@@ -278,6 +303,16 @@ Result CmdBuffer::Begin(
                 m_pMemAllocatorStartPos = m_pMemAllocator->Current();
             }
 
+            // Forget the references of the previous building session. Most command buffers never track references so
+            // the reference set isn't allocated until one is begun with tracking enabled.
+            m_memRefs.Reset();
+
+            if ((result == Result::Success) && TracksMemRefs() && (m_flags.memRefsInitialized == 0))
+            {
+                result = m_memRefs.Init();
+                m_flags.memRefsInitialized = (result == Result::Success);
+            }
+
             if (result == Result::Success)
             {
                 CmdStreamBeginFlags cmdStreamflags = {};
@@ -286,6 +321,14 @@ Result CmdBuffer::Begin(
                     (((settings.cmdBufOptimizePm4 == Pm4OptDefaultEnable) && m_buildFlags.optimizeGpuSmallBatch) ||
                      (settings.cmdBufOptimizePm4 == Pm4OptForceEnable));
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+                // The PM4 optimizer may drop or move the packets which hold user-data patch points.
+                if (m_buildFlags.enableUserDataPatching != 0)
+                {
+                    cmdStreamflags.optimizeCommands = 0;
+                }
+#endif
+
                 // If the app explicitly called "reset" on this command buffer, there's no need to do another reset
                 // on the command streams.
                 result = BeginCommandStreams(cmdStreamflags, m_recordState != CmdBufferRecordState::Reset);
@@ -455,6 +498,59 @@ Result CmdBuffer::Reset(
     return m_status;
 }
 
+// =====================================================================================================================
+// Adds the memory bound to an image to this command buffer's reference set.
+void CmdBuffer::TrackMemRef(
+    const IImage& image)
+{
+    if (TracksMemRefs())
+    {
+        const GpuMemory*const pGpuMemory = static_cast<const Image&>(image).GetBoundGpuMemory().Memory();
+
+        if (pGpuMemory != nullptr)
+        {
+            AddMemRef(pGpuMemory);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Adds the memory bound to a query pool to this command buffer's reference set.
+void CmdBuffer::TrackMemRef(
+    const IQueryPool& queryPool)
+{
+    if (TracksMemRefs())
+    {
+        AddMemRef(&static_cast<const QueryPool&>(queryPool).GpuMemory());
+    }
+}
+
+// =====================================================================================================================
+// Adds every memory object referenced by a nested command buffer to this command buffer's reference set.
+void CmdBuffer::TrackMemRefs(
+    const CmdBuffer& callee)
+{
+    if (TracksMemRefs())
+    {
+        // A callee which wasn't built with tracking enabled has an empty set; we can't know what it references so the
+        // client must make its memory resident some other way.
+        for (auto iter = callee.MemRefs().Begin(); iter.Get() != nullptr; iter.Next())
+        {
+            AddMemRef(iter.Get()->key);
+        }
+    }
+}
+
+// =====================================================================================================================
+void CmdBuffer::AddMemRef(
+    const IGpuMemory* pGpuMemory)
+{
+    if (m_memRefs.Insert(pGpuMemory) != Result::Success)
+    {
+        NotifyAllocFailure();
+    }
+}
+
 // =====================================================================================================================
 // Returns a new chunk by first searching the retained chunk list for a valid chunk then querying the command allocator
 // if there are no retained chunks available.
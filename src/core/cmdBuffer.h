@@ -31,7 +31,8 @@
 #include "core/gpuEvent.h"
 #include "palAssert.h"
 #include "palCmdBuffer.h"
-#include "palFile.h"
+#include "palBufferedFile.h"
+#include "palHashSet.h"
 #include "palVector.h"
 
 namespace Util { class VirtualLinearAllocator; }
@@ -159,6 +160,9 @@ struct P2pBltWaInfo
 // Convenience typedef for a vector of P2P BLT workaround structures.
 typedef Util::Vector<P2pBltWaInfo, 1, Platform> P2pBltWaInfoVector;
 
+// Deduplicated set of the GPU memory objects referenced by a command buffer's commands.
+typedef Util::HashSet<const IGpuMemory*, Platform> MemRefSet;
+
 // =====================================================================================================================
 // A command buffer can be executed by the GPU multiple times and recycled, provided the command buffer is not pending
 // execution on the GPU when it is recycled.
@@ -190,6 +194,15 @@ public:
     virtual uint32 GetEmbeddedDataLimit() const override
         { return m_pCmdAllocator->ChunkSize(EmbeddedDataAlloc) / sizeof(uint32); }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    // Command buffers which don't support user-data patching never record any patch points.
+    virtual Result PatchUserData(
+        PipelineBindPoint bindPoint,
+        uint32            firstEntry,
+        uint32            entryCount,
+        const uint32*     pEntryValues) override { return Result::ErrorUnavailable; }
+#endif
+
     virtual void CmdBarrier(const BarrierInfo& barrierInfo) override;
 
     virtual void CmdRelease(
@@ -795,7 +808,7 @@ public:
 
 #if PAL_ENABLE_PRINTS_ASSERTS
     // This function allows us to dump the contents of this command buffer to a file at submission time.
-    virtual void DumpCmdStreamsToFile(Util::File* pFile, CmdBufDumpFormat mode) const = 0;
+    virtual void DumpCmdStreamsToFile(Util::BufferedFile* pFile, CmdBufDumpFormat mode) const = 0;
 
     // This function gets the directory from device settings and dump the file to the right directory.
     void OpenCmdBufDumpFile(const char* pFilename);
@@ -831,6 +844,11 @@ public:
 
     uint64 LastPagingFence() const { return m_lastPagingFence; }
 
+    // Returns true if this command buffer was built with the trackMemoryReferences flag.  If so, MemRefs() holds every
+    // memory object referenced by this command buffer and all nested command buffers it called.
+    bool             TracksMemRefs() const { return (m_buildFlags.trackMemoryReferences != 0); }
+    const MemRefSet& MemRefs()       const { return m_memRefs; }
+
     // Note that this is not a general-purpose allocator. It is only valid during command building and its allocations
     // must follow special life-time rules. Read the CmdBufferBuildInfo documentation for more information.
     Util::VirtualLinearAllocator* Allocator() { return m_pMemAllocator; }
@@ -894,6 +912,10 @@ protected:
     virtual void WriteEventCmd(const BoundGpuMemory& boundMemObj, HwPipePoint pipePoint, uint32 data) = 0;
 
     virtual bool SupportsExecutionMarker() { return false; }
+
+    // Returns true if this command buffer records the patch points needed by PatchUserData().
+    virtual bool SupportsUserDataPatching() const { return false; }
+
     virtual void BeginExecutionMarker(uint64 clientHandle);
     virtual void EndExecutionMarker() { PAL_NEVER_CALLED(); }
 
@@ -926,6 +948,14 @@ protected:
     // appropriate command stream.
     void P2pBltWaCopyNextRegion(CmdStream* pCmdStream, gpusize chunkAddr);
 
+    // Adds a memory object, the memory bound to an image or query pool, or all of a nested command buffer's references
+    // to this command buffer's reference set.  These do nothing unless the trackMemoryReferences build flag is set.
+    void TrackMemRef(const IGpuMemory& gpuMemory)
+        { if (TracksMemRefs()) { AddMemRef(&gpuMemory); } }
+    void TrackMemRef(const IImage& image);
+    void TrackMemRef(const IQueryPool& queryPool);
+    void TrackMemRefs(const CmdBuffer& callee);
+
     static void PAL_STDCALL CmdDispatchInvalid(
         ICmdBuffer* pCmdBuffer,
         uint32      x,
@@ -948,9 +978,9 @@ protected:
     // Utility function for determing if command buffer dumping has been enabled.
     bool IsDumpingEnabled() const { return m_device.Settings().cmdBufDumpMode == CmdBufDumpModeRecordTime; }
 
-    Util::File* DumpFile() { return &m_file; }
-    uint32      UniqueId() const { return m_uniqueId; }
-    uint32      NumBegun() const { return m_numCmdBufsBegun; }
+    Util::BufferedFile* DumpFile() { return &m_file; }
+    uint32              UniqueId() const { return m_uniqueId; }
+    uint32              NumBegun() const { return m_numCmdBufsBegun; }
 #endif
 
     virtual void CmdNop(
@@ -993,6 +1023,10 @@ protected:
     // command buffer.
     uint64  m_lastPagingFence;
 
+    // Memory objects referenced by this command buffer, only used if the trackMemoryReferences build flag is set. The
+    // hash table is allocated the first time a command buffer using it is begun.
+    MemRefSet m_memRefs;
+
     P2pBltWaInfoVector m_p2pBltWaInfo;           // List of P2P BLT info that is required by the KMD-assisted PCI BAR
                                                  // workaround.
     gpusize            m_p2pBltWaLastChunkAddr;  // Scratch variable to avoid starting a new chunk if the starting
@@ -1004,13 +1038,16 @@ protected:
         struct
         {
             uint32 internalMemAllocator  : 1;  // True if m_pMemAllocator is owned internally by PAL.
-            uint32 reserved              : 31;
+            uint32 memRefsInitialized    : 1;  // True if m_memRefs has been initialized.
+            uint32 reserved              : 30;
         };
 
         uint32     u32All;
     } m_flags;
 
 private:
+    void AddMemRef(const IGpuMemory* pGpuMemory);
+
     CmdStreamChunk* GetNextDataChunk(
         CmdAllocType type,
         ChunkData*   pData,
@@ -1032,10 +1069,10 @@ private:
 
 #if PAL_ENABLE_PRINTS_ASSERTS
     // These member variables are only for command buffer dumping support.
-    static uint32  s_numCreated[QueueTypeCount]; // Number of created CmdBuffers of each type.
-    Util::File     m_file;
-    uint32         m_uniqueId;
-    uint32         m_numCmdBufsBegun;
+    static uint32      s_numCreated[QueueTypeCount]; // Number of created CmdBuffers of each type.
+    Util::BufferedFile m_file;
+    uint32             m_uniqueId;
+    uint32             m_numCmdBufsBegun;
 #endif
 
     PAL_DISALLOW_COPY_AND_ASSIGN(CmdBuffer);
@@ -0,0 +1,335 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/cmdChunkPool.h"
+#include "core/device.h"
+#include "core/internalMemMgr.h"
+#include "core/platform.h"
+#include "palBuddyAllocatorImpl.h"
+#include "palListImpl.h"
+
+using namespace Util;
+
+namespace Pal
+{
+
+// The smallest suballocation; command allocator chunk sizes must already be multiples of this.
+static constexpr gpusize MinSuballocationSize = PAL_PAGE_BYTES;
+
+// Number of blocks without any suballocations which are kept around for future requests rather than freed.
+static constexpr uint32 MaxEmptyBlocks = 2;
+
+// =====================================================================================================================
+CmdChunkPool::CmdChunkPool(
+    Device* pDevice)
+    :
+    m_pDevice(pDevice),
+    m_blockList(pDevice->GetPlatform()),
+    m_emptyBlockCount(0),
+    m_suballocatedBytes(0),
+    m_peakSuballocatedBytes(0),
+    m_suballocCount(0),
+    m_fallbackCount(0)
+{
+}
+
+// =====================================================================================================================
+// Frees all blocks. Every command allocator must have released its pooled allocations by now.
+void CmdChunkPool::FreeAllocations()
+{
+    PAL_ASSERT(m_suballocatedBytes == 0);
+
+    while (m_blockList.NumElements() != 0)
+    {
+        auto it = m_blockList.Begin();
+
+        DestroyBlock(it.Get());
+        m_blockList.Erase(&it);
+    }
+
+    m_emptyBlockCount = 0;
+}
+
+// =====================================================================================================================
+// Determines whether a block can serve a request with the given memory properties. Every property the block's GPU
+// memory object was created with must match, since a suballocation inherits all of them.
+bool CmdChunkPool::IsMatchingBlock(
+    const Block&                       block,
+    const GpuMemoryCreateInfo&         createInfo,
+    const GpuMemoryInternalCreateInfo& internalInfo,
+    bool                               cpuAccessible)
+{
+    bool matches = ((block.heapCount      == createInfo.heapCount)                 &&
+                    (block.vaRange        == createInfo.vaRange)                   &&
+                    (block.priority       == createInfo.priority)                  &&
+                    (block.priorityOffset == createInfo.priorityOffset)            &&
+                    (block.flags          == createInfo.flags.u32All)              &&
+                    (block.mtype          == internalInfo.mtype)                   &&
+                    (block.internalFlags  == internalInfo.flags.u32All)            &&
+                    (block.cpuAccessible  == cpuAccessible)                        &&
+                    (block.hasPagingFence == (internalInfo.pPagingFence != nullptr)));
+
+    for (uint32 h = 0; matches && (h < block.heapCount); ++h)
+    {
+        matches = (block.heaps[h] == createInfo.heaps[h]);
+    }
+
+    return matches;
+}
+
+// =====================================================================================================================
+// Allocates, maps and sets up the suballocator of a new block with the given memory properties.
+Result CmdChunkPool::CreateBlock(
+    const GpuMemoryCreateInfo&         createInfo,
+    const GpuMemoryInternalCreateInfo& internalInfo,
+    bool                               cpuAccessible,
+    Block*                             pBlock)
+{
+    memset(pBlock, 0, sizeof(*pBlock));
+
+    pBlock->heapCount      = createInfo.heapCount;
+    pBlock->vaRange        = createInfo.vaRange;
+    pBlock->priority       = createInfo.priority;
+    pBlock->priorityOffset = createInfo.priorityOffset;
+    pBlock->flags          = createInfo.flags.u32All;
+    pBlock->mtype          = internalInfo.mtype;
+    pBlock->internalFlags  = internalInfo.flags.u32All;
+    pBlock->cpuAccessible  = cpuAccessible;
+    pBlock->hasPagingFence = (internalInfo.pPagingFence != nullptr);
+
+    for (uint32 h = 0; h < createInfo.heapCount; ++h)
+    {
+        pBlock->heaps[h] = createInfo.heaps[h];
+    }
+
+    GpuMemoryCreateInfo         blockCreateInfo   = createInfo;
+    GpuMemoryInternalCreateInfo blockInternalInfo = internalInfo;
+
+    blockCreateInfo.size      = BlockSize;
+    blockCreateInfo.alignment = BlockSize;
+
+    // Each command allocator remembers the latest paging fence of the memory it uses, so the block's paging fence is
+    // handed on to every command allocator which suballocates from it.
+    if (pBlock->hasPagingFence)
+    {
+        blockInternalInfo.pPagingFence = &pBlock->pagingFence;
+    }
+
+    // The allocator lock is held by the caller.
+    Result result = m_pDevice->MemMgr()->AllocateGpuMemNoAllocLock(blockCreateInfo,
+                                                                   blockInternalInfo,
+                                                                   false,
+                                                                   &pBlock->pGpuMemory,
+                                                                   nullptr);
+
+    if ((result == Result::Success) && cpuAccessible)
+    {
+        result = pBlock->pGpuMemory->Map(&pBlock->pCpuAddr);
+    }
+
+    if (result == Result::Success)
+    {
+        pBlock->pBuddyAllocator = PAL_NEW(BuddyAllocator<Platform>, m_pDevice->GetPlatform(), AllocInternal)
+                                  (m_pDevice->GetPlatform(), BlockSize, MinSuballocationSize);
+
+        result = (pBlock->pBuddyAllocator != nullptr) ? pBlock->pBuddyAllocator->Init() : Result::ErrorOutOfMemory;
+    }
+
+    if (result != Result::Success)
+    {
+        DestroyBlock(pBlock);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void CmdChunkPool::DestroyBlock(
+    Block* pBlock)
+{
+    PAL_DELETE(pBlock->pBuddyAllocator, m_pDevice->GetPlatform());
+    pBlock->pBuddyAllocator = nullptr;
+
+    if (pBlock->pGpuMemory != nullptr)
+    {
+        if (pBlock->pCpuAddr != nullptr)
+        {
+            const Result result = pBlock->pGpuMemory->Unmap();
+            PAL_ASSERT(result == Result::Success);
+
+            pBlock->pCpuAddr = nullptr;
+        }
+
+        m_pDevice->MemMgr()->FreeGpuMem(pBlock->pGpuMemory, 0);
+        pBlock->pGpuMemory = nullptr;
+    }
+}
+
+// =====================================================================================================================
+Result CmdChunkPool::Allocate(
+    const GpuMemoryCreateInfo&         createInfo,
+    const GpuMemoryInternalCreateInfo& internalInfo,
+    bool                               cpuAccessible,
+    GpuMemory**                        ppGpuMemory,
+    gpusize*                           pOffset,
+    void**                             ppCpuAddr)
+{
+    Result result = Result::ErrorOutOfGpuMemory;
+
+    // Like InternalMemMgr, only pool allocations which leave room for others in the same block.
+    if ((createInfo.size <= (BlockSize / 2)) && (createInfo.alignment <= BlockSize))
+    {
+        MutexAuto lock(&m_lock);
+
+        Block* pBlock = nullptr;
+
+        for (auto it = m_blockList.Begin(); it.Get() != nullptr; it.Next())
+        {
+            Block*const pCandidate = it.Get();
+
+            if (IsMatchingBlock(*pCandidate, createInfo, internalInfo, cpuAccessible))
+            {
+                const bool wasEmpty = pCandidate->pBuddyAllocator->IsEmpty();
+
+                result = pCandidate->pBuddyAllocator->Allocate(createInfo.size, createInfo.alignment, pOffset);
+
+                if (result == Result::Success)
+                {
+                    m_emptyBlockCount -= (wasEmpty ? 1 : 0);
+                    pBlock             = pCandidate;
+                    break;
+                }
+            }
+        }
+
+        if (pBlock == nullptr)
+        {
+            Block newBlock;
+            result = CreateBlock(createInfo, internalInfo, cpuAccessible, &newBlock);
+
+            if (result == Result::Success)
+            {
+                result = m_blockList.PushFront(newBlock);
+
+                if (result == Result::Success)
+                {
+                    pBlock = m_blockList.Begin().Get();
+
+                    // This can only fail if we're out of system memory; the block is kept for future requests.
+                    result = pBlock->pBuddyAllocator->Allocate(createInfo.size, createInfo.alignment, pOffset);
+
+                    if (result != Result::Success)
+                    {
+                        ++m_emptyBlockCount;
+                        pBlock = nullptr;
+                    }
+                }
+                else
+                {
+                    DestroyBlock(&newBlock);
+                }
+            }
+        }
+
+        if (pBlock != nullptr)
+        {
+            *ppGpuMemory = pBlock->pGpuMemory;
+            *ppCpuAddr   = (pBlock->pCpuAddr != nullptr) ? VoidPtrInc(pBlock->pCpuAddr, static_cast<size_t>(*pOffset))
+                                                         : nullptr;
+
+            if (pBlock->hasPagingFence)
+            {
+                *internalInfo.pPagingFence = Max(*internalInfo.pPagingFence, pBlock->pagingFence);
+            }
+
+            m_suballocatedBytes    += createInfo.size;
+            m_peakSuballocatedBytes = Max(m_peakSuballocatedBytes, m_suballocatedBytes);
+            ++m_suballocCount;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Returns a suballocation to its block. If too many blocks are now empty, the block is freed.
+void CmdChunkPool::Free(
+    GpuMemory* pGpuMemory,
+    gpusize    offset,
+    gpusize    size)
+{
+    Block freedBlock = {};
+
+    m_lock.Lock();
+
+    for (auto it = m_blockList.Begin(); it.Get() != nullptr; it.Next())
+    {
+        Block*const pBlock = it.Get();
+
+        if (pBlock->pGpuMemory == pGpuMemory)
+        {
+            pBlock->pBuddyAllocator->Free(offset);
+            m_suballocatedBytes -= size;
+
+            if (pBlock->pBuddyAllocator->IsEmpty())
+            {
+                if (m_emptyBlockCount < MaxEmptyBlocks)
+                {
+                    ++m_emptyBlockCount;
+                }
+                else
+                {
+                    freedBlock = *pBlock;
+                    m_blockList.Erase(&it);
+                }
+            }
+            break;
+        }
+    }
+
+    m_lock.Unlock();
+
+    // Freeing GPU memory waits for readers of the internal reference list, so don't hold the pool lock meanwhile.
+    if (freedBlock.pGpuMemory != nullptr)
+    {
+        DestroyBlock(&freedBlock);
+    }
+}
+
+// =====================================================================================================================
+void CmdChunkPool::GetStats(
+    CmdChunkPoolStats* pStats)
+{
+    MutexAuto lock(&m_lock);
+
+    pStats->blockCount            = m_blockList.NumElements();
+    pStats->blockBytes            = pStats->blockCount * BlockSize;
+    pStats->suballocatedBytes     = m_suballocatedBytes;
+    pStats->peakSuballocatedBytes = m_peakSuballocatedBytes;
+    pStats->suballocCount         = m_suballocCount;
+    pStats->fallbackCount         = m_fallbackCount;
+}
+
+} // Pal
@@ -0,0 +1,125 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "core/gpuMemory.h"
+#include "palBuddyAllocator.h"
+#include "palList.h"
+#include "palMutex.h"
+
+namespace Pal
+{
+
+class Device;
+class Platform;
+
+// =====================================================================================================================
+// A device-wide pool which suballocates the GPU memory of command stream allocations out of a few large, huge-page
+// aligned GPU memory blocks instead of giving every command allocator its own small allocations. Because the blocks are
+// shared by all command allocators, this bounds the number of GPU memory objects in the internal reference list (and
+// thus in each submit's BO list) and turns most command allocation growth into a buddy suballocation.
+//
+// Like InternalMemMgr's pools, each block has a BuddyAllocator and only serves requests with identical memory
+// properties. Blocks are created with the device's internal memory manager's allocator lock held; they stay mapped for
+// their whole lifetime.
+class CmdChunkPool
+{
+public:
+    // Blocks are aligned to their size so that the OS can back them with huge pages.
+    static constexpr gpusize BlockSize = 2 * 1024 * 1024;
+
+    explicit CmdChunkPool(Device* pDevice);
+    ~CmdChunkPool() { FreeAllocations(); }
+
+    Result Init() { return m_lock.Init(); }
+    void FreeAllocations();
+
+    // Suballocates the GPU memory described by the create info. The caller must hold the internal memory manager's
+    // allocator lock. Returns ErrorOutOfGpuMemory if the request can't be pooled; the caller should then fall back to
+    // a dedicated allocation.
+    Result Allocate(
+        const GpuMemoryCreateInfo&         createInfo,
+        const GpuMemoryInternalCreateInfo& internalInfo,
+        bool                               cpuAccessible,
+        GpuMemory**                        ppGpuMemory,
+        gpusize*                           pOffset,
+        void**                             ppCpuAddr);
+
+    void Free(GpuMemory* pGpuMemory, gpusize offset, gpusize size);
+
+    // Counts a command stream allocation which was not given to the pool.
+    void RecordFallback() { Util::AtomicIncrement64(&m_fallbackCount); }
+
+    void GetStats(CmdChunkPoolStats* pStats);
+
+private:
+    struct Block
+    {
+        GpuMemory*                      pGpuMemory;
+        void*                           pCpuAddr;        // Null if the block isn't CPU accessible.
+        uint64                          pagingFence;     // Paging fence returned when the block was allocated.
+        size_t                          heapCount;
+        GpuHeap                         heaps[GpuHeapCount];
+        VaRange                         vaRange;
+        GpuMemPriority                  priority;
+        GpuMemPriorityOffset            priorityOffset;
+        uint32                          flags;           // GpuMemoryCreateInfo flags of the block.
+        MType                           mtype;
+        uint32                          internalFlags;   // GpuMemoryInternalCreateInfo flags of the block.
+        bool                            cpuAccessible;
+        bool                            hasPagingFence;  // The block was allocated with wait-on-submit residency.
+        Util::BuddyAllocator<Platform>* pBuddyAllocator;
+    };
+
+    typedef Util::List<Block, Platform> BlockList;
+
+    static bool IsMatchingBlock(
+        const Block&                       block,
+        const GpuMemoryCreateInfo&         createInfo,
+        const GpuMemoryInternalCreateInfo& internalInfo,
+        bool                               cpuAccessible);
+
+    Result CreateBlock(
+        const GpuMemoryCreateInfo&         createInfo,
+        const GpuMemoryInternalCreateInfo& internalInfo,
+        bool                               cpuAccessible,
+        Block*                             pBlock);
+    void DestroyBlock(Block* pBlock);
+
+    Device*const    m_pDevice;
+    Util::Mutex     m_lock;              // Protects the block list and the statistics below.
+    BlockList       m_blockList;
+    uint32          m_emptyBlockCount;   // Number of blocks with no suballocations, kept for future requests.
+    gpusize         m_suballocatedBytes;
+    gpusize         m_peakSuballocatedBytes;
+    uint64          m_suballocCount;
+    volatile uint64 m_fallbackCount;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(CmdChunkPool);
+    PAL_DISALLOW_DEFAULT_CTOR(CmdChunkPool);
+};
+
+} // Pal
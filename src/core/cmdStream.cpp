@@ -29,7 +29,7 @@
 #include "core/fence.h"
 #include "core/g_palSettings.h"
 #include "core/queue.h"
-#include "palFile.h"
+#include "palBufferedFile.h"
 #include "palHashMapImpl.h"
 #include "palLinearAllocator.h"
 #include "palVectorImpl.h"
@@ -689,7 +689,7 @@ gpusize CmdStream::GetCurrentGpuVa()
 // It is the callers responsibility to verify that pFile is pointing to an open file. "pHeader" should point to a
 // string of the format "text = ". It will be appended with the number of DWORDs associated with this stream.
 void CmdStream::DumpCommands(
-    File*            pFile,          // [in] pointer to an opened file object
+    BufferedFile*    pFile,          // [in] pointer to an opened file object
     const char*      pHeader,        // [in] pointer to a string that contains header info
     CmdBufDumpFormat mode            // [in] true if it's binary dump requested
     ) const
@@ -706,11 +706,17 @@ void CmdStream::DumpCommands(
         }
 
         // First, output the header information.
-        constexpr size_t MaxLineSize = 128;
-        char line[MaxLineSize];
+        result = pFile->PutString(pHeader);
 
-        Snprintf(line, MaxLineSize, "%s%llu\n", pHeader, streamSizeInDwords);
-        result = pFile->Write(line, strlen(line));
+        if (result == Result::Success)
+        {
+            result = pFile->PutUint(streamSizeInDwords);
+        }
+
+        if (result == Result::Success)
+        {
+            result = pFile->PutChar('\n');
+        }
     }
 
     uint32 subEngineId = 0; // DE subengine ID
@@ -33,7 +33,7 @@
 #include "palIntrusiveList.h"
 #include "palVector.h"
 
-namespace Util { class File; }
+namespace Util { class BufferedFile; }
 namespace Util { class VirtualLinearAllocator; }
 
 namespace Pal
@@ -217,7 +217,7 @@ public:
     uint32 GetSizeAlignDwords() const { return m_sizeAlignDwords; }
 
 #if PAL_ENABLE_PRINTS_ASSERTS
-    void DumpCommands(Util::File* pFile, const char* pHeader, CmdBufDumpFormat mode) const;
+    void DumpCommands(Util::BufferedFile* pFile, const char* pHeader, CmdBufDumpFormat mode) const;
 #endif
 
     void EnableDropIfSameContext(bool enable) { m_flags.dropIfSameContext = enable; }
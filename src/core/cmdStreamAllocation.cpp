@@ -28,7 +28,7 @@
 #include "core/internalMemMgr.h"
 #include "core/platform.h"
 #include "core/cmdBuffer.h"
-#include "palFile.h"
+#include "palBufferedFile.h"
 #include "palIntrusiveListImpl.h"
 #include "palSysMemory.h"
 
@@ -77,6 +77,8 @@ CmdStreamAllocation::CmdStreamAllocation(
     m_parentNode(this),
     m_pChunks(reinterpret_cast<CmdStreamChunk*>(this + 1)),
     m_pGpuMemory(nullptr),
+    m_poolOffset(0),
+    m_pooled(false),
     m_pCpuAddr(nullptr),
     m_pStaging(nullptr)
 {
@@ -113,16 +115,37 @@ Result CmdStreamAllocation::Init(
     }
     else
     {
-        // In CmdAllocator::CreateAllocation() the allocator lock is already accquired.
-        result = pDevice->MemMgr()->AllocateGpuMemNoAllocLock(m_createInfo.memObjCreateInfo,
-                                                              m_createInfo.memObjInternalInfo,
-                                                              false,
-                                                              &m_pGpuMemory,
-                                                              nullptr);
-
-        if ((result == Result::Success) && CpuAccessible())
+        if (m_createInfo.flags.usePool)
         {
-            result = m_pGpuMemory->Map(reinterpret_cast<void**>(&m_pCpuAddr));
+            // In CmdAllocator::CreateAllocation() the allocator lock is already accquired. If the pool can't serve
+            // this allocation we fall back to a dedicated GPU memory object.
+            result   = pDevice->GetCmdChunkPool()->Allocate(m_createInfo.memObjCreateInfo,
+                                                            m_createInfo.memObjInternalInfo,
+                                                            CpuAccessible(),
+                                                            &m_pGpuMemory,
+                                                            &m_poolOffset,
+                                                            reinterpret_cast<void**>(&m_pCpuAddr));
+            m_pooled = (result == Result::Success);
+
+            if (m_pooled == false)
+            {
+                pDevice->GetCmdChunkPool()->RecordFallback();
+            }
+        }
+
+        if (m_pooled == false)
+        {
+            // In CmdAllocator::CreateAllocation() the allocator lock is already accquired.
+            result = pDevice->MemMgr()->AllocateGpuMemNoAllocLock(m_createInfo.memObjCreateInfo,
+                                                                  m_createInfo.memObjInternalInfo,
+                                                                  false,
+                                                                  &m_pGpuMemory,
+                                                                  nullptr);
+
+            if ((result == Result::Success) && CpuAccessible())
+            {
+                result = m_pGpuMemory->Map(reinterpret_cast<void**>(&m_pCpuAddr));
+            }
         }
 
         if ((result == Result::Success) && m_createInfo.flags.enableStagingBuffer)
@@ -142,7 +165,7 @@ Result CmdStreamAllocation::Init(
     // We construct the chunks even if we've encountered an error because Destroy() requires us to have done so.
     uint32* pChunkCpuAddr   = m_pCpuAddr;
     uint32* pChunkWriteAddr = (m_pStaging != nullptr) ? m_pStaging : m_pCpuAddr;
-    size_t  byteOffset      = 0;
+    gpusize byteOffset      = m_poolOffset;
 
     for (uint32 idx = 0; idx < m_createInfo.numChunks; ++idx)
     {
@@ -169,7 +192,16 @@ void CmdStreamAllocation::Destroy(
         m_pChunks[idx].Destroy();
     }
 
-    if (m_pGpuMemory != nullptr)
+    if (m_pooled)
+    {
+        // The pool keeps its GPU memory mapped; just return our range to it.
+        pDevice->GetCmdChunkPool()->Free(m_pGpuMemory, m_poolOffset, m_createInfo.memObjCreateInfo.size);
+
+        m_pGpuMemory = nullptr;
+        m_pCpuAddr   = nullptr;
+        m_pooled     = false;
+    }
+    else if (m_pGpuMemory != nullptr)
     {
         if (m_pCpuAddr != nullptr)
         {
@@ -527,7 +559,7 @@ bool CmdStreamChunk::ContainsAddress(
 // =====================================================================================================================
 // Writes the commands in this chunk to the given file. Each DWORD is expressed in hex and printed on its own line.
 Result CmdStreamChunk::WriteCommandsToFile(
-    File*          pFile,
+    BufferedFile*  pFile,
     uint32         subEngineId,
     CmdBufDumpFormat mode
     ) const
@@ -537,29 +569,43 @@ Result CmdStreamChunk::WriteCommandsToFile(
     if ((mode == CmdBufDumpFormat::CmdBufDumpFormatBinary) ||
         (mode == CmdBufDumpFormat::CmdBufDumpFormatBinaryHeaders))
     {
-        if (mode == CmdBufDumpFormat::CmdBufDumpFormatBinaryHeaders)
+        const CmdBufferDumpHeader chunkheader =
         {
-            const CmdBufferDumpHeader chunkheader =
-            {
-                static_cast<uint32>(sizeof(CmdBufferDumpHeader)),
-                m_usedDataSizeDwords * static_cast<uint32>(sizeof(uint32)),
-                subEngineId
-            };
-            pFile->Write(&chunkheader, sizeof(chunkheader));
-        }
-        pFile->Write(m_pWriteAddr, m_usedDataSizeDwords * sizeof(uint32));
+            static_cast<uint32>(sizeof(CmdBufferDumpHeader)),
+            m_usedDataSizeDwords * static_cast<uint32>(sizeof(uint32)),
+            subEngineId
+        };
+
+        // Write the optional header and the chunk contents together so that large chunks go straight from the
+        // command memory to the OS without being copied into the file's staging buffer.
+        const FileSpan spans[] =
+        {
+            { &chunkheader,  sizeof(chunkheader) },
+            { m_pWriteAddr,  m_usedDataSizeDwords * sizeof(uint32) },
+        };
+
+        const bool   writeHeader = (mode == CmdBufDumpFormat::CmdBufDumpFormatBinaryHeaders);
+        const uint32 firstSpan   = writeHeader ? 0 : 1;
+
+        result = pFile->WriteVectored(&spans[firstSpan], static_cast<uint32>(ArrayLen(spans)) - firstSpan);
     }
     else
     {
-        constexpr uint32 MaxLineSize = 16;
-        char line[MaxLineSize];
-
         PAL_ASSERT(mode == CmdBufDumpFormat::CmdBufDumpFormatText);
 
         for (uint32 idx = 0; (idx < m_usedDataSizeDwords) && (result == Result::Success); ++idx)
         {
-            Snprintf(line, MaxLineSize, "0x%08x\n", m_pWriteAddr[idx]);
-            result = pFile->Write(line, strlen(line));
+            result = pFile->PutString("0x");
+
+            if (result == Result::Success)
+            {
+                result = pFile->PutHex(m_pWriteAddr[idx], 8);
+            }
+
+            if (result == Result::Success)
+            {
+                result = pFile->PutChar('\n');
+            }
         }
     }
 
@@ -33,7 +33,7 @@
 #include "palMutex.h"
 #include "palVector.h"
 
-namespace Util { class File; }
+namespace Util { class BufferedFile; }
 
 namespace Pal
 {
@@ -57,7 +57,9 @@ struct CmdStreamAllocationCreateInfo
                                                             // system memory and get dummy GPU memory from Device
         uint32                  cpuAccessible       :  1;   // True if this chunk should be CPU-accessible.  Only valid
                                                             // for "real" GPU memory allocations.
-        uint32                  reserved            : 29;
+        uint32                  usePool             :  1;   // True if the GPU memory should be suballocated from the
+                                                            // device's CmdChunkPool if possible.
+        uint32                  reserved            : 28;
     } flags;
 };
 
@@ -97,6 +99,9 @@ public:
     bool IsDummyAllocation() const { return (m_createInfo.flags.dummyAllocation != 0); }
     bool CpuAccessible() const { return (m_createInfo.flags.cpuAccessible != 0); }
 
+    // Returns true if the GPU memory is suballocated from the device's CmdChunkPool.
+    bool IsPooled() const { return m_pooled; }
+
 private:
     CmdStreamAllocation(const CmdStreamAllocationCreateInfo& createInfo);
     ~CmdStreamAllocation() {}
@@ -108,6 +113,8 @@ private:
     AllocList::Node      m_parentNode; // This allocation should always be owned by exactly one list using this node.
     CmdStreamChunk*const m_pChunks;    // This allocation has been split into these chunks.
     Pal::GpuMemory*      m_pGpuMemory; // The GPU memory object that backs this allocation.
+    gpusize              m_poolOffset; // Offset of this allocation within m_pGpuMemory if it is pooled.
+    bool                 m_pooled;     // If true, m_pGpuMemory belongs to the device's CmdChunkPool.
     uint32*              m_pCpuAddr;   // CPU virtual address of the mapped GPU allocation.
     uint32*              m_pStaging;   // If non-null, commands should be accumulated here until chunks are finalized.
 
@@ -199,7 +206,7 @@ public:
     bool ContainsAddress(const uint32* pAddress) const;
 
 #if PAL_ENABLE_PRINTS_ASSERTS
-    Result WriteCommandsToFile(Util::File* pFile, uint32 subEngineId, CmdBufDumpFormat mode) const;
+    Result WriteCommandsToFile(Util::BufferedFile* pFile, uint32 subEngineId, CmdBufDumpFormat mode) const;
 #endif
 
     // We need these intrusive getters so that we can apply the PM4 optimizer during finalization (and other things).
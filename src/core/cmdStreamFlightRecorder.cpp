@@ -0,0 +1,430 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/cmdBuffer.h"
+#include "core/cmdStream.h"
+#include "core/cmdStreamAllocation.h"
+#include "core/cmdStreamFlightRecorder.h"
+#include "core/device.h"
+#include "core/g_palSettings.h"
+#include "core/queue.h"
+#include "palBufferedFile.h"
+#include "palSysUtil.h"
+
+using namespace Util;
+
+namespace Pal
+{
+
+// The ring must have enough slots that two submissions in flight at once can never be assigned the same slot.
+constexpr uint32 MinSlotCount = 16;
+
+// Number of sampled DWORDs printed per line of a text dump.
+constexpr uint32 DwordsPerLine = 8;
+
+// =====================================================================================================================
+CmdStreamFlightRecorder::CmdStreamFlightRecorder(
+    Device* pDevice,
+    uint32  deviceIndex)
+    :
+    m_pDevice(pDevice),
+    m_deviceIndex(deviceIndex),
+    m_pHeader(nullptr),
+    m_slotSize(0),
+    m_slotCount(0),
+    m_copyBudgetDwords(0),
+    m_dumpCount(0),
+    m_lostDumpSubmitId(UINT64_MAX)
+{
+    m_fileName[0] = '\0';
+}
+
+// =====================================================================================================================
+CmdStreamFlightRecorder::~CmdStreamFlightRecorder()
+{
+    if (m_fileView.IsValid())
+    {
+        m_fileView.UnMap(false);
+    }
+}
+
+// =====================================================================================================================
+// Creates and maps the flight recorder file. The file is sized to hold as many submission slots as fit in the
+// CmdStreamFlightRecorderSize setting.
+Result CmdStreamFlightRecorder::Init()
+{
+    const PalSettings& settings = m_pDevice->Settings();
+
+    m_copyBudgetDwords = settings.cmdStreamFlightRecorderCopyBudget / sizeof(uint32);
+
+    const size_t slotSize = sizeof(FlightRecorderSubmit) +
+                            (sizeof(FlightRecorderChunk) * FlightRecorderMaxChunksPerSubmit) +
+                            (sizeof(uint32) * m_copyBudgetDwords);
+
+    m_slotSize = static_cast<uint32>(Pow2Align(slotSize, sizeof(uint64)));
+
+    if (settings.cmdStreamFlightRecorderSize > sizeof(FlightRecorderHeader))
+    {
+        m_slotCount = (settings.cmdStreamFlightRecorderSize - sizeof(FlightRecorderHeader)) / m_slotSize;
+    }
+
+    Result result = Result::Success;
+
+    if (m_slotCount < MinSlotCount)
+    {
+        PAL_ALERT_ALWAYS_MSG("CmdStreamFlightRecorderSize must hold at least %u submissions of %u bytes each.",
+                             MinSlotCount,
+                             m_slotSize);
+        result = Result::ErrorInvalidValue;
+    }
+
+    const size_t fileSize = sizeof(FlightRecorderHeader) + (static_cast<size_t>(m_slotSize) * m_slotCount);
+
+    if (result == Result::Success)
+    {
+        const char* pLogDir = &settings.cmdBufDumpDirectory[0];
+
+        // Create the directory. We don't care if it fails (existing is fine, failure is caught when creating the file).
+        MkDir(pLogDir);
+
+        // Include the process ID so that concurrently running applications don't share a file.
+        Snprintf(m_fileName, sizeof(m_fileName), "%s/cmdStreamFlightRecorder_%u_%u.bin",
+                 pLogDir,
+                 GetIdOfCurrentProcess(),
+                 m_deviceIndex);
+
+        result = m_fileMapping.Create(m_fileName, true, fileSize, nullptr);
+    }
+
+    if (result == Result::Success)
+    {
+        m_pHeader = static_cast<FlightRecorderHeader*>(m_fileView.Map(m_fileMapping, true, 0, fileSize));
+        result    = (m_pHeader != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+    }
+
+    if (result == Result::Success)
+    {
+        // The file may be left over from an earlier process with the same ID, so clear out any stale slots.
+        memset(m_pHeader, 0, fileSize);
+
+        m_pHeader->magic              = FlightRecorderMagic;
+        m_pHeader->version            = FlightRecorderVersion;
+        m_pHeader->headerSize         = sizeof(FlightRecorderHeader);
+        m_pHeader->slotSize           = m_slotSize;
+        m_pHeader->slotCount          = m_slotCount;
+        m_pHeader->maxChunksPerSubmit = FlightRecorderMaxChunksPerSubmit;
+        m_pHeader->familyId           = m_pDevice->ChipProperties().familyId;
+        m_pHeader->eRevId             = m_pDevice->ChipProperties().eRevId;
+        m_pHeader->cpuFrequency       = static_cast<uint64>(GetPerfFrequency());
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Returns the slot which holds (or will hold) the given submission.
+FlightRecorderSubmit* CmdStreamFlightRecorder::GetSlot(
+    uint64 submitId
+    ) const
+{
+    const size_t slotIdx = static_cast<size_t>((submitId - 1) % m_slotCount);
+
+    return static_cast<FlightRecorderSubmit*>(
+        VoidPtrInc(m_pHeader, sizeof(FlightRecorderHeader) + (slotIdx * m_slotSize)));
+}
+
+// =====================================================================================================================
+// Records a submission into the next slot of the ring. The cost is bounded: at most FlightRecorderMaxChunksPerSubmit
+// chunks are described and at most CmdStreamFlightRecorderCopyBudget bytes of command data are copied.
+void CmdStreamFlightRecorder::RecordSubmit(
+    const Queue&              queue,
+    const SubmitInfo&         submitInfo,
+    const InternalSubmitInfo& internalSubmitInfo)
+{
+    const uint64 submitId = AtomicIncrement64(&m_pHeader->lastSubmitId);
+
+    FlightRecorderSubmit*const pSubmit = GetSlot(submitId);
+
+    // Invalidate the slot before overwriting it so that a partially written slot is never mistaken for a complete one
+    // if the process dies mid-way.
+    AtomicExchange64(&pSubmit->submitId, 0);
+
+    uint32 totalChunks = 0;
+
+    for (uint32 idx = 0; idx < internalSubmitInfo.numPreambleCmdStreams; ++idx)
+    {
+        totalChunks += internalSubmitInfo.pPreambleCmdStream[idx]->GetNumChunks();
+    }
+
+    for (uint32 idxCmdBuf = 0; idxCmdBuf < submitInfo.cmdBufferCount; ++idxCmdBuf)
+    {
+        const auto*const pCmdBuffer = static_cast<CmdBuffer*>(submitInfo.ppCmdBuffers[idxCmdBuf]);
+
+        for (uint32 idxStream = 0; idxStream < pCmdBuffer->NumCmdStreams(); ++idxStream)
+        {
+            totalChunks += pCmdBuffer->GetCmdStream(idxStream)->GetNumChunks();
+        }
+    }
+
+    for (uint32 idx = 0; idx < internalSubmitInfo.numPostambleCmdStreams; ++idx)
+    {
+        totalChunks += internalSubmitInfo.pPostambleCmdStream[idx]->GetNumChunks();
+    }
+
+    SampleState state  = {};
+    state.pChunks      = reinterpret_cast<FlightRecorderChunk*>(pSubmit + 1);
+    state.pSamples     = reinterpret_cast<uint32*>(state.pChunks + FlightRecorderMaxChunksPerSubmit);
+    state.chunksLeft   = totalChunks;
+    state.budgetDwords = m_copyBudgetDwords;
+
+    for (uint32 idx = 0; idx < internalSubmitInfo.numPreambleCmdStreams; ++idx)
+    {
+        RecordCmdStream(*internalSubmitInfo.pPreambleCmdStream[idx], FlightRecorderPreamble, &state);
+    }
+
+    for (uint32 idxCmdBuf = 0; idxCmdBuf < submitInfo.cmdBufferCount; ++idxCmdBuf)
+    {
+        const auto*const pCmdBuffer = static_cast<CmdBuffer*>(submitInfo.ppCmdBuffers[idxCmdBuf]);
+
+        for (uint32 idxStream = 0; idxStream < pCmdBuffer->NumCmdStreams(); ++idxStream)
+        {
+            RecordCmdStream(*pCmdBuffer->GetCmdStream(idxStream), idxCmdBuf, &state);
+        }
+    }
+
+    for (uint32 idx = 0; idx < internalSubmitInfo.numPostambleCmdStreams; ++idx)
+    {
+        RecordCmdStream(*internalSubmitInfo.pPostambleCmdStream[idx], FlightRecorderPostamble, &state);
+    }
+
+    pSubmit->cpuTimestamp     = static_cast<uint64>(GetPerfCpuTime());
+    pSubmit->frameCount       = m_pDevice->GetFrameCount();
+    pSubmit->queueType        = static_cast<uint32>(queue.Type());
+    pSubmit->engineType       = static_cast<uint32>(queue.GetEngineType());
+    pSubmit->engineId         = queue.EngineId();
+    pSubmit->cmdBufferCount   = submitInfo.cmdBufferCount;
+    pSubmit->chunkCount       = state.chunkCount;
+    pSubmit->chunkRecordCount = state.chunkRecords;
+    pSubmit->sampleDwords     = m_copyBudgetDwords - state.budgetDwords;
+
+    // The atomic add is a full barrier, so the slot contents are written before the slot is marked valid.
+    AtomicAdd64(&pSubmit->submitId, submitId);
+}
+
+// =====================================================================================================================
+// Describes each chunk of a command stream and samples its leading command DWORDs. The remaining copy budget is split
+// evenly between the chunks which haven't been recorded yet so one huge chunk can't starve the rest of the submission;
+// whatever a small chunk doesn't use rolls over to the chunks after it.
+void CmdStreamFlightRecorder::RecordCmdStream(
+    const CmdStream& cmdStream,
+    uint32           cmdBufferIndex,
+    SampleState*     pState
+    ) const
+{
+    for (auto iter = cmdStream.GetFwdIterator(); iter.IsValid(); iter.Next())
+    {
+        const CmdStreamChunk*const pChunk = iter.Get();
+
+        PAL_ASSERT(pState->chunksLeft > 0);
+        const uint32 shareDwords = pState->budgetDwords / pState->chunksLeft;
+
+        pState->chunksLeft--;
+        pState->chunkCount++;
+
+        if (pState->chunkRecords < FlightRecorderMaxChunksPerSubmit)
+        {
+            const uint32 sampleDwords = Min(shareDwords, pChunk->CmdDwordsToExecute());
+
+            FlightRecorderChunk*const pRecord = &pState->pChunks[pState->chunkRecords++];
+
+            pRecord->gpuVirtAddr     = pChunk->GpuVirtAddr();
+            pRecord->allocatedDwords = pChunk->DwordsAllocated();
+            pRecord->executeDwords   = pChunk->CmdDwordsToExecute();
+            pRecord->sampleDwords    = sampleDwords;
+            pRecord->cmdBufferIndex  = cmdBufferIndex;
+            pRecord->subEngineType   = static_cast<uint32>(cmdStream.GetSubEngineType());
+            pRecord->reserved        = 0;
+
+            // Read from the write buffer: it is the same memory as the chunk unless staging buffers are enabled, in
+            // which case it is cacheable system memory and much cheaper to read than the GPU allocation.
+            memcpy(pState->pSamples, pChunk->WriteAddr(), sizeof(uint32) * sampleDwords);
+
+            pState->pSamples     += sampleDwords;
+            pState->budgetDwords -= sampleDwords;
+        }
+    }
+}
+
+// =====================================================================================================================
+// Writes the ring out once per device loss.  Every submit and fence wait that runs into a lost device reports it, so
+// the ring is only dumped again if something was submitted since the last device-lost dump.
+void CmdStreamFlightRecorder::DumpOnDeviceLost(
+    const char* pReason)
+{
+    const uint64 lastSubmitId = m_pHeader->lastSubmitId;
+
+    if (AtomicExchange64(&m_lostDumpSubmitId, lastSubmitId) != lastSubmitId)
+    {
+        Dump(pReason);
+    }
+}
+
+// =====================================================================================================================
+// Writes the contents of the ring, oldest submission first, to a text file in the command buffer dump directory.
+// Called when the device is lost, or on request.
+void CmdStreamFlightRecorder::Dump(
+    const char* pReason)
+{
+    const uint32 dumpIdx = AtomicIncrement(&m_dumpCount);
+
+    // Push the ring itself out to disk first in case the process doesn't survive long enough to write the text.
+    m_fileView.Flush(m_fileView.Size());
+
+    char fileName[256] = {};
+    Snprintf(fileName, sizeof(fileName), "%s/cmdStreamFlightRecorder_%u_%u_%u.txt",
+             &m_pDevice->Settings().cmdBufDumpDirectory[0],
+             GetIdOfCurrentProcess(),
+             m_deviceIndex,
+             dumpIdx);
+
+    BufferedFile dumpFile;
+    Result result = dumpFile.Open(&fileName[0], FileAccessMode::FileAccessWrite);
+
+    if (result == Result::Success)
+    {
+        const uint64 lastId  = m_pHeader->lastSubmitId;
+        const uint64 firstId = (lastId > m_slotCount) ? (lastId - m_slotCount + 1) : 1;
+
+        result = dumpFile.Printf("# Command stream flight recorder: %s\n", pReason);
+
+        if (result == Result::Success)
+        {
+            result = dumpFile.Printf("# Family %u, revision %u, submissions %llu to %llu\n",
+                                     m_pHeader->familyId,
+                                     m_pHeader->eRevId,
+                                     firstId,
+                                     lastId);
+        }
+
+        for (uint64 submitId = firstId; (submitId <= lastId) && (result == Result::Success); ++submitId)
+        {
+            const FlightRecorderSubmit& submit = *GetSlot(submitId);
+
+            if (submit.submitId == submitId)
+            {
+                result = DumpSubmit(submit, &dumpFile);
+            }
+            else
+            {
+                // Either still being recorded or overwritten while we were dumping.
+                result = dumpFile.Printf("\nSubmit %llu: incomplete\n", submitId);
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            result = dumpFile.Flush();
+        }
+
+        dumpFile.Close();
+    }
+
+    PAL_ALERT_MSG(result != Result::Success, "Failed to write flight recorder dump file '%s'", fileName);
+}
+
+// =====================================================================================================================
+// Writes a single submission to a text dump.
+Result CmdStreamFlightRecorder::DumpSubmit(
+    const FlightRecorderSubmit& submit,
+    BufferedFile*               pFile
+    ) const
+{
+    const double cpuTimeMs = (1000.0 * submit.cpuTimestamp) / m_pHeader->cpuFrequency;
+
+    Result result = pFile->Printf("\nSubmit %llu: frame %u, CPU time %.3f ms, queue type %u, engine type %u, "
+                                  "engine %u, %u command buffers, %u chunks (%u recorded)\n",
+                                  submit.submitId,
+                                  submit.frameCount,
+                                  cpuTimeMs,
+                                  submit.queueType,
+                                  submit.engineType,
+                                  submit.engineId,
+                                  submit.cmdBufferCount,
+                                  submit.chunkCount,
+                                  submit.chunkRecordCount);
+
+    const auto*const pChunks  = reinterpret_cast<const FlightRecorderChunk*>(&submit + 1);
+    const uint32*    pSamples = reinterpret_cast<const uint32*>(pChunks + FlightRecorderMaxChunksPerSubmit);
+
+    for (uint32 chunkIdx = 0; (chunkIdx < submit.chunkRecordCount) && (result == Result::Success); ++chunkIdx)
+    {
+        const FlightRecorderChunk& chunk = pChunks[chunkIdx];
+
+        if (chunk.cmdBufferIndex == FlightRecorderPreamble)
+        {
+            result = pFile->PutString("  Preamble");
+        }
+        else if (chunk.cmdBufferIndex == FlightRecorderPostamble)
+        {
+            result = pFile->PutString("  Postamble");
+        }
+        else
+        {
+            result = pFile->Printf("  CmdBuffer %u", chunk.cmdBufferIndex);
+        }
+
+        if (result == Result::Success)
+        {
+            result = pFile->Printf(" sub-engine %u: VA 0x%016llx, %u DWORDs allocated, %u executed, %u sampled\n",
+                                   chunk.subEngineType,
+                                   chunk.gpuVirtAddr,
+                                   chunk.allocatedDwords,
+                                   chunk.executeDwords,
+                                   chunk.sampleDwords);
+        }
+
+        for (uint32 idx = 0; (idx < chunk.sampleDwords) && (result == Result::Success); ++idx)
+        {
+            result = pFile->PutString(((idx % DwordsPerLine) == 0) ? "    0x" : " 0x");
+
+            if (result == Result::Success)
+            {
+                result = pFile->PutHex(pSamples[idx], 8);
+            }
+
+            if ((result == Result::Success) &&
+                (((idx % DwordsPerLine) == (DwordsPerLine - 1)) || (idx == (chunk.sampleDwords - 1))))
+            {
+                result = pFile->PutChar('\n');
+            }
+        }
+
+        pSamples += chunk.sampleDwords;
+    }
+
+    return result;
+}
+
+} // Pal
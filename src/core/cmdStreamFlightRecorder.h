@@ -0,0 +1,152 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "pal.h"
+#include "palFileMap.h"
+
+namespace Util { class BufferedFile; }
+
+namespace Pal
+{
+
+class  CmdStream;
+class  Device;
+class  Queue;
+struct InternalSubmitInfo;
+struct SubmitInfo;
+
+// The flight recorder is a memory-mapped file holding a ring of fixed-size slots, one per submission. Because the
+// file is mapped shared, its contents survive the process crashing and can be inspected post-mortem; it is also
+// converted to a readable text file when the device is lost. All multi-byte values are little-endian.
+constexpr uint32 FlightRecorderMagic   = 0x43524650; // 'PFRC'
+constexpr uint32 FlightRecorderVersion = 1;
+
+// Maximum number of command chunks described per submission. Any further chunks are only counted.
+constexpr uint32 FlightRecorderMaxChunksPerSubmit = 64;
+
+// Special values of FlightRecorderChunk::cmdBufferIndex for chunks which don't belong to a client command buffer.
+constexpr uint32 FlightRecorderPreamble  = 0xFFFFFFFE;
+constexpr uint32 FlightRecorderPostamble = 0xFFFFFFFF;
+
+// Header at the start of the flight recorder file.
+struct FlightRecorderHeader
+{
+    uint32          magic;              // FlightRecorderMagic.
+    uint32          version;            // FlightRecorderVersion.
+    uint32          headerSize;         // Size of this header; the first slot starts immediately after it.
+    uint32          slotSize;           // Size in bytes of each submission slot.
+    uint32          slotCount;          // Number of submission slots in the ring.
+    uint32          maxChunksPerSubmit; // Number of FlightRecorderChunk entries in each slot.
+    uint32          familyId;           // ASIC family.
+    uint32          eRevId;             // ASIC revision.
+    uint64          cpuFrequency;       // Frequency of the submission CPU timestamps, in ticks per second.
+    volatile uint64 lastSubmitId;       // ID of the most recently started submission. Submission N lives in slot
+                                        // (N - 1) % slotCount.
+};
+
+// Each slot starts with this structure, followed by maxChunksPerSubmit FlightRecorderChunk entries, followed by the
+// sampled command DWORDs of all recorded chunks, in chunk order.
+struct FlightRecorderSubmit
+{
+    volatile uint64 submitId;         // Submission ID, or zero if the slot is empty or being written.
+    uint64          cpuTimestamp;     // CPU timestamp taken when the submission was recorded.
+    uint32          frameCount;       // Device frame count at submission time.
+    uint32          queueType;        // QueueType of the submitting queue.
+    uint32          engineType;       // EngineType of the submitting queue.
+    uint32          engineId;         // Engine instance of the submitting queue.
+    uint32          cmdBufferCount;   // Number of client command buffers in the submission.
+    uint32          chunkCount;       // Total number of command chunks submitted.
+    uint32          chunkRecordCount; // Number of valid FlightRecorderChunk entries.
+    uint32          sampleDwords;     // Total number of sampled command DWORDs following the chunk entries.
+};
+
+// Describes a single submitted command chunk.
+struct FlightRecorderChunk
+{
+    gpusize gpuVirtAddr;      // GPU virtual address of the chunk.
+    uint32  allocatedDwords;  // Number of DWORDs of commands and embedded data in the chunk.
+    uint32  executeDwords;    // Number of command DWORDs the GPU executes from the start of the chunk.
+    uint32  sampleDwords;     // Number of leading DWORDs of this chunk copied into the sample area.
+    uint32  cmdBufferIndex;   // Index of the owning command buffer, or FlightRecorderPreamble/Postamble.
+    uint32  subEngineType;    // SubEngineType of the owning command stream.
+    uint32  reserved;
+};
+
+// =====================================================================================================================
+// Records a bounded summary of every submission on a device into a crash-persistent ring so that the last few
+// submissions can be examined after a hang or device loss. Recording is lock-free so queues on different threads can
+// submit concurrently: each submission claims its own slot with an atomic increment and marks it valid once complete.
+class CmdStreamFlightRecorder
+{
+public:
+    CmdStreamFlightRecorder(Device* pDevice, uint32 deviceIndex);
+    ~CmdStreamFlightRecorder();
+
+    Result Init();
+
+    void RecordSubmit(
+        const Queue&              queue,
+        const SubmitInfo&         submitInfo,
+        const InternalSubmitInfo& internalSubmitInfo);
+
+    void Dump(const char* pReason);
+    void DumpOnDeviceLost(const char* pReason);
+
+private:
+    struct SampleState
+    {
+        FlightRecorderChunk* pChunks;         // Chunk entries of the slot being written.
+        uint32*              pSamples;        // Next free DWORD in the slot's sample area.
+        uint32               chunkCount;      // Total number of chunks seen so far.
+        uint32               chunkRecords;    // Number of chunk entries written so far.
+        uint32               chunksLeft;      // Number of chunks in the submission not yet seen.
+        uint32               budgetDwords;    // Sample DWORDs still available for this submission.
+    };
+
+    void RecordCmdStream(const CmdStream& cmdStream, uint32 cmdBufferIndex, SampleState* pState) const;
+    Result DumpSubmit(const FlightRecorderSubmit& submit, Util::BufferedFile* pFile) const;
+
+    FlightRecorderSubmit* GetSlot(uint64 submitId) const;
+
+    Device*const          m_pDevice;
+    const uint32          m_deviceIndex;      // Distinguishes the files of multiple devices in one process.
+    FlightRecorderHeader* m_pHeader;          // Start of the mapped file.
+    uint32                m_slotSize;
+    uint32                m_slotCount;
+    uint32                m_copyBudgetDwords; // Maximum number of command DWORDs sampled per submission.
+    volatile uint32       m_dumpCount;        // Number of text dumps written so far.
+    volatile uint64       m_lostDumpSubmitId; // Last submission ID covered by a device-lost dump.
+
+    Util::FileMapping     m_fileMapping;
+    Util::FileView        m_fileView;
+    char                  m_fileName[256];    // m_fileMapping keeps a pointer to this name.
+
+    PAL_DISALLOW_DEFAULT_CTOR(CmdStreamFlightRecorder);
+    PAL_DISALLOW_COPY_AND_ASSIGN(CmdStreamFlightRecorder);
+};
+
+} // Pal
@@ -25,9 +25,11 @@
 
 #include "core/cmdAllocator.h"
 #include "core/cmdBuffer.h"
+#include "core/cmdStreamFlightRecorder.h"
 #include "core/device.h"
 #include "core/engine.h"
 #include "core/fence.h"
+#include "core/fenceNotifier.h"
 #include "core/gpuEvent.h"
 #include "core/image.h"
 #include "core/masterQueueSemaphore.h"
@@ -216,6 +218,7 @@ Device::Device(
     :
     m_pPlatform(pPlatform),
     m_memMgr(this),
+    m_cmdChunkPool(this),
     m_connectedPrivateScreens(0),
     m_emulatedPrivateScreens(0),
     m_emulatedTargetId(UINT_MAX),
@@ -223,6 +226,8 @@ Device::Device(
     m_pGfxDevice(nullptr),
     m_pOssDevice(nullptr),
     m_pTextWriter(nullptr),
+    m_pFlightRecorder(nullptr),
+    m_pFenceNotifier(nullptr),
     m_devDriverClientId(0),
     m_pFormatPropertiesTable(nullptr),
     m_perPipelineBindPointGds(false),
@@ -369,6 +374,11 @@ Result Device::Cleanup()
         PAL_SAFE_DELETE(m_pTextWriter, m_pPlatform);
     }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    PAL_SAFE_DELETE(m_pFenceNotifier, m_pPlatform);
+#endif
+    PAL_SAFE_DELETE(m_pFlightRecorder, m_pPlatform);
+
     for (uint32 engineType = 0; engineType < EngineTypeCount; engineType++)
     {
         PAL_SAFE_DELETE(m_pDummyCommandStreams[engineType], m_pPlatform);
@@ -421,6 +431,20 @@ Result Device::Cleanup()
         }
     }
 
+#if PAL_ENABLE_PRINTS_ASSERTS
+    CmdChunkPoolStats poolStats = {};
+    m_cmdChunkPool.GetStats(&poolStats);
+
+    PAL_DPINFO("Command chunk pool: %u blocks, peak %llu bytes suballocated, %llu pooled / %llu unpooled allocations",
+               poolStats.blockCount,
+               static_cast<unsigned long long>(poolStats.peakSuballocatedBytes),
+               static_cast<unsigned long long>(poolStats.suballocCount),
+               static_cast<unsigned long long>(poolStats.fallbackCount));
+#endif
+
+    // All command allocators are gone, so the command chunk pool's blocks can be freed.
+    m_cmdChunkPool.FreeAllocations();
+
     // NOTE: Explicitly free all internal GPU memory. Any child object which needs to free GPU memory MUST be torn
     // down before this!
     m_memMgr.FreeAllocations();
@@ -456,6 +480,11 @@ Result Device::EarlyInit(
     // video memory!
     Result result = m_memMgr.Init();
 
+    if (result == Result::Success)
+    {
+        result = m_cmdChunkPool.Init();
+    }
+
     if (result == Result::Success)
     {
         m_referencedGpuMemLock.Init();
@@ -471,6 +500,11 @@ Result Device::EarlyInit(
         result = m_queueLock.Init();
     }
 
+    if (result == Result::Success)
+    {
+        result = m_fenceNotifierLock.Init();
+    }
+
     if (result == Result::Success)
     {
         result = OsEarlyInit();
@@ -1503,6 +1537,19 @@ Result Device::Finalize(
         result        = (m_pTextWriter != nullptr) ? m_pTextWriter->Init() : Result::ErrorOutOfMemory;
     }
 
+    // The flight recorder is a debugging aid, so failing to create it shouldn't fail the device.
+    if ((result == Result::Success) && (Settings().cmdStreamFlightRecorderSize > 0))
+    {
+        m_pFlightRecorder = PAL_NEW(CmdStreamFlightRecorder, m_pPlatform, AllocInternal)(this, m_deviceIndex);
+
+        if ((m_pFlightRecorder != nullptr) && (m_pFlightRecorder->Init() != Result::Success))
+        {
+            PAL_SAFE_DELETE(m_pFlightRecorder, m_pPlatform);
+        }
+
+        PAL_ALERT(m_pFlightRecorder == nullptr);
+    }
+
     m_texOptLevel = finalizeInfo.internalTexOptLevel;
 
 #if PAL_ENABLE_PRINTS_ASSERTS
@@ -2454,9 +2501,101 @@ Result Device::WaitForFences(
                                       timeoutInNs);
     }
 
+    if ((result == Result::ErrorDeviceLost) && (m_pFlightRecorder != nullptr))
+    {
+        m_pFlightRecorder->DumpOnDeviceLost("device lost while waiting for fences");
+    }
+
     return result;
 }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+// =====================================================================================================================
+// Registers a callback with this device's fence notifier, creating the notifier if this is the first registration.
+// NOTE: Part of the public IDevice interface.
+Result Device::RegisterFenceCallback(
+    const IFence*     pFence,
+    FenceCallbackFunc pfnCallback,
+    void*             pUserData)
+{
+    Result result = Result::ErrorInvalidPointer;
+
+    if ((pFence != nullptr) && (pfnCallback != nullptr))
+    {
+        MutexAuto lock(&m_fenceNotifierLock);
+
+        result = Result::Success;
+
+        if (m_pFenceNotifier == nullptr)
+        {
+            FenceNotifier* pFenceNotifier = PAL_NEW(FenceNotifier, m_pPlatform, AllocInternal)(this);
+            result = (pFenceNotifier != nullptr) ? pFenceNotifier->Init() : Result::ErrorOutOfMemory;
+
+            if (result == Result::Success)
+            {
+                m_pFenceNotifier = pFenceNotifier;
+            }
+            else
+            {
+                PAL_SAFE_DELETE(pFenceNotifier, m_pPlatform);
+            }
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        // The notifier is never destroyed before the device, so it can be used without holding the lock.
+        result = m_pFenceNotifier->RegisterCallback(static_cast<const Fence*>(pFence), pfnCallback, pUserData);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Cancels a callback which was registered with this device's fence notifier.
+// NOTE: Part of the public IDevice interface.
+Result Device::UnregisterFenceCallback(
+    const IFence*     pFence,
+    FenceCallbackFunc pfnCallback,
+    void*             pUserData)
+{
+    Result result = Result::ErrorInvalidPointer;
+
+    if ((pFence != nullptr) && (pfnCallback != nullptr))
+    {
+        MutexAuto lock(&m_fenceNotifierLock);
+
+        result = (m_pFenceNotifier != nullptr) ? Result::Success : Result::NotFound;
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_pFenceNotifier->UnregisterCallback(static_cast<const Fence*>(pFence), pfnCallback, pUserData);
+    }
+
+    return result;
+}
+#endif
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 551
+// =====================================================================================================================
+// NOTE: Part of the public IDevice interface.
+Result Device::GetCmdChunkPoolStats(
+    CmdChunkPoolStats* pStats)
+{
+    Result result = Result::ErrorInvalidPointer;
+
+    if (pStats != nullptr)
+    {
+        m_cmdChunkPool.GetStats(pStats);
+
+        result = Result::Success;
+    }
+
+    return result;
+}
+#endif
+
 // =====================================================================================================================
 // Determines the size in bytes of a CmdAllocator object.
 // NOTE: Part of the public IDevice interface.
@@ -4355,6 +4494,12 @@ void Device::IncFrameCount()
 #if PAL_ENABLE_PRINTS_ASSERTS
     // Force command buffer dumping on for the next frame if the user is currently holding Shift-F10.
     m_cmdBufDumpEnabled = IsKeyPressed(KeyCode::Shift_F10);
+
+    // The same key also writes out the flight recorder, so that it can be inspected without waiting for a hang.
+    if (m_cmdBufDumpEnabled && (m_pFlightRecorder != nullptr))
+    {
+        m_pFlightRecorder->Dump("requested");
+    }
 #endif
     Util::AtomicIncrement(&m_frameCnt);
 }
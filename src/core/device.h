@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include "core/cmdChunkPool.h"
 #include "core/image.h"
 #include "core/internalMemMgr.h"
 #include "core/privateScreen.h"
@@ -58,6 +59,8 @@ namespace Pal
 
 class  CmdAllocator;
 class  CmdBuffer;
+class  CmdStreamFlightRecorder;
+class  FenceNotifier;
 class  Fence;
 class  GpuMemory;
 class  OssDevice;
@@ -1074,6 +1077,25 @@ public:
         bool                waitAll,
         uint64              timeout) const override;
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    // NOTE: Part of the public IDevice interface.
+    virtual Result RegisterFenceCallback(
+        const IFence*     pFence,
+        FenceCallbackFunc pfnCallback,
+        void*             pUserData) override;
+
+    // NOTE: Part of the public IDevice interface.
+    virtual Result UnregisterFenceCallback(
+        const IFence*     pFence,
+        FenceCallbackFunc pfnCallback,
+        void*             pUserData) override;
+#endif
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 551
+    virtual Result GetCmdChunkPoolStats(
+        CmdChunkPoolStats* pStats) override;
+#endif
+
     // Queries the size of a GpuMemory object, in bytes.
     virtual size_t GpuMemoryObjectSize() const = 0;
 
@@ -1543,6 +1565,7 @@ public:
     SchedulerMode GetSchedulerMode() const { return m_hwsInfo.mode; }
 
     InternalMemMgr* MemMgr() { return &m_memMgr; }
+    CmdChunkPool* GetCmdChunkPool() { return &m_cmdChunkPool; }
 
     // Returns the internal tracked command allocator except for engines that do not support tracking.
     CmdAllocator* InternalCmdAllocator(EngineType engineType) const
@@ -1686,6 +1709,9 @@ public:
     uint32 GetFrameCount() const { return m_frameCnt; }
     void IncFrameCount();
 
+    // Returns the command stream flight recorder, or null if CmdStreamFlightRecorderSize is zero.
+    CmdStreamFlightRecorder* FlightRecorder() const { return m_pFlightRecorder; }
+
     ImageTexOptLevel TexOptLevel() const { return m_texOptLevel; }
 
     void ApplyDevOverlay(const IImage& dstImage, ICmdBuffer* pCmdBuffer) const;
@@ -1849,6 +1875,7 @@ protected:
 
     Platform*      m_pPlatform;
     InternalMemMgr m_memMgr;
+    CmdChunkPool   m_cmdChunkPool; // Must be destroyed before m_memMgr.
 
     // An array stores enumerated private screens info and only m_connectedPrivateScreens out of them are valid.
     PrivateScreenCreateInfo m_privateScreenInfo[MaxPrivateScreens];
@@ -1873,6 +1900,9 @@ protected:
     OssDevice*         m_pOssDevice;
 
     GpuUtil::TextWriter<Platform>*     m_pTextWriter;
+    CmdStreamFlightRecorder*           m_pFlightRecorder;
+    FenceNotifier*                     m_pFenceNotifier;     // Created by the first fence callback registration.
+    Util::Mutex                        m_fenceNotifierLock;  // Serializes creation of m_pFenceNotifier.
     uint32                             m_devDriverClientId;
 
     FlglState                          m_flglState;
@@ -473,6 +473,9 @@ void DmaCmdBuffer::CmdCopyMemory(
     uint32                  regionCount,
     const MemoryCopyRegion* pRegions)
 {
+    TrackMemRef(srcGpuMemory);
+    TrackMemRef(dstGpuMemory);
+
     uint32* pCmdSpace = nullptr;
     uint32* pPredCmd  = nullptr;
 
@@ -555,6 +558,9 @@ void DmaCmdBuffer::CmdCopyTypedBuffer(
     uint32                       regionCount,
     const TypedBufferCopyRegion* pRegions)
 {
+    TrackMemRef(srcGpuMemory);
+    TrackMemRef(dstGpuMemory);
+
     uint32* pCmdSpace = nullptr;
     uint32* pPredCmd = nullptr;
 
@@ -825,6 +831,9 @@ void DmaCmdBuffer::CmdCopyImage(
     const ImageCopyRegion* pRegions,
     uint32                 flags)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstImage);
+
     uint32* pCmdSpace = nullptr;
     uint32* pPredCmd  = nullptr;
 
@@ -1019,6 +1028,9 @@ void DmaCmdBuffer::CmdCopyMemoryToImage(
     uint32                       regionCount,
     const MemoryImageCopyRegion* pRegions)
 {
+    TrackMemRef(srcGpuMemory);
+    TrackMemRef(dstImage);
+
     uint32* pCmdSpace = nullptr;
     uint32* pPredCmd  = nullptr;
 
@@ -1147,6 +1159,9 @@ void DmaCmdBuffer::CmdCopyImageToMemory(
     uint32                       regionCount,
     const MemoryImageCopyRegion* pRegions)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstGpuMemory);
+
     uint32* pCmdSpace = nullptr;
     uint32* pPredCmd  = nullptr;
 
@@ -1275,6 +1290,9 @@ void DmaCmdBuffer::CmdCopyMemoryToTiledImage(
     uint32                            regionCount,
     const MemoryTiledImageCopyRegion* pRegions)
 {
+    TrackMemRef(srcGpuMemory);
+    TrackMemRef(dstImage);
+
     AutoBuffer<MemoryImageCopyRegion, 8, Platform> copyRegions(regionCount, m_pDevice->GetPlatform());
 
     if (copyRegions.Capacity() < regionCount)
@@ -1313,6 +1331,9 @@ void DmaCmdBuffer::CmdCopyTiledImageToMemory(
     uint32                            regionCount,
     const MemoryTiledImageCopyRegion* pRegions)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstGpuMemory);
+
     AutoBuffer<MemoryImageCopyRegion, 8, Platform> copyRegions(regionCount, m_pDevice->GetPlatform());
 
     if (copyRegions.Capacity() < regionCount)
@@ -1350,6 +1371,8 @@ void DmaCmdBuffer::CmdFillMemory(
     gpusize           fillSize,
     uint32            data)
 {
+    TrackMemRef(dstGpuMemory);
+
     gpusize dstAddr = dstGpuMemory.Desc().gpuVirtAddr + dstOffset;
 
     // Both the destination address and the fillSize need to be dword aligned, so verify that here.
@@ -1385,6 +1408,16 @@ void DmaCmdBuffer::CmdSetPredication(
     bool                waitResults,
     bool                accumulateData)
 {
+    if (pQueryPool != nullptr)
+    {
+        TrackMemRef(*pQueryPool);
+    }
+
+    if (pGpuMemory != nullptr)
+    {
+        TrackMemRef(*pGpuMemory);
+    }
+
     PAL_ASSERT(pQueryPool == nullptr);
 
     // On DMA queue, this is the only supported predication
@@ -1411,6 +1444,7 @@ void DmaCmdBuffer::CmdExecuteNestedCmdBuffers(
 
         const bool exclusiveSubmit = cmdBuffer.IsExclusiveSubmit();
 
+        TrackMemRefs(cmdBuffer);
         m_cmdStream.TrackNestedEmbeddedData(cmdBuffer.m_embeddedData.chunkList);
         m_cmdStream.TrackNestedCommands(cmdBuffer.m_cmdStream);
 
@@ -1544,7 +1578,7 @@ void DmaCmdBuffer::SetupDmaTypedBufferCopyInfo(
 // =====================================================================================================================
 // Dumps this command buffer's single command stream to the given file with an appropriate header.
 void DmaCmdBuffer::DumpCmdStreamsToFile(
-    File*          pFile,
+    BufferedFile*  pFile,
     CmdBufDumpFormat mode
     ) const
 {
@@ -1896,6 +1930,8 @@ void DmaCmdBuffer::CmdUpdateBusAddressableMemoryMarker(
     gpusize           offset,
     uint32            value)
 {
+    TrackMemRef(dstGpuMemory);
+
     CmdWriteImmediate(Pal::HwPipePoint::HwPipeBottom,
                       value,
                       Pal::ImmediateDataWidth::ImmediateData32Bit,
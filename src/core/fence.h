@@ -64,6 +64,9 @@ public:
 
     virtual Result Reset() = 0;
 
+    // Signals the fence from the CPU, which counts as a submission. Not all fence types support this.
+    virtual Result Signal() { return Result::Unsupported; }
+
     bool InitialState() const                { return (m_fenceState.initialSignalState != 0); }
     bool WasNeverSubmitted() const           { return (m_fenceState.neverSubmitted != 0); }
     bool WasPrivateScreenPresentUsed() const { return (m_fenceState.privateScreenPresentUsed != 0); }
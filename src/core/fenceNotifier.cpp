@@ -0,0 +1,414 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+
+#include "core/device.h"
+#include "core/fence.h"
+#include "core/fenceNotifier.h"
+#include "core/platform.h"
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+using namespace Util;
+
+namespace Pal
+{
+
+// Timeout value which makes ConditionVariable::Wait() wait forever.
+constexpr uint32 InfiniteWait = 0xFFFFFFFF;
+
+// If the device's fences can't be signaled from the CPU, the kernel fence wait can't be interrupted when a new callback
+// is registered, so the worker waits in slices of this many nanoseconds while any callbacks are pending. This bounds
+// how late a newly registered fence can be noticed.
+constexpr uint64 WaitSliceNs = 2000000;
+
+// Timeout value which makes Fence::WaitForFences() wait forever.
+constexpr uint64 InfiniteWaitNs = UINT64_MAX;
+
+// =====================================================================================================================
+FenceNotifier::FenceNotifier(
+    Device* pDevice)
+    :
+    m_pDevice(pDevice),
+    m_registrations(pDevice->GetPlatform()),
+    m_exit(false),
+    m_pWakeFence(nullptr),
+    m_completed(pDevice->GetPlatform()),
+    m_numInvoked(0),
+    m_invoking(false),
+    m_callbacksStarted(0),
+    m_waitList(pDevice->GetPlatform())
+{
+}
+
+// =====================================================================================================================
+FenceNotifier::~FenceNotifier()
+{
+    {
+        MutexAuto lock(&m_lock);
+        m_exit = true;
+
+        if (m_worker.IsCreated())
+        {
+            m_workerCond.WakeOne();
+            WakeWorker();
+        }
+    }
+
+    if (m_worker.IsCreated())
+    {
+        m_worker.Join();
+    }
+
+    // Nobody will ever wait on the remaining fences, so tell their owners that they won't be signaled by us.
+    NotifyCompleted(true, Result::ErrorUnavailable);
+
+    if (m_pWakeFence != nullptr)
+    {
+        m_pWakeFence->DestroyInternal(m_pDevice->GetPlatform());
+        m_pWakeFence = nullptr;
+    }
+}
+
+// =====================================================================================================================
+Result FenceNotifier::Init()
+{
+    Result result = m_lock.Init();
+
+    if (result == Result::Success)
+    {
+        result = m_workerCond.Init();
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_callbackCond.Init();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Creates the wake fence and starts the worker thread if that hasn't been done yet. Must be called with m_lock held.
+Result FenceNotifier::StartWorker()
+{
+    Result result = Result::Success;
+
+    if (m_worker.IsCreated() == false)
+    {
+        FenceCreateInfo createInfo = {};
+        Fence*          pWakeFence = nullptr;
+
+        // Only keep the wake fence if the CPU can signal it. Otherwise the worker falls back to waiting in slices.
+        if (m_pDevice->CreateInternalFence(createInfo, &pWakeFence) == Result::Success)
+        {
+            if ((pWakeFence->Signal() == Result::Success) && (pWakeFence->Reset() == Result::Success))
+            {
+                m_pWakeFence = pWakeFence;
+            }
+            else
+            {
+                pWakeFence->DestroyInternal(m_pDevice->GetPlatform());
+            }
+        }
+
+        result = m_worker.Begin(&WorkerThreadFunc, this);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Interrupts the worker's fence wait, if it's in one, so that it picks up changes to m_registrations or m_exit. Must be
+// called with m_lock held.
+void FenceNotifier::WakeWorker()
+{
+    if (m_pWakeFence != nullptr)
+    {
+        const Result result = m_pWakeFence->Signal();
+        PAL_ASSERT(result == Result::Success);
+    }
+}
+
+// =====================================================================================================================
+// Returns true if any callback registered on pFence hasn't returned yet. Must be called with m_lock held.
+bool FenceNotifier::IsFencePending(
+    const Fence* pFence
+    ) const
+{
+    bool isPending = false;
+
+    for (uint32 idx = 0; (isPending == false) && (idx < m_registrations.NumElements()); ++idx)
+    {
+        isPending = (m_registrations.At(idx).pFence == pFence);
+    }
+
+    // This includes the callback which is running right now, if any.
+    const uint32 firstPending = m_invoking ? (m_numInvoked - 1) : m_numInvoked;
+
+    for (uint32 idx = firstPending; (isPending == false) && (idx < m_completed.NumElements()); ++idx)
+    {
+        isPending = (m_completed.At(idx).pFence == pFence) && (m_completed.At(idx).pfnCallback != nullptr);
+    }
+
+    return isPending;
+}
+
+// =====================================================================================================================
+// Registers a callback to be invoked once pFence is signaled. If the fence is already signaled the callback is invoked
+// immediately on the calling thread; otherwise it will be invoked on the worker thread.
+Result FenceNotifier::RegisterCallback(
+    const Fence*      pFence,
+    FenceCallbackFunc pfnCallback,
+    void*             pUserData)
+{
+    Result result    = pFence->GetStatus();
+    bool   invokeNow = false;
+
+    if ((result == Result::Success) || (result == Result::NotReady))
+    {
+        MutexAuto lock(&m_lock);
+
+        // Callbacks on one fence are invoked in registration order, so even if the fence is signaled this callback has
+        // to go through the worker when earlier callbacks on the same fence are still queued there.
+        invokeNow = (result == Result::Success) && (IsFencePending(pFence) == false);
+
+        if (invokeNow == false)
+        {
+            // Don't spend a thread or a fence on devices which never wait on anything.
+            result = StartWorker();
+
+            if (result == Result::Success)
+            {
+                const Registration registration = { pFence, pfnCallback, pUserData, Result::NotReady };
+                result = m_registrations.PushBack(registration);
+            }
+
+            if (result == Result::Success)
+            {
+                m_workerCond.WakeOne();
+                WakeWorker();
+            }
+        }
+    }
+
+    if (invokeNow)
+    {
+        pfnCallback(pUserData, Result::Success);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Removes a registration which hasn't been invoked yet. If the callback is running on another thread, waits for it to
+// return so that the caller may free its user data.
+Result FenceNotifier::UnregisterCallback(
+    const Fence*      pFence,
+    FenceCallbackFunc pfnCallback,
+    void*             pUserData)
+{
+    Result result = Result::NotFound;
+
+    MutexAuto lock(&m_lock);
+
+    for (uint32 idx = 0; idx < m_registrations.NumElements(); ++idx)
+    {
+        const Registration& registration = m_registrations.At(idx);
+
+        if ((registration.pFence      == pFence)      &&
+            (registration.pfnCallback == pfnCallback) &&
+            (registration.pUserData   == pUserData))
+        {
+            // Shift the later registrations down to keep them in registration order.
+            for (uint32 next = idx + 1; next < m_registrations.NumElements(); ++next)
+            {
+                m_registrations.At(next - 1) = m_registrations.At(next);
+            }
+
+            m_registrations.PopBack(nullptr);
+            result = Result::Success;
+            break;
+        }
+    }
+
+    // The worker may have already collected it but not gotten around to invoking it.
+    for (uint32 idx = m_numInvoked; (result == Result::NotFound) && (idx < m_completed.NumElements()); ++idx)
+    {
+        Registration* pRegistration = &m_completed.At(idx);
+
+        if ((pRegistration->pFence      == pFence)      &&
+            (pRegistration->pfnCallback == pfnCallback) &&
+            (pRegistration->pUserData   == pUserData))
+        {
+            pRegistration->pfnCallback = nullptr;
+            result                     = Result::Success;
+        }
+    }
+
+    if ((result == Result::NotFound) && m_invoking && (m_exit == false) && m_worker.IsNotCurrentThread())
+    {
+        const Registration& running = m_completed.At(m_numInvoked - 1);
+
+        if ((running.pFence == pFence) && (running.pfnCallback == pfnCallback) && (running.pUserData == pUserData))
+        {
+            // Wait until this particular invocation has returned. A callback can't wait on itself, which is why callers
+            // on the worker thread skip this.
+            const uint64 runningCallback = m_callbacksStarted;
+
+            while (m_invoking && (m_callbacksStarted == runningCallback))
+            {
+                m_callbackCond.Wait(&m_lock, InfiniteWait);
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void FenceNotifier::WorkerThreadFunc(
+    void* pParam)
+{
+    static_cast<FenceNotifier*>(pParam)->WorkerThread();
+}
+
+// =====================================================================================================================
+// Waits on all fences with pending callbacks at once and invokes the callbacks of those which have been signaled.
+void FenceNotifier::WorkerThread()
+{
+    bool exit = false;
+
+    while (exit == false)
+    {
+        Result result       = Result::Success;
+        bool   useWakeFence = false;
+
+        {
+            MutexAuto lock(&m_lock);
+
+            while ((m_exit == false) && m_registrations.IsEmpty())
+            {
+                m_workerCond.Wait(&m_lock, InfiniteWait);
+            }
+
+            exit = m_exit;
+
+            m_waitList.Clear();
+
+            // Anything which signals the wake fence after this point is picked up by the wait below, and anything
+            // before it is already reflected in m_registrations.
+            if ((exit == false) && (m_pWakeFence != nullptr) && (m_pWakeFence->Reset() == Result::Success))
+            {
+                useWakeFence = (m_waitList.PushBack(m_pWakeFence) == Result::Success);
+            }
+
+            for (uint32 idx = 0; (result == Result::Success) && (idx < m_registrations.NumElements()); ++idx)
+            {
+                result = m_waitList.PushBack(m_registrations.At(idx).pFence);
+            }
+        }
+
+        if ((exit == false) && (m_waitList.IsEmpty() == false))
+        {
+            // If we couldn't build the whole list we can still wait on part of it; the rest will be checked when we
+            // look for signaled fences below. That only happens if we're woken up, so wait in slices in that case.
+            const bool canWaitForever = useWakeFence && (result == Result::Success);
+
+            result = m_waitList.At(0)->WaitForFences(*m_pDevice,
+                                                     m_waitList.NumElements(),
+                                                     m_waitList.Data(),
+                                                     false,
+                                                     canWaitForever ? InfiniteWaitNs : WaitSliceNs);
+
+            if (result != Result::Timeout)
+            {
+                // An error (e.g., device loss) ends the wait on every fence.
+                NotifyCompleted(IsErrorResult(result), result);
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Removes every registration whose fence is no longer pending (or all of them if signalAll is set, using the given
+// result) and then invokes their callbacks in registration order. The callbacks are called without holding the lock so
+// they may register or unregister callbacks.
+void FenceNotifier::NotifyCompleted(
+    bool   signalAll,
+    Result result)
+{
+    m_lock.Lock();
+
+    PAL_ASSERT(m_completed.IsEmpty());
+
+    uint32 numPending = 0;
+    for (uint32 idx = 0; idx < m_registrations.NumElements(); ++idx)
+    {
+        Registration registration = m_registrations.At(idx);
+
+        registration.result = signalAll ? result : registration.pFence->GetStatus();
+
+        const bool completed = (registration.result != Result::NotReady) &&
+                               (m_completed.PushBack(registration) == Result::Success);
+
+        if (completed == false)
+        {
+            // Keep waiting on this fence. If we failed to queue its callback we'll simply try again next time.
+            m_registrations.At(numPending++) = registration;
+        }
+    }
+
+    while (m_registrations.NumElements() > numPending)
+    {
+        m_registrations.PopBack(nullptr);
+    }
+
+    for (m_numInvoked = 0; m_numInvoked < m_completed.NumElements(); )
+    {
+        const Registration registration = m_completed.At(m_numInvoked++);
+
+        // Skip the callbacks which were unregistered after we collected them.
+        if (registration.pfnCallback != nullptr)
+        {
+            m_invoking = true;
+            m_callbacksStarted++;
+            m_lock.Unlock();
+
+            registration.pfnCallback(registration.pUserData, registration.result);
+
+            m_lock.Lock();
+            m_invoking = false;
+            m_callbackCond.WakeAll();
+        }
+    }
+
+    m_completed.Clear();
+    m_numInvoked = 0;
+
+    m_lock.Unlock();
+}
+
+} // Pal
+#endif
@@ -0,0 +1,104 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+
+#pragma once
+
+#include "pal.h"
+#include "palConditionVariable.h"
+#include "palDevice.h"
+#include "palMutex.h"
+#include "palThread.h"
+#include "palVector.h"
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+namespace Pal
+{
+
+class Device;
+class Fence;
+class Platform;
+
+// =====================================================================================================================
+// Invokes client callbacks when their fences are signaled. Every fence with a pending callback is waited on together by
+// a single worker thread, so clients that would otherwise poll their own fences (or dedicate a thread to waiting on
+// them) share one wait. The worker and its wake fence are only created once a registration has to wait. While no
+// callbacks are pending the worker sleeps on a condition variable and never wakes up. Where fences can be signaled from
+// the CPU, the wake fence is added to the wait so that new registrations and shutdown interrupt it and the worker can
+// wait without a timeout.
+class FenceNotifier
+{
+public:
+    explicit FenceNotifier(Device* pDevice);
+    ~FenceNotifier();
+
+    Result Init();
+
+    Result RegisterCallback(const Fence* pFence, FenceCallbackFunc pfnCallback, void* pUserData);
+    Result UnregisterCallback(const Fence* pFence, FenceCallbackFunc pfnCallback, void* pUserData);
+
+private:
+    struct Registration
+    {
+        const Fence*      pFence;
+        FenceCallbackFunc pfnCallback;
+        void*             pUserData;
+        Result            result;      // Result passed to the callback once the registration has completed.
+    };
+
+    static void WorkerThreadFunc(void* pParam);
+    void WorkerThread();
+
+    Result StartWorker();
+    bool IsFencePending(const Fence* pFence) const;
+    void NotifyCompleted(bool signalAll, Result result);
+    void WakeWorker();
+
+    Device*const                             m_pDevice;
+
+    Util::Thread                             m_worker;
+    Util::Mutex                              m_lock;          // Protects everything below except m_waitList.
+    Util::ConditionVariable                  m_workerCond;    // Signaled when the worker has something to do.
+    Util::ConditionVariable                  m_callbackCond;  // Signaled whenever a callback returns.
+    Util::Vector<Registration, 16, Platform> m_registrations; // Callbacks still waiting on their fences.
+    bool                                     m_exit;
+    Fence*                                   m_pWakeFence;    // Signaled to interrupt the worker's fence wait. May be
+                                                              // null if the device's fences can't be signaled by us.
+
+    // Callbacks whose fences have completed, in registration order. They're invoked without holding m_lock, so entries
+    // which are unregistered before their turn have their pfnCallback cleared instead of being removed.
+    Util::Vector<Registration, 16, Platform> m_completed;
+    uint32                                   m_numInvoked;    // Entries of m_completed whose callbacks have started.
+    bool                                     m_invoking;      // A callback from m_completed is running.
+    uint64                                   m_callbacksStarted; // Number of callbacks started over our lifetime.
+
+    Util::Vector<const Fence*, 16, Platform> m_waitList;      // Fences to wait on. Only touched by the worker.
+
+    PAL_DISALLOW_DEFAULT_CTOR(FenceNotifier);
+    PAL_DISALLOW_COPY_AND_ASSIGN(FenceNotifier);
+};
+
+} // Pal
+#endif
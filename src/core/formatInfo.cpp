@@ -49,6 +49,47 @@ constexpr float LinearToGammaOffset    = 0.055f;
 constexpr float LinearToGammaThreshold = 0.0031308f;
 constexpr float GammaToLinearThreshold = 0.04045f;
 
+// Bit patterns of the linear color values at which the 8-bit sRGB encoding of a channel steps up: entry N is the
+// smallest non-negative float which LinearToGamma() and FloatToUFixed() encode to N + 1. Non-negative floats sort the
+// same way as their bit patterns, so these can be binary searched instead of calling powf() for every channel.
+constexpr uint32 SrgbUnorm8Thresholds[] =
+{
+    0x391F22B3, 0x39EEB40E, 0x3A46EB61, 0x3A8B3E5D, 0x3AB3070B, 0x3ADACFB7, 0x3B014C32, 0x3B153089,
+    0x3B2914DF, 0x3B3CF936, 0x3B50F2D1, 0x3B65FB9A, 0x3B7C3404, 0x3B89D060, 0x3B962333, 0x3BA314BE,
+    0x3BB0A731, 0x3BBEDCB6, 0x3BCDB76C, 0x3BDD3966, 0x3BED64AE, 0x3BFE3B44, 0x3C07DF90, 0x3C10F919,
+    0x3C1A6B32, 0x3C2436C7, 0x3C2E5CC7, 0x3C38DE19, 0x3C43BBA3, 0x3C4EF646, 0x3C5A8EE2, 0x3C668654,
+    0x3C72DD73, 0x3C7F9512, 0x3C865703, 0x3C8D1490, 0x3C940396, 0x3C9B247C, 0x3CA277A8, 0x3CA9FD79,
+    0x3CB1B654, 0x3CB9A299, 0x3CC1C2A9, 0x3CCA16E3, 0x3CD29FA4, 0x3CDB5D4D, 0x3CE45034, 0x3CED78B6,
+    0x3CF6D72F, 0x3D0035FC, 0x3D051BB6, 0x3D0A1CEE, 0x3D0F39D1, 0x3D14728A, 0x3D19C745, 0x3D1F382B,
+    0x3D24C56A, 0x3D2A6F24, 0x3D303586, 0x3D3618B9, 0x3D3C18E6, 0x3D423634, 0x3D4870CB, 0x3D4EC8D3,
+    0x3D553E74, 0x3D5BD1D3, 0x3D628319, 0x3D69526A, 0x3D703FEE, 0x3D774BCE, 0x3D7E7627, 0x3D82DF92,
+    0x3D869374, 0x3D8A56CC, 0x3D8E29AD, 0x3D920C28, 0x3D95FE50, 0x3D9A0036, 0x3D9E11EC, 0x3DA23384,
+    0x3DA66510, 0x3DAAA6A0, 0x3DAEF847, 0x3DB35A17, 0x3DB7CC1D, 0x3DBC4E6C, 0x3DC0E116, 0x3DC5842A,
+    0x3DCA37BA, 0x3DCEFBD7, 0x3DD3D090, 0x3DD8B5F6, 0x3DDDAC19, 0x3DE2B30A, 0x3DE7CAD9, 0x3DECF395,
+    0x3DF22D4F, 0x3DF7781A, 0x3DFCD3FE, 0x3E012088, 0x3E03DFAF, 0x3E06A77C, 0x3E0977F7, 0x3E0C5127,
+    0x3E0F3314, 0x3E121DC6, 0x3E151144, 0x3E180D95, 0x3E1B12C2, 0x3E1E20D1, 0x3E2137CB, 0x3E2457B7,
+    0x3E27809A, 0x3E2AB27C, 0x3E2DED67, 0x3E313160, 0x3E347E6F, 0x3E37D49D, 0x3E3B33ED, 0x3E3E9C68,
+    0x3E420E14, 0x3E4588FA, 0x3E490D21, 0x3E4C9A8F, 0x3E50314B, 0x3E53D15C, 0x3E577AC9, 0x3E5B2D99,
+    0x3E5EE9D2, 0x3E62AF7C, 0x3E667E9D, 0x3E6A5740, 0x3E6E3963, 0x3E722512, 0x3E761A53, 0x3E7A192D,
+    0x3E7E21A6, 0x3E8119E2, 0x3E8327C8, 0x3E853A87, 0x3E875222, 0x3E896E9E, 0x3E8B8FFC, 0x3E8DB641,
+    0x3E8FE170, 0x3E92118B, 0x3E944696, 0x3E968094, 0x3E98BF89, 0x3E9B0377, 0x3E9D4C61, 0x3E9F9A4B,
+    0x3EA1ED38, 0x3EA4452A, 0x3EA6A225, 0x3EA9042D, 0x3EAB6B43, 0x3EADD76B, 0x3EB048A9, 0x3EB2BF01,
+    0x3EB53A72, 0x3EB7BB01, 0x3EBA40B2, 0x3EBCCB86, 0x3EBF5B82, 0x3EC1F0A7, 0x3EC48AFA, 0x3EC72A7D,
+    0x3EC9CF32, 0x3ECC791E, 0x3ECF2842, 0x3ED1DCA2, 0x3ED49641, 0x3ED75521, 0x3EDA1945, 0x3EDCE2B1,
+    0x3EDFB167, 0x3EE2856A, 0x3EE55EBC, 0x3EE83D62, 0x3EEB215C, 0x3EEE0AAF, 0x3EF0F95D, 0x3EF3ED69,
+    0x3EF6E6D6, 0x3EF9E5A6, 0x3EFCE9E0, 0x3EFFF37F, 0x3F018145, 0x3F030B82, 0x3F049878, 0x3F062827,
+    0x3F07BA92, 0x3F094FBA, 0x3F0AE79F, 0x3F0C8244, 0x3F0E1FAA, 0x3F0FBFD2, 0x3F1162BE, 0x3F13086E,
+    0x3F14B0E4, 0x3F165C22, 0x3F180A29, 0x3F19BAF9, 0x3F1B6E95, 0x3F1D24FE, 0x3F1EDE35, 0x3F209A3B,
+    0x3F225912, 0x3F241ABB, 0x3F25DF37, 0x3F27A688, 0x3F2970AE, 0x3F2B3DAC, 0x3F2D0D84, 0x3F2EE033,
+    0x3F30B5BE, 0x3F328E25, 0x3F346969, 0x3F36478C, 0x3F38288F, 0x3F3A0C73, 0x3F3BF33A, 0x3F3DDCE5,
+    0x3F3FC975, 0x3F41B8EB, 0x3F43AB48, 0x3F45A08F, 0x3F4798BF, 0x3F4993DA, 0x3F4B91E2, 0x3F4D92D8,
+    0x3F4F96BD, 0x3F519D91, 0x3F53A758, 0x3F55B410, 0x3F57C3BD, 0x3F59D65E, 0x3F5BEBF6, 0x3F5E0485,
+    0x3F60200D, 0x3F623E91, 0x3F64600B, 0x3F668486, 0x3F68ABFA, 0x3F6AD671, 0x3F6D03E3, 0x3F6F345B,
+    0x3F7167D0, 0x3F739E4D, 0x3F75D7CA, 0x3F781452, 0x3F7A53DB, 0x3F7C9671, 0x3F7EDC0E
+};
+
+static_assert(ArrayLen(SrgbUnorm8Thresholds) == 255, "SrgbUnorm8Thresholds must have one entry per step.");
+
 // =====================================================================================================================
 // Converts a linearly-scaled color value to gamma-corrected sRGB. The conversion parameters are the same as documented
 // in d3d10.h.
@@ -95,6 +136,30 @@ float GammaToLinear(
     return linearVal;
 }
 
+// =====================================================================================================================
+// Converts a linear color value to an 8-bit sRGB unorm value. The result is identical to encoding the output of
+// LinearToGamma() with FloatToUFixed(), but uses a table of step thresholds rather than powf().
+static uint32 LinearToSrgbUnorm8(
+    float linear)
+{
+    const uint32 linearBits = FloatToBits(linear);
+    uint32       srgb       = 0;
+
+    // Negative values and NaNs encode to zero; their bit patterns are all greater than positive infinity's.
+    if (linearBits <= FloatExponentMask)
+    {
+        for (uint32 step = 128; step > 0; step >>= 1)
+        {
+            if (linearBits >= SrgbUnorm8Thresholds[srgb + step - 1])
+            {
+                srgb += step;
+            }
+        }
+    }
+
+    return srgb;
+}
+
 // =====================================================================================================================
 // Converts a color in RGB_ order into a shared exponent format, X9Y9Z9E5.
 // SEE: https://tinyurl.com/gs7wv3u
@@ -117,11 +182,19 @@ void ConvertColorToX9Y9Z9E5(
     // Find the largest clamped component
     const float maxC = Max(Max(redC, greenC), blueC);
 
-    // Calculate a preliminary shared exponent
-    int32 sharedExp = Max(-ExponentBias - 1, static_cast<int32>(floor(log2(maxC)))) + 1 + ExponentBias;
+    // Calculate a preliminary shared exponent. floor(log2(maxC)) is just the unbiased exponent of maxC; zero and
+    // denormals have the smallest exponent, which gets clamped anyway.
+    const int32 maxExp = static_cast<int32>((FloatToBits(maxC) & FloatExponentMask) >> FloatNumMantissaBits) -
+                         static_cast<int32>(FloatExponentBias);
+
+    int32 sharedExp = Max(-ExponentBias - 1, maxExp) + 1 + ExponentBias;
     PAL_ASSERT(sharedExp <= MaxBiasedExponent);
 
-    float denom = pow(2.0f, static_cast<float>(sharedExp - ExponentBias - MantissaBits));
+    // The denominator is a power of two well within the range of normalized floats, so build its bits directly.
+    const int32 denomBiasedExp = sharedExp - ExponentBias - MantissaBits + static_cast<int32>(FloatExponentBias);
+
+    float denom;
+    SetBitsToFloat(&denom, static_cast<uint32>(denomBiasedExp) << FloatNumMantissaBits);
 
     // Max shared exponent RGB value
     const int32 maxS = static_cast<int32>(floor((maxC / denom) + 0.5f));
@@ -221,6 +294,10 @@ void ConvertColor(
                     {
                         compVal = FloatToUFixed(rgbaVal, 0, numBits, true);
                     }
+                    else if (numBits == 8)
+                    {
+                        compVal = LinearToSrgbUnorm8(rgbaVal);
+                    }
                     else
                     {
                         compVal = FloatToUFixed(LinearToGamma(rgbaVal), 0, numBits, true);
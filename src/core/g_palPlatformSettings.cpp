@@ -123,6 +123,7 @@ void PlatformSettingsLoader::SetupDefaults()
     m_settings.gpuProfilerConfig.breakSubmitBatches = false;
     m_settings.gpuProfilerConfig.useFullPipelineHash = false;
     m_settings.gpuProfilerConfig.traceModeMask = 0x0;
+    m_settings.gpuProfilerConfig.logFormat = GpuProfilerLogFormatCsv;
     memset(m_settings.gpuProfilerPerfCounterConfig.globalPerfCounterConfigFile, 0, 256);
     strncpy(m_settings.gpuProfilerPerfCounterConfig.globalPerfCounterConfigFile, "", 256);
     m_settings.gpuProfilerPerfCounterConfig.cacheFlushOnCounterCollection = false;
@@ -412,6 +413,11 @@ void PlatformSettingsLoader::ReadSettings(Pal::Device* pDevice)
                            &m_settings.gpuProfilerConfig.traceModeMask,
                            InternalSettingScope::PrivatePalKey);
 
+    pDevice->ReadSetting(pGpuProfilerConfig_LogFormatStr,
+                           Util::ValueType::Uint,
+                           &m_settings.gpuProfilerConfig.logFormat,
+                           InternalSettingScope::PrivatePalKey);
+
     pDevice->ReadSetting(pGpuProfilerPerfCounterConfig_GlobalPerfCounterConfigFileStr,
                            Util::ValueType::Str,
                            &m_settings.gpuProfilerPerfCounterConfig.globalPerfCounterConfigFile,
@@ -858,6 +864,11 @@ void PlatformSettingsLoader::InitSettingsInfo()
     info.valueSize = sizeof(m_settings.gpuProfilerConfig.traceModeMask);
     m_settingsInfoMap.Insert(2717664970, info);
 
+    info.type      = SettingType::Uint;
+    info.pValuePtr = &m_settings.gpuProfilerConfig.logFormat;
+    info.valueSize = sizeof(m_settings.gpuProfilerConfig.logFormat);
+    m_settingsInfoMap.Insert(2718986885, info);
+
     info.type      = SettingType::String;
     info.pValuePtr = &m_settings.gpuProfilerPerfCounterConfig.globalPerfCounterConfigFile;
     info.valueSize = sizeof(m_settings.gpuProfilerPerfCounterConfig.globalPerfCounterConfigFile);
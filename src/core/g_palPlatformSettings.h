@@ -84,6 +84,12 @@ enum GpuProfilerGranularity : uint32
     GpuProfilerGranularityFrame = 2
 };
 
+enum GpuProfilerLogFormat : uint32
+{
+    GpuProfilerLogFormatCsv = 0,
+    GpuProfilerLogFormatBinary = 1
+};
+
 enum Pm4InstrumentorDumpMode : uint32
 {
     Pm4InstrumentorDumpQueueDestroy = 0,
@@ -157,6 +163,7 @@ struct PalPlatformSettings : public Pal::DriverSettings
         bool                                        breakSubmitBatches;
         bool                                        useFullPipelineHash;
         uint32                                      traceModeMask;
+        GpuProfilerLogFormat                        logFormat;
     } gpuProfilerConfig;
     struct {
         char                                        globalPerfCounterConfigFile[MaxFileNameStrLen];
@@ -277,6 +284,7 @@ static const char* pGpuProfilerConfig_RecordPipelineStatsStr = "#1092484338";
 static const char* pGpuProfilerConfig_BreakSubmitBatchesStr = "#2743656777";
 static const char* pGpuProfilerConfig_UseFullPipelineHashStr = "#3204367348";
 static const char* pGpuProfilerConfig_TraceModeMaskStr = "#2717664970";
+static const char* pGpuProfilerConfig_LogFormatStr = "#2718986885";
 static const char* pGpuProfilerPerfCounterConfig_GlobalPerfCounterConfigFileStr = "#1666123781";
 static const char* pGpuProfilerPerfCounterConfig_CacheFlushOnCounterCollectionStr = "#3543519762";
 static const char* pGpuProfilerPerfCounterConfig_GranularityStr = "#3380953453";
@@ -317,7 +325,7 @@ static const char* pInterfaceLoggerConfig_MultithreadedStr = "#4177532476";
 static const char* pInterfaceLoggerConfig_BasePresetStr = "#3886684530";
 static const char* pInterfaceLoggerConfig_ElevatedPresetStr = "#3991423149";
 
-static const uint32 g_palPlatformNumSettings = 88;
+static const uint32 g_palPlatformNumSettings = 89;
 static const SettingNameHash g_palPlatformSettingHashList[] = {
 #if PAL_ENABLE_PRINTS_ASSERTS
 87264462,
@@ -387,6 +395,7 @@ static const SettingNameHash g_palPlatformSettingHashList[] = {
 2743656777,
 3204367348,
 2717664970,
+2718986885,
 1666123781,
 3543519762,
 3380953453,
@@ -107,6 +107,8 @@ void SettingsLoader::SetupDefaults()
 #endif
     m_settings.submitTimeCmdBufDumpStartFrame = 0;
     m_settings.submitTimeCmdBufDumpEndFrame = 0;
+    m_settings.cmdStreamFlightRecorderSize = 0;
+    m_settings.cmdStreamFlightRecorderCopyBudget = 4096;
     m_settings.logCmdBufCommitSizes = false;
     m_settings.logPipelines = false;
     m_settings.pipelineLogConfig.logInternal = false;
@@ -125,6 +127,7 @@ void SettingsLoader::SetupDefaults()
     m_settings.cmdStreamMemsetValue = 4294967295;
     m_settings.cmdBufChunkEnableStagingBuffer = false;
     m_settings.cmdAllocatorFreeOnReset = false;
+    m_settings.cmdChunkPoolAllocatorQuota = 0;
     m_settings.cmdBufOptimizePm4 = Pm4OptDefaultEnable;
     m_settings.cmdBufOptimizePm4Mode = Pm4OptModeImmediate;
     m_settings.cmdBufForceCpuUpdatePath = CmdBufForceCpuUpdatePathOn;
@@ -134,6 +137,7 @@ void SettingsLoader::SetupDefaults()
     m_settings.commandBufferCombineDePreambles = false;
     m_settings.cmdUtilVerifyShadowedRegRanges = true;
     m_settings.submitOptModeOverride = 0;
+    m_settings.submitCoalesceLimit = 0;
     m_settings.tileSwizzleMode = 0x7;
     m_settings.enableVidMmGpuVaMappingValidation = false;
     m_settings.enableUswcHeapAllAllocations = false;
@@ -342,6 +346,16 @@ void SettingsLoader::ReadSettings()
                            &m_settings.submitTimeCmdBufDumpEndFrame,
                            InternalSettingScope::PrivatePalKey);
 
+    static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pCmdStreamFlightRecorderSizeStr,
+                           Util::ValueType::Uint,
+                           &m_settings.cmdStreamFlightRecorderSize,
+                           InternalSettingScope::PrivatePalKey);
+
+    static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pCmdStreamFlightRecorderCopyBudgetStr,
+                           Util::ValueType::Uint,
+                           &m_settings.cmdStreamFlightRecorderCopyBudget,
+                           InternalSettingScope::PrivatePalKey);
+
     static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pLogCmdBufCommitSizesStr,
                            Util::ValueType::Boolean,
                            &m_settings.logCmdBufCommitSizes,
@@ -418,6 +432,11 @@ void SettingsLoader::ReadSettings()
                            &m_settings.cmdAllocatorFreeOnReset,
                            InternalSettingScope::PrivatePalKey);
 
+    static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pCmdChunkPoolAllocatorQuotaStr,
+                           Util::ValueType::Uint,
+                           &m_settings.cmdChunkPoolAllocatorQuota,
+                           InternalSettingScope::PrivatePalKey);
+
     static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pCmdBufOptimizePm4Str,
                            Util::ValueType::Uint,
                            &m_settings.cmdBufOptimizePm4,
@@ -463,6 +482,11 @@ void SettingsLoader::ReadSettings()
                            &m_settings.submitOptModeOverride,
                            InternalSettingScope::PrivatePalKey);
 
+    static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pSubmitCoalesceLimitStr,
+                           Util::ValueType::Uint,
+                           &m_settings.submitCoalesceLimit,
+                           InternalSettingScope::PrivatePalKey);
+
     static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pTileSwizzleModeStr,
                            Util::ValueType::Uint,
                            &m_settings.tileSwizzleMode,
@@ -811,6 +835,16 @@ void SettingsLoader::InitSettingsInfo()
     info.valueSize = sizeof(m_settings.submitTimeCmdBufDumpEndFrame);
     m_settingsInfoMap.Insert(4221961293, info);
 
+    info.type      = SettingType::Uint;
+    info.pValuePtr = &m_settings.cmdStreamFlightRecorderSize;
+    info.valueSize = sizeof(m_settings.cmdStreamFlightRecorderSize);
+    m_settingsInfoMap.Insert(1468692982, info);
+
+    info.type      = SettingType::Uint;
+    info.pValuePtr = &m_settings.cmdStreamFlightRecorderCopyBudget;
+    info.valueSize = sizeof(m_settings.cmdStreamFlightRecorderCopyBudget);
+    m_settingsInfoMap.Insert(680920599, info);
+
     info.type      = SettingType::Boolean;
     info.pValuePtr = &m_settings.logCmdBufCommitSizes;
     info.valueSize = sizeof(m_settings.logCmdBufCommitSizes);
@@ -886,6 +920,11 @@ void SettingsLoader::InitSettingsInfo()
     info.valueSize = sizeof(m_settings.cmdAllocatorFreeOnReset);
     m_settingsInfoMap.Insert(1461164706, info);
 
+    info.type      = SettingType::Uint;
+    info.pValuePtr = &m_settings.cmdChunkPoolAllocatorQuota;
+    info.valueSize = sizeof(m_settings.cmdChunkPoolAllocatorQuota);
+    m_settingsInfoMap.Insert(3022979109, info);
+
     info.type      = SettingType::Uint;
     info.pValuePtr = &m_settings.cmdBufOptimizePm4;
     info.valueSize = sizeof(m_settings.cmdBufOptimizePm4);
@@ -931,6 +970,11 @@ void SettingsLoader::InitSettingsInfo()
     info.valueSize = sizeof(m_settings.submitOptModeOverride);
     m_settingsInfoMap.Insert(3054810609, info);
 
+    info.type      = SettingType::Uint;
+    info.pValuePtr = &m_settings.submitCoalesceLimit;
+    info.valueSize = sizeof(m_settings.submitCoalesceLimit);
+    m_settingsInfoMap.Insert(1832448649, info);
+
     info.type      = SettingType::Uint;
     info.pValuePtr = &m_settings.tileSwizzleMode;
     info.valueSize = sizeof(m_settings.tileSwizzleMode);
@@ -223,6 +223,8 @@ struct PalSettings : public Pal::DriverSettings
     char                                        cmdBufDumpDirectory[MaxPathStrLen];
     uint32                                      submitTimeCmdBufDumpStartFrame;
     uint32                                      submitTimeCmdBufDumpEndFrame;
+    uint32                                      cmdStreamFlightRecorderSize;
+    uint32                                      cmdStreamFlightRecorderCopyBudget;
     bool                                        logCmdBufCommitSizes;
     bool                                        logPipelines;
     struct {
@@ -240,6 +242,7 @@ struct PalSettings : public Pal::DriverSettings
     uint32                                      cmdStreamMemsetValue;
     bool                                        cmdBufChunkEnableStagingBuffer;
     bool                                        cmdAllocatorFreeOnReset;
+    uint32                                      cmdChunkPoolAllocatorQuota;
     Pm4OptEnable                                cmdBufOptimizePm4;
     Pm4OptMode                                  cmdBufOptimizePm4Mode;
     CmdBufForceCpuUpdatePath                    cmdBufForceCpuUpdatePath;
@@ -249,6 +252,7 @@ struct PalSettings : public Pal::DriverSettings
     bool                                        commandBufferCombineDePreambles;
     bool                                        cmdUtilVerifyShadowedRegRanges;
     uint32                                      submitOptModeOverride;
+    uint32                                      submitCoalesceLimit;
     uint32                                      tileSwizzleMode;
     bool                                        enableVidMmGpuVaMappingValidation;
     bool                                        enableUswcHeapAllAllocations;
@@ -305,6 +309,8 @@ static const char* pCmdBufDumpFormatStr = "#1905164977";
 static const char* pCmdBufDumpDirectoryStr = "#3293295025";
 static const char* pSubmitTimeCmdBufDumpStartFrameStr = "#1639305458";
 static const char* pSubmitTimeCmdBufDumpEndFrameStr = "#4221961293";
+static const char* pCmdStreamFlightRecorderSizeStr = "#1468692982";
+static const char* pCmdStreamFlightRecorderCopyBudgetStr = "#680920599";
 static const char* pLogCmdBufCommitSizesStr = "#2222002517";
 static const char* pLogPipelineInfoStr = "#835791563";
 static const char* pPipelineLogConfig_LogInternalStr = "#2166447132";
@@ -320,6 +326,7 @@ static const char* pCmdStreamEnableMemsetOnReserveStr = "#3927521274";
 static const char* pCmdStreamMemsetValueStr = "#3661455441";
 static const char* pCmdBufChunkEnableStagingBufferStr = "#169161685";
 static const char* pCmdAllocatorFreeOnResetStr = "#1461164706";
+static const char* pCmdChunkPoolAllocatorQuotaStr = "#3022979109";
 static const char* pCmdBufOptimizePm4Str = "#1018895288";
 static const char* pCmdBufOptimizePm4ModeStr = "#2490816619";
 static const char* pCmdBufForceCpuUpdatePathStr = "#3282911281";
@@ -329,6 +336,7 @@ static const char* pCommandBufferForceCeRamDumpInPostambleStr = "#3413911781";
 static const char* pCommandBufferCombineDePreamblesStr = "#148412311";
 static const char* pCmdUtilVerifyShadowedRegRangesStr = "#3890704045";
 static const char* pSubmitOptModeOverrideStr = "#3054810609";
+static const char* pSubmitCoalesceLimitStr = "#1832448649";
 static const char* pTileSwizzleModeStr = "#1146877010";
 static const char* pEnableVidMmGpuVaMappingValidationStr = "#2751785051";
 static const char* pEnableUswcHeapAllAllocationsStr = "#3408333164";
@@ -349,7 +357,7 @@ static const char* pPresentViaOglRuntimeStr = "#2466363770";
 static const char* pDebugForceResourceAlignmentStr = "#397089904";
 static const char* pDebugForceResourceAdditionalPaddingStr = "#3601080919";
 
-static const uint32 g_palNumSettings = 95;
+static const uint32 g_palNumSettings = 99;
 static const SettingNameHash g_palSettingHashList[] = {
 4265240458,
 1901986348,
@@ -401,6 +409,8 @@ static const SettingNameHash g_palSettingHashList[] = {
 3293295025,
 1639305458,
 4221961293,
+1468692982,
+680920599,
 2222002517,
 835791563,
 2166447132,
@@ -416,6 +426,7 @@ static const SettingNameHash g_palSettingHashList[] = {
 3661455441,
 169161685,
 1461164706,
+3022979109,
 1018895288,
 2490816619,
 3282911281,
@@ -425,6 +436,7 @@ static const SettingNameHash g_palSettingHashList[] = {
 148412311,
 3890704045,
 3054810609,
+1832448649,
 1146877010,
 2751785051,
 3408333164,
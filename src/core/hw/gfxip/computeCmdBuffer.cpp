@@ -230,7 +230,7 @@ void ComputeCmdBuffer::CmdBindPipeline(
 // =====================================================================================================================
 // Dumps this command buffer's single command stream to the given file with an appropriate header.
 void ComputeCmdBuffer::DumpCmdStreamsToFile(
-    File*          pFile,
+    BufferedFile*  pFile,
     CmdBufDumpFormat mode
     ) const
 {
@@ -2063,6 +2063,7 @@ void PAL_STDCALL UniversalCmdBuffer::CmdDrawIndirectMulti(
     PAL_ASSERT(offset + (sizeof(DrawIndirectArgs) * maximumCount) <= gpuMemory.Desc().size);
 
     auto* pThis = static_cast<UniversalCmdBuffer*>(pCmdBuffer);
+    pThis->TrackMemRef(gpuMemory);
 
     ValidateDrawInfo drawInfo;
     drawInfo.vtxIdxCount   = 0;
@@ -2173,6 +2174,7 @@ void PAL_STDCALL UniversalCmdBuffer::CmdDrawIndexedIndirectMulti(
     PAL_ASSERT(offset + (sizeof(DrawIndexedIndirectArgs) * maximumCount) <= gpuMemory.Desc().size);
 
     auto* pThis = static_cast<UniversalCmdBuffer*>(pCmdBuffer);
+    pThis->TrackMemRef(gpuMemory);
 
     ValidateDrawInfo drawInfo;
     drawInfo.vtxIdxCount   = 0;
@@ -2310,6 +2312,7 @@ void PAL_STDCALL UniversalCmdBuffer::CmdDispatchIndirect(
     PAL_ASSERT(offset + sizeof(DispatchIndirectArgs) <= gpuMemory.Desc().size);
 
     auto* pThis = static_cast<UniversalCmdBuffer*>(pCmdBuffer);
+    pThis->TrackMemRef(gpuMemory);
 
     if (DescribeDrawDispatch)
     {
@@ -2399,6 +2402,9 @@ void UniversalCmdBuffer::CmdCloneImageData(
     const IImage& srcImage,
     const IImage& dstImage)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstImage);
+
     m_device.RsrcProcMgr().CmdCloneImageData(this, GetGfx6Image(srcImage), GetGfx6Image(dstImage));
 }
 
@@ -2409,6 +2415,9 @@ void UniversalCmdBuffer::CmdCopyMemory(
     uint32                  regionCount,
     const MemoryCopyRegion* pRegions)
 {
+    TrackMemRef(srcGpuMemory);
+    TrackMemRef(dstGpuMemory);
+
     m_device.RsrcProcMgr().CmdCopyMemory(this,
                                          static_cast<const GpuMemory&>(srcGpuMemory),
                                          static_cast<const GpuMemory&>(dstGpuMemory),
@@ -2423,6 +2432,8 @@ void UniversalCmdBuffer::CmdUpdateMemory(
     gpusize           dataSize,
     const uint32*     pData)
 {
+    TrackMemRef(dstGpuMemory);
+
     PAL_ASSERT(pData != nullptr);
     m_device.RsrcProcMgr().CmdUpdateMemory(this,
                                            static_cast<const GpuMemory&>(dstGpuMemory),
@@ -2437,6 +2448,8 @@ void UniversalCmdBuffer::CmdUpdateBusAddressableMemoryMarker(
     gpusize           offset,
     uint32            value)
 {
+    TrackMemRef(dstGpuMemory);
+
     const GpuMemory* pGpuMemory = static_cast<const GpuMemory*>(&dstGpuMemory);
     WriteDataInfo    writeData  = {};
 
@@ -2457,6 +2470,8 @@ void UniversalCmdBuffer::CmdMemoryAtomic(
     uint64            srcData,
     AtomicOp          atomicOp)
 {
+    TrackMemRef(dstGpuMemory);
+
     const gpusize address = dstGpuMemory.Desc().gpuVirtAddr + dstOffset;
 
     uint32* pDeCmdSpace = m_deCmdStream.ReserveCommands();
@@ -2472,6 +2487,8 @@ void UniversalCmdBuffer::CmdWriteTimestamp(
     const IGpuMemory& dstGpuMemory,
     gpusize           dstOffset)
 {
+    TrackMemRef(dstGpuMemory);
+
     const gpusize address = dstGpuMemory.Desc().gpuVirtAddr + dstOffset;
 
     uint32* pDeCmdSpace = m_deCmdStream.ReserveCommands();
@@ -3276,33 +3293,63 @@ uint32* UniversalCmdBuffer::WriteDirtyUserDataEntriesToCeRam(
     const uint16 spillThreshold = pCurrSignature->spillThreshold;
     const uint16 userDataLimit  = pCurrSignature->userDataLimit;
 
-    uint16 lastEntry = 0;
-    uint16 count     = 0;
-    for (uint16 e = spillThreshold; e < userDataLimit; ++e)
+    PAL_ASSERT(spillThreshold < userDataLimit);
+
+    // Walk the dirty flags one wide-bitfield sub-mask at a time using bit-scans, merging each run of consecutive dirty
+    // entries (even one which crosses into the next sub-mask) into a single upload.
+    const uint32 numEntries  = (userDataLimit - spillThreshold);
+    const uint32 firstMaskId = (spillThreshold / UserDataEntriesPerMask);
+    const uint32 lastMaskId  = ((userDataLimit - 1) / UserDataEntriesPerMask);
+
+    uint32 runFirst = 0;
+    uint32 runCount = 0;
+    for (uint32 maskId = firstMaskId; maskId <= lastMaskId; ++maskId)
     {
-        while ((e < userDataLimit) && WideBitfieldIsSet(entries.dirty, e))
-        {
-            PAL_ASSERT((lastEntry == 0) || (lastEntry == (e - 1)));
-            lastEntry = e;
-            ++count;
-            ++e;
-        }
+        uint64 dirtyMask = (entries.dirty[maskId] & WideBitfieldRangeMask<uint64>(maskId, spillThreshold, numEntries));
 
-        if (count > 0)
+        while (dirtyMask != 0)
         {
-            const uint16 firstEntry = (lastEntry - count + 1);
-            pCeCmdSpace = UploadToUserDataTable(pSpillTable,
-                                                firstEntry,
-                                                count,
-                                                &entries.entries[firstEntry],
-                                                userDataLimit,
-                                                pCeCmdSpace);
+            uint32 bit = 0;
+            BitMaskScanForward(&bit, dirtyMask);
+
+            // The run ends at the first clear bit above "bit", or at the end of the sub-mask if there isn't one.
+            uint32 numBits = 0;
+            if (BitMaskScanForward(&numBits, ~(dirtyMask >> bit)) == false)
+            {
+                numBits = (UserDataEntriesPerMask - bit);
+            }
+
+            const uint32 entry = ((maskId * UserDataEntriesPerMask) + bit);
+            if ((runCount > 0) && ((runFirst + runCount) != entry))
+            {
+                pCeCmdSpace = UploadToUserDataTable(pSpillTable,
+                                                    runFirst,
+                                                    runCount,
+                                                    &entries.entries[runFirst],
+                                                    userDataLimit,
+                                                    pCeCmdSpace);
+                runCount = 0;
+            }
+
+            if (runCount == 0)
+            {
+                runFirst = entry;
+            }
 
-            // Reset accumulators for the next packet.
-            lastEntry = 0;
-            count     = 0;
+            runCount  += numBits;
+            dirtyMask &= ~WideBitfieldRangeMask<uint64>(0, bit, numBits);
         }
-    } // for each entry
+    } // for each wide-bitfield sub-mask
+
+    if (runCount > 0)
+    {
+        pCeCmdSpace = UploadToUserDataTable(pSpillTable,
+                                            runFirst,
+                                            runCount,
+                                            &entries.entries[runFirst],
+                                            userDataLimit,
+                                            pCeCmdSpace);
+    }
 
     // NOTE: Both spill tables share the same ring buffer, so when one gets updated, the other must also. This is
     // because there may be a large series of Dispatches between Draws (or vice-versa), so if the buffer wraps, it
@@ -3389,34 +3436,31 @@ uint32* UniversalCmdBuffer::WriteDirtyUserDataEntriesToUserSgprsCs(
     // us get away with only checking the first sub-mask of the user-data entries' wide-bitfield of dirty flags.
     static_assert(MaxFastUserDataEntriesCs <= UserDataEntriesPerMask,
                   "The CS user-data entries mapped to user-SGPR's spans multiple wide-bitfield elements!");
-    constexpr uint32 AllFastUserDataEntriesMask = ((1 << MaxFastUserDataEntriesCs) - 1);
-    uint16 userSgprDirtyMask = (m_computeState.csUserDataEntries.dirty[0] & AllFastUserDataEntriesMask);
+    constexpr uint64 AllFastUserDataEntriesMask = ((static_cast<uint64>(1) << MaxFastUserDataEntriesCs) - 1);
+    uint32 userSgprDirtyMask =
+        static_cast<uint32>(m_computeState.csUserDataEntries.dirty[0] & AllFastUserDataEntriesMask);
 
     // Additionally, dirty compute user-data is always written to user-SGPR's if it could be mapped by a pipeline,
     // which lets us avoid any complex logic when switching pipelines.
     const uint16 baseUserSgpr = FirstUserDataRegAddr[static_cast<uint32>(HwShaderStage::Cs)];
 
-    for (uint16 e = 0; e < MaxFastUserDataEntriesCs; ++e)
+    // Write each run of consecutive dirty entries with a single packet.
+    while (userSgprDirtyMask != 0)
     {
-        const uint16 firstEntry = e;
-        uint16       entryCount = 0;
+        uint32 firstEntry = 0;
+        uint32 entryCount = 0;
+        BitMaskScanForward(&firstEntry, userSgprDirtyMask);
+        BitMaskScanForward(&entryCount, ~(userSgprDirtyMask >> firstEntry));
 
-        while ((e < MaxFastUserDataEntriesCs) && ((userSgprDirtyMask & (1 << e)) != 0))
-        {
-            ++entryCount;
-            ++e;
-        }
+        const uint32 lastEntry = (firstEntry + entryCount - 1);
+        pDeCmdSpace = m_deCmdStream.WriteSetSeqShRegs((baseUserSgpr + firstEntry),
+                                                      (baseUserSgpr + lastEntry),
+                                                      ShaderCompute,
+                                                      &m_computeState.csUserDataEntries.entries[firstEntry],
+                                                      pDeCmdSpace);
 
-        if (entryCount > 0)
-        {
-            const uint16 lastEntry = (firstEntry + entryCount - 1);
-            pDeCmdSpace = m_deCmdStream.WriteSetSeqShRegs((baseUserSgpr + firstEntry),
-                                                          (baseUserSgpr + lastEntry),
-                                                          ShaderCompute,
-                                                          &m_computeState.csUserDataEntries.entries[firstEntry],
-                                                          pDeCmdSpace);
-        }
-    } // for each entry
+        userSgprDirtyMask &= ~(((1u << entryCount) - 1) << firstEntry);
+    }
 
     return pDeCmdSpace;
 }
@@ -3693,31 +3737,12 @@ uint32* UniversalCmdBuffer::ValidateGraphicsUserDataCpu(
         }
         else
         {
-            // Otherwise, use the following loop to check if any of the spilled user-data entries are dirty.
-            const uint32 firstMaskId = (spillThreshold / UserDataEntriesPerMask);
-            const uint32 lastMaskId  = (lastUserData   / UserDataEntriesPerMask);
-            for (uint32 maskId = firstMaskId; maskId <= lastMaskId; ++maskId)
+            // Otherwise, check if any of the spilled user-data entries are dirty.
+            const uint32 numSpilled = (lastUserData - spillThreshold + 1);
+            if (WideBitfieldIsAnySetInRange(m_graphicsState.gfxUserDataEntries.dirty, spillThreshold, numSpilled))
             {
-                uint16 dirtyMask = m_graphicsState.gfxUserDataEntries.dirty[maskId];
-                if (maskId == firstMaskId)
-                {
-                    // Ignore the dirty bits for any entries below the spill threshold.
-                    const uint16 firstEntryInMask = (spillThreshold & (UserDataEntriesPerMask - 1));
-                    dirtyMask &= ~((1 << firstEntryInMask) - 1);
-                }
-                if (maskId == lastMaskId)
-                {
-                    // Ignore the dirty bits for any entries beyond the user-data limit.
-                    const uint16 lastEntryInMask = (lastUserData & (UserDataEntriesPerMask - 1));
-                    dirtyMask &= ((1 << (lastEntryInMask + 1)) - 1);
-                }
-
-                if (dirtyMask != 0)
-                {
-                    reUpload = true;
-                    break; // We only care if *any* spill table contents change!
-                }
-            } // for each wide-bitfield sub-mask
+                reUpload = true; // We only care if *any* spill table contents change!
+            }
         }
 
         // Step #4:
@@ -3880,31 +3905,12 @@ uint32* UniversalCmdBuffer::ValidateComputeUserDataCpu(
         }
         else
         {
-            // Otherwise, use the following loop to check if any of the spilled user-data entries are dirty.
-            const uint32 firstMaskId = (spillThreshold / UserDataEntriesPerMask);
-            const uint32 lastMaskId  = (lastUserData   / UserDataEntriesPerMask);
-            for (uint32 maskId = firstMaskId; maskId <= lastMaskId; ++maskId)
+            // Otherwise, check if any of the spilled user-data entries are dirty.
+            const uint32 numSpilled = (lastUserData - spillThreshold + 1);
+            if (WideBitfieldIsAnySetInRange(m_computeState.csUserDataEntries.dirty, spillThreshold, numSpilled))
             {
-                uint16 dirtyMask = m_computeState.csUserDataEntries.dirty[maskId];
-                if (maskId == firstMaskId)
-                {
-                    // Ignore the dirty bits for any entries below the spill threshold.
-                    const uint16 firstEntryInMask = (spillThreshold & (UserDataEntriesPerMask - 1));
-                    dirtyMask &= ~((1 << firstEntryInMask) - 1);
-                }
-                if (maskId == lastMaskId)
-                {
-                    // Ignore the dirty bits for any entries beyond the user-data limit.
-                    const uint16 lastEntryInMask = (lastUserData & (UserDataEntriesPerMask - 1));
-                    dirtyMask &= ((1 << (lastEntryInMask + 1)) - 1);
-                }
-
-                if (dirtyMask != 0)
-                {
-                    reUpload = true;
-                    break; // We only care if *any* spill table contents change!
-                }
-            } // for each wide-bitfield sub-mask
+                reUpload = true; // We only care if *any* spill table contents change!
+            }
         }
 
         // Step #3:
@@ -4800,6 +4806,8 @@ void UniversalCmdBuffer::CmdLoadGds(
     gpusize           srcMemOffset,
     uint32            size)
 {
+    TrackMemRef(srcGpuMemory);
+
     BuildLoadGds(&m_deCmdStream,
                  &m_cmdUtil,
                  pipePoint,
@@ -4818,6 +4826,8 @@ void UniversalCmdBuffer::CmdStoreGds(
     uint32            size,
     bool              waitForWC)
 {
+    TrackMemRef(dstGpuMemory);
+
     BuildStoreGds(&m_deCmdStream,
                   &m_cmdUtil,
                   pipePoint,
@@ -4933,6 +4943,8 @@ void UniversalCmdBuffer::CmdBeginQuery(
     uint32            slot,
     QueryControlFlags flags)
 {
+    TrackMemRef(queryPool);
+
     static_cast<const QueryPool&>(queryPool).Begin(this, &m_deCmdStream, queryType, slot, flags);
 }
 
@@ -4942,6 +4954,8 @@ void UniversalCmdBuffer::CmdEndQuery(
     QueryType         queryType,
     uint32            slot)
 {
+    TrackMemRef(queryPool);
+
     static_cast<const QueryPool&>(queryPool).End(this, &m_deCmdStream, queryType, slot);
 }
 
@@ -4956,6 +4970,9 @@ void UniversalCmdBuffer::CmdResolveQuery(
     gpusize           dstOffset,
     gpusize           dstStride)
 {
+    TrackMemRef(queryPool);
+    TrackMemRef(dstGpuMemory);
+
     // Resolving a query is not supposed to honor predication.
     const uint32 packetPredicate = PacketPredicate();
     m_gfxCmdBufState.flags.packetPredicate = 0;
@@ -4979,6 +4996,8 @@ void UniversalCmdBuffer::CmdResetQueryPool(
     uint32            startQuery,
     uint32            queryCount)
 {
+    TrackMemRef(queryPool);
+
     static_cast<const QueryPool&>(queryPool).Reset(this, &m_deCmdStream, startQuery, queryCount);
 }
 
@@ -5438,6 +5457,8 @@ void UniversalCmdBuffer::CmdLoadCeRam(
     uint32            ramOffset,        // CE RAM offset, must be 32-byte aligned
     uint32            dwordSize)        // Number of DWORDs to load, must be a multiple of 8
 {
+    TrackMemRef(srcGpuMemory);
+
     uint32* pCeCmdSpace = m_ceCmdStream.ReserveCommands();
     pCeCmdSpace += m_cmdUtil.BuildLoadConstRam(srcGpuMemory.Desc().gpuVirtAddr + memOffset,
                                                (ReservedCeRamBytes + ramOffset),
@@ -5456,6 +5477,8 @@ void UniversalCmdBuffer::CmdDumpCeRam(
     uint32            currRingPos,
     uint32            ringSize)
 {
+    TrackMemRef(dstGpuMemory);
+
     uint32* pCeCmdSpace = m_ceCmdStream.ReserveCommands();
     HandleCeRinging(&m_state, currRingPos, 1, ringSize);
 
@@ -5494,6 +5517,8 @@ void UniversalCmdBuffer::CmdIf(
     uint64            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     // CE and nested command buffers don't support control flow yet.
     PAL_ASSERT(m_ceCmdStream.IsEmpty() && (IsNested() == false));
 
@@ -5526,6 +5551,8 @@ void UniversalCmdBuffer::CmdWhile(
     uint64            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     // CE and nested command buffers don't support control flow yet.
     PAL_ASSERT(m_ceCmdStream.IsEmpty() && (IsNested() == false));
 
@@ -5642,6 +5669,8 @@ void UniversalCmdBuffer::CmdWaitMemoryValue(
     uint32            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     uint32* pCmdSpace = m_deCmdStream.ReserveCommands();
     const GpuMemory* pGpuMemory = static_cast<const GpuMemory*>(&gpuMemory);
 
@@ -5664,6 +5693,8 @@ void UniversalCmdBuffer::CmdWaitBusAddressableMemoryMarker(
     uint32            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     uint32* pCmdSpace = m_deCmdStream.ReserveCommands();
     const GpuMemory* pGpuMemory = static_cast<const GpuMemory*>(&gpuMemory);
 
@@ -5693,6 +5724,16 @@ void UniversalCmdBuffer::CmdSetPredication(
     bool                waitResults,
     bool                accumulateData)
 {
+    if (pQueryPool != nullptr)
+    {
+        TrackMemRef(*pQueryPool);
+    }
+
+    if (pGpuMemory != nullptr)
+    {
+        TrackMemRef(*pGpuMemory);
+    }
+
     PAL_ASSERT((pQueryPool == nullptr) || (pGpuMemory == nullptr));
 
     m_gfxCmdBufState.flags.clientPredicate = ((pQueryPool != nullptr) || (pGpuMemory != nullptr)) ? 1 : 0;
@@ -5734,6 +5775,8 @@ void UniversalCmdBuffer::CmdCopyRegisterToMemory(
     const IGpuMemory& dstGpuMemory,
     gpusize           dstOffset)
 {
+    TrackMemRef(dstGpuMemory);
+
     uint32* pDeCmdSpace = m_deCmdStream.ReserveCommands();
 
     DmaDataInfo dmaData = {};
@@ -5762,6 +5805,7 @@ void UniversalCmdBuffer::CmdExecuteNestedCmdBuffers(
 
         // Track the most recent OS paging fence value across all nested command buffers called from this one.
         m_lastPagingFence = Max(m_lastPagingFence, pCallee->LastPagingFence());
+        TrackMemRefs(*pCallee);
 
         // All user-data entries have been uploaded into CE RAM and GPU memory, so we can safely "call" the nested
         // command buffer's command streams.
@@ -5791,6 +5835,8 @@ void UniversalCmdBuffer::CmdExecuteIndirectCmds(
     uint32                       maximumCount,
     gpusize                      countGpuAddr)
 {
+    TrackMemRef(gpuMemory);
+
     // It is only safe to generate indirect commands on a one-time-submit or exclusive-submit command buffer because
     // there is a potential race condition on the memory used to receive the generated commands.
     PAL_ASSERT(IsOneTimeSubmit() || IsExclusiveSubmit());
@@ -6406,6 +6452,8 @@ void UniversalCmdBuffer::CmdUpdateHiSPretests(
     uint32             firstMip,
     uint32             numMips)
 {
+    TrackMemRef(*pImage);
+
     const Image* pGfx6Image = static_cast<const Image*>(static_cast<const Pal::Image*>(pImage)->GetGfxImage());
 
     if (pGfx6Image->HasHiSPretestsMetaData())
@@ -59,6 +59,7 @@ void SettingsLoader::SetupDefaults()
 {
     // set setting variables to their default values...
     m_settings.enableLoadIndexForObjectBinds = true;
+    m_settings.pipelineRegDeltaCacheSize = 0;
     m_settings.copyDstIsCompressed = CopyDstComprAlwaysAllowGfx10;
 
     m_settings.allowBigPage = 0x3f;
@@ -113,6 +114,8 @@ void SettingsLoader::SetupDefaults()
     m_settings.lateAllocVs = LateAllocVsBehaviorLegacy;
     m_settings.maxTessFactor = 64.0;
     m_settings.numOffchipLdsBuffers = 508;
+    m_settings.growShaderRingsGeometrically = true;
+    m_settings.scratchRingReserveSize = 0;
     m_settings.numTessPatchesPerTg = 0;
     m_settings.offchipLdsBufferSize = OffchipLdsBufferSize8192;
     m_settings.isolineDistributionFactor = 40;
@@ -244,6 +247,11 @@ void SettingsLoader::ReadSettings()
                            &m_settings.enableLoadIndexForObjectBinds,
                            InternalSettingScope::PrivatePalGfx9Key);
 
+    static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pPipelineRegDeltaCacheSizeStr,
+                           Util::ValueType::Uint,
+                           &m_settings.pipelineRegDeltaCacheSize,
+                           InternalSettingScope::PrivatePalGfx9Key);
+
     static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pCopyDstIsCompressedStr,
                            Util::ValueType::Uint,
                            &m_settings.copyDstIsCompressed,
@@ -484,6 +492,16 @@ void SettingsLoader::ReadSettings()
                            &m_settings.numOffchipLdsBuffers,
                            InternalSettingScope::PrivatePalGfx9Key);
 
+    static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pGrowShaderRingsGeometricallyStr,
+                           Util::ValueType::Boolean,
+                           &m_settings.growShaderRingsGeometrically,
+                           InternalSettingScope::PrivatePalGfx9Key);
+
+    static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pScratchRingReserveSizeStr,
+                           Util::ValueType::Uint,
+                           &m_settings.scratchRingReserveSize,
+                           InternalSettingScope::PrivatePalGfx9Key);
+
     static_cast<Pal::Device*>(m_pDevice)->ReadSetting(pNumTessPatchesPerThreadGroupStr,
                            Util::ValueType::Uint,
                            &m_settings.numTessPatchesPerTg,
@@ -1180,6 +1198,11 @@ void SettingsLoader::InitSettingsInfo()
     info.valueSize = sizeof(m_settings.enableLoadIndexForObjectBinds);
     m_settingsInfoMap.Insert(2416072074, info);
 
+    info.type      = SettingType::Uint;
+    info.pValuePtr = &m_settings.pipelineRegDeltaCacheSize;
+    info.valueSize = sizeof(m_settings.pipelineRegDeltaCacheSize);
+    m_settingsInfoMap.Insert(532253770, info);
+
     info.type      = SettingType::Uint;
     info.pValuePtr = &m_settings.copyDstIsCompressed;
     info.valueSize = sizeof(m_settings.copyDstIsCompressed);
@@ -1420,6 +1443,16 @@ void SettingsLoader::InitSettingsInfo()
     info.valueSize = sizeof(m_settings.numOffchipLdsBuffers);
     m_settingsInfoMap.Insert(4150915470, info);
 
+    info.type      = SettingType::Boolean;
+    info.pValuePtr = &m_settings.growShaderRingsGeometrically;
+    info.valueSize = sizeof(m_settings.growShaderRingsGeometrically);
+    m_settingsInfoMap.Insert(1249436745, info);
+
+    info.type      = SettingType::Uint;
+    info.pValuePtr = &m_settings.scratchRingReserveSize;
+    info.valueSize = sizeof(m_settings.scratchRingReserveSize);
+    m_settingsInfoMap.Insert(4170229940, info);
+
     info.type      = SettingType::Uint;
     info.pValuePtr = &m_settings.numTessPatchesPerTg;
     info.valueSize = sizeof(m_settings.numTessPatchesPerTg);
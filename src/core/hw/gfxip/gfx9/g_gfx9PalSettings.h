@@ -179,6 +179,7 @@ enum Gfx9PrefetchCommands : uint32
 struct Gfx9PalSettings : public Pal::DriverSettings
 {
     bool                                        enableLoadIndexForObjectBinds;
+    uint32                                      pipelineRegDeltaCacheSize;
     CopyDstCompr                                copyDstIsCompressed;
 
     uint32                                      allowBigPage;
@@ -233,6 +234,8 @@ struct Gfx9PalSettings : public Pal::DriverSettings
     LateAllocVsBehavior                         lateAllocVs;
     float                                       maxTessFactor;
     uint32                                      numOffchipLdsBuffers;
+    bool                                        growShaderRingsGeometrically;
+    uint32                                      scratchRingReserveSize;
     uint32                                      numTessPatchesPerTg;
     OffchipLdsBufferSize                        offchipLdsBufferSize;
     uint32                                      isolineDistributionFactor;
@@ -355,6 +358,7 @@ struct Gfx9PalSettings : public Pal::DriverSettings
     uint32                                      depthStencilFastClearComputeThresholdMultiSampled;
 };
 static const char* pEnableLoadIndexForObjectBindsStr = "#2416072074";
+static const char* pPipelineRegDeltaCacheSizeStr = "#532253770";
 static const char* pCopyDstIsCompressedStr = "#3919048798";
 
 static const char* pAllowBigPageStr = "#1926167631";
@@ -409,6 +413,8 @@ static const char* pLateAllocGsStr = "#1802508004";
 static const char* pLateAllocVsStr = "#1805023933";
 static const char* pMaxTessFactorStr = "#3272504111";
 static const char* pNumOffchipLdsBuffersStr = "#4150915470";
+static const char* pGrowShaderRingsGeometricallyStr = "#1249436745";
+static const char* pScratchRingReserveSizeStr = "#4170229940";
 static const char* pNumTessPatchesPerThreadGroupStr = "#2699532302";
 static const char* pOffchipLdsBufferSizeStr = "#4262839798";
 static const char* pIsolineDistributionFactorStr = "#951961633";
@@ -529,9 +535,10 @@ static const char* pWaTessIncorrectRelativeIndexStr = "#3815932601";
 static const char* pDepthStencilFastClearComputeThresholdSingleSampledStr = "#2634603321";
 static const char* pDepthStencilFastClearComputeThresholdMultiSampledStr = "#2782857680";
 
-static const uint32 g_gfx9PalNumSettings = 151;
+static const uint32 g_gfx9PalNumSettings = 154;
 static const SettingNameHash g_gfx9PalSettingHashList[] = {
 2416072074,
+532253770,
 3919048798,
 
 1926167631,
@@ -586,6 +593,8 @@ static const SettingNameHash g_gfx9PalSettingHashList[] = {
 1805023933,
 3272504111,
 4150915470,
+1249436745,
+4170229940,
 2699532302,
 4262839798,
 951961633,
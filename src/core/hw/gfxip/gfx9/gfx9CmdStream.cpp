@@ -609,46 +609,51 @@ uint32* CmdStream::WriteUserDataEntriesToSgprsGfx(
     else
     {
         // If we are honoring the dirty flags, then there may be multiple packets because skipping dirty entries
-        // can break the assumption about only writing consecutive registers.
-        for (uint16 sgpr = 0; sgpr < userSgprCount; ++sgpr)
+        // can break the assumption about only writing consecutive registers. Most draws don't dirty any entries, so
+        // check all of the dirty words at once before walking the mapped user-SGPR's one at a time.
+        if (WideBitfieldIsAnySetInRange(entries.dirty, 0, static_cast<uint32>(sizeof(entries.dirty) << 3)))
         {
-            const uint16 packetFirstSgpr = (firstUserSgpr + sgpr);
-            uint16       packetSgprCount = 0;
-
-            uint16 entry = entryMap.mappedEntry[sgpr];
-            while ((sgpr < userSgprCount) && WideBitfieldIsSet(entries.dirty, entry))
+            for (uint16 sgpr = 0; sgpr < userSgprCount; ++sgpr)
             {
-                pCmdPayload[packetSgprCount] = entries.entries[entry];
-                ++packetSgprCount;
-                ++sgpr;
-                entry = entryMap.mappedEntry[sgpr];
-            }
+                const uint16 packetFirstSgpr = (firstUserSgpr + sgpr);
+                uint16       packetSgprCount = 0;
 
-            if (packetSgprCount > 0)
-            {
-                if (Pm4OptImmediate)
+                uint16 entry = entryMap.mappedEntry[sgpr];
+                while ((sgpr < userSgprCount) && WideBitfieldIsSet(entries.dirty, entry))
                 {
-                    PM4_ME_SET_SH_REG setShReg;
-                    m_cmdUtil.BuildSetSeqShRegs(packetFirstSgpr,
-                                                (packetFirstSgpr + packetSgprCount - 1),
-                                                ShaderGraphics,
-                                                &setShReg);
-
-                    pCmdSpace = m_pPm4Optimizer->WriteOptimizedSetSeqShRegs(setShReg, pCmdPayload, pCmdSpace);
+                    pCmdPayload[packetSgprCount] = entries.entries[entry];
+                    ++packetSgprCount;
+                    ++sgpr;
+                    entry = entryMap.mappedEntry[sgpr];
                 }
-                else
+
+                if (packetSgprCount > 0)
                 {
-                    const size_t totalDwords = m_cmdUtil.BuildSetSeqShRegs(packetFirstSgpr,
-                                                                           (packetFirstSgpr + packetSgprCount - 1),
-                                                                           ShaderGraphics,
-                                                                           pCmdSpace);
-                    // The packet is complete and will not be optimized, fix-up pCmdSpace and we're done.
-                    PAL_ASSERT(totalDwords == (packetSgprCount + CmdUtil::ShRegSizeDwords));
-                    pCmdSpace   += totalDwords;
-                    pCmdPayload += totalDwords;
+                    if (Pm4OptImmediate)
+                    {
+                        PM4_ME_SET_SH_REG setShReg;
+                        m_cmdUtil.BuildSetSeqShRegs(packetFirstSgpr,
+                                                    (packetFirstSgpr + packetSgprCount - 1),
+                                                    ShaderGraphics,
+                                                    &setShReg);
+
+                        pCmdSpace = m_pPm4Optimizer->WriteOptimizedSetSeqShRegs(setShReg, pCmdPayload, pCmdSpace);
+                    }
+                    else
+                    {
+                        const size_t totalDwords =
+                            m_cmdUtil.BuildSetSeqShRegs(packetFirstSgpr,
+                                                        (packetFirstSgpr + packetSgprCount - 1),
+                                                        ShaderGraphics,
+                                                        pCmdSpace);
+                        // The packet is complete and will not be optimized, fix-up pCmdSpace and we're done.
+                        PAL_ASSERT(totalDwords == (packetSgprCount + CmdUtil::ShRegSizeDwords));
+                        pCmdSpace   += totalDwords;
+                        pCmdPayload += totalDwords;
+                    }
                 }
-            }
-        } // for each mapped user-SGPR
+            } // for each mapped user-SGPR
+        }
     }
 
     return pCmdSpace;
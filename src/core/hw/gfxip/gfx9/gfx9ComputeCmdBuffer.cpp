@@ -248,6 +248,7 @@ void PAL_STDCALL ComputeCmdBuffer::CmdDispatchIndirect(
     gpusize           offset)
 {
     auto* pThis = static_cast<ComputeCmdBuffer*>(pCmdBuffer);
+    pThis->TrackMemRef(gpuMemory);
 
     if (issueSqttMarkerEvent)
     {
@@ -360,6 +361,9 @@ void ComputeCmdBuffer::CmdCopyMemory(
     uint32                  regionCount,
     const MemoryCopyRegion* pRegions)
 {
+    TrackMemRef(srcGpuMemory);
+    TrackMemRef(dstGpuMemory);
+
     m_device.RsrcProcMgr().CmdCopyMemory(this,
                                          static_cast<const GpuMemory&>(srcGpuMemory),
                                          static_cast<const GpuMemory&>(dstGpuMemory),
@@ -374,6 +378,8 @@ void ComputeCmdBuffer::CmdUpdateMemory(
     gpusize           dataSize,
     const uint32*     pData)
 {
+    TrackMemRef(dstGpuMemory);
+
     PAL_ASSERT(pData != nullptr);
     m_device.RsrcProcMgr().CmdUpdateMemory(this,
                                            static_cast<const GpuMemory&>(dstGpuMemory),
@@ -388,6 +394,8 @@ void ComputeCmdBuffer::CmdUpdateBusAddressableMemoryMarker(
     gpusize           offset,
     uint32            value)
 {
+    TrackMemRef(dstGpuMemory);
+
     const GpuMemory* pGpuMemory = static_cast<const GpuMemory*>(&dstGpuMemory);
     WriteDataInfo    writeData  = {};
 
@@ -408,6 +416,8 @@ void ComputeCmdBuffer::CmdMemoryAtomic(
     uint64            srcData,
     AtomicOp          atomicOp)
 {
+    TrackMemRef(dstGpuMemory);
+
     uint32* pCmdSpace = m_cmdStream.ReserveCommands();
     pCmdSpace += m_cmdUtil.BuildAtomicMem(atomicOp, dstGpuMemory.Desc().gpuVirtAddr + dstOffset, srcData, pCmdSpace);
     m_cmdStream.CommitCommands(pCmdSpace);
@@ -421,6 +431,8 @@ void ComputeCmdBuffer::CmdWriteTimestamp(
     const IGpuMemory& dstGpuMemory,
     gpusize           dstOffset)
 {
+    TrackMemRef(dstGpuMemory);
+
     const gpusize address   = dstGpuMemory.Desc().gpuVirtAddr + dstOffset;
     uint32*       pCmdSpace = m_cmdStream.ReserveCommands();
 
@@ -561,6 +573,14 @@ uint32* ComputeCmdBuffer::ValidateUserData(
                                    spillThreshold,
                                    &m_computeState.csUserDataEntries.entries[0]);
             relocated = true;
+
+            if (RecordsUserDataPatchPoints())
+            {
+                RecordUserDataPatchPoints(PipelineBindPoint::Compute,
+                                          spillThreshold,
+                                          sizeInDwords,
+                                          (m_spillTableCs.pCpuVirtAddr + spillThreshold));
+            }
         }
 
         // Step #3:
@@ -683,38 +703,38 @@ uint32* ComputeCmdBuffer::WriteDirtyUserDataEntries(
     // us get away with only checking the first sub-mask of the user-data entries' wide-bitfield of dirty flags.
     static_assert(MaxFastUserDataEntriesCompute <= UserDataEntriesPerMask,
                   "The CS user-data entries mapped to user-SGPR's spans multiple wide-bitfield elements!");
-    constexpr uint32 AllFastUserDataEntriesMask = ((1 << MaxFastUserDataEntriesCompute) - 1);
-    const uint16 userSgprDirtyMask = (m_computeState.csUserDataEntries.dirty[0] & AllFastUserDataEntriesMask);
+    constexpr uint64 AllFastUserDataEntriesMask = ((static_cast<uint64>(1) << MaxFastUserDataEntriesCompute) - 1);
+    uint32 userSgprDirtyMask =
+        static_cast<uint32>(m_computeState.csUserDataEntries.dirty[0] & AllFastUserDataEntriesMask);
 
     // Additionally, dirty compute user-data is always written to user-SGPR's if it could be mapped by a pipeline,
     // which lets us avoid any complex logic when switching pipelines.
     const uint16 baseUserSgpr = m_device.GetFirstUserDataReg(HwShaderStage::Cs);
 
-    uint16 lastEntry = 0;
-    uint16 count     = 0;
-    for (uint16 e = 0; e < MaxFastUserDataEntriesCompute; ++e)
+    // Write each run of consecutive dirty entries with a single packet.
+    while (userSgprDirtyMask != 0)
     {
-        while ((e < MaxFastUserDataEntriesCompute) && ((userSgprDirtyMask & (1 << e)) != 0))
+        uint32 firstEntry = 0;
+        uint32 entryCount = 0;
+        BitMaskScanForward(&firstEntry, userSgprDirtyMask);
+        BitMaskScanForward(&entryCount, ~(userSgprDirtyMask >> firstEntry));
+
+        if (RecordsUserDataPatchPoints())
         {
-            PAL_ASSERT((lastEntry == 0) || (lastEntry == (e - 1)));
-            lastEntry = e;
-            ++count;
-            ++e;
+            RecordUserDataPatchPoints(PipelineBindPoint::Compute,
+                                      firstEntry,
+                                      entryCount,
+                                      (pCmdSpace + CmdUtil::ShRegSizeDwords));
         }
 
-        if (count > 0)
-        {
-            const uint16 firstEntry = (lastEntry - count + 1);
-            pCmdSpace = m_cmdStream.WriteSetSeqShRegs((baseUserSgpr + firstEntry),
-                                                      (baseUserSgpr + lastEntry),
-                                                      ShaderCompute,
-                                                      &m_computeState.csUserDataEntries.entries[firstEntry],
-                                                      pCmdSpace);
+        const uint32 lastEntry = (firstEntry + entryCount - 1);
+        pCmdSpace = m_cmdStream.WriteSetSeqShRegs((baseUserSgpr + firstEntry),
+                                                  (baseUserSgpr + lastEntry),
+                                                  ShaderCompute,
+                                                  &m_computeState.csUserDataEntries.entries[firstEntry],
+                                                  pCmdSpace);
 
-            // Reset accumulators for the next packet.
-            lastEntry = 0;
-            count     = 0;
-        }
+        userSgprDirtyMask &= ~(((1u << entryCount) - 1) << firstEntry);
     }
 
     // If the currently active pipeline spills any entries to GPU memory, we need to check if any of the dirty
@@ -724,32 +744,16 @@ uint32* ComputeCmdBuffer::WriteDirtyUserDataEntries(
         PAL_ASSERT(m_pSignatureCs->userDataLimit != 0);
 
         // Since the spill table is managed by the CPU in embedded memory, it needs to be fully "re-uploaded" for
-        // each Dispatch whenever any contents change.  Therefore, the following loop just needs to check the
-        // relevant dirty flags and mark the spill table dirty if any were set.
-        const uint32 firstMaskId = (m_pSignatureCs->spillThreshold / UserDataEntriesPerMask);
-        const uint32 lastMaskId  = ((m_pSignatureCs->userDataLimit - 1) / UserDataEntriesPerMask);
-        for (uint32 maskId = firstMaskId; maskId <= lastMaskId; ++maskId)
-        {
-            uint16 dirtyMask = m_computeState.csUserDataEntries.dirty[maskId];
-            if (maskId == firstMaskId)
-            {
-                // Ignore the dirty bits for any entries below the spill threshold.
-                const uint16 firstEntryInMask = (m_pSignatureCs->spillThreshold & (UserDataEntriesPerMask - 1));
-                dirtyMask &= ~((1 << firstEntryInMask) - 1);
-            }
-            if (maskId == lastMaskId)
-            {
-                // Ignore the dirty bits for any entries beyond the user-data limit.
-                const uint16 lastEntryInMask = ((m_pSignatureCs->userDataLimit - 1) & (UserDataEntriesPerMask - 1));
-                dirtyMask &= ((1 << (lastEntryInMask + 1)) - 1);
-            }
+        // each Dispatch whenever any contents change.  Therefore, we just need to check the relevant dirty
+        // flags and mark the spill table dirty if any were set.
+        const uint32 spillThreshold = m_pSignatureCs->spillThreshold;
+        const uint32 spillCount     = (m_pSignatureCs->userDataLimit - spillThreshold);
 
-            if (dirtyMask != 0)
-            {
-                m_spillTableCs.dirty = 1;
-                m_computeState.csUserDataEntries.dirty[maskId] &= ~dirtyMask;
-            }
-        } // for each wide-bitfield sub-mask
+        if (WideBitfieldIsAnySetInRange(m_computeState.csUserDataEntries.dirty, spillThreshold, spillCount))
+        {
+            m_spillTableCs.dirty = 1;
+            WideBitfieldClearRange(m_computeState.csUserDataEntries.dirty, spillThreshold, spillCount);
+        }
     } // if current pipeline spills user-data
 
     // Clear all dirty bits for user-data entries which were written to user-SGPR's.  These are cleared last because
@@ -783,6 +787,8 @@ void ComputeCmdBuffer::CmdBeginQuery(
     uint32            slot,
     QueryControlFlags flags)
 {
+    TrackMemRef(queryPool);
+
     static_cast<const QueryPool&>(queryPool).Begin(this, &m_cmdStream, queryType, slot, flags);
 }
 
@@ -792,6 +798,8 @@ void ComputeCmdBuffer::CmdEndQuery(
     QueryType         queryType,
     uint32            slot)
 {
+    TrackMemRef(queryPool);
+
     static_cast<const QueryPool&>(queryPool).End(this, &m_cmdStream, queryType, slot);
 }
 
@@ -801,6 +809,8 @@ void ComputeCmdBuffer::CmdResetQueryPool(
     uint32            startQuery,
     uint32            queryCount)
 {
+    TrackMemRef(queryPool);
+
     static_cast<const QueryPool&>(queryPool).Reset(this, &m_cmdStream, startQuery, queryCount);
 }
 
@@ -812,6 +822,8 @@ void ComputeCmdBuffer::CmdIf(
     uint64            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     // Nested command buffers don't support control flow yet.
     PAL_ASSERT(IsNested() == false);
 
@@ -844,6 +856,8 @@ void ComputeCmdBuffer::CmdWhile(
     uint64            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     // Nested command buffers don't support control flow yet.
     PAL_ASSERT(IsNested() == false);
 
@@ -867,6 +881,8 @@ void ComputeCmdBuffer::CmdLoadGds(
     gpusize           srcMemOffset,
     uint32            size)
 {
+    TrackMemRef(srcGpuMemory);
+
     BuildLoadGds(&m_cmdStream,
                  &m_cmdUtil,
                  pipePoint,
@@ -885,6 +901,8 @@ void ComputeCmdBuffer::CmdStoreGds(
     uint32            size,
     bool              waitForWC)
 {
+    TrackMemRef(dstGpuMemory);
+
     BuildStoreGds(&m_cmdStream,
                   &m_cmdUtil,
                   pipePoint,
@@ -934,6 +952,8 @@ void ComputeCmdBuffer::CmdCopyRegisterToMemory(
     const IGpuMemory& dstGpuMemory,
     gpusize           dstOffset)
 {
+    TrackMemRef(dstGpuMemory);
+
     uint32* pCmdSpace = m_cmdStream.ReserveCommands();
 
     DmaDataInfo dmaData = {};
@@ -979,6 +999,8 @@ void ComputeCmdBuffer::CmdWaitMemoryValue(
     uint32            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     uint32* pCmdSpace = m_cmdStream.ReserveCommands();
 
     pCmdSpace += m_cmdUtil.BuildWaitRegMem(EngineTypeCompute,
@@ -1000,6 +1022,8 @@ void ComputeCmdBuffer::CmdWaitBusAddressableMemoryMarker(
     uint32            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     const GpuMemory* pGpuMemory = static_cast<const GpuMemory*>(&gpuMemory);
 
     uint32* pCmdSpace = m_cmdStream.ReserveCommands();
@@ -1282,6 +1306,16 @@ void ComputeCmdBuffer::CmdSetPredication(
     bool                waitResults,
     bool                accumulateData)
 {
+    if (pQueryPool != nullptr)
+    {
+        TrackMemRef(*pQueryPool);
+    }
+
+    if (pGpuMemory != nullptr)
+    {
+        TrackMemRef(*pGpuMemory);
+    }
+
     // This emulation doesn't work for QueryPool based predication, fortuanately DX12 just has Boolean type
     // predication. TODO: emulation for Zpass and Streamout predication if they are really used on compute.
     PAL_ASSERT((predType == PredicateType::Boolean) && (pQueryPool == nullptr));
@@ -1328,6 +1362,8 @@ void ComputeCmdBuffer::CmdExecuteIndirectCmds(
     uint32                       maximumCount,
     gpusize                      countGpuAddr)
 {
+    TrackMemRef(gpuMemory);
+
     // It is only safe to generate indirect commands on a one-time-submit or exclusive-submit command buffer because
     // there is a potential race condition on the memory used to receive the generated commands.
     PAL_ASSERT(IsOneTimeSubmit() || IsExclusiveSubmit());
@@ -1472,6 +1508,7 @@ void ComputeCmdBuffer::CmdExecuteNestedCmdBuffers(
 
         // Track the most recent OS paging fence value across all nested command buffers called from this one.
         m_lastPagingFence = Max(m_lastPagingFence, pCallee->LastPagingFence());
+        TrackMemRefs(*pCallee);
 
         // All user-data entries have been uploaded into the GPU memory the callee expects to receive them in, so we
         // can safely "call" the nested command buffer's command stream.
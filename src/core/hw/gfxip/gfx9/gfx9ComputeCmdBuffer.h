@@ -232,6 +232,8 @@ protected:
 
     virtual void InheritStateFromCmdBuf(const GfxCmdBuffer* pCmdBuffer) override;
 
+    virtual bool SupportsUserDataPatching() const override { return true; }
+
 private:
     template <bool issueSqttMarkerEvent>
     static void PAL_STDCALL CmdDispatch(
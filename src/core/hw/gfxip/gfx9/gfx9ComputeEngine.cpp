@@ -91,6 +91,7 @@ Result ComputeEngine::UpdateRingSet(
         // NOTE: If a batched command generates a submit which triggers ring validation we are in deep trouble because
         // some of the commands further down in the batched queue might assume that the preamble stream hasn't been
         // rebuilt. To prevent this, this preprocessing is done before the submission has a chance to be batched.
+        m_pDevice->NotifyRingIdleStall();
         result = WaitIdleAllQueues();
 
         // The queues are idle, so it is safe to validate the rest of the RingSet.
@@ -178,6 +178,8 @@ Device::Device(
               GetFrameCountRegister(pDevice)),
     m_cmdUtil(*this),
     m_queueContextUpdateCounter(0),
+    m_ringReallocationCount(0),
+    m_ringIdleStallCount(0),
     // The default value of MSAA rate is 1xMSAA.
     m_msaaRate(1),
     m_presentResolution({ 0,0 }),
@@ -202,6 +204,12 @@ Device::Device(
 // this device object.
 Result Device::Cleanup()
 {
+#if PAL_ENABLE_PRINTS_ASSERTS
+    PAL_DPINFO("Shader rings: %u video memory reallocations, %u queue idles forced by ring set validation",
+               RingReallocationCount(),
+               RingIdleStallCount());
+#endif
+
     // RsrcProcMgr::Cleanup must be called before GfxDevice::Cleanup because the ShaderCache object referenced by
     // RsrcProcMgr is owned by GfxDevice and gets reset on GfxDevice::Cleanup.
     m_pRsrcProcMgr->Cleanup();
@@ -323,6 +331,18 @@ Result Device::LateInit()
     // If this device has been used before it will need this state zeroed.
     memset(const_cast<ShaderRingItemSizes*>(&m_largestRingSizes), 0, sizeof(m_largestRingSizes));
     m_queueContextUpdateCounter = 0;
+    m_ringReallocationCount     = 0;
+    m_ringIdleStallCount        = 0;
+
+    // Reserve the requested amount of scratch up-front so that the first pipelines which use scratch don't force the
+    // rings to be reallocated. The counter bump makes the first submission on each queue validate its ring set.
+    const uint32 scratchReserve = Settings().scratchRingReserveSize;
+    if (scratchReserve > 0)
+    {
+        m_largestRingSizes.itemSize[static_cast<size_t>(ShaderRingType::ComputeScratch)] = scratchReserve;
+        m_largestRingSizes.itemSize[static_cast<size_t>(ShaderRingType::GfxScratch)]     = scratchReserve;
+        m_queueContextUpdateCounter++;
+    }
 
     return Result::Success;
 }
@@ -1066,13 +1086,28 @@ void Device::UpdateLargestRingSizes(
 {
     const MutexAuto lock(&m_ringSizesLock);
 
+    const Gfx9PalSettings& settings = Settings();
+
     // Loop over all ring sizes and check if the ring sizes need to grow at all.
     bool ringSizesDirty = false;
     for (size_t ring = 0; ring < static_cast<size_t>(ShaderRingType::NumUniversal); ++ring)
     {
-        if (pRingSizesNeeded->itemSize[ring] > m_largestRingSizes.itemSize[ring])
+        size_t itemSize = pRingSizesNeeded->itemSize[ring];
+
+        if (itemSize > m_largestRingSizes.itemSize[ring])
         {
-            m_largestRingSizes.itemSize[ring] = pRingSizesNeeded->itemSize[ring];
+            // Growing a ring idles every queue and rebuilds their preambles, so the scratch and GS/VS rings (whose
+            // item sizes vary from pipeline to pipeline) are grown to the next power of two. An application which
+            // slowly ramps up its scratch usage then only reallocates these rings a handful of times.
+            if (settings.growShaderRingsGeometrically &&
+                ((ring == static_cast<size_t>(ShaderRingType::ComputeScratch)) ||
+                 (ring == static_cast<size_t>(ShaderRingType::GfxScratch))     ||
+                 (ring == static_cast<size_t>(ShaderRingType::GsVs))))
+            {
+                itemSize = Pow2Pad(itemSize);
+            }
+
+            m_largestRingSizes.itemSize[ring] = itemSize;
             ringSizesDirty = true;
         }
     }
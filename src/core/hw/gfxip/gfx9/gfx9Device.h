@@ -362,6 +362,13 @@ public:
     void   GetLargestRingSizes(ShaderRingItemSizes* pRingSizesNeeded);
     uint32 QueueContextUpdateCounter() const { return m_queueContextUpdateCounter; }
 
+    // Statistics for tuning the shader ring growth policy: the number of times an existing shader ring's video memory
+    // was grown and the number of times an engine had to idle all queues to validate its ring set.
+    void   NotifyRingReallocation() { Util::AtomicIncrement(&m_ringReallocationCount); }
+    void   NotifyRingIdleStall() { Util::AtomicIncrement(&m_ringIdleStallCount); }
+    uint32 RingReallocationCount() const { return m_ringReallocationCount; }
+    uint32 RingIdleStallCount() const { return m_ringIdleStallCount; }
+
     virtual Result SetSamplePatternPalette(const SamplePatternPalette& palette) override;
     void GetSamplePatternPalette(SamplePatternPalette* pSamplePatternPalette);
 
@@ -722,6 +729,9 @@ private:
     // will check its watermark against the one owned by the device and update accordingly.
     volatile uint32               m_queueContextUpdateCounter;
 
+    volatile uint32               m_ringReallocationCount; // Number of shader ring video memory reallocations.
+    volatile uint32               m_ringIdleStallCount;    // Number of queue idles forced by ring set validation.
+
     // Tracks the sample pattern palette for sample pos shader ring. Access to this object must be
     // serialized using m_samplePatternLock.
     volatile SamplePatternPalette m_samplePatternPalette;
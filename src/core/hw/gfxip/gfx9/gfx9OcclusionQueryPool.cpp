@@ -29,6 +29,7 @@
 #include "core/hw/gfxip/gfx9/gfx9CmdUtil.h"
 #include "core/hw/gfxip/gfx9/gfx9Device.h"
 #include "core/hw/gfxip/gfx9/gfx9OcclusionQueryPool.h"
+#include "core/hw/gfxip/gfx9/gfx9QueryResults.h"
 #include "core/hw/gfxip/gfx9/gfx9UniversalCmdBuffer.h"
 #include "palCmdBuffer.h"
 #include "palIntervalTreeImpl.h"
@@ -396,72 +397,6 @@ size_t OcclusionQueryPool::GetResultSizeForOneSlot(
     return numResultIntegers * resultIntegerSize;
 }
 
-// =====================================================================================================================
-// Helper function for ComputeResults. It computes the result data according to the given flags, storing all data in
-// integers of type ResultUint. Returns true if all counters were ready. Note that the counters pointer is volatile
-// because the GPU could write them at any time (and if QueryResultWait is set we expect it to do so).
-template <typename ResultUint>
-static bool ComputeResultsForOneSlot(
-    QueryResultFlags                         flags,
-    uint32                                   numTotalRbs,
-    bool                                     isBinary,
-    volatile const OcclusionQueryResultPair* pRbCounters,
-    ResultUint*                              pOutputBuffer)
-{
-    ResultUint result     = 0;
-    bool       queryReady = true;
-
-    // Loop through all the RBs associated with this ASIC.
-    for (uint32 idx = 0; idx < numTotalRbs; idx++)
-    {
-        bool countersReady = false;
-
-        do
-        {
-            // The RBs will set the valid bits when they have written their data. We do not need to skip disabled RBs
-            // because they are initialized to valid with zPassData equal to zero. We will loop here for as long as
-            // necessary if the caller has requested it.
-            countersReady = (pRbCounters[idx].begin.bits.valid == 1) && (pRbCounters[idx].end.bits.valid == 1);
-        }
-        while ((countersReady == false) && TestAnyFlagSet(flags, QueryResultWait));
-
-        if (countersReady)
-        {
-            result += static_cast<ResultUint>(pRbCounters[idx].end.bits.zPassData -
-                                              pRbCounters[idx].begin.bits.zPassData);
-        }
-
-        // The entire query will only be ready if all of its counters were ready.
-        queryReady = queryReady && countersReady;
-    }
-
-    // Store the result in the output buffer if it's legal for us to do so.
-    if (queryReady || TestAnyFlagSet(flags, QueryResultPartial))
-    {
-        if (TestAnyFlagSet(flags, QueryResultAccumulate))
-        {
-            // Accumulate the present data; we do this first so that the if isBinary is set we still get a 0 or 1.
-            result += pOutputBuffer[0];
-        }
-
-        pOutputBuffer[0] = isBinary ? (result != 0) : result;
-    }
-
-    // The caller also wants us to output whether or not the final query results were available. If we're
-    // accumulating data we must AND our data the present data so the caller knows if all queries were available.
-    if (TestAnyFlagSet(flags, QueryResultAvailability))
-    {
-        if (TestAnyFlagSet(flags, QueryResultAccumulate))
-        {
-            queryReady = queryReady && (pOutputBuffer[1] != 0);
-        }
-
-        pOutputBuffer[1] = queryReady;
-    }
-
-    return queryReady;
-}
-
 // =====================================================================================================================
 // Adds up all the results from each RB (stored in pGpuData) and puts the accumulated result in the memory pointed to in
 // pData. This function wraps a template function to reduce code duplication due to selecting between 32-bit and 64-bit
@@ -485,8 +420,8 @@ bool OcclusionQueryPool::ComputeResults(
         const auto* pRbCounters = static_cast<const OcclusionQueryResultPair*>(pGpuData);
 
         const bool queryReady = ((TestAnyFlagSet(flags, QueryResult64Bit))
-            ? ComputeResultsForOneSlot(flags, numTotalRbs, isBinary, pRbCounters, static_cast<uint64*>(pData))
-            : ComputeResultsForOneSlot(flags, numTotalRbs, isBinary, pRbCounters, static_cast<uint32*>(pData)));
+            ? ComputeOcclusionResults(flags, numTotalRbs, isBinary, pRbCounters, static_cast<uint64*>(pData))
+            : ComputeOcclusionResults(flags, numTotalRbs, isBinary, pRbCounters, static_cast<uint32*>(pData)));
 
         allQueriesReady = allQueriesReady && queryReady;
         pGpuData        = VoidPtrInc(pGpuData, GetGpuResultSizeInBytes(1));
@@ -0,0 +1,566 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/hw/gfxip/gfx9/gfx9CmdStream.h"
+#include "core/hw/gfxip/gfx9/gfx9CmdUtil.h"
+#include "core/hw/gfxip/gfx9/gfx9Device.h"
+#include "core/hw/gfxip/gfx9/gfx9GraphicsPipeline.h"
+#include "core/hw/gfxip/gfx9/gfx9PipelineRegDeltaCache.h"
+#include "palInlineFuncs.h"
+
+using namespace Util;
+
+namespace Pal
+{
+namespace Gfx9
+{
+
+// =====================================================================================================================
+PipelineRegDeltaCache::PipelineRegDeltaCache(
+    const Device& device,
+    uint32        numEntries)
+    :
+    m_device(device),
+    m_numEntries(numEntries),
+    m_pImages(nullptr),
+    m_pDeltas(nullptr),
+    m_pCurImage(nullptr),
+    m_useCounter(0),
+    m_lastBindWroteDelta(false)
+{
+    // An image can't be replaced while it is programmed in hardware, so at least two are needed to capture a new one.
+    PAL_ASSERT((numEntries == 0) || (numEntries >= 2));
+}
+
+// =====================================================================================================================
+PipelineRegDeltaCache::~PipelineRegDeltaCache()
+{
+    // The deltas share the images' allocation.
+    PAL_SAFE_FREE(m_pImages, m_device.GetPlatform());
+}
+
+// =====================================================================================================================
+// Allocates the cache entries. The cache stays disabled if it was created with no entries.
+Result PipelineRegDeltaCache::Init()
+{
+    Result result = Result::Success;
+
+    if (m_numEntries > 0)
+    {
+        const size_t imagesSize = (sizeof(RegImage) * m_numEntries);
+        const size_t deltasSize = (sizeof(RegDelta) * m_numEntries);
+
+        void*const pMemory = PAL_MALLOC(imagesSize + deltasSize, m_device.GetPlatform(), AllocInternal);
+
+        if (pMemory == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+        else
+        {
+            m_pImages = static_cast<RegImage*>(pMemory);
+            m_pDeltas = static_cast<RegDelta*>(VoidPtrInc(pMemory, imagesSize));
+
+            Reset();
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Discards every cached image and delta. Must be called whenever the owning command buffer begins recording because
+// pipeline objects may have been destroyed (and their addresses reused) since the last time it recorded.
+void PipelineRegDeltaCache::Reset()
+{
+    if (IsEnabled())
+    {
+        for (uint32 idx = 0; idx < m_numEntries; ++idx)
+        {
+            m_pImages[idx].pPipeline = nullptr;
+            m_pDeltas[idx].pFrom     = nullptr;
+        }
+    }
+
+    m_pCurImage          = nullptr;
+    m_useCounter         = 0;
+    m_lastBindWroteDelta = false;
+}
+
+// =====================================================================================================================
+// Writes the commands which bind the given pipeline's SH registers and, if writeContext is set, its context registers.
+// The caller is expected to skip the context registers when the previous pipeline's context PM4 image was identical.
+// Returns the next unused DWORD in pCmdSpace.
+uint32* PipelineRegDeltaCache::WritePipelineBind(
+    const GraphicsPipeline&           pipeline,
+    const DynamicGraphicsShaderInfos& dynamicInfo,
+    bool                              writeContext,
+    CmdStream*                        pCmdStream,
+    uint32*                           pCmdSpace)
+{
+    PAL_ASSERT(IsEnabled());
+
+    ++m_useCounter;
+
+    RegImage* pImage = FindImage(pipeline, dynamicInfo);
+    RegDelta* pDelta = nullptr;
+
+    if ((pImage != nullptr) && (m_pCurImage != nullptr))
+    {
+        pDelta = FindDelta(m_pCurImage, pImage);
+
+        if (pDelta == nullptr)
+        {
+            pDelta = BuildDelta(m_pCurImage, pImage);
+        }
+
+        pDelta->lastUse = m_useCounter;
+        pImage->lastUse = m_useCounter;
+    }
+
+    m_lastBindWroteDelta = ((pDelta != nullptr) && (pDelta->tooLarge == false));
+
+    if (m_lastBindWroteDelta)
+    {
+        const uint32 numSpaces = (writeContext ? RegSpaceCount : (RegSpaceSh + 1));
+
+        for (uint32 space = 0; space < numSpaces; ++space)
+        {
+            if (pDelta->numDwords[space] > 0)
+            {
+                pCmdSpace = pCmdStream->WritePm4Image(pDelta->numDwords[space], &pDelta->dwords[space][0], pCmdSpace);
+            }
+
+            if (pImage->numFixedDwords[space] > 0)
+            {
+                pCmdSpace = pCmdStream->WritePm4Image(pImage->numFixedDwords[space],
+                                                      &pImage->fixedDwords[space][0],
+                                                      pCmdSpace);
+            }
+        }
+    }
+    else
+    {
+        const uint32*const pShCmds = pCmdSpace;
+        pCmdSpace = pipeline.WriteShCommands(pCmdStream, pCmdSpace, dynamicInfo);
+
+        const uint32*const pCtxCmds = pCmdSpace;
+        if (writeContext)
+        {
+            pCmdSpace = pipeline.WriteContextCommands(pCmdStream, pCmdSpace);
+        }
+
+        if (pImage == nullptr)
+        {
+            pImage = CaptureImage(pipeline, dynamicInfo, pShCmds, pCtxCmds, pCmdSpace, writeContext);
+        }
+    }
+
+    // If the new pipeline's image couldn't be captured then we no longer know what is programmed in hardware.
+    m_pCurImage = pImage;
+
+    return pCmdSpace;
+}
+
+// =====================================================================================================================
+// Returns the cached register image of the given pipeline and dynamic shader infos, or null if there isn't one.
+PipelineRegDeltaCache::RegImage* PipelineRegDeltaCache::FindImage(
+    const GraphicsPipeline&           pipeline,
+    const DynamicGraphicsShaderInfos& dynamicInfo
+    ) const
+{
+    RegImage* pImage = nullptr;
+
+    for (uint32 idx = 0; idx < m_numEntries; ++idx)
+    {
+        if ((m_pImages[idx].pPipeline == &pipeline) &&
+            (memcmp(&m_pImages[idx].dynamicInfo, &dynamicInfo, sizeof(dynamicInfo)) == 0))
+        {
+            pImage = &m_pImages[idx];
+            break;
+        }
+    }
+
+    return pImage;
+}
+
+// =====================================================================================================================
+// Builds a register image from the commands which were just written to bind the given pipeline. The SH commands span
+// [pShCmds, pCtxCmds) and the context commands span [pCtxCmds, pCmdEnd). If the context commands were skipped, they
+// must match those of the image currently programmed in hardware. Returns null if an image couldn't be built.
+PipelineRegDeltaCache::RegImage* PipelineRegDeltaCache::CaptureImage(
+    const GraphicsPipeline&           pipeline,
+    const DynamicGraphicsShaderInfos& dynamicInfo,
+    const uint32*                     pShCmds,
+    const uint32*                     pCtxCmds,
+    const uint32*                     pCmdEnd,
+    bool                              contextWritten)
+{
+    // Replace an unused image if there is one, otherwise the least recently used one. The image programmed in hardware
+    // is needed to capture context registers which weren't written, and to build the delta for the next bind.
+    RegImage* pImage = nullptr;
+
+    for (uint32 idx = 0; idx < m_numEntries; ++idx)
+    {
+        RegImage*const pEntry = &m_pImages[idx];
+
+        if (pEntry != m_pCurImage)
+        {
+            if (pEntry->pPipeline == nullptr)
+            {
+                pImage = pEntry;
+                break;
+            }
+            else if ((pImage == nullptr) || (pEntry->lastUse < pImage->lastUse))
+            {
+                pImage = pEntry;
+            }
+        }
+    }
+
+    PAL_ASSERT(pImage != nullptr);
+
+    if (pImage->pPipeline != nullptr)
+    {
+        // Every delta to or from the replaced image is now stale.
+        for (uint32 idx = 0; idx < m_numEntries; ++idx)
+        {
+            if ((m_pDeltas[idx].pFrom == pImage) || (m_pDeltas[idx].pTo == pImage))
+            {
+                m_pDeltas[idx].pFrom = nullptr;
+            }
+        }
+
+        pImage->pPipeline = nullptr;
+    }
+
+    bool success = ParseCommands(pShCmds, pCtxCmds, RegSpaceSh, pImage);
+
+    if (success)
+    {
+        if (contextWritten)
+        {
+            success = ParseCommands(pCtxCmds, pCmdEnd, RegSpaceContext, pImage);
+        }
+        else if (m_pCurImage != nullptr)
+        {
+            pImage->numRegs[RegSpaceContext]        = m_pCurImage->numRegs[RegSpaceContext];
+            pImage->numFixedDwords[RegSpaceContext] = m_pCurImage->numFixedDwords[RegSpaceContext];
+
+            memcpy(&pImage->regs[RegSpaceContext][0],
+                   &m_pCurImage->regs[RegSpaceContext][0],
+                   (sizeof(RegPair) * m_pCurImage->numRegs[RegSpaceContext]));
+            memcpy(&pImage->fixedDwords[RegSpaceContext][0],
+                   &m_pCurImage->fixedDwords[RegSpaceContext][0],
+                   (sizeof(uint32) * m_pCurImage->numFixedDwords[RegSpaceContext]));
+        }
+        else
+        {
+            success = false;
+        }
+    }
+
+    if (success)
+    {
+        pImage->pPipeline   = &pipeline;
+        pImage->dynamicInfo = dynamicInfo;
+        pImage->lastUse     = m_useCounter;
+    }
+    else
+    {
+        pImage = nullptr;
+    }
+
+    return pImage;
+}
+
+// =====================================================================================================================
+// Splits the PM4 commands in [pCmds, pCmdEnd) into the registers set by SET packets of the given register space and
+// the packets which must be re-sent on every bind. Returns false if they don't fit in the image.
+bool PipelineRegDeltaCache::ParseCommands(
+    const uint32* pCmds,
+    const uint32* pCmdEnd,
+    RegSpace      space,
+    RegImage*     pImage
+    ) const
+{
+    static_assert(CmdUtil::ShRegSizeDwords == CmdUtil::ContextRegSizeDwords,
+                  "SET_SH_REG and SET_CONTEXT_REG packets are expected to have the same layout.");
+
+    const uint32 setOpcode = (space == RegSpaceSh) ? IT_SET_SH_REG : IT_SET_CONTEXT_REG;
+
+    RegPair*const pRegs          = &pImage->regs[space][0];
+    uint32*const  pFixedDwords   = &pImage->fixedDwords[space][0];
+    uint32        numRegs        = 0;
+    uint32        numFixedDwords = 0;
+    bool          success        = true;
+
+    while (success && (pCmds < pCmdEnd))
+    {
+        const auto& header = reinterpret_cast<const PM4_PFP_TYPE_3_HEADER&>(*pCmds);
+
+        // Pipelines only write TYPE 3 packets.
+        PAL_ASSERT(header.type == 3);
+
+        uint32 packetDwords = (header.count + 2);
+
+        if (header.opcode == IT_NOP)
+        {
+            // Gfx9 ASICs have a one DWORD type-3 NOP packet. If the size field is its maximum value (0x3FFF), then the
+            // CP interprets this as having a size of one. NOPs are dropped from the image.
+            if (header.count == 0x3FFF)
+            {
+                packetDwords = 1;
+            }
+        }
+        else if (header.opcode == setOpcode)
+        {
+            // SET_SH_REG and SET_CONTEXT_REG share a layout: the offset of the first register follows the header,
+            // followed by the values of consecutive registers.
+            const uint32 regOffset = reinterpret_cast<const PM4_PFP_SET_CONTEXT_REG&>(*pCmds).bitfields2.reg_offset;
+            const uint32 setCount  = (packetDwords - CmdUtil::ContextRegSizeDwords);
+
+            if ((numRegs + setCount) > MaxImageRegs)
+            {
+                success = false;
+            }
+            else
+            {
+                for (uint32 idx = 0; idx < setCount; ++idx)
+                {
+                    pRegs[numRegs].offset = (regOffset + idx);
+                    pRegs[numRegs].value  = pCmds[CmdUtil::ContextRegSizeDwords + idx];
+                    numRegs++;
+                }
+            }
+        }
+        else if ((numFixedDwords + packetDwords) > MaxFixedDwords)
+        {
+            success = false;
+        }
+        else
+        {
+            memcpy(&pFixedDwords[numFixedDwords], pCmds, (sizeof(uint32) * packetDwords));
+            numFixedDwords += packetDwords;
+        }
+
+        pCmds += packetDwords;
+    }
+
+    if (success)
+    {
+        // Sort the registers by offset. The images are mostly sorted already, so an insertion sort is cheap. Being a
+        // stable sort, it leaves the last value written to a register after any earlier ones.
+        for (uint32 idx = 1; idx < numRegs; ++idx)
+        {
+            const RegPair reg = pRegs[idx];
+
+            uint32 pos = idx;
+            while ((pos > 0) && (pRegs[pos - 1].offset > reg.offset))
+            {
+                pRegs[pos] = pRegs[pos - 1];
+                pos--;
+            }
+
+            pRegs[pos] = reg;
+        }
+
+        uint32 numUniqueRegs = 0;
+        for (uint32 idx = 0; idx < numRegs; ++idx)
+        {
+            if ((numUniqueRegs > 0) && (pRegs[numUniqueRegs - 1].offset == pRegs[idx].offset))
+            {
+                pRegs[numUniqueRegs - 1] = pRegs[idx];
+            }
+            else
+            {
+                pRegs[numUniqueRegs++] = pRegs[idx];
+            }
+        }
+
+        pImage->numRegs[space]        = numUniqueRegs;
+        pImage->numFixedDwords[space] = numFixedDwords;
+    }
+
+    return success;
+}
+
+// =====================================================================================================================
+// Returns the cached delta between the two given images, or null if there isn't one.
+PipelineRegDeltaCache::RegDelta* PipelineRegDeltaCache::FindDelta(
+    const RegImage* pFrom,
+    const RegImage* pTo
+    ) const
+{
+    RegDelta* pDelta = nullptr;
+
+    for (uint32 idx = 0; idx < m_numEntries; ++idx)
+    {
+        if ((m_pDeltas[idx].pFrom == pFrom) && (m_pDeltas[idx].pTo == pTo))
+        {
+            pDelta = &m_pDeltas[idx];
+            break;
+        }
+    }
+
+    return pDelta;
+}
+
+// =====================================================================================================================
+// Builds the SET packets which switch the hardware from one image to another, replacing an unused or the least
+// recently used delta. Deltas which don't fit are still cached (marked as too large) so they aren't rebuilt on every
+// bind.
+PipelineRegDeltaCache::RegDelta* PipelineRegDeltaCache::BuildDelta(
+    const RegImage* pFrom,
+    const RegImage* pTo)
+{
+    RegDelta* pDelta = nullptr;
+
+    for (uint32 idx = 0; idx < m_numEntries; ++idx)
+    {
+        RegDelta*const pEntry = &m_pDeltas[idx];
+
+        if (pEntry->pFrom == nullptr)
+        {
+            pDelta = pEntry;
+            break;
+        }
+        else if ((pDelta == nullptr) || (pEntry->lastUse < pDelta->lastUse))
+        {
+            pDelta = pEntry;
+        }
+    }
+
+    pDelta->pFrom    = pFrom;
+    pDelta->pTo      = pTo;
+    pDelta->tooLarge = ((BuildSpaceDelta(*pFrom, *pTo, RegSpaceSh,      pDelta) == false) ||
+                        (BuildSpaceDelta(*pFrom, *pTo, RegSpaceContext, pDelta) == false));
+
+    return pDelta;
+}
+
+// =====================================================================================================================
+// Builds the SET packets for one register space of a delta: every register in the "to" image whose value differs from
+// (or is missing in) the "from" image. Registers only in the "from" image are left alone, exactly as writing the full
+// "to" image would. Returns false if the packets don't fit in the delta.
+bool PipelineRegDeltaCache::BuildSpaceDelta(
+    const RegImage& from,
+    const RegImage& to,
+    RegSpace        space,
+    RegDelta*       pDelta
+    ) const
+{
+    const CmdUtil& cmdUtil = m_device.CmdUtil();
+
+    const RegPair*const pFromRegs = &from.regs[space][0];
+    const RegPair*const pToRegs   = &to.regs[space][0];
+    const uint32        numFrom   = from.numRegs[space];
+    const uint32        numTo     = to.numRegs[space];
+
+    bool changed[MaxImageRegs];
+
+    uint32 fromIdx = 0;
+    for (uint32 toIdx = 0; toIdx < numTo; ++toIdx)
+    {
+        while ((fromIdx < numFrom) && (pFromRegs[fromIdx].offset < pToRegs[toIdx].offset))
+        {
+            fromIdx++;
+        }
+
+        changed[toIdx] = ((fromIdx == numFrom)                                    ||
+                          (pFromRegs[fromIdx].offset != pToRegs[toIdx].offset) ||
+                          (pFromRegs[fromIdx].value  != pToRegs[toIdx].value));
+    }
+
+    const uint32 headerDwords = (space == RegSpaceSh) ? CmdUtil::ShRegSizeDwords : CmdUtil::ContextRegSizeDwords;
+    const uint32 regBase      = (space == RegSpaceSh) ? PERSISTENT_SPACE_START : CONTEXT_SPACE_START;
+
+    uint32* const pDwords   = &pDelta->dwords[space][0];
+    uint32        numDwords = 0;
+    bool          fits      = true;
+
+    uint32 first = 0;
+    while (fits && (first < numTo))
+    {
+        if (changed[first])
+        {
+            // Extend the packet over consecutive registers. Rewriting a few unchanged registers between two changed
+            // ones costs no more than the header of a second packet.
+            uint32 last = first;
+            for (uint32 next = (first + 1);
+                 ((next < numTo)                                               &&
+                  (pToRegs[next].offset == (pToRegs[next - 1].offset + 1)) &&
+                  ((next - last) <= (MaxBridgedRegs + 1)));
+                 ++next)
+            {
+                if (changed[next])
+                {
+                    last = next;
+                }
+            }
+
+            const uint32 numRegs = (last - first + 1);
+
+            if ((numDwords + headerDwords + numRegs) > MaxDeltaDwords)
+            {
+                fits = false;
+            }
+            else
+            {
+                uint32*const pPacket  = &pDwords[numDwords];
+                const uint32 startReg = (regBase + pToRegs[first].offset);
+                const uint32 endReg   = (regBase + pToRegs[last].offset);
+
+                if (space == RegSpaceSh)
+                {
+                    numDwords += static_cast<uint32>(
+                        cmdUtil.BuildSetSeqShRegs(startReg, endReg, ShaderGraphics, pPacket));
+                }
+                else
+                {
+                    numDwords += static_cast<uint32>(cmdUtil.BuildSetSeqContextRegs(startReg, endReg, pPacket));
+                }
+
+                for (uint32 idx = 0; idx < numRegs; ++idx)
+                {
+                    pPacket[headerDwords + idx] = pToRegs[first + idx].value;
+                }
+            }
+
+            first = (last + 1);
+        }
+        else
+        {
+            first++;
+        }
+    }
+
+    pDelta->numDwords[space] = numDwords;
+
+    return fits;
+}
+
+} // Gfx9
+} // Pal
@@ -0,0 +1,149 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "pal.h"
+#include "palCmdBuffer.h"
+
+namespace Pal
+{
+namespace Gfx9
+{
+
+class CmdStream;
+class Device;
+class GraphicsPipeline;
+
+// =====================================================================================================================
+// A bounded per-command-buffer cache of the differences between the register state of pairs of graphics pipelines.
+//
+// Binding a pipeline normally writes every register in its PM4 image, even though renderers tend to alternate between a
+// handful of pipelines which share most of their register values. The first time a pipeline is bound with a given set
+// of dynamic shader infos, the SET_SH_REG and SET_CONTEXT_REG packets it writes are captured as a register image. Once
+// the images of both the previous and the new pipeline are known, binding the new pipeline only writes the registers
+// whose values differ, plus any non-SET packets (SET_SH_REG_INDEX, RMW, events, etc.) which are re-sent on every bind.
+// The delta packets are saved so that the next switch between the same two pipelines is a single copy.
+//
+// Like the context PM4 image hash, this relies on nothing but pipeline binds writing the registers found in pipeline
+// images. Anything which leaves the hardware state unknown (e.g., executing a nested command buffer) must call
+// InvalidateHwState().
+class PipelineRegDeltaCache
+{
+public:
+    PipelineRegDeltaCache(const Device& device, uint32 numEntries);
+    ~PipelineRegDeltaCache();
+
+    Result Init();
+    void Reset();
+
+    bool IsEnabled() const { return (m_pImages != nullptr); }
+
+    // Forgets which pipeline's registers are currently programmed, forcing the next bind to write its full image.
+    void InvalidateHwState() { m_pCurImage = nullptr; }
+
+    uint32* WritePipelineBind(
+        const GraphicsPipeline&           pipeline,
+        const DynamicGraphicsShaderInfos& dynamicInfo,
+        bool                              writeContext,
+        CmdStream*                        pCmdStream,
+        uint32*                           pCmdSpace);
+
+    // Returns true if the most recent call to WritePipelineBind() wrote a register delta instead of a full image.
+    bool LastBindWroteDelta() const { return m_lastBindWroteDelta; }
+
+private:
+    // Register spaces tracked by each image. Each space is written separately because the context registers are
+    // skipped entirely when the new pipeline's context PM4 image matches the previous one.
+    enum RegSpace : uint32
+    {
+        RegSpaceSh = 0,
+        RegSpaceContext,
+        RegSpaceCount
+    };
+
+    static constexpr uint32 MaxImageRegs    = 128; // Registers tracked per space in each image.
+    static constexpr uint32 MaxFixedDwords  = 64;  // DWORDs of non-SET packets saved per space in each image.
+    static constexpr uint32 MaxDeltaDwords  = 128; // DWORDs of SET packets saved per space in each delta.
+    static constexpr uint32 MaxBridgedRegs  = 2;   // Unchanged registers worth rewriting to avoid a new SET packet.
+
+    // Offset (from the start of its register space) and value of a register written by a SET packet.
+    struct RegPair
+    {
+        uint32 offset;
+        uint32 value;
+    };
+
+    // The register state written by binding one pipeline with one set of dynamic shader infos.
+    struct RegImage
+    {
+        const GraphicsPipeline*    pPipeline; // Null if this entry is unused.
+        DynamicGraphicsShaderInfos dynamicInfo;
+        uint64                     lastUse;
+        uint32                     numRegs[RegSpaceCount];
+        uint32                     numFixedDwords[RegSpaceCount];
+        RegPair                    regs[RegSpaceCount][MaxImageRegs];        // Sorted by offset.
+        uint32                     fixedDwords[RegSpaceCount][MaxFixedDwords];
+    };
+
+    // The SET packets needed to switch the hardware from one register image to another.
+    struct RegDelta
+    {
+        const RegImage* pFrom;    // Null if this entry is unused.
+        const RegImage* pTo;
+        uint64          lastUse;
+        bool            tooLarge; // The delta didn't fit in this entry; the full image must be written instead.
+        uint32          numDwords[RegSpaceCount];
+        uint32          dwords[RegSpaceCount][MaxDeltaDwords];
+    };
+
+    RegImage* FindImage(const GraphicsPipeline& pipeline, const DynamicGraphicsShaderInfos& dynamicInfo) const;
+    RegImage* CaptureImage(
+        const GraphicsPipeline&           pipeline,
+        const DynamicGraphicsShaderInfos& dynamicInfo,
+        const uint32*                     pShCmds,
+        const uint32*                     pCtxCmds,
+        const uint32*                     pCmdEnd,
+        bool                              contextWritten);
+    bool ParseCommands(const uint32* pCmds, const uint32* pCmdEnd, RegSpace space, RegImage* pImage) const;
+
+    RegDelta* FindDelta(const RegImage* pFrom, const RegImage* pTo) const;
+    RegDelta* BuildDelta(const RegImage* pFrom, const RegImage* pTo);
+    bool BuildSpaceDelta(const RegImage& from, const RegImage& to, RegSpace space, RegDelta* pDelta) const;
+
+    const Device&          m_device;
+    const uint32           m_numEntries;  // Number of image entries and of delta entries.
+    RegImage*              m_pImages;
+    RegDelta*              m_pDeltas;
+    const RegImage*        m_pCurImage;   // Image currently programmed in hardware, or null if that is unknown.
+    uint64                 m_useCounter;  // Incremented on each bind to order entries for replacement.
+    bool                   m_lastBindWroteDelta;
+
+    PAL_DISALLOW_DEFAULT_CTOR(PipelineRegDeltaCache);
+    PAL_DISALLOW_COPY_AND_ASSIGN(PipelineRegDeltaCache);
+};
+
+} // Gfx9
+} // Pal
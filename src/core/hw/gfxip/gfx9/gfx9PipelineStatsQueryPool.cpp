@@ -29,6 +29,7 @@
 #include "core/hw/gfxip/gfx9/gfx9CmdUtil.h"
 #include "core/hw/gfxip/gfx9/gfx9Device.h"
 #include "core/hw/gfxip/gfx9/gfx9PipelineStatsQueryPool.h"
+#include "core/hw/gfxip/gfx9/gfx9QueryResults.h"
 #include "palCmdBuffer.h"
 
 using namespace Util;
@@ -70,9 +71,10 @@ struct PipelineStatsLayoutData
     uint32                  counterOffset; // The offset in QWORDs to this stat inside of a Gfx9ipelineStatsData.
 };
 
-static constexpr uint32  PipelineStatsMaxNumCounters       = sizeof(Gfx9PipelineStatsData) / sizeof(uint64);
+static_assert(PipelineStatsMaxNumCounters == (sizeof(Gfx9PipelineStatsData) / sizeof(uint64)),
+              "PipelineStatsMaxNumCounters doesn't match the hardware layout.");
+
 static constexpr uint32  PipelineStatsResetMemValue32      = 0xFFFFFFFF;
-static constexpr uint64  PipelineStatsResetMemValue64      = 0xFFFFFFFFFFFFFFFF;
 static constexpr gpusize PipelineStatsQueryMemoryAlignment = 8;
 
 // All other clients use this layout.
@@ -404,84 +406,6 @@ size_t PipelineStatsQueryPool::GetResultSizeForOneSlot(
     return numResultIntegers * resultIntegerSize;
 }
 
-// =====================================================================================================================
-// Helper function for ComputeResults. It computes the result data according to the given flags, storing all data in
-// integers of type ResultUint. Returns true if all counters were ready. Note that the counter pointers are volatile
-// because the GPU could write them at any time (and if QueryResultWait is set we expect it to do so).
-template <typename ResultUint>
-static bool ComputeResultsForOneSlot(
-    QueryResultFlags       resultFlags,
-    uint32                 enableStatsFlags,
-    volatile const uint64* pBeginCounters,
-    volatile const uint64* pEndCounters,
-    ResultUint*            pOutputBuffer)
-{
-    // Unless QueryResultPartial is set, we can't touch the destination buffer if some results aren't ready. We will
-    // store our results in here until we know whether or not it's safe to write to the output buffer.
-    ResultUint results[PipelineStatsMaxNumCounters] = {};
-    uint32     numStatsEnabled = 0;
-    bool       queryReady      = true;
-
-    for (uint32 layoutIdx = 0; layoutIdx < PipelineStatsMaxNumCounters; ++layoutIdx)
-    {
-        // Filter out stats that are not enabled for this pool.
-        if (TestAnyFlagSet(enableStatsFlags, PipelineStatsLayout[layoutIdx].statFlag))
-        {
-            const uint32 counterOffset = PipelineStatsLayout[layoutIdx].counterOffset;
-            bool         countersReady = false;
-
-            do
-            {
-                // If the initial value is still in one of the counters it implies that the query hasn't finished yet.
-                // We will loop here for as long as necessary if the caller has requested it.
-                countersReady = ((pBeginCounters[counterOffset] != PipelineStatsResetMemValue64) &&
-                                 (pEndCounters[counterOffset]   != PipelineStatsResetMemValue64));
-            }
-            while ((countersReady == false) && TestAnyFlagSet(resultFlags, QueryResultWait));
-
-            if (countersReady)
-            {
-                results[numStatsEnabled] = static_cast<ResultUint>(pEndCounters[counterOffset] -
-                                                                   pBeginCounters[counterOffset]);
-            }
-
-            // The entire query will only be ready if all of its counters were ready.
-            queryReady = queryReady && countersReady;
-
-            numStatsEnabled++;
-        }
-    }
-
-    // Store the results in the output buffer if it's legal for us to do so.
-    if (queryReady || TestAnyFlagSet(resultFlags, QueryResultPartial))
-    {
-        // Accumulate the present data.
-        if (TestAnyFlagSet(resultFlags, QueryResultAccumulate))
-        {
-            for (uint32 idx = 0; idx < numStatsEnabled; ++idx)
-            {
-                results[idx] += pOutputBuffer[idx];
-            }
-        }
-
-        memcpy(pOutputBuffer, results, numStatsEnabled * sizeof(ResultUint));
-    }
-
-    // The caller also wants us to output whether or not the final query results were available. If we're
-    // accumulating data we must AND our data the present data so the caller knows if all queries were available.
-    if (TestAnyFlagSet(resultFlags, QueryResultAvailability))
-    {
-        if (TestAnyFlagSet(resultFlags, QueryResultAccumulate))
-        {
-            queryReady = queryReady && (pOutputBuffer[numStatsEnabled] != 0);
-        }
-
-        pOutputBuffer[numStatsEnabled] = queryReady;
-    }
-
-    return queryReady;
-}
-
 // =====================================================================================================================
 // Gets the pipeline statistics data pointed to by pGpuData. This function wraps a template function to reduce code
 // duplication due to selecting between 32-bit and 64-bit results. Returns true if all counters were ready.
@@ -495,6 +419,18 @@ bool PipelineStatsQueryPool::ComputeResults(
 {
     PAL_ASSERT(queryType == QueryType::PipelineStats);
 
+    // Filter out stats that are not enabled for this pool once rather than for every slot.
+    uint32 counterOffsets[PipelineStatsMaxNumCounters];
+    uint32 numStatsEnabled = 0;
+
+    for (uint32 layoutIdx = 0; layoutIdx < PipelineStatsMaxNumCounters; ++layoutIdx)
+    {
+        if (TestAnyFlagSet(m_createInfo.enabledStats, PipelineStatsLayout[layoutIdx].statFlag))
+        {
+            counterOffsets[numStatsEnabled++] = PipelineStatsLayout[layoutIdx].counterOffset;
+        }
+    }
+
     bool allQueriesReady = true;
     for (uint32 queryIdx = 0; queryIdx < queryCount; ++queryIdx)
     {
@@ -503,8 +439,10 @@ bool PipelineStatsQueryPool::ComputeResults(
         const uint64*    pEnd     = reinterpret_cast<const uint64*>(&pGpuPair->end);
 
         const bool queryReady = ((TestAnyFlagSet(flags, QueryResult64Bit))
-            ? ComputeResultsForOneSlot(flags, m_createInfo.enabledStats, pBegin, pEnd, static_cast<uint64*>(pData))
-            : ComputeResultsForOneSlot(flags, m_createInfo.enabledStats, pBegin, pEnd, static_cast<uint32*>(pData)));
+            ? ComputePipelineStatsResults(flags, numStatsEnabled, counterOffsets, pBegin, pEnd,
+                                          static_cast<uint64*>(pData))
+            : ComputePipelineStatsResults(flags, numStatsEnabled, counterOffsets, pBegin, pEnd,
+                                          static_cast<uint32*>(pData)));
 
         allQueriesReady = allQueriesReady && queryReady;
         pGpuData        = VoidPtrInc(pGpuData, GetGpuResultSizeInBytes(1));
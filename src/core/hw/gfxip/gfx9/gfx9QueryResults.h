@@ -0,0 +1,233 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "core/hw/gfxip/gfx9/gfx9Chip.h"
+#include "palInlineFuncs.h"
+#include "palQueryPool.h"
+#include <cstring>
+
+namespace Pal
+{
+namespace Gfx9
+{
+
+// Number of 64-bit counters the hardware writes for each begin or end of a pipeline stats query.
+constexpr uint32 PipelineStatsMaxNumCounters  = 11;
+
+// Pipeline stats counters hold this value until the GPU has written them.
+constexpr uint64 PipelineStatsResetMemValue64 = 0xFFFFFFFFFFFFFFFF;
+
+// =====================================================================================================================
+// Sums the zPass deltas of every RB which has written both of its counters and returns true if all RBs had done so.
+// Each counter is read exactly once and the loop has no data-dependent branches so that the compiler can vectorize it;
+// the valid bit lives in the same qword as the data so one read sees both.
+inline bool SumRbCounters(
+    uint32                          numTotalRbs,
+    const OcclusionQueryResultPair* pRbCounters,
+    uint64*                         pResult)
+{
+    constexpr uint64 ValidMask = (1ull << 63);
+
+    uint64 result   = 0;
+    uint64 allValid = ValidMask;
+
+    for (uint32 idx = 0; idx < numTotalRbs; idx++)
+    {
+        const uint64 begin = pRbCounters[idx].begin.data;
+        const uint64 end   = pRbCounters[idx].end.data;
+        const uint64 valid = (begin & end & ValidMask);
+
+        // When both counters are valid their valid bits cancel out in the subtraction. Otherwise the mask is zero and
+        // this RB doesn't contribute, just like the partial results of the slow path below.
+        result   += ((end - begin) & (0 - (valid >> 63)));
+        allValid &= valid;
+    }
+
+    *pResult = result;
+
+    return (allValid != 0);
+}
+
+// =====================================================================================================================
+// Same as SumRbCounters but spins on each RB until the GPU has written both of its counters. Note that the counters
+// pointer is volatile because we expect the GPU to write them while we wait.
+inline void WaitAndSumRbCounters(
+    uint32                                   numTotalRbs,
+    volatile const OcclusionQueryResultPair* pRbCounters,
+    uint64*                                  pResult)
+{
+    uint64 result = 0;
+
+    for (uint32 idx = 0; idx < numTotalRbs; idx++)
+    {
+        // The RBs will set the valid bits when they have written their data. We do not need to skip disabled RBs
+        // because they are initialized to valid with zPassData equal to zero.
+        while ((pRbCounters[idx].begin.bits.valid == 0) || (pRbCounters[idx].end.bits.valid == 0))
+        {
+        }
+
+        result += (pRbCounters[idx].end.bits.zPassData - pRbCounters[idx].begin.bits.zPassData);
+    }
+
+    *pResult = result;
+}
+
+// =====================================================================================================================
+// Computes the result data of one occlusion query slot according to the given flags, storing all data in integers of
+// type ResultUint. Returns true if all counters were ready.
+template <typename ResultUint>
+bool ComputeOcclusionResults(
+    QueryResultFlags                flags,
+    uint32                          numTotalRbs,
+    bool                            isBinary,
+    const OcclusionQueryResultPair* pRbCounters,
+    ResultUint*                     pOutputBuffer)
+{
+    // Most slots are resolved long after the GPU has finished with them, so first take a single pass over the counters
+    // and only fall back to waiting on each RB if the caller requested it and some of them weren't ready. The sum is
+    // taken in 64 bits and truncated once, which is equivalent to summing in ResultUint.
+    uint64 sum        = 0;
+    bool   queryReady = SumRbCounters(numTotalRbs, pRbCounters, &sum);
+
+    if ((queryReady == false) && Util::TestAnyFlagSet(flags, QueryResultWait))
+    {
+        WaitAndSumRbCounters(numTotalRbs, pRbCounters, &sum);
+        queryReady = true;
+    }
+
+    ResultUint result = static_cast<ResultUint>(sum);
+
+    // Store the result in the output buffer if it's legal for us to do so.
+    if (queryReady || Util::TestAnyFlagSet(flags, QueryResultPartial))
+    {
+        if (Util::TestAnyFlagSet(flags, QueryResultAccumulate))
+        {
+            // Accumulate the present data; we do this first so that the if isBinary is set we still get a 0 or 1.
+            result += pOutputBuffer[0];
+        }
+
+        pOutputBuffer[0] = isBinary ? (result != 0) : result;
+    }
+
+    // The caller also wants us to output whether or not the final query results were available. If we're
+    // accumulating data we must AND our data the present data so the caller knows if all queries were available.
+    if (Util::TestAnyFlagSet(flags, QueryResultAvailability))
+    {
+        if (Util::TestAnyFlagSet(flags, QueryResultAccumulate))
+        {
+            queryReady = queryReady && (pOutputBuffer[1] != 0);
+        }
+
+        pOutputBuffer[1] = queryReady;
+    }
+
+    return queryReady;
+}
+
+// =====================================================================================================================
+// Computes the result data of one pipeline stats query slot according to the given flags, storing all data in integers
+// of type ResultUint. pCounterOffsets lists the QWORD offsets of the enabled counters in result order. Returns true if
+// all counters were ready. Note that the counter pointers are volatile because the GPU could write them at any time
+// (and if QueryResultWait is set we expect it to do so).
+template <typename ResultUint>
+bool ComputePipelineStatsResults(
+    QueryResultFlags       resultFlags,
+    uint32                 numStatsEnabled,
+    const uint32*          pCounterOffsets,
+    volatile const uint64* pBeginCounters,
+    volatile const uint64* pEndCounters,
+    ResultUint*            pOutputBuffer)
+{
+    // Unless QueryResultPartial is set, we can't touch the destination buffer if some results aren't ready. We will
+    // store our results in here until we know whether or not it's safe to write to the output buffer.
+    ResultUint results[PipelineStatsMaxNumCounters] = {};
+    bool       queryReady = true;
+
+    // Most slots are resolved long after the GPU has finished with them, so first read each enabled counter pair once
+    // without branching on whether it's ready.
+    for (uint32 idx = 0; idx < numStatsEnabled; ++idx)
+    {
+        const uint64 begin = pBeginCounters[pCounterOffsets[idx]];
+        const uint64 end   = pEndCounters[pCounterOffsets[idx]];
+
+        // If the initial value is still in one of the counters it implies that the query hasn't finished yet.
+        const bool countersReady = ((begin != PipelineStatsResetMemValue64) & (end != PipelineStatsResetMemValue64));
+
+        results[idx] = countersReady ? static_cast<ResultUint>(end - begin) : 0;
+        queryReady   = queryReady & countersReady;
+    }
+
+    if ((queryReady == false) && Util::TestAnyFlagSet(resultFlags, QueryResultWait))
+    {
+        // We will loop here for as long as necessary since the caller has requested it.
+        for (uint32 idx = 0; idx < numStatsEnabled; ++idx)
+        {
+            const uint32 counterOffset = pCounterOffsets[idx];
+
+            while ((pBeginCounters[counterOffset] == PipelineStatsResetMemValue64) ||
+                   (pEndCounters[counterOffset]   == PipelineStatsResetMemValue64))
+            {
+            }
+
+            results[idx] = static_cast<ResultUint>(pEndCounters[counterOffset] - pBeginCounters[counterOffset]);
+        }
+
+        queryReady = true;
+    }
+
+    // Store the results in the output buffer if it's legal for us to do so.
+    if (queryReady || Util::TestAnyFlagSet(resultFlags, QueryResultPartial))
+    {
+        // Accumulate the present data.
+        if (Util::TestAnyFlagSet(resultFlags, QueryResultAccumulate))
+        {
+            for (uint32 idx = 0; idx < numStatsEnabled; ++idx)
+            {
+                results[idx] += pOutputBuffer[idx];
+            }
+        }
+
+        memcpy(pOutputBuffer, results, numStatsEnabled * sizeof(ResultUint));
+    }
+
+    // The caller also wants us to output whether or not the final query results were available. If we're
+    // accumulating data we must AND our data the present data so the caller knows if all queries were available.
+    if (Util::TestAnyFlagSet(resultFlags, QueryResultAvailability))
+    {
+        if (Util::TestAnyFlagSet(resultFlags, QueryResultAccumulate))
+        {
+            queryReady = queryReady && (pOutputBuffer[numStatsEnabled] != 0);
+        }
+
+        pOutputBuffer[numStatsEnabled] = queryReady;
+    }
+
+    return queryReady;
+}
+
+} // Gfx9
+} // Pal
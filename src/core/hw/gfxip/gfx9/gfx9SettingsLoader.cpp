@@ -179,6 +179,15 @@ void SettingsLoader::ValidateSettings(
         pSettings->cmdBufPreemptionMode = CmdBufPreemptModeDisable;
     }
 
+    // The pipeline register delta cache captures register values from the SET packets written by pipeline binds, so
+    // it can't be used with the LOAD_INDEX path. It also needs room for at least two images: the one programmed in
+    // hardware and the one being captured.
+    if (m_settings.pipelineRegDeltaCacheSize > 0)
+    {
+        m_settings.enableLoadIndexForObjectBinds = false;
+        m_settings.pipelineRegDeltaCacheSize     = Max(m_settings.pipelineRegDeltaCacheSize, 2u);
+    }
+
     // Validate the number of offchip LDS buffers used for tessellation.
     if (m_settings.numOffchipLdsBuffers > 0)
     {
@@ -106,13 +106,6 @@ Result ShaderRing::AllocateVideoMemory(
 {
     InternalMemMgr*const pMemMgr = m_pDevice->Parent()->MemMgr();
 
-    if (m_ringMem.IsBound())
-    {
-        // Need to release any preexisting memory allocation.
-        pMemMgr->FreeGpuMem(m_ringMem.Memory(), m_ringMem.Offset());
-        m_ringMem.Update(nullptr, 0);
-    }
-
     // Alignment requirement for shader rings is 256 Bytes.
     constexpr gpusize ShaderRingAlignment = 256;
 
@@ -164,6 +157,15 @@ Result ShaderRing::AllocateVideoMemory(
 
     if (result == Result::Success)
     {
+        // The preexisting allocation is only released once its replacement exists so that a failed reallocation
+        // leaves the Ring usable at its old size.  Only growing an existing Ring counts as a reallocation; the first
+        // allocation of each Ring is expected.
+        if (m_ringMem.IsBound())
+        {
+            pMemMgr->FreeGpuMem(m_ringMem.Memory(), m_ringMem.Offset());
+            m_pDevice->NotifyRingReallocation();
+        }
+
         m_ringMem.Update(pGpuMemory, memOffset);
     }
 
@@ -181,6 +183,8 @@ Result ShaderRing::Validate(
     // Only need to validate if the new item size is larger than the largest we've validated thus far.
     if (itemSize > m_itemSizeMax)
     {
+        const size_t oldItemSizeMax = m_itemSizeMax;
+
         m_itemSizeMax = itemSize;
         const gpusize sizeNeeded = ComputeAllocationSize();
 
@@ -191,6 +195,11 @@ Result ShaderRing::Validate(
             // Track our current allocation size.
             m_allocSize = sizeNeeded;
         }
+        else
+        {
+            // We kept our old allocation, so keep describing it.
+            m_itemSizeMax = oldItemSizeMax;
+        }
 
         if (m_ringMem.IsBound())
         {
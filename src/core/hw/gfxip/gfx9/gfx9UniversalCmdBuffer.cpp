@@ -239,6 +239,7 @@ UniversalCmdBuffer::UniversalCmdBuffer(
     m_pSignatureCs(&NullCsSignature),
     m_pSignatureGfx(&NullGfxSignature),
     m_pipelineCtxPm4Hash(0),
+    m_regDeltaCache(device, device.Settings().pipelineRegDeltaCacheSize),
     m_pfnValidateUserDataGfx(nullptr),
     m_pfnValidateUserDataGfxPipelineSwitch(nullptr),
     m_workaroundState(&device, createInfo.flags.nested, m_state),
@@ -458,6 +459,11 @@ Result UniversalCmdBuffer::Init(
         result = m_ceCmdStream.Init();
     }
 
+    if (result == Result::Success)
+    {
+        result = m_regDeltaCache.Init();
+    }
+
     return result;
 }
 
@@ -667,6 +673,8 @@ void UniversalCmdBuffer::ResetState()
     m_pipelinePsHash.upper = 0;
     m_pipelineFlags.u32All = 0;
 
+    m_regDeltaCache.Reset();
+
     // Set this flag at command buffer Begin/Reset, in case the last draw of the previous chained command buffer has
     // rasterization killed.
     m_pipelineFlags.noRaster = 1;
@@ -788,10 +796,25 @@ uint32* UniversalCmdBuffer::SwitchGraphicsPipeline(
     const bool gsEnabled           = pCurrPipeline->IsGsEnabled();
     const bool isRasterKilled      = pCurrPipeline->IsRasterizationKilled();
 
-    const uint64 ctxPm4Hash = pCurrPipeline->GetContextPm4ImgHash();
-    if (wasPrevPipelineNull || (m_pipelineCtxPm4Hash != ctxPm4Hash))
+    const uint64 ctxPm4Hash   = pCurrPipeline->GetContextPm4ImgHash();
+    const bool   writeContext = (wasPrevPipelineNull || (m_pipelineCtxPm4Hash != ctxPm4Hash));
+
+    if (UseRegDeltaCache())
+    {
+        // The SH registers weren't written by ValidateDraw(); the cache writes them along with the context registers.
+        pDeCmdSpace = m_regDeltaCache.WritePipelineBind(*pCurrPipeline,
+                                                        m_graphicsState.dynamicGraphicsInfo,
+                                                        writeContext,
+                                                        &m_deCmdStream,
+                                                        pDeCmdSpace);
+    }
+    else if (writeContext)
     {
         pDeCmdSpace = pCurrPipeline->WriteContextCommands(&m_deCmdStream, pDeCmdSpace);
+    }
+
+    if (writeContext)
+    {
         m_deCmdStream.SetContextRollDetected<true>();
 
         m_pipelineCtxPm4Hash = ctxPm4Hash;
@@ -2472,6 +2495,7 @@ void PAL_STDCALL UniversalCmdBuffer::CmdDrawIndirectMulti(
     gpusize           countGpuAddr)
 {
     auto* pThis = static_cast<UniversalCmdBuffer*>(pCmdBuffer);
+    pThis->TrackMemRef(gpuMemory);
 
     PAL_ASSERT(IsPow2Aligned(offset, sizeof(uint32)) && IsPow2Aligned(countGpuAddr, sizeof(uint32)));
     PAL_ASSERT(offset + (sizeof(DrawIndirectArgs) * maximumCount) <= gpuMemory.Desc().size);
@@ -2580,6 +2604,7 @@ void PAL_STDCALL UniversalCmdBuffer::CmdDrawIndexedIndirectMulti(
     gpusize           countGpuAddr)
 {
     auto* pThis = static_cast<UniversalCmdBuffer*>(pCmdBuffer);
+    pThis->TrackMemRef(gpuMemory);
 
     PAL_ASSERT(IsPow2Aligned(offset, sizeof(uint32)) && IsPow2Aligned(countGpuAddr, sizeof(uint32)));
     PAL_ASSERT(offset + (sizeof(DrawIndexedIndirectArgs) * maximumCount) <= gpuMemory.Desc().size);
@@ -2740,6 +2765,7 @@ void PAL_STDCALL UniversalCmdBuffer::CmdDispatchIndirect(
     gpusize           offset)
 {
     auto* pThis = static_cast<UniversalCmdBuffer*>(pCmdBuffer);
+    pThis->TrackMemRef(gpuMemory);
 
     if (DescribeDrawDispatch)
     {
@@ -2836,6 +2862,9 @@ void UniversalCmdBuffer::CmdCloneImageData(
     const IImage& srcImage,
     const IImage& dstImage)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstImage);
+
     m_device.RsrcProcMgr().CmdCloneImageData(this, GetGfx9Image(srcImage), GetGfx9Image(dstImage));
 }
 
@@ -2846,6 +2875,9 @@ void UniversalCmdBuffer::CmdCopyMemory(
     uint32                  regionCount,
     const MemoryCopyRegion* pRegions)
 {
+    TrackMemRef(srcGpuMemory);
+    TrackMemRef(dstGpuMemory);
+
     m_device.RsrcProcMgr().CmdCopyMemory(this,
                                          static_cast<const GpuMemory&>(srcGpuMemory),
                                          static_cast<const GpuMemory&>(dstGpuMemory),
@@ -2860,6 +2892,8 @@ void UniversalCmdBuffer::CmdUpdateMemory(
     gpusize           dataSize,
     const uint32*     pData)
 {
+    TrackMemRef(dstGpuMemory);
+
     PAL_ASSERT(pData != nullptr);
     m_device.RsrcProcMgr().CmdUpdateMemory(this,
                                            static_cast<const GpuMemory&>(dstGpuMemory),
@@ -2874,6 +2908,8 @@ void UniversalCmdBuffer::CmdUpdateBusAddressableMemoryMarker(
     gpusize           offset,
     uint32            value)
 {
+    TrackMemRef(dstGpuMemory);
+
     const GpuMemory* pGpuMemory = static_cast<const GpuMemory*>(&dstGpuMemory);
     WriteDataInfo    writeData  = {};
 
@@ -2895,6 +2931,8 @@ void UniversalCmdBuffer::CmdMemoryAtomic(
     uint64            srcData,
     AtomicOp          atomicOp)
 {
+    TrackMemRef(dstGpuMemory);
+
     const gpusize address = dstGpuMemory.Desc().gpuVirtAddr + dstOffset;
 
     uint32* pDeCmdSpace = m_deCmdStream.ReserveCommands();
@@ -2910,6 +2948,8 @@ void UniversalCmdBuffer::CmdWriteTimestamp(
     const IGpuMemory& dstGpuMemory,
     gpusize           dstOffset)
 {
+    TrackMemRef(dstGpuMemory);
+
     const gpusize address = dstGpuMemory.Desc().gpuVirtAddr + dstOffset;
 
     uint32* pDeCmdSpace = m_deCmdStream.ReserveCommands();
@@ -3942,33 +3982,63 @@ uint32* UniversalCmdBuffer::WriteDirtyUserDataEntriesToCeRam(
     const uint16 spillThreshold = pCurrSignature->spillThreshold;
     const uint16 userDataLimit  = pCurrSignature->userDataLimit;
 
-    uint16 lastEntry = 0;
-    uint16 count     = 0;
-    for (uint16 e = spillThreshold; e < userDataLimit; ++e)
+    PAL_ASSERT(spillThreshold < userDataLimit);
+
+    // Walk the dirty flags one wide-bitfield sub-mask at a time using bit-scans, merging each run of consecutive dirty
+    // entries (even one which crosses into the next sub-mask) into a single upload.
+    const uint32 numEntries  = (userDataLimit - spillThreshold);
+    const uint32 firstMaskId = (spillThreshold / UserDataEntriesPerMask);
+    const uint32 lastMaskId  = ((userDataLimit - 1) / UserDataEntriesPerMask);
+
+    uint32 runFirst = 0;
+    uint32 runCount = 0;
+    for (uint32 maskId = firstMaskId; maskId <= lastMaskId; ++maskId)
     {
-        while ((e < userDataLimit) && WideBitfieldIsSet(entries.dirty, e))
-        {
-            PAL_ASSERT((lastEntry == 0) || (lastEntry == (e - 1)));
-            lastEntry = e;
-            ++count;
-            ++e;
-        }
+        uint64 dirtyMask = (entries.dirty[maskId] & WideBitfieldRangeMask<uint64>(maskId, spillThreshold, numEntries));
 
-        if (count > 0)
+        while (dirtyMask != 0)
         {
-            const uint16 firstEntry = (lastEntry - count + 1);
-            pCeCmdSpace = UploadToUserDataTable(pSpillTable,
-                                                firstEntry,
-                                                count,
-                                                &entries.entries[firstEntry],
-                                                userDataLimit,
-                                                pCeCmdSpace);
+            uint32 bit = 0;
+            BitMaskScanForward(&bit, dirtyMask);
 
-            // Reset accumulators for the next packet.
-            lastEntry = 0;
-            count     = 0;
+            // The run ends at the first clear bit above "bit", or at the end of the sub-mask if there isn't one.
+            uint32 numBits = 0;
+            if (BitMaskScanForward(&numBits, ~(dirtyMask >> bit)) == false)
+            {
+                numBits = (UserDataEntriesPerMask - bit);
+            }
+
+            const uint32 entry = ((maskId * UserDataEntriesPerMask) + bit);
+            if ((runCount > 0) && ((runFirst + runCount) != entry))
+            {
+                pCeCmdSpace = UploadToUserDataTable(pSpillTable,
+                                                    runFirst,
+                                                    runCount,
+                                                    &entries.entries[runFirst],
+                                                    userDataLimit,
+                                                    pCeCmdSpace);
+                runCount = 0;
+            }
+
+            if (runCount == 0)
+            {
+                runFirst = entry;
+            }
+
+            runCount  += numBits;
+            dirtyMask &= ~WideBitfieldRangeMask<uint64>(0, bit, numBits);
         }
-    } // for each entry
+    } // for each wide-bitfield sub-mask
+
+    if (runCount > 0)
+    {
+        pCeCmdSpace = UploadToUserDataTable(pSpillTable,
+                                            runFirst,
+                                            runCount,
+                                            &entries.entries[runFirst],
+                                            userDataLimit,
+                                            pCeCmdSpace);
+    }
 
     // NOTE: Both spill tables share the same ring buffer, so when one gets updated, the other must also. This is
     // because there may be a large series of Dispatches between Draws (or vice-versa), so if the buffer wraps, it
@@ -4038,36 +4108,89 @@ uint32* UniversalCmdBuffer::WriteDirtyUserDataEntriesToUserSgprsCs(
     // us get away with only checking the first sub-mask of the user-data entries' wide-bitfield of dirty flags.
     static_assert(MaxFastUserDataEntriesCompute <= UserDataEntriesPerMask,
                   "The CS user-data entries mapped to user-SGPR's spans multiple wide-bitfield elements!");
-    constexpr uint32 AllFastUserDataEntriesMask = ((1 << MaxFastUserDataEntriesCompute) - 1);
-    uint16 userSgprDirtyMask = (m_computeState.csUserDataEntries.dirty[0] & AllFastUserDataEntriesMask);
+    constexpr uint64 AllFastUserDataEntriesMask = ((static_cast<uint64>(1) << MaxFastUserDataEntriesCompute) - 1);
+    uint32 userSgprDirtyMask =
+        static_cast<uint32>(m_computeState.csUserDataEntries.dirty[0] & AllFastUserDataEntriesMask);
 
     // Additionally, dirty compute user-data is always written to user-SGPR's if it could be mapped by a pipeline,
     // which lets us avoid any complex logic when switching pipelines.
     const uint16 baseUserSgpr = m_device.GetFirstUserDataReg(HwShaderStage::Cs);
 
-    for (uint16 e = 0; e < MaxFastUserDataEntriesCompute; ++e)
+    // Write each run of consecutive dirty entries with a single packet.
+    while (userSgprDirtyMask != 0)
     {
-        const uint16 firstEntry = e;
-        uint16       entryCount = 0;
+        uint32 firstEntry = 0;
+        uint32 entryCount = 0;
+        BitMaskScanForward(&firstEntry, userSgprDirtyMask);
+        BitMaskScanForward(&entryCount, ~(userSgprDirtyMask >> firstEntry));
 
-        while ((e < MaxFastUserDataEntriesCompute) && ((userSgprDirtyMask & (1 << e)) != 0))
+        if (RecordsUserDataPatchPoints())
         {
-            ++entryCount;
-            ++e;
+            RecordUserDataPatchPoints(PipelineBindPoint::Compute,
+                                      firstEntry,
+                                      entryCount,
+                                      (pDeCmdSpace + CmdUtil::ShRegSizeDwords));
         }
 
-        if (entryCount > 0)
+        const uint32 lastEntry = (firstEntry + entryCount - 1);
+        pDeCmdSpace = m_deCmdStream.WriteSetSeqShRegs((baseUserSgpr + firstEntry),
+                                                      (baseUserSgpr + lastEntry),
+                                                      ShaderCompute,
+                                                      &m_computeState.csUserDataEntries.entries[firstEntry],
+                                                      pDeCmdSpace);
+
+        userSgprDirtyMask &= ~(((1u << entryCount) - 1) << firstEntry);
+    }
+
+    return pDeCmdSpace;
+}
+
+// =====================================================================================================================
+// Records the patch points of the graphics user-data entries written to user-SGPR's by the SET_SH_REG packets between
+// pCmdStart and pCmdEnd. User-data patching disables the PM4 optimizer, so every packet is written unmodified. Other
+// packets found in the range don't write user-SGPR's and are skipped.
+void UniversalCmdBuffer::RecordUserSgprPatchPointsGfx(
+    uint32*       pCmdStart,
+    const uint32* pCmdEnd)
+{
+    uint32* pCmd = pCmdStart;
+
+    while (pCmd < pCmdEnd)
+    {
+        const auto&  header       = reinterpret_cast<const PM4_PFP_TYPE_3_HEADER&>(*pCmd);
+        const uint32 packetDwords = (header.count + 2);
+
+        if (header.opcode == IT_SET_SH_REG)
         {
-            const uint16 lastEntry = (firstEntry + entryCount - 1);
-            pDeCmdSpace = m_deCmdStream.WriteSetSeqShRegs((baseUserSgpr + firstEntry),
-                                                          (baseUserSgpr + lastEntry),
-                                                          ShaderCompute,
-                                                          &m_computeState.csUserDataEntries.entries[firstEntry],
-                                                          pDeCmdSpace);
+            const auto&  packet   = reinterpret_cast<const PM4_ME_SET_SH_REG&>(*pCmd);
+            const uint32 firstReg = (packet.bitfields2.reg_offset + PERSISTENT_SPACE_START);
+            const uint32 regCount = (packetDwords - CmdUtil::ShRegSizeDwords);
+
+            // Each packet writes consecutive user-SGPR's of a single hardware stage.
+            for (uint32 s = 0; s < NumHwShaderStagesGfx; ++s)
+            {
+                const UserDataEntryMap& entryMap = m_pSignatureGfx->stage[s];
+
+                if ((firstReg >= entryMap.firstUserSgprRegAddr) &&
+                    (firstReg <  (entryMap.firstUserSgprRegAddr + entryMap.userSgprCount)))
+                {
+                    const uint32 firstSgpr = (firstReg - entryMap.firstUserSgprRegAddr);
+                    PAL_ASSERT((firstSgpr + regCount) <= entryMap.userSgprCount);
+
+                    for (uint32 idx = 0; idx < regCount; ++idx)
+                    {
+                        RecordUserDataPatchPoints(PipelineBindPoint::Graphics,
+                                                  entryMap.mappedEntry[firstSgpr + idx],
+                                                  1,
+                                                  (pCmd + CmdUtil::ShRegSizeDwords + idx));
+                    }
+                    break;
+                }
+            }
         }
-    } // for each entry
 
-    return pDeCmdSpace;
+        pCmd += packetDwords;
+    }
 }
 
 // =====================================================================================================================
@@ -4393,6 +4516,7 @@ uint32* UniversalCmdBuffer::ValidateGraphicsUserDataCpu(
 
     // Step #2:
     // Write all dirty user-data entries to their mapped user SGPR's.
+    uint32*const pUserSgprCmds = pDeCmdSpace;
     uint8 alreadyWrittenStageMask = 0;
     if (HasPipelineChanged)
     {
@@ -4403,6 +4527,11 @@ uint32* UniversalCmdBuffer::ValidateGraphicsUserDataCpu(
                                                                                          alreadyWrittenStageMask,
                                                                                          pDeCmdSpace);
 
+    if (RecordsUserDataPatchPoints())
+    {
+        RecordUserSgprPatchPointsGfx(pUserSgprCmds, pDeCmdSpace);
+    }
+
     const uint16 spillThreshold = m_pSignatureGfx->spillThreshold;
     if (spillThreshold != NoUserDataSpilling)
     {
@@ -4423,31 +4552,12 @@ uint32* UniversalCmdBuffer::ValidateGraphicsUserDataCpu(
         }
         else
         {
-            // Otherwise, use the following loop to check if any of the spilled user-data entries are dirty.
-            const uint32 firstMaskId = (spillThreshold / UserDataEntriesPerMask);
-            const uint32 lastMaskId  = (lastUserData   / UserDataEntriesPerMask);
-            for (uint32 maskId = firstMaskId; maskId <= lastMaskId; ++maskId)
+            // Otherwise, check if any of the spilled user-data entries are dirty.
+            const uint32 numSpilled = (lastUserData - spillThreshold + 1);
+            if (WideBitfieldIsAnySetInRange(m_graphicsState.gfxUserDataEntries.dirty, spillThreshold, numSpilled))
             {
-                uint16 dirtyMask = m_graphicsState.gfxUserDataEntries.dirty[maskId];
-                if (maskId == firstMaskId)
-                {
-                    // Ignore the dirty bits for any entries below the spill threshold.
-                    const uint16 firstEntryInMask = (spillThreshold & (UserDataEntriesPerMask - 1));
-                    dirtyMask &= ~((1 << firstEntryInMask) - 1);
-                }
-                if (maskId == lastMaskId)
-                {
-                    // Ignore the dirty bits for any entries beyond the user-data limit.
-                    const uint16 lastEntryInMask = (lastUserData & (UserDataEntriesPerMask - 1));
-                    dirtyMask &= ((1 << (lastEntryInMask + 1)) - 1);
-                }
-
-                if (dirtyMask != 0)
-                {
-                    reUpload = true;
-                    break; // We only care if *any* spill table contents change!
-                }
-            } // for each wide-bitfield sub-mask
+                reUpload = true; // We only care if *any* spill table contents change!
+            }
         }
 
         // Step #4:
@@ -4458,6 +4568,14 @@ uint32* UniversalCmdBuffer::ValidateGraphicsUserDataCpu(
                                    (userDataLimit - spillThreshold),
                                    spillThreshold,
                                    &m_graphicsState.gfxUserDataEntries.entries[0]);
+
+            if (RecordsUserDataPatchPoints())
+            {
+                RecordUserDataPatchPoints(PipelineBindPoint::Graphics,
+                                          spillThreshold,
+                                          (userDataLimit - spillThreshold),
+                                          (m_spillTable.stateGfx.pCpuVirtAddr + spillThreshold));
+            }
         }
 
         // NOTE: If the pipeline is changing, we may need to re-write the spill table address to any shader stage, even
@@ -4591,31 +4709,12 @@ uint32* UniversalCmdBuffer::ValidateComputeUserDataCpu(
         }
         else
         {
-            // Otherwise, use the following loop to check if any of the spilled user-data entries are dirty.
-            const uint32 firstMaskId = (spillThreshold / UserDataEntriesPerMask);
-            const uint32 lastMaskId  = (lastUserData   / UserDataEntriesPerMask);
-            for (uint32 maskId = firstMaskId; maskId <= lastMaskId; ++maskId)
+            // Otherwise, check if any of the spilled user-data entries are dirty.
+            const uint32 numSpilled = (lastUserData - spillThreshold + 1);
+            if (WideBitfieldIsAnySetInRange(m_computeState.csUserDataEntries.dirty, spillThreshold, numSpilled))
             {
-                uint16 dirtyMask = m_computeState.csUserDataEntries.dirty[maskId];
-                if (maskId == firstMaskId)
-                {
-                    // Ignore the dirty bits for any entries below the spill threshold.
-                    const uint16 firstEntryInMask = (spillThreshold & (UserDataEntriesPerMask - 1));
-                    dirtyMask &= ~((1 << firstEntryInMask) - 1);
-                }
-                if (maskId == lastMaskId)
-                {
-                    // Ignore the dirty bits for any entries beyond the user-data limit.
-                    const uint16 lastEntryInMask = (lastUserData & (UserDataEntriesPerMask - 1));
-                    dirtyMask &= ((1 << (lastEntryInMask + 1)) - 1);
-                }
-
-                if (dirtyMask != 0)
-                {
-                    reUpload = true;
-                    break; // We only care if *any* spill table contents change!
-                }
-            } // for each wide-bitfield sub-mask
+                reUpload = true; // We only care if *any* spill table contents change!
+            }
         }
 
         // Step #3:
@@ -4627,6 +4726,14 @@ uint32* UniversalCmdBuffer::ValidateComputeUserDataCpu(
                                    spillThreshold,
                                    &m_computeState.csUserDataEntries.entries[0]);
 
+            if (RecordsUserDataPatchPoints())
+            {
+                RecordUserDataPatchPoints(PipelineBindPoint::Compute,
+                                          spillThreshold,
+                                          (userDataLimit - spillThreshold),
+                                          (m_spillTable.stateCs.pCpuVirtAddr + spillThreshold));
+            }
+
             pDeCmdSpace = m_deCmdStream.WriteSetOneShReg<ShaderCompute>(m_pSignatureCs->stage.spillTableRegAddr,
                                                                         LowPart(m_spillTable.stateCs.gpuVirtAddr),
                                                                         pDeCmdSpace);
@@ -4666,9 +4773,10 @@ void UniversalCmdBuffer::ValidateDraw(
 {
 
 #if PAL_BUILD_PM4_INSTRUMENTOR
-    uint32 startingCmdLen = GetUsedSize(CommandDataAlloc);
-    uint32 pipelineCmdLen = 0;
-    uint32 userDataCmdLen = 0;
+    uint32 startingCmdLen      = GetUsedSize(CommandDataAlloc);
+    uint32 pipelineCmdLen      = 0;
+    uint32 pipelineDeltaCmdLen = 0;
+    uint32 userDataCmdLen      = 0;
 #endif
 
     if (m_graphicsState.pipelineState.dirtyFlags.pipelineDirty)
@@ -4677,7 +4785,12 @@ void UniversalCmdBuffer::ValidateDraw(
 
         const auto*const pNewPipeline = static_cast<const GraphicsPipeline*>(m_graphicsState.pipelineState.pPipeline);
 
-        pDeCmdSpace = pNewPipeline->WriteShCommands(&m_deCmdStream, pDeCmdSpace, m_graphicsState.dynamicGraphicsInfo);
+        if (UseRegDeltaCache() == false)
+        {
+            pDeCmdSpace = pNewPipeline->WriteShCommands(&m_deCmdStream,
+                                                        pDeCmdSpace,
+                                                        m_graphicsState.dynamicGraphicsInfo);
+        }
 
         if (m_buildFlags.prefetchShaders)
         {
@@ -4698,6 +4811,13 @@ void UniversalCmdBuffer::ValidateDraw(
         {
             pipelineCmdLen  = (GetUsedSize(CommandDataAlloc) - startingCmdLen);
             startingCmdLen += pipelineCmdLen;
+
+            // Report delta binds separately so the command sizes of the two bind paths can be compared.
+            if (UseRegDeltaCache() && m_regDeltaCache.LastBindWroteDelta())
+            {
+                pipelineDeltaCmdLen = pipelineCmdLen;
+                pipelineCmdLen      = 0;
+            }
         }
 #endif
 
@@ -4748,7 +4868,7 @@ void UniversalCmdBuffer::ValidateDraw(
     if (m_cachedSettings.enablePm4Instrumentation != 0)
     {
         const uint32 miscCmdLen = (GetUsedSize(CommandDataAlloc) - startingCmdLen);
-        m_device.DescribeDrawDispatchValidation(this, userDataCmdLen, pipelineCmdLen, miscCmdLen);
+        m_device.DescribeDrawDispatchValidation(this, userDataCmdLen, pipelineCmdLen, miscCmdLen, pipelineDeltaCmdLen);
     }
 #endif
 }
@@ -6841,6 +6961,8 @@ void UniversalCmdBuffer::CmdLoadGds(
     gpusize           srcMemOffset,
     uint32            size)
 {
+    TrackMemRef(srcGpuMemory);
+
     BuildLoadGds(&m_deCmdStream,
                  &m_cmdUtil,
                  pipePoint,
@@ -6859,6 +6981,8 @@ void UniversalCmdBuffer::CmdStoreGds(
     uint32            size,
     bool              waitForWC)
 {
+    TrackMemRef(dstGpuMemory);
+
     BuildStoreGds(&m_deCmdStream,
                   &m_cmdUtil,
                   pipePoint,
@@ -6976,6 +7100,8 @@ void UniversalCmdBuffer::CmdBeginQuery(
     uint32            slot,
     QueryControlFlags flags)
 {
+    TrackMemRef(queryPool);
+
     static_cast<const QueryPool&>(queryPool).Begin(this, &m_deCmdStream, queryType, slot, flags);
 }
 
@@ -6985,6 +7111,8 @@ void UniversalCmdBuffer::CmdEndQuery(
     QueryType         queryType,
     uint32            slot)
 {
+    TrackMemRef(queryPool);
+
     static_cast<const QueryPool&>(queryPool).End(this, &m_deCmdStream, queryType, slot);
 }
 
@@ -6999,6 +7127,9 @@ void UniversalCmdBuffer::CmdResolveQuery(
     gpusize           dstOffset,
     gpusize           dstStride)
 {
+    TrackMemRef(queryPool);
+    TrackMemRef(dstGpuMemory);
+
     // Resolving a query is not supposed to honor predication.
     const uint32 packetPredicate = m_gfxCmdBufState.flags.packetPredicate;
     m_gfxCmdBufState.flags.packetPredicate = 0;
@@ -7022,6 +7153,8 @@ void UniversalCmdBuffer::CmdResetQueryPool(
     uint32            startQuery,
     uint32            queryCount)
 {
+    TrackMemRef(queryPool);
+
     static_cast<const QueryPool&>(queryPool).Reset(this, &m_deCmdStream, startQuery, queryCount);
 }
 
@@ -7455,6 +7588,8 @@ void UniversalCmdBuffer::CmdLoadCeRam(
     uint32            ramOffset,        // CE RAM offset, must be 32-byte aligned
     uint32            dwordSize)        // Number of DWORDs to load, must be a multiple of 8
 {
+    TrackMemRef(srcGpuMemory);
+
     uint32* pCeCmdSpace = m_ceCmdStream.ReserveCommands();
     pCeCmdSpace += CmdUtil::BuildLoadConstRam(srcGpuMemory.Desc().gpuVirtAddr + memOffset,
                                               (ReservedCeRamBytes + ramOffset),
@@ -7473,6 +7608,8 @@ void UniversalCmdBuffer::CmdDumpCeRam(
     uint32            currRingPos,
     uint32            ringSize)
 {
+    TrackMemRef(dstGpuMemory);
+
     uint32* pCeCmdSpace = m_ceCmdStream.ReserveCommands();
     HandleCeRinging(&m_state, currRingPos, 1, ringSize);
 
@@ -7514,6 +7651,8 @@ void UniversalCmdBuffer::CmdIf(
     uint64            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     // CE and nested command buffers don't support control flow yet.
     PAL_ASSERT(m_ceCmdStream.IsEmpty() && (IsNested() == false));
 
@@ -7546,6 +7685,8 @@ void UniversalCmdBuffer::CmdWhile(
     uint64            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     // CE and nested command buffers don't support control flow yet.
     PAL_ASSERT(m_ceCmdStream.IsEmpty() && (IsNested() == false));
 
@@ -7661,6 +7802,8 @@ void UniversalCmdBuffer::CmdWaitMemoryValue(
     uint32            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     uint32* pCmdSpace = m_deCmdStream.ReserveCommands();
 
     pCmdSpace += CmdUtil::BuildWaitRegMem(EngineTypeUniversal,
@@ -7682,6 +7825,8 @@ void UniversalCmdBuffer::CmdWaitBusAddressableMemoryMarker(
     uint32            mask,
     CompareFunc       compareFunc)
 {
+    TrackMemRef(gpuMemory);
+
     const GpuMemory* pGpuMemory = static_cast<const GpuMemory*>(&gpuMemory);
     uint32* pCmdSpace = m_deCmdStream.ReserveCommands();
 
@@ -7750,6 +7895,8 @@ void UniversalCmdBuffer::CmdUpdateHiSPretests(
     uint32             firstMip,
     uint32             numMips)
 {
+    TrackMemRef(*pImage);
+
     Image* pGfx9Image = static_cast<Image*>(static_cast<const Pal::Image*>(pImage)->GetGfxImage());
 
     if (pGfx9Image->HasHiSPretestsMetaData())
@@ -7816,6 +7963,16 @@ void UniversalCmdBuffer::CmdSetPredication(
     bool                waitResults,
     bool                accumulateData)
 {
+    if (pQueryPool != nullptr)
+    {
+        TrackMemRef(*pQueryPool);
+    }
+
+    if (pGpuMemory != nullptr)
+    {
+        TrackMemRef(*pGpuMemory);
+    }
+
     PAL_ASSERT((pQueryPool == nullptr) || (pGpuMemory == nullptr));
 
     m_gfxCmdBufState.flags.clientPredicate = ((pQueryPool != nullptr) || (pGpuMemory != nullptr)) ? 1 : 0;
@@ -7857,6 +8014,8 @@ void UniversalCmdBuffer::CmdCopyRegisterToMemory(
     const IGpuMemory& dstGpuMemory,
     gpusize           dstOffset)
 {
+    TrackMemRef(dstGpuMemory);
+
     uint32* pCmdSpace = m_deCmdStream.ReserveCommands();
 
     DmaDataInfo dmaData = {};
@@ -7881,6 +8040,8 @@ void UniversalCmdBuffer::CmdExecuteIndirectCmds(
     uint32                       maximumCount,
     gpusize                      countGpuAddr)
 {
+    TrackMemRef(gpuMemory);
+
     // It is only safe to generate indirect commands on a one-time-submit or exclusive-submit command buffer because
     // there is a potential race condition on the memory used to receive the generated commands.
     PAL_ASSERT(IsOneTimeSubmit() || IsExclusiveSubmit());
@@ -8227,6 +8388,7 @@ void UniversalCmdBuffer::LeakNestedCmdBufferState(
 
     m_pipelineCtxPm4Hash   = cmdBuffer.m_pipelineCtxPm4Hash;
     m_pipelinePsHash       = cmdBuffer.m_pipelinePsHash;
+    m_regDeltaCache.InvalidateHwState();
     m_pipelineFlags.u32All = cmdBuffer.m_pipelineFlags.u32All;
 
     if (cmdBuffer.m_graphicsState.pipelineState.dirtyFlags.pipelineDirty ||
@@ -8458,6 +8620,7 @@ void UniversalCmdBuffer::CmdExecuteNestedCmdBuffers(
 
         // Track the most recent OS paging fence value across all nested command buffers called from this one.
         m_lastPagingFence = Max(m_lastPagingFence, pCallee->LastPagingFence());
+        TrackMemRefs(*pCallee);
 
         // All user-data entries have been uploaded into CE RAM and GPU memory, so we can safely "call" the nested
         // command buffer's command streams.
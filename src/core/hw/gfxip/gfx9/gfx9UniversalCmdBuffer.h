@@ -29,6 +29,7 @@
 #include "core/hw/gfxip/gfx9/gfx9Gds.h"
 #include "core/hw/gfxip/gfx9/gfx9Chip.h"
 #include "core/hw/gfxip/gfx9/gfx9CmdStream.h"
+#include "core/hw/gfxip/gfx9/gfx9PipelineRegDeltaCache.h"
 #include "core/hw/gfxip/gfx9/gfx9WorkaroundState.h"
 #include "core/hw/gfxip/gfx9/g_gfx9PalSettings.h"
 #include "palIntervalTree.h"
@@ -773,6 +774,8 @@ protected:
 
     virtual void InheritStateFromCmdBuf(const GfxCmdBuffer* pCmdBuffer) override;
 
+    virtual bool SupportsUserDataPatching() const override { return true; }
+
     template <bool pm4OptImmediate>
     uint32* ValidateBinSizes(
         const GraphicsPipeline&  pipeline,
@@ -980,6 +983,11 @@ private:
         const GraphicsPipeline*          pCurrPipeline,
         uint32*                          pDeCmdSpace);
 
+    // The register delta cache can't be used while the PM4 optimizer is enabled because the optimizer may drop SET
+    // packets, leaving the captured register images out of sync with the hardware.
+    bool UseRegDeltaCache() const
+        { return (m_regDeltaCache.IsEnabled() && (m_deCmdStream.Pm4OptimizerEnabled() == false)); }
+
     template <uint32 AlignmentInDwords>
     void RelocateUserDataTable(
         UserDataTableState* pTable,
@@ -1025,6 +1033,10 @@ private:
     uint32* WriteDirtyUserDataEntriesToUserSgprsCs(
         uint32* pDeCmdSpace);
 
+    void RecordUserSgprPatchPointsGfx(
+        uint32*       pCmdStart,
+        const uint32* pCmdEnd);
+
     template <typename PipelineSignature>
     uint32* WriteDirtyUserDataEntriesToCeRam(
         const PipelineSignature* pPrevSignature,
@@ -1121,6 +1133,7 @@ private:
     const GraphicsPipelineSignature*  m_pSignatureGfx;
 
     uint64      m_pipelineCtxPm4Hash;   // Hash of current pipeline's PM4 image for context registers.
+    PipelineRegDeltaCache m_regDeltaCache; // Register deltas between recently bound graphics pipelines.
     ShaderHash  m_pipelinePsHash;       // Hash of current pipeline's pixel shader program.
     union
     {
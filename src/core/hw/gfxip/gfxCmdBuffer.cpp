@@ -67,7 +67,11 @@ GfxCmdBuffer::GfxCmdBuffer(
     m_fceRefCountVec(device.GetPlatform()),
     m_gfxBltActiveCtr(0),
     m_csBltActiveCtr(0),
-    m_releaseActivityMap(128, device.GetPlatform())
+    m_releaseActivityMap(128, device.GetPlatform()),
+    m_userDataPatchPoints(device.GetPlatform()),
+    m_patchableUserDataFirstEntry(0),
+    m_patchableUserDataEntryCount(0),
+    m_userDataPatchSuspendCount(0)
 {
     PAL_ASSERT((createInfo.queueType == QueueTypeUniversal) || (createInfo.queueType == QueueTypeCompute));
 
@@ -166,6 +170,15 @@ Result GfxCmdBuffer::Begin(
         {
             SetGfxCmdBufCpBltState(true);
         }
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+        if (m_buildFlags.enableUserDataPatching != 0)
+        {
+            m_patchableUserDataFirstEntry = Min(info.patchableUserDataFirstEntry, MaxUserDataEntries);
+            m_patchableUserDataEntryCount = Min(info.patchableUserDataEntryCount,
+                                                (MaxUserDataEntries - m_patchableUserDataFirstEntry));
+        }
+#endif
     }
 
     return result;
@@ -219,6 +232,78 @@ Result GfxCmdBuffer::Reset(
     return CmdBuffer::Reset(pCmdAllocator, returnGpuMemory);
 }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+// =====================================================================================================================
+// Rewrites every value of the specified user-data entries which was written into this command buffer's command and
+// embedded data memory while recording, as if CmdSetUserData() had been called with the new values instead.
+Result GfxCmdBuffer::PatchUserData(
+    PipelineBindPoint bindPoint,
+    uint32            firstEntry,
+    uint32            entryCount,
+    const uint32*     pEntryValues)
+{
+    Result result = Result::Success;
+
+    if (m_patchableUserDataEntryCount == 0)
+    {
+        result = Result::ErrorUnavailable;
+    }
+    else if (RecordState() != CmdBufferRecordState::Executable)
+    {
+        result = Result::ErrorIncompleteCommandBuffer;
+    }
+    else if ((pEntryValues == nullptr)                    ||
+             (entryCount == 0)                            ||
+             (firstEntry < m_patchableUserDataFirstEntry) ||
+             (entryCount > m_patchableUserDataEntryCount) ||
+             ((firstEntry - m_patchableUserDataFirstEntry) > (m_patchableUserDataEntryCount - entryCount)))
+    {
+        result = Result::ErrorInvalidValue;
+    }
+    else
+    {
+        for (auto iter = m_userDataPatchPoints.Begin(); iter.IsValid(); iter.Next())
+        {
+            const UserDataPatchPoint& point = iter.Get();
+
+            // Entries below firstEntry wrap around to large indices and are skipped too.
+            const uint32 index = (point.entry - firstEntry);
+            if ((point.bindPoint == bindPoint) && (index < entryCount))
+            {
+                *point.pCpuAddr = pEntryValues[index];
+            }
+        }
+    }
+
+    return result;
+}
+#endif
+
+// =====================================================================================================================
+// Records that the values of consecutive user-data entries were written to consecutive DWORDs starting at pCpuAddr.
+// Entries outside of the patchable range are ignored.
+void GfxCmdBuffer::RecordUserDataPatchPoints(
+    PipelineBindPoint bindPoint,
+    uint32            firstEntry,
+    uint32            entryCount,
+    uint32*           pCpuAddr)
+{
+    const uint32 patchFirst = Max(firstEntry, m_patchableUserDataFirstEntry);
+    const uint32 patchEnd   = Min((firstEntry + entryCount),
+                                  (m_patchableUserDataFirstEntry + m_patchableUserDataEntryCount));
+
+    for (uint32 entry = patchFirst; entry < patchEnd; ++entry)
+    {
+        const UserDataPatchPoint point = { (pCpuAddr + (entry - firstEntry)), entry, bindPoint };
+
+        if (m_userDataPatchPoints.PushBack(point) != Result::Success)
+        {
+            NotifyAllocFailure();
+            break;
+        }
+    }
+}
+
 // =====================================================================================================================
 // Decrements the ref count of images stored in the Fast clear eliminate ref count array.
 void GfxCmdBuffer::ResetFastClearReferenceCounts()
@@ -264,6 +349,10 @@ void GfxCmdBuffer::ResetState()
     m_gfxBltActiveCtr = 0;
     m_csBltActiveCtr  = 0;
 
+    m_userDataPatchPoints.Clear();
+    m_patchableUserDataFirstEntry = 0;
+    m_patchableUserDataEntryCount = 0;
+    m_userDataPatchSuspendCount   = 0;
 }
 
 // =====================================================================================================================
@@ -556,6 +645,9 @@ void GfxCmdBuffer::CmdCopyImage(
     const ImageCopyRegion* pRegions,
     uint32                 flags)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstImage);
+
     PAL_ASSERT(pRegions != nullptr);
     m_device.RsrcProcMgr().CmdCopyImage(this,
                                         static_cast<const Image&>(srcImage),
@@ -575,6 +667,9 @@ void GfxCmdBuffer::CmdCopyMemoryToImage(
     uint32                       regionCount,
     const MemoryImageCopyRegion* pRegions)
 {
+    TrackMemRef(srcGpuMemory);
+    TrackMemRef(dstImage);
+
     PAL_ASSERT(pRegions != nullptr);
     m_device.RsrcProcMgr().CmdCopyMemoryToImage(this,
                                                 static_cast<const GpuMemory&>(srcGpuMemory),
@@ -593,6 +688,9 @@ void GfxCmdBuffer::CmdCopyImageToMemory(
     uint32                       regionCount,
     const MemoryImageCopyRegion* pRegions)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstGpuMemory);
+
     PAL_ASSERT(pRegions != nullptr);
     m_device.RsrcProcMgr().CmdCopyImageToMemory(this,
                                                 static_cast<const Image&>(srcImage),
@@ -611,6 +709,9 @@ void GfxCmdBuffer::CmdCopyMemoryToTiledImage(
     uint32                            regionCount,
     const MemoryTiledImageCopyRegion* pRegions)
 {
+    TrackMemRef(srcGpuMemory);
+    TrackMemRef(dstImage);
+
     PAL_ASSERT(pRegions != nullptr);
 
     AutoBuffer<MemoryImageCopyRegion, 8, Platform> copyRegions(regionCount, m_device.GetPlatform());
@@ -657,6 +758,9 @@ void GfxCmdBuffer::CmdCopyTiledImageToMemory(
     uint32                            regionCount,
     const MemoryTiledImageCopyRegion* pRegions)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstGpuMemory);
+
     PAL_ASSERT(pRegions != nullptr);
 
     AutoBuffer<MemoryImageCopyRegion, 8, Platform> copyRegions(regionCount, m_device.GetPlatform());
@@ -702,6 +806,9 @@ void GfxCmdBuffer::CmdCopyTypedBuffer(
     uint32                       regionCount,
     const TypedBufferCopyRegion* pRegions)
 {
+    TrackMemRef(srcGpuMemory);
+    TrackMemRef(dstGpuMemory);
+
     PAL_ASSERT(pRegions != nullptr);
     m_device.RsrcProcMgr().CmdCopyTypedBuffer(this,
                                               static_cast<const GpuMemory&>(srcGpuMemory),
@@ -714,6 +821,9 @@ void GfxCmdBuffer::CmdCopyTypedBuffer(
 void GfxCmdBuffer::CmdScaledCopyImage(
     const ScaledCopyInfo& copyInfo)
 {
+    TrackMemRef(*copyInfo.pSrcImage);
+    TrackMemRef(*copyInfo.pDstImage);
+
     constexpr ScaledCopyInternalFlags NullInternalFlags = {};
 
     PAL_ASSERT(copyInfo.pRegions != nullptr);
@@ -724,6 +834,8 @@ void GfxCmdBuffer::CmdScaledCopyImage(
 void GfxCmdBuffer::CmdGenerateMipmaps(
     const GenMipmapsInfo& genInfo)
 {
+    TrackMemRef(*genInfo.pImage);
+
     m_device.RsrcProcMgr().CmdGenerateMipmaps(this, genInfo);
 }
 
@@ -738,6 +850,9 @@ void GfxCmdBuffer::CmdColorSpaceConversionCopy(
     TexFilter                         filter,
     const ColorSpaceConversionTable&  cscTable)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstImage);
+
     PAL_ASSERT(pRegions != nullptr);
     m_device.RsrcProcMgr().CmdColorSpaceConversionCopy(this,
                                                        static_cast<const Image&>(srcImage),
@@ -837,6 +952,8 @@ void GfxCmdBuffer::CmdFillMemory(
     gpusize           fillSize,
     uint32            data)
 {
+    TrackMemRef(dstGpuMemory);
+
     m_device.RsrcProcMgr().CmdFillMemory(this,
                                          (IsComputeStateSaved() == false),
                                          static_cast<const GpuMemory&>(dstGpuMemory),
@@ -855,6 +972,8 @@ void GfxCmdBuffer::CmdClearColorBuffer(
     uint32            rangeCount,
     const Range*      pRanges)
 {
+    TrackMemRef(gpuMemory);
+
     m_device.RsrcProcMgr().CmdClearColorBuffer(this,
                                                gpuMemory,
                                                color,
@@ -890,6 +1009,8 @@ void GfxCmdBuffer::CmdClearColorImage(
     const Box*         pBoxes,
     uint32             flags)
 {
+    TrackMemRef(image);
+
     PAL_ASSERT(pRanges != nullptr);
     m_device.RsrcProcMgr().CmdClearColorImage(this,
                                               static_cast<const Image&>(image),
@@ -935,6 +1056,8 @@ void GfxCmdBuffer::CmdClearDepthStencil(
     const Rect*        pRects,
     uint32             flags)
 {
+    TrackMemRef(image);
+
     PAL_ASSERT(pRanges != nullptr);
     m_device.RsrcProcMgr().CmdClearDepthStencil(this,
                                                 static_cast<const Image&>(image),
@@ -957,6 +1080,8 @@ void GfxCmdBuffer::CmdClearBufferView(
     uint32            rangeCount,
     const Range*      pRanges)
 {
+    TrackMemRef(gpuMemory);
+
     PAL_ASSERT(pBufferViewSrd != nullptr);
     m_device.RsrcProcMgr().CmdClearBufferView(this, gpuMemory, color, pBufferViewSrd, rangeCount, pRanges);
 }
@@ -970,6 +1095,8 @@ void GfxCmdBuffer::CmdClearImageView(
     uint32            rectCount,
     const Rect*       pRects)
 {
+    TrackMemRef(image);
+
      PAL_ASSERT(pImageViewSrd != nullptr);
      m_device.RsrcProcMgr().CmdClearImageView(this,
                                               static_cast<const Image&>(image),
@@ -990,6 +1117,9 @@ void GfxCmdBuffer::CmdResolveImage(
     uint32                    regionCount,
     const ImageResolveRegion* pRegions)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstImage);
+
     PAL_ASSERT(pRegions != nullptr);
     m_device.RsrcProcMgr().CmdResolveImage(this,
                                            static_cast<const Image&>(srcImage),
@@ -1028,6 +1158,8 @@ void GfxCmdBuffer::CmdSaveComputeState(
         m_pCurrentExperiment->BeginInternalOps(GetCmdStreamByEngine(GetPerfExperimentEngine()));
     }
 
+    // The internal operations will write their own compute user-data, which the client must not be able to patch.
+    SuspendUserDataPatchPoints();
 }
 
 // =====================================================================================================================
@@ -1045,6 +1177,7 @@ void GfxCmdBuffer::CmdRestoreComputeState(
     // to revisit this!)
 
     SetComputeState(m_computeRestoreState, stateFlags);
+    ResumeUserDataPatchPoints();
 
     if (m_pCurrentExperiment != nullptr)
     {
@@ -1167,11 +1300,8 @@ void PAL_STDCALL GfxCmdBuffer::CmdSetUserDataCs(
 
     // NOTE: Compute operations are expected to be far rarer than graphics ones, so at the moment it is not expected
     // that filtering-out redundant compute user-data updates is worthwhile.
-    for (uint32 e = firstEntry; e < (firstEntry + entryCount); ++e)
-    {
-        WideBitfieldSetBit(pEntries->touched, e);
-        WideBitfieldSetBit(pEntries->dirty,   e);
-    }
+    WideBitfieldSetRange(pEntries->touched, firstEntry, entryCount);
+    WideBitfieldSetRange(pEntries->dirty,   firstEntry, entryCount);
     memcpy(&pEntries->entries[firstEntry], pEntryValues, entryCount * sizeof(uint32));
 }
 
@@ -1211,7 +1341,7 @@ void GfxCmdBuffer::LeakPerPipelineStateChanges(
             const uint32 entry = (bit + (UserDataEntriesPerMask * index));
             pDestUserDataEntries->entries[entry] = leakedUserDataEntries.entries[entry];
 
-            mask &= ~(1 << bit);
+            mask &= ~(static_cast<uint64>(1) << bit);
         }
     }
 }
@@ -1315,6 +1445,9 @@ void GfxCmdBuffer::CmdCopyImageToPackedPixelImage(
         const ImageCopyRegion* pRegions,
         Pal::PackedPixelType   packPixelType)
 {
+    TrackMemRef(srcImage);
+    TrackMemRef(dstImage);
+
     PAL_ASSERT(pRegions != nullptr);
     m_device.RsrcProcMgr().CopyImageToPackedPixelImage(
         this,
@@ -63,10 +63,11 @@ constexpr uint32 PredicationAlign = 16;
 // the number returned to the client.
 constexpr uint32 MaxUserDataEntries = 128;
 
-// Wide-bitmask of one flag for every user-data entry.
-constexpr uint32 UserDataEntriesPerMask = (sizeof(uint16) << 3);
+// Wide-bitmask of one flag for every user-data entry. Each part covers 64 entries so that typical pipelines' user-data
+// fits in one or two parts and dirty entries can be found with a single bit-scan per run.
+constexpr uint32 UserDataEntriesPerMask = (sizeof(uint64) << 3);
 constexpr uint32 NumUserDataFlagsParts  = (MaxUserDataEntries / UserDataEntriesPerMask);
-typedef uint16 UserDataFlags[NumUserDataFlagsParts];
+typedef uint64 UserDataFlags[NumUserDataFlagsParts];
 
 // Represents the user data entries for a particular shader stage.
 struct UserDataEntries
@@ -191,6 +192,16 @@ struct ReleaseActivityInfo
 
 typedef Util::HashMap<const IGpuEvent*, ReleaseActivityInfo, Platform> ReleaseActivityMap;
 
+// Location in command or embedded data memory of a DWORD holding the value of a patchable user-data entry.
+struct UserDataPatchPoint
+{
+    uint32*           pCpuAddr;  // Mapped CPU address of the DWORD.
+    uint32            entry;     // Index of the user-data entry whose value the DWORD holds.
+    PipelineBindPoint bindPoint; // Which set of user-data entries (graphics or compute) the entry belongs to.
+};
+
+typedef Util::Vector<UserDataPatchPoint, 16, Platform> UserDataPatchPointVector;
+
 // =====================================================================================================================
 // Abstract class for executing basic hardware-specific functionality common to GFXIP universal and compute command
 // buffers.
@@ -210,6 +221,14 @@ public:
     virtual Result End() override;
     virtual Result Reset(ICmdAllocator* pCmdAllocator, bool returnGpuMemory) override;
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    virtual Result PatchUserData(
+        PipelineBindPoint bindPoint,
+        uint32            firstEntry,
+        uint32            entryCount,
+        const uint32*     pEntryValues) override;
+#endif
+
     virtual void CmdCopyImage(
         const IImage&          srcImage,
         ImageLayout            srcImageLayout,
@@ -526,6 +545,24 @@ protected:
 
     virtual bool SupportsExecutionMarker() { return true; }
 
+    // Returns true if the locations of patchable user-data values written to command memory must be recorded. This is
+    // false while internal operations (e.g., RPM blits) have overridden the client's user-data.
+    bool RecordsUserDataPatchPoints() const
+        { return ((m_patchableUserDataEntryCount != 0) && (m_userDataPatchSuspendCount == 0)); }
+
+    void RecordUserDataPatchPoints(
+        PipelineBindPoint bindPoint,
+        uint32            firstEntry,
+        uint32            entryCount,
+        uint32*           pCpuAddr);
+
+    void SuspendUserDataPatchPoints() { ++m_userDataPatchSuspendCount; }
+    void ResumeUserDataPatchPoints()
+    {
+        PAL_ASSERT(m_userDataPatchSuspendCount > 0);
+        --m_userDataPatchSuspendCount;
+    }
+
     uint32            m_engineSupport;       // Indicates which engines are supported by the command buffer.
                                              // Populated by the GFXIP-specific layer.
     ComputeState      m_computeState;        // Currently bound compute command buffer state.
@@ -570,6 +607,12 @@ private:
 
     ReleaseActivityMap m_releaseActivityMap; // A hashmap that tracks active releases.
 
+    // Locations of every value of a patchable user-data entry written while recording; see PatchUserData().
+    UserDataPatchPointVector m_userDataPatchPoints;
+    uint32                   m_patchableUserDataFirstEntry;
+    uint32                   m_patchableUserDataEntryCount; // Zero unless user-data patching is enabled.
+    uint32                   m_userDataPatchSuspendCount;   // Nesting depth of internal user-data overrides.
+
     PAL_DISALLOW_COPY_AND_ASSIGN(GfxCmdBuffer);
     PAL_DISALLOW_DEFAULT_CTOR(GfxCmdBuffer);
 };
@@ -594,14 +594,16 @@ void GfxDevice::DescribeDrawDispatchValidation(
     GfxCmdBuffer* pCmdBuf,
     size_t        userDataCmdSize,
     size_t        pipelineCmdSize,
-    size_t        miscCmdSize
+    size_t        miscCmdSize,
+    size_t        pipelineDeltaCmdSize
     ) const
 {
     Developer::DrawDispatchValidationData data = { };
-    data.pCmdBuffer      = pCmdBuf;
-    data.userDataCmdSize = static_cast<uint32>(userDataCmdSize);
-    data.pipelineCmdSize = static_cast<uint32>(pipelineCmdSize);
-    data.miscCmdSize     = static_cast<uint32>(miscCmdSize);
+    data.pCmdBuffer           = pCmdBuf;
+    data.userDataCmdSize      = static_cast<uint32>(userDataCmdSize);
+    data.pipelineCmdSize      = static_cast<uint32>(pipelineCmdSize);
+    data.miscCmdSize          = static_cast<uint32>(miscCmdSize);
+    data.pipelineDeltaCmdSize = static_cast<uint32>(pipelineDeltaCmdSize);
 
     m_pParent->DeveloperCb(Developer::CallbackType::DrawDispatchValidation, &data);
 }
@@ -556,7 +556,8 @@ public:
         GfxCmdBuffer* pCmdBuf,
         size_t        userDataCmdSize,
         size_t        pipelineCmdSize,
-        size_t        miscCmdSize) const;
+        size_t        miscCmdSize,
+        size_t        pipelineDeltaCmdSize = 0) const;
 
     void DescribeHotRegisters(
         GfxCmdBuffer* pCmdBuf,
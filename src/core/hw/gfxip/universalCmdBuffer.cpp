@@ -313,15 +313,32 @@ void PAL_STDCALL UniversalCmdBuffer::CmdSetUserDataGfx(
 
             pEntries->entries[userDataArgs.firstEntry] = userDataArgs.pEntryValues[0];
         }
-        else
+        else if (filterRedundantUserData)
         {
+            // The first and last entries are known to have changed but the entries between them may not have. Only
+            // the entries whose values actually change need to be rewritten to hardware.
             const uint32 entryLimit = (userDataArgs.firstEntry + userDataArgs.entryCount);
-            for (uint32 e = userDataArgs.firstEntry; e < entryLimit ; ++e)
+            for (uint32 e = userDataArgs.firstEntry; e < entryLimit; ++e)
             {
-                WideBitfieldSetBit(pEntries->touched, e);
-                WideBitfieldSetBit(pEntries->dirty,   e);
+                const uint32 value = userDataArgs.pEntryValues[e - userDataArgs.firstEntry];
+
+                if ((pEntries->entries[e] != value) || (WideBitfieldIsSet(pEntries->touched, e) == false))
+                {
+                    WideBitfieldSetBit(pEntries->dirty, e);
+                }
             }
 
+            WideBitfieldSetRange(pEntries->touched, userDataArgs.firstEntry, userDataArgs.entryCount);
+
+            memcpy(&pEntries->entries[userDataArgs.firstEntry],
+                   userDataArgs.pEntryValues,
+                   (sizeof(uint32) * userDataArgs.entryCount));
+        }
+        else
+        {
+            WideBitfieldSetRange(pEntries->touched, userDataArgs.firstEntry, userDataArgs.entryCount);
+            WideBitfieldSetRange(pEntries->dirty,   userDataArgs.firstEntry, userDataArgs.entryCount);
+
             memcpy(&pEntries->entries[userDataArgs.firstEntry],
                    userDataArgs.pEntryValues,
                    (sizeof(uint32) * userDataArgs.entryCount));
@@ -345,10 +362,9 @@ void PAL_STDCALL UniversalCmdBuffer::CmdSetUserDataGfx<true>(
 
 // =====================================================================================================================
 // Compares the client-specified user data update parameters against the current user data values, and filters any
-// redundant updates at the beginning of ending of the range.  Filtering redundant values in the middle of the range
-// would involve significant updates to the rest of PAL, and we typically expect a good hit rate for redundant updates
-// at the beginning or end.  The most common updates are setting 2-dword addresses (best hit rate on high bits) and
-// 4-dword buffer SRDs (best hit rate on last dword).
+// redundant updates at the beginning of ending of the range.  Redundant values in the middle of the range are filtered
+// later, when CmdSetUserDataGfx() sets the dirty flags.  The most common updates are setting 2-dword addresses (best
+// hit rate on high bits) and 4-dword buffer SRDs (best hit rate on last dword).
 //
 // Returns true if there are still entries that should be processed after filtering.  False means that the entire set
 // is redundant.
@@ -485,7 +501,7 @@ void UniversalCmdBuffer::CmdSetLineStippleState(
 // =====================================================================================================================
 // Dumps this command buffer's DE and CE command streams to the given file with an appropriate header.
 void UniversalCmdBuffer::DumpCmdStreamsToFile(
-    File*          pFile,
+    BufferedFile*  pFile,
     CmdBufDumpFormat mode
     ) const
 {
@@ -507,6 +523,9 @@ void UniversalCmdBuffer::PushGraphicsState()
     m_graphicsRestoreState = m_graphicsState;
     memset(&m_graphicsState.gfxUserDataEntries.touched[0], 0, sizeof(m_graphicsState.gfxUserDataEntries.touched));
 
+    // The internal operations will write their own graphics user-data, which the client must not be able to patch.
+    SuspendUserDataPatchPoints();
+
     if (m_pCurrentExperiment != nullptr)
     {
         // Inform the performance experiment that we're starting some internal operations.
@@ -529,6 +548,7 @@ void UniversalCmdBuffer::PopGraphicsState()
     // need to revisit this!)
 
     SetGraphicsState(m_graphicsRestoreState);
+    ResumeUserDataPatchPoints();
 
     // All RMP GFX Blts should push/pop command buffer's graphics state,
     // so this is a safe opprotunity to mark that a GFX Blt is active
@@ -209,7 +209,7 @@ public:
 
 #if PAL_ENABLE_PRINTS_ASSERTS
     // This function allows us to dump the contents of this command buffer to a file at submission time.
-    virtual void DumpCmdStreamsToFile(Util::File* pFile, CmdBufDumpFormat mode) const override;
+    virtual void DumpCmdStreamsToFile(Util::BufferedFile* pFile, CmdBufDumpFormat mode) const override;
 #endif
 
     // Universal command buffers have two command streams: Draw Engine and Constant Engine.
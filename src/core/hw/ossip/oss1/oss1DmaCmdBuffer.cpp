@@ -697,6 +697,8 @@ void DmaCmdBuffer::CmdUpdateMemory(
     gpusize           dataSize,
     const uint32*     pData)
 {
+    TrackMemRef(dstGpuMemory);
+
     gpusize dstAddr = dstGpuMemory.Desc().gpuVirtAddr + dstOffset;
 
     // Both the destination address and the dataSize need to be dword aligned, so verify that here.
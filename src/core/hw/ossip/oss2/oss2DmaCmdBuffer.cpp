@@ -120,6 +120,8 @@ void DmaCmdBuffer::CmdWriteTimestamp(
     const IGpuMemory& dstGpuMemory,
     gpusize           dstOffset)
 {
+    TrackMemRef(dstGpuMemory);
+
     const GpuMemory& gpuMemory = static_cast<const GpuMemory&>(dstGpuMemory);
     const gpusize    dstAddr   = gpuMemory.Desc().gpuVirtAddr + dstOffset;
 
@@ -828,6 +830,8 @@ void DmaCmdBuffer::CmdUpdateMemory(
     gpusize           dataSize,
     const uint32*     pData)
 {
+    TrackMemRef(dstGpuMemory);
+
     gpusize dstAddr = dstGpuMemory.Desc().gpuVirtAddr + dstOffset;
 
     // Both the destination address and the dataSize need to be dword aligned, so verify that here.
@@ -177,6 +177,7 @@ struct SubResourceInfo
     Extent3d       actualExtentTexels;   // Padded width, height, and depth in units of texels.
     Extent3d       actualExtentElements; // Padded width, height, and depth in elements (e.g., blocks for BC formats).
     uint32         actualArraySize;      // Padded array size. (possibly pow2-padded for GFX6-8).
+    uint32         tileToken;            // This subresource's tiling token.
 
     // Information about how the subresource is laid out in memory.
     gpusize        size;                 // Size of the subresource in bytes.
@@ -186,8 +187,6 @@ struct SubResourceInfo
     gpusize        rowPitch;             // Row pitch in bytes.
     gpusize        depthPitch;           // Depth pitch in bytes.
 
-    uint32         tileToken;            // This subresource's tiling token.
-
     gpusize        stereoOffset;         // Mem offset to the right eye data, in bytes
     uint32         stereoLineOffset;     // Y offset to the right eye data, in texels
 
@@ -476,6 +475,8 @@ protected:
 
     GfxImage*       m_pGfxImage;
 
+    // Every array slice keeps its own SubResourceInfo: SubresourceInfo() hands out pointers into this array, and the
+    // offsets of a slice can't be derived from slice zero of its mip level without repeating the HWL's layout walk.
     SubResourceInfo*const  m_pSubResInfoList;   // Array of SubResourceInfo structures for each subresource
     void*const             m_pTileInfoList;     // Array of tile info structures for each subresource
     const size_t           m_tileInfoBytes;     // Size of each tile info structure, in bytes
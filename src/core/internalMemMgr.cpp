@@ -31,6 +31,8 @@
 #include "palGpuMemoryBindable.h"
 #include "palListImpl.h"
 #include "palSysMemory.h"
+#include "palSysUtil.h"
+#include "palVectorImpl.h"
 #include <stdio.h>
 
 using namespace Util;
@@ -128,9 +130,16 @@ InternalMemMgr::InternalMemMgr(
     :
     m_pDevice(pDevice),
     m_poolList(pDevice->GetPlatform()),
-    m_references(pDevice->GetPlatform()),
-    m_referenceWatermark(0)
+    m_refListSlotCount(0),
+    m_refListChunkCount(0),
+    m_freeRefListSlots(pDevice->GetPlatform()),
+    m_refListEpoch(0),
+    m_referenceWatermark(0),
+    m_referenceCount(0)
 {
+    memset(&m_pRefListChunks[0], 0, sizeof(m_pRefListChunks));
+    m_refListReaders[0] = 0;
+    m_refListReaders[1] = 0;
 }
 
 // =====================================================================================================================
@@ -152,21 +161,31 @@ Result InternalMemMgr::Init()
 // Explicitly frees all GPU memory allocations.
 void InternalMemMgr::FreeAllocations()
 {
-    // Delete the GPU memory objects using the references list
-    while (m_references.NumElements() != 0)
-    {
-        auto it = GetRefListIter();
+    // Delete the GPU memory objects using the references list. No submits can be in flight by now so there are no
+    // readers to wait for.
+    PAL_ASSERT((m_refListReaders[0] == 0) && (m_refListReaders[1] == 0));
 
-        PAL_ASSERT((it.Get() != nullptr) && (it.Get()->pGpuMemory != nullptr));
+    for (uint32 slot = 0; slot < m_refListSlotCount; ++slot)
+    {
+        GpuMemoryInfo*const pEntry = RefListEntry(slot);
 
-        // Free the GPU memory object
-        it.Get()->pGpuMemory->DestroyInternal();
-        it.Get()->pGpuMemory = nullptr;
+        if (pEntry->pGpuMemory != nullptr)
+        {
+            pEntry->pGpuMemory->DestroyInternal();
+            pEntry->pGpuMemory = nullptr;
+        }
+    }
 
-        // Remove the list entry
-        m_references.Erase(&it);
+    for (uint32 chunk = 0; chunk < m_refListChunkCount; ++chunk)
+    {
+        PAL_SAFE_FREE(m_pRefListChunks[chunk], m_pDevice->GetPlatform());
     }
 
+    m_refListSlotCount   = 0;
+    m_refListChunkCount  = 0;
+    m_referenceCount     = 0;
+    m_freeRefListSlots.Clear();
+
     while (m_poolList.NumElements() != 0)
     {
         auto it = m_poolList.Begin();
@@ -388,19 +407,9 @@ Result InternalMemMgr::AllocateBaseGpuMem(
     if (IsErrorResult(result) == false)
     {
         // We need to add the newly created allocation to the reference list
-        RWLockAuto<RWLock::ReadWrite> referenceLock(&m_referenceLock);
-
-        GpuMemoryInfo memInfo = {};
-        memInfo.pGpuMemory  = *ppGpuMemory;
-        memInfo.readOnly    = readOnly;
-        result = m_references.PushBack(memInfo);
+        result = AddReference(*ppGpuMemory, readOnly);
 
-        if (result == Result::Success)
-        {
-            // If we succeeded then increment the reference list watermark and return with success
-            m_referenceWatermark++;
-        }
-        else
+        if (result != Result::Success)
         {
             // If there was a failure then release the GPU memory object
             (*ppGpuMemory)->DestroyInternal();
@@ -507,48 +516,206 @@ Result InternalMemMgr::FreeGpuMem(
 Result InternalMemMgr::FreeBaseGpuMem(
     GpuMemory*  pGpuMemory)
 {
-    Result result = Result::ErrorInvalidValue;
+    // Remove the allocation from the reference list. This won't return until no reader can still see it.
+    const Result result = RemoveReference(pGpuMemory) ? Result::Success : Result::ErrorInvalidValue;
+
+    // Release the GPU memory object.
+    // This must be done after releasing the references lock because some platforms may take a different lock to do
+    // internal bookkeeping when releasing GPU memory.
+    pGpuMemory->DestroyInternal();
+
+    // If we didn't find the allocation in the reference list then something went wrong with the allocation scheme
+    PAL_ASSERT(result == Result::Success);
+
+    return result;
+}
+
+// =====================================================================================================================
+// Adds a GPU memory object to the reference list, reusing a tombstoned slot if there is one.
+Result InternalMemMgr::AddReference(
+    GpuMemory* pGpuMemory,
+    bool       readOnly)
+{
+    MutexAuto referenceLock(&m_referenceLock);
+
+    Result result = Result::Success;
+    uint32 slot   = m_refListSlotCount;
 
-    // This scope is just to minimize the duration of holding the references lock.
+    // Free slots past the end of the list are left behind when the tail of the list is trimmed; skip them.
+    while (m_freeRefListSlots.NumElements() > 0)
     {
-        RWLockAuto<RWLock::ReadWrite> referenceLock(&m_referenceLock);
+        uint32 freeSlot = 0;
+        m_freeRefListSlots.PopBack(&freeSlot);
 
-        // Try to find the allocation in the reference list
-        for (auto it = GetRefListIter(); it.Get() != nullptr; it.Next())
+        if (freeSlot < m_refListSlotCount)
         {
-            GpuMemoryInfo* pMemInfo = it.Get();
+            slot = freeSlot;
+            break;
+        }
+    }
 
-            PAL_ASSERT(pMemInfo->pGpuMemory != nullptr);
+    if ((slot / RefListChunkEntries) >= m_refListChunkCount)
+    {
+        if (m_refListChunkCount == RefListMaxChunks)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+        else
+        {
+            m_pRefListChunks[m_refListChunkCount] = static_cast<GpuMemoryInfo*>(
+                PAL_CALLOC(sizeof(GpuMemoryInfo) * RefListChunkEntries, m_pDevice->GetPlatform(), AllocInternal));
 
-            if (pGpuMemory == pMemInfo->pGpuMemory)
+            if (m_pRefListChunks[m_refListChunkCount] == nullptr)
             {
-                // Also remove the reference list item and increment the watermark
-                m_references.Erase(&it);
-                m_referenceWatermark++;
-
-                result = Result::Success;
-                break;
+                result = Result::ErrorOutOfMemory;
+            }
+            else
+            {
+                m_refListChunkCount++;
             }
         }
     }
 
-    // Release the GPU memory object.
-    // This must be done after releasing the references lock because some platforms may take a different lock to do
-    // internal bookkeeping when releasing GPU memory.
-    pGpuMemory->DestroyInternal();
+    if (result == Result::Success)
+    {
+        // Readers treat a non-null pointer as a valid entry so it must be written last. The atomics below also make
+        // sure the entry is visible before the slot count and watermark change.
+        GpuMemoryInfo*const pEntry = RefListEntry(slot);
+        pEntry->readOnly = readOnly;
+        AtomicExchangePointer(reinterpret_cast<void*volatile*>(&pEntry->pGpuMemory), pGpuMemory);
 
-    // If we didn't find the allocation in the reference list then something went wrong with the allocation scheme
-    PAL_ASSERT(result == Result::Success);
+        if (slot == m_refListSlotCount)
+        {
+            AtomicIncrement(&m_refListSlotCount);
+        }
+
+        AtomicIncrement(&m_referenceCount);
+        AtomicIncrement(&m_referenceWatermark);
+    }
 
     return result;
 }
 
 // =====================================================================================================================
-// Get number of elements of m_reference
-uint32 InternalMemMgr::GetReferencesCount()
+// Replaces a GPU memory object's reference list entry with a tombstone and waits for any readers which might have seen
+// it. Returns false if the object wasn't in the list.
+bool InternalMemMgr::RemoveReference(
+    GpuMemory* pGpuMemory)
+{
+    MutexAuto referenceLock(&m_referenceLock);
+
+    bool found = false;
+
+    for (uint32 slot = 0; slot < m_refListSlotCount; ++slot)
+    {
+        GpuMemoryInfo*const pEntry = RefListEntry(slot);
+
+        if (pEntry->pGpuMemory == pGpuMemory)
+        {
+            AtomicExchangePointer(reinterpret_cast<void*volatile*>(&pEntry->pGpuMemory), nullptr);
+
+            // Tombstones at the end of the list are trimmed right away so readers don't walk them; the others are
+            // reused by later allocations. If we can't remember the slot it's simply never reused.
+            if ((slot + 1) == m_refListSlotCount)
+            {
+                uint32 slotCount = slot;
+                while ((slotCount > 0) && (RefListEntry(slotCount - 1)->pGpuMemory == nullptr))
+                {
+                    slotCount--;
+                }
+
+                AtomicExchange(&m_refListSlotCount, slotCount);
+            }
+            else
+            {
+                m_freeRefListSlots.PushBack(slot);
+            }
+
+            AtomicDecrement(&m_referenceCount);
+            AtomicIncrement(&m_referenceWatermark);
+
+            found = true;
+            break;
+        }
+    }
+
+    if (found)
+    {
+        WaitForRefListReaders();
+    }
+
+    return found;
+}
+
+// =====================================================================================================================
+// Starts a reader section of the reference list and returns its epoch, which must be passed to EndRefListRead().
+uint32 InternalMemMgr::BeginRefListRead()
+{
+    uint32 epoch = 0;
+
+    while (true)
+    {
+        epoch = m_refListEpoch;
+        AtomicIncrement(&m_refListReaders[epoch & 1]);
+
+        // If a writer advanced the epoch before we were counted it may not have waited for us, so try again with the
+        // new epoch. Otherwise any writer that removes an entry from now on will wait for us.
+        if (epoch == m_refListEpoch)
+        {
+            break;
+        }
+
+        AtomicDecrement(&m_refListReaders[epoch & 1]);
+    }
+
+    return epoch;
+}
+
+// =====================================================================================================================
+// Waits for every reader section which began before the caller's last change to the reference list. New readers are
+// counted against the next epoch so this can't be starved by them. The caller must hold the references lock.
+void InternalMemMgr::WaitForRefListReaders()
 {
-    RWLockAuto<RWLock::ReadOnly> referenceLock(&m_referenceLock);
-    return static_cast<uint32>(m_references.NumElements());
+    const uint32 oldEpoch = AtomicIncrement(&m_refListEpoch) - 1;
+
+    while (m_refListReaders[oldEpoch & 1] != 0)
+    {
+        YieldThread();
+    }
+}
+
+// =====================================================================================================================
+InternalMemMgr::RefListIterator::RefListIterator(
+    const InternalMemMgr* pMemMgr)
+    :
+    m_pMemMgr(pMemMgr),
+    m_slotCount(pMemMgr->m_refListSlotCount),
+    m_slot(0),
+    m_current()
+{
+    // Pretend we're just before the first slot so Next() finds the first live entry.
+    m_slot--;
+    Next();
+}
+
+// =====================================================================================================================
+// Advances to the next live entry, skipping tombstones. Slots added after the iteration began aren't visited.
+void InternalMemMgr::RefListIterator::Next()
+{
+    m_current = {};
+
+    for (++m_slot; m_slot < m_slotCount; ++m_slot)
+    {
+        const volatile GpuMemoryInfo* pEntry = m_pMemMgr->RefListEntry(m_slot);
+        GpuMemory*const pGpuMemory = pEntry->pGpuMemory;
+
+        if (pGpuMemory != nullptr)
+        {
+            m_current.pGpuMemory = pGpuMemory;
+            m_current.readOnly   = pEntry->readOnly;
+            break;
+        }
+    }
 }
 
 } // Pal
@@ -28,6 +28,7 @@
 #include "core/gpuMemory.h"
 #include "palBuddyAllocator.h"
 #include "palMutex.h"
+#include "palVector.h"
 
 namespace Pal
 {
@@ -42,6 +43,11 @@ struct GpuMemoryInfo
     bool            readOnly;
 };
 
+// The reference list is stored in fixed-size chunks of entries which are never moved or freed while the memory manager
+// is alive, so readers can walk it without taking a lock.
+constexpr uint32 RefListChunkEntries = 256;
+constexpr uint32 RefListMaxChunks    = 512;
+
 // Contains the information describing a GPU memory chunk pool
 struct GpuMemoryPool
 {
@@ -69,14 +75,34 @@ struct GpuMemoryPool
 //
 // Note that AllocateGpuMem's internalInfo must have the alwaysResident flag set because all memory managed by the
 // InternalMemMgr must be always resident.
+//
+// The reference list is read by every submit on every queue, so reading it is lock-free: a reader brackets its walk
+// with BeginRefListRead() and EndRefListRead() (see RefListReadScope). Removed entries are replaced by tombstones which
+// readers skip and whose slots are reused by later allocations. A removed GPU memory object is only destroyed once
+// every reader which might have seen it has finished, using a pair of reader counters indexed by an epoch.
 class InternalMemMgr
 {
 public:
-    typedef Util::List<GpuMemoryInfo, Platform>         GpuMemoryList;
-    typedef Util::ListIterator<GpuMemoryInfo, Platform> GpuMemoryListIterator;
-
     typedef Util::List<GpuMemoryPool, Platform>         GpuMemoryPoolList;
 
+    // Iterates over the live entries in the reference list. Must only be used inside a reader section.
+    class RefListIterator
+    {
+    public:
+        const GpuMemoryInfo* Get() const { return (m_current.pGpuMemory != nullptr) ? &m_current : nullptr; }
+        void Next();
+
+    private:
+        explicit RefListIterator(const InternalMemMgr* pMemMgr);
+
+        const InternalMemMgr*const m_pMemMgr;
+        const uint32               m_slotCount; // Number of slots published when the iteration began.
+        uint32                     m_slot;      // Slot which m_current was read from.
+        GpuMemoryInfo              m_current;   // Copy of the current entry.
+
+        friend class InternalMemMgr;
+    };
+
     explicit InternalMemMgr(Device* pDevice);
     ~InternalMemMgr() { FreeAllocations(); }
 
@@ -105,15 +131,20 @@ public:
         GpuMemory*  pGpuMemory,
         gpusize     offset);
 
-    GpuMemoryListIterator GetRefListIter() const { return m_references.Begin(); }
-    Util::RWLock* GetRefListLock() { return &m_referenceLock; }
+    RefListIterator GetRefListIter() const { return RefListIterator(this); }
     Util::Mutex* GetAllocatorLock() { return &m_allocatorLock; }
 
-    // It is assumed that the caller will take the references lock before calling this if necessary.
-    uint32 ReferenceWatermark() { return m_referenceWatermark; }
+    // Reader sections of the reference list. Memory removed from the list won't be destroyed until all reader
+    // sections which were active at the time of removal have ended.
+    uint32 BeginRefListRead();
+    void   EndRefListRead(uint32 epoch) { Util::AtomicDecrement(&m_refListReaders[epoch & 1]); }
+
+    // Changes whenever the reference list changes. Read this before walking the list: the walk will see at least the
+    // state the watermark describes.
+    uint32 ReferenceWatermark() const { return m_referenceWatermark; }
 
-    // Number of all allocations in the reference list. Note that this function takes the reference list lock.
-    uint32 GetReferencesCount();
+    // Number of all allocations in the reference list.
+    uint32 GetReferencesCount() const { return m_referenceCount; }
 
 private:
     Result AllocateBaseGpuMem(
@@ -125,6 +156,13 @@ private:
     Result FreeBaseGpuMem(
         GpuMemory*  pGpuMemory);
 
+    Result AddReference(GpuMemory* pGpuMemory, bool readOnly);
+    bool   RemoveReference(GpuMemory* pGpuMemory);
+    void   WaitForRefListReaders();
+
+    GpuMemoryInfo* RefListEntry(uint32 slot) const
+        { return &m_pRefListChunks[slot / RefListChunkEntries][slot % RefListChunkEntries]; }
+
     Device*const        m_pDevice;
 
     // Serialize access to the memory manager to ensure thread-safety
@@ -133,17 +171,41 @@ private:
     // Maintain a list of GPU memory objects that are sub-allocated
     GpuMemoryPoolList   m_poolList;
 
-    // Maintain a list of internal GPU memory references
-    GpuMemoryList       m_references;
+    // Chunked array of internal GPU memory references. Entries with a null pGpuMemory are tombstones.
+    GpuMemoryInfo*      m_pRefListChunks[RefListMaxChunks];
+    volatile uint32     m_refListSlotCount;   // Number of slots readers must look at.
+    uint32              m_refListChunkCount;  // Number of allocated chunks.
+    Util::Vector<uint32, 16, Platform> m_freeRefListSlots; // Tombstoned slots below m_refListSlotCount.
 
-    // Serialize access to the reference list
-    Util::RWLock        m_referenceLock;
+    // Serializes changes to the reference list; readers don't take it.
+    Util::Mutex         m_referenceLock;
+
+    // Reader counters for the current and previous epoch.
+    volatile uint32     m_refListEpoch;
+    volatile uint32     m_refListReaders[2];
 
     // Ever-incrementing watermark to signal changes to the internal memory reference list
-    uint32              m_referenceWatermark;
+    volatile uint32     m_referenceWatermark;
+    volatile uint32     m_referenceCount;
 
     PAL_DISALLOW_COPY_AND_ASSIGN(InternalMemMgr);
     PAL_DISALLOW_DEFAULT_CTOR(InternalMemMgr);
 };
 
+// =====================================================================================================================
+// Keeps a reader section of the InternalMemMgr reference list open for as long as it's in scope.
+class RefListReadScope
+{
+public:
+    explicit RefListReadScope(InternalMemMgr* pMemMgr) : m_pMemMgr(pMemMgr), m_epoch(pMemMgr->BeginRefListRead()) { }
+    ~RefListReadScope() { m_pMemMgr->EndRefListRead(m_epoch); }
+
+private:
+    InternalMemMgr*const m_pMemMgr;
+    const uint32         m_epoch;
+
+    PAL_DISALLOW_COPY_AND_ASSIGN(RefListReadScope);
+    PAL_DISALLOW_DEFAULT_CTOR(RefListReadScope);
+};
+
 } // Pal
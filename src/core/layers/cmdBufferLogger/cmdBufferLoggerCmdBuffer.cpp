@@ -4777,6 +4777,18 @@ uint32 CmdBuffer::GetEmbeddedDataLimit() const
     return GetNextLayer()->GetEmbeddedDataLimit();
 }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+// =====================================================================================================================
+Result CmdBuffer::PatchUserData(
+    PipelineBindPoint bindPoint,
+    uint32            firstEntry,
+    uint32            entryCount,
+    const uint32*     pEntryValues)
+{
+    return GetNextLayer()->PatchUserData(bindPoint, firstEntry, entryCount, pEntryValues);
+}
+#endif
+
 // =====================================================================================================================
 uint32* CmdBuffer::CmdAllocateEmbeddedData(
     uint32   sizeInDwords,
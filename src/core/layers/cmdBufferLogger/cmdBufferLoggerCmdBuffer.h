@@ -432,6 +432,13 @@ public:
         uint32            currRingPos,
         uint32            ringSize) override;
     virtual uint32 GetEmbeddedDataLimit() const override;
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    virtual Result PatchUserData(
+        PipelineBindPoint bindPoint,
+        uint32            firstEntry,
+        uint32            entryCount,
+        const uint32*     pEntryValues) override;
+#endif
     virtual uint32* CmdAllocateEmbeddedData(
         uint32   sizeInDwords,
         uint32   alignmentInDwords,
@@ -276,7 +276,10 @@ void FpsMgr::UpdateGpuFps()
         }
 
         // Update Evaluate Time List
-        if (pTimestamp->pFence->GetStatus() == Result::Success)
+        const bool isIdle = pTimestamp->fenceCallback ? (pTimestamp->fenceSignaled != 0)
+                                                      : (pTimestamp->pFence->GetStatus() == Result::Success);
+
+        if (isIdle)
         {
             // If this triggers, this timestamp was added to the list out of frame order.
             PAL_ASSERT(pTimestamp->frameNumber == m_frameTracker);
@@ -532,6 +532,17 @@ Result Queue::SubmitWithGpuTimestampPair(
             result = AssociateFenceWithLastSubmit(pTimestamp->pFence);
         }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+        if (result == Result::Success)
+        {
+            // Have the device flag the timestamps as ready so that the FPS manager doesn't have to poll the fence.
+            pTimestamp->fenceSignaled = 0;
+            pTimestamp->fenceCallback =
+                (m_pDevice->RegisterFenceCallback(pTimestamp->pFence, &TimestampFenceCallback, pTimestamp) ==
+                 Result::Success);
+        }
+#endif
+
         if (result == Result::Success)
         {
             pPlatform->GetFpsMgr()->UpdateSubmitTimelist(pTimestamp);
@@ -635,10 +646,32 @@ Result Queue::CreateGpuTimestampPair(
     return result;
 }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+// =====================================================================================================================
+// Called by the device, possibly on another thread, once a GpuTimestampPair's submit has completed.
+void PAL_STDCALL Queue::TimestampFenceCallback(
+    void*  pUserData,
+    Result result)
+{
+    if (result == Result::Success)
+    {
+        AtomicIncrement(&static_cast<GpuTimestampPair*>(pUserData)->fenceSignaled);
+    }
+}
+#endif
+
 // =====================================================================================================================
 void Queue::DestroyGpuTimestampPair(
     GpuTimestampPair* pTimestamp)
 {
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    // Make sure the device won't call back into a destroyed timestamp pair.
+    if (pTimestamp->fenceCallback)
+    {
+        m_pDevice->UnregisterFenceCallback(pTimestamp->pFence, &TimestampFenceCallback, pTimestamp);
+    }
+#endif
+
     if (pTimestamp->pBeginCmdBuffer != nullptr)
     {
         pTimestamp->pBeginCmdBuffer->Destroy();
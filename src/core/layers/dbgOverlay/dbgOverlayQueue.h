@@ -52,6 +52,8 @@ struct GpuTimestampPair
     volatile uint64* pBeginTimestamp;
     volatile uint64* pEndTimestamp;
     volatile uint32  numActiveSubmissions;  // Keeps track of GpuTimestampPair currently in use
+    bool             fenceCallback;         // The device reports the fence's completion through fenceSignaled
+    volatile uint32  fenceSignaled;         // Set once the last submit's fence has been signaled
 };
 
 // A command buffer and a fence to track its submission state wrapped into one object.
@@ -92,6 +94,10 @@ private:
     Result CreateGpuTimestampPair(GpuTimestampPair** ppTimestamp);
     void DestroyGpuTimestampPair(GpuTimestampPair* pTimestamp);
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    static void PAL_STDCALL TimestampFenceCallback(void* pUserData, Result result);
+#endif
+
 #if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 518
     Result CreateTrackedCmdBuffer(TrackedCmdBuffer** ppTrackedCmdBuffer);
     void DestroyTrackedCmdBuffer(TrackedCmdBuffer* pTrackedCmdBuffer);
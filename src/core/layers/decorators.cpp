@@ -1908,24 +1908,24 @@ void PAL_STDCALL DeviceDecorator::DestroyPrivateScreen(
 }
 
 // =====================================================================================================================
-void PAL_STDCALL CmdBufferFwdDecorator::CmdSetUserDataDecoratorCs(
+void PAL_STDCALL CmdBufferDecorator::CmdSetUserDataDecoratorCs(
     ICmdBuffer*   pCmdBuffer,
     uint32        firstEntry,
     uint32        entryCount,
     const uint32* pEntryValues)
 {
-    auto*const pNextLayer = static_cast<CmdBufferFwdDecorator*>(pCmdBuffer)->GetNextLayer();
+    auto*const pNextLayer = static_cast<CmdBufferDecorator*>(pCmdBuffer)->GetNextLayer();
     pNextLayer->CmdSetUserData(PipelineBindPoint::Compute, firstEntry, entryCount, pEntryValues);
 }
 
 // =====================================================================================================================
-void PAL_STDCALL CmdBufferFwdDecorator::CmdSetUserDataDecoratorGfx(
+void PAL_STDCALL CmdBufferDecorator::CmdSetUserDataDecoratorGfx(
     ICmdBuffer*   pCmdBuffer,
     uint32        firstEntry,
     uint32        entryCount,
     const uint32* pEntryValues)
 {
-    auto*const pNextLayer = static_cast<CmdBufferFwdDecorator*>(pCmdBuffer)->GetNextLayer();
+    auto*const pNextLayer = static_cast<CmdBufferDecorator*>(pCmdBuffer)->GetNextLayer();
     pNextLayer->CmdSetUserData(PipelineBindPoint::Graphics, firstEntry, entryCount, pEntryValues);
 }
 
@@ -282,6 +282,16 @@ public:
         PlatformProperties* pProperties) override
         { return m_pNextLayer->GetProperties(pProperties); }
 
+    virtual Result WriteAllocProfilerReport(
+        const char* pFilename) override
+        { return m_pNextLayer->WriteAllocProfilerReport(pFilename); }
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 550
+    virtual Result GetSlabAllocatorStats(
+        Util::SlabAllocatorStats* pStats) override
+        { return m_pNextLayer->GetSlabAllocatorStats(pStats); }
+#endif
+
     // Part of the IDestroyable public interface.
     virtual void Destroy() override
     {
@@ -584,6 +594,26 @@ public:
         uint64              timeout
         ) const override;
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    virtual Result RegisterFenceCallback(
+        const IFence*     pFence,
+        FenceCallbackFunc pfnCallback,
+        void*             pUserData) override
+        { return m_pNextLayer->RegisterFenceCallback(NextFence(pFence), pfnCallback, pUserData); }
+
+    virtual Result UnregisterFenceCallback(
+        const IFence*     pFence,
+        FenceCallbackFunc pfnCallback,
+        void*             pUserData) override
+        { return m_pNextLayer->UnregisterFenceCallback(NextFence(pFence), pfnCallback, pUserData); }
+#endif
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 551
+    virtual Result GetCmdChunkPoolStats(
+        CmdChunkPoolStats* pStats) override
+        { return m_pNextLayer->GetCmdChunkPoolStats(pStats); }
+#endif
+
     virtual Result WaitForSemaphores(
         uint32                       semaphoreCount,
         const IQueueSemaphore*const* ppSemaphores,
@@ -1248,6 +1278,126 @@ protected:
     const CmdPostProcessFrameInfo* NextCmdPostProcessFrameInfo(const CmdPostProcessFrameInfo& postProcessInfo,
                                                                CmdPostProcessFrameInfo*       pNextPostProcessInfo);
 
+    // Points every entry of m_funcTable at a thunk which passes the call straight to the next layer. Layers which
+    // intercept the table calls may switch individual entries back to these thunks while they have nothing to do, so
+    // that an idle layer costs one forwarding call instead of a full trip through its own implementation.
+    void SetForwardingFuncTable()
+    {
+        m_funcTable.pfnCmdSetUserData[static_cast<uint32>(PipelineBindPoint::Compute)] = CmdSetUserDataDecoratorCs;
+        m_funcTable.pfnCmdSetUserData[static_cast<uint32>(PipelineBindPoint::Graphics)] = CmdSetUserDataDecoratorGfx;
+        m_funcTable.pfnCmdDraw                      = CmdDrawDecorator;
+        m_funcTable.pfnCmdDrawOpaque                = CmdDrawOpaqueDecorator;
+        m_funcTable.pfnCmdDrawIndexed               = CmdDrawIndexedDecorator;
+        m_funcTable.pfnCmdDrawIndirectMulti         = CmdDrawIndirectMultiDecorator;
+        m_funcTable.pfnCmdDrawIndexedIndirectMulti  = CmdDrawIndexedIndirectMultiDecorator;
+        m_funcTable.pfnCmdDispatch                  = CmdDispatchDecorator;
+        m_funcTable.pfnCmdDispatchIndirect          = CmdDispatchIndirectDecorator;
+        m_funcTable.pfnCmdDispatchOffset            = CmdDispatchOffsetDecorator;
+    }
+
+    static void PAL_STDCALL CmdSetUserDataDecoratorCs(
+        ICmdBuffer*   pCmdBuffer,
+        uint32        firstEntry,
+        uint32        entryCount,
+        const uint32* pEntryValues);
+
+    static void PAL_STDCALL CmdSetUserDataDecoratorGfx(
+        ICmdBuffer*   pCmdBuffer,
+        uint32        firstEntry,
+        uint32        entryCount,
+        const uint32* pEntryValues);
+
+    static void PAL_STDCALL CmdDrawDecorator(
+        ICmdBuffer* pCmdBuffer,
+        uint32      firstVertex,
+        uint32      vertexCount,
+        uint32      firstInstance,
+        uint32      instanceCount)
+    {
+        ICmdBuffer* pNextLayer = static_cast<CmdBufferDecorator*>(pCmdBuffer)->m_pNextLayer;
+        pNextLayer->CmdDraw(firstVertex, vertexCount, firstInstance, instanceCount);
+    }
+
+    static void PAL_STDCALL CmdDrawOpaqueDecorator(
+        ICmdBuffer*   pCmdBuffer,
+        gpusize       streamOutFilledSizeVa,
+        uint32        streamOutOffset,
+        uint32        stride,
+        uint32        firstInstance,
+        uint32        instanceCount)
+    {
+        ICmdBuffer* pNextLayer = static_cast<CmdBufferDecorator*>(pCmdBuffer)->m_pNextLayer;
+        pNextLayer->CmdDrawOpaque(streamOutFilledSizeVa, streamOutOffset, stride, firstInstance, instanceCount);
+    }
+
+    static void PAL_STDCALL CmdDrawIndexedDecorator(
+        ICmdBuffer* pCmdBuffer,
+        uint32      firstIndex,
+        uint32      indexCount,
+        int32       vertexOffset,
+        uint32      firstInstance,
+        uint32      instanceCount)
+    {
+        ICmdBuffer* pNextLayer = static_cast<CmdBufferDecorator*>(pCmdBuffer)->m_pNextLayer;
+        pNextLayer->CmdDrawIndexed(firstIndex, indexCount, vertexOffset, firstInstance, instanceCount);
+    }
+
+    static void PAL_STDCALL CmdDrawIndirectMultiDecorator(
+        ICmdBuffer*       pCmdBuffer,
+        const IGpuMemory& gpuMemory,
+        gpusize           offset,
+        uint32            stride,
+        uint32            maximumCount,
+        gpusize           countGpuAddr)
+    {
+        ICmdBuffer* pNextLayer = static_cast<CmdBufferDecorator*>(pCmdBuffer)->m_pNextLayer;
+        pNextLayer->CmdDrawIndirectMulti(*NextGpuMemory(&gpuMemory), offset, stride, maximumCount, countGpuAddr);
+    }
+
+    static void PAL_STDCALL CmdDrawIndexedIndirectMultiDecorator(
+        ICmdBuffer*       pCmdBuffer,
+        const IGpuMemory& gpuMemory,
+        gpusize           offset,
+        uint32            stride,
+        uint32            maximumCount,
+        gpusize           countGpuAddr)
+    {
+        ICmdBuffer* pNextLayer = static_cast<CmdBufferDecorator*>(pCmdBuffer)->m_pNextLayer;
+        pNextLayer->CmdDrawIndexedIndirectMulti(*NextGpuMemory(&gpuMemory), offset, stride, maximumCount, countGpuAddr);
+    }
+
+    static void PAL_STDCALL CmdDispatchDecorator(
+        ICmdBuffer* pCmdBuffer,
+        uint32      x,
+        uint32      y,
+        uint32      z)
+    {
+        ICmdBuffer* pNextLayer = static_cast<CmdBufferDecorator*>(pCmdBuffer)->m_pNextLayer;
+        pNextLayer->CmdDispatch(x, y, z);
+    }
+
+    static void PAL_STDCALL CmdDispatchIndirectDecorator(
+        ICmdBuffer*       pCmdBuffer,
+        const IGpuMemory& gpuMemory,
+        gpusize           offset)
+    {
+        ICmdBuffer* pNextLayer = static_cast<CmdBufferDecorator*>(pCmdBuffer)->m_pNextLayer;
+        pNextLayer->CmdDispatchIndirect(*NextGpuMemory(&gpuMemory), offset);
+    }
+
+    static void PAL_STDCALL CmdDispatchOffsetDecorator(
+        ICmdBuffer* pCmdBuffer,
+        uint32      xOffset,
+        uint32      yOffset,
+        uint32      zOffset,
+        uint32      xDim,
+        uint32      yDim,
+        uint32      zDim)
+    {
+        ICmdBuffer* pNextLayer = static_cast<CmdBufferDecorator*>(pCmdBuffer)->m_pNextLayer;
+        pNextLayer->CmdDispatchOffset(xOffset, yOffset, zOffset, xDim, yDim, zDim);
+    }
+
     PAL_DISALLOW_DEFAULT_CTOR(CmdBufferDecorator);
     PAL_DISALLOW_COPY_AND_ASSIGN(CmdBufferDecorator);
 };
@@ -1260,18 +1410,7 @@ public:
         :
         CmdBufferDecorator(pNextCmdBuffer, pNextDevice)
     {
-        m_funcTable.pfnCmdSetUserData[static_cast<uint32>(PipelineBindPoint::Compute)] =
-            &CmdBufferFwdDecorator::CmdSetUserDataDecoratorCs;
-        m_funcTable.pfnCmdSetUserData[static_cast<uint32>(PipelineBindPoint::Graphics)] =
-            &CmdBufferFwdDecorator::CmdSetUserDataDecoratorGfx;
-        m_funcTable.pfnCmdDraw                      = CmdDrawDecorator;
-        m_funcTable.pfnCmdDrawOpaque                = CmdDrawOpaqueDecorator;
-        m_funcTable.pfnCmdDrawIndexed               = CmdDrawIndexedDecorator;
-        m_funcTable.pfnCmdDrawIndirectMulti         = CmdDrawIndirectMultiDecorator;
-        m_funcTable.pfnCmdDrawIndexedIndirectMulti  = CmdDrawIndexedIndirectMultiDecorator;
-        m_funcTable.pfnCmdDispatch                  = CmdDispatchDecorator;
-        m_funcTable.pfnCmdDispatchIndirect          = CmdDispatchIndirectDecorator;
-        m_funcTable.pfnCmdDispatchOffset            = CmdDispatchOffsetDecorator;
+        SetForwardingFuncTable();
     }
 
     virtual Result Begin(const CmdBufferBuildInfo& info) override
@@ -1286,6 +1425,15 @@ public:
     virtual uint32 GetEmbeddedDataLimit() const override
         { return m_pNextLayer->GetEmbeddedDataLimit(); }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    virtual Result PatchUserData(
+        PipelineBindPoint bindPoint,
+        uint32            firstEntry,
+        uint32            entryCount,
+        const uint32*     pEntryValues) override
+        { return m_pNextLayer->PatchUserData(bindPoint, firstEntry, entryCount, pEntryValues); }
+#endif
+
     virtual void CmdBindPipeline(
         const PipelineBindParams& params) override
         { m_pNextLayer->CmdBindPipeline(NextPipelineBindParams(params)); }
@@ -2088,110 +2236,6 @@ public:
 protected:
     virtual ~CmdBufferFwdDecorator() {}
 
-private:
-    static void PAL_STDCALL CmdSetUserDataDecoratorCs(
-        ICmdBuffer*   pCmdBuffer,
-        uint32        firstEntry,
-        uint32        entryCount,
-        const uint32* pEntryValues);
-
-    static void PAL_STDCALL CmdSetUserDataDecoratorGfx(
-        ICmdBuffer*   pCmdBuffer,
-        uint32        firstEntry,
-        uint32        entryCount,
-        const uint32* pEntryValues);
-
-    static void PAL_STDCALL CmdDrawDecorator(
-        ICmdBuffer* pCmdBuffer,
-        uint32      firstVertex,
-        uint32      vertexCount,
-        uint32      firstInstance,
-        uint32      instanceCount)
-    {
-        ICmdBuffer* pNextLayer = static_cast<CmdBufferFwdDecorator*>(pCmdBuffer)->m_pNextLayer;
-        pNextLayer->CmdDraw(firstVertex, vertexCount, firstInstance, instanceCount);
-    }
-
-    static void PAL_STDCALL CmdDrawOpaqueDecorator(
-        ICmdBuffer*   pCmdBuffer,
-        gpusize       streamOutFilledSizeVa,
-        uint32        streamOutOffset,
-        uint32        stride,
-        uint32        firstInstance,
-        uint32        instanceCount)
-    {
-        ICmdBuffer* pNextLayer = static_cast<CmdBufferFwdDecorator*>(pCmdBuffer)->m_pNextLayer;
-        pNextLayer->CmdDrawOpaque(streamOutFilledSizeVa, streamOutOffset, stride, firstInstance, instanceCount);
-    }
-
-    static void PAL_STDCALL CmdDrawIndexedDecorator(
-        ICmdBuffer* pCmdBuffer,
-        uint32      firstIndex,
-        uint32      indexCount,
-        int32       vertexOffset,
-        uint32      firstInstance,
-        uint32      instanceCount)
-    {
-        ICmdBuffer* pNextLayer = static_cast<CmdBufferFwdDecorator*>(pCmdBuffer)->m_pNextLayer;
-        pNextLayer->CmdDrawIndexed(firstIndex, indexCount, vertexOffset, firstInstance, instanceCount);
-    }
-
-    static void PAL_STDCALL CmdDrawIndirectMultiDecorator(
-        ICmdBuffer*       pCmdBuffer,
-        const IGpuMemory& gpuMemory,
-        gpusize           offset,
-        uint32            stride,
-        uint32            maximumCount,
-        gpusize           countGpuAddr)
-    {
-        ICmdBuffer* pNextLayer = static_cast<CmdBufferFwdDecorator*>(pCmdBuffer)->m_pNextLayer;
-        pNextLayer->CmdDrawIndirectMulti(*NextGpuMemory(&gpuMemory), offset, stride, maximumCount, countGpuAddr);
-    }
-
-    static void PAL_STDCALL CmdDrawIndexedIndirectMultiDecorator(
-        ICmdBuffer*       pCmdBuffer,
-        const IGpuMemory& gpuMemory,
-        gpusize           offset,
-        uint32            stride,
-        uint32            maximumCount,
-        gpusize           countGpuAddr)
-    {
-        ICmdBuffer* pNextLayer = static_cast<CmdBufferFwdDecorator*>(pCmdBuffer)->m_pNextLayer;
-        pNextLayer->CmdDrawIndexedIndirectMulti(*NextGpuMemory(&gpuMemory), offset, stride, maximumCount, countGpuAddr);
-    }
-
-    static void PAL_STDCALL CmdDispatchDecorator(
-        ICmdBuffer* pCmdBuffer,
-        uint32      x,
-        uint32      y,
-        uint32      z)
-    {
-        ICmdBuffer* pNextLayer = static_cast<CmdBufferFwdDecorator*>(pCmdBuffer)->m_pNextLayer;
-        pNextLayer->CmdDispatch(x, y, z);
-    }
-
-    static void PAL_STDCALL CmdDispatchIndirectDecorator(
-        ICmdBuffer*       pCmdBuffer,
-        const IGpuMemory& gpuMemory,
-        gpusize           offset)
-    {
-        ICmdBuffer* pNextLayer = static_cast<CmdBufferFwdDecorator*>(pCmdBuffer)->m_pNextLayer;
-        pNextLayer->CmdDispatchIndirect(*NextGpuMemory(&gpuMemory), offset);
-    }
-
-    static void PAL_STDCALL CmdDispatchOffsetDecorator(
-        ICmdBuffer* pCmdBuffer,
-        uint32      xOffset,
-        uint32      yOffset,
-        uint32      zOffset,
-        uint32      xDim,
-        uint32      yDim,
-        uint32      zDim)
-    {
-        ICmdBuffer* pNextLayer = static_cast<CmdBufferFwdDecorator*>(pCmdBuffer)->m_pNextLayer;
-        pNextLayer->CmdDispatchOffset(xOffset, yOffset, zOffset, xDim, yDim, zDim);
-    }
-
     PAL_DISALLOW_DEFAULT_CTOR(CmdBufferFwdDecorator);
     PAL_DISALLOW_COPY_AND_ASSIGN(CmdBufferFwdDecorator);
 };
@@ -0,0 +1,149 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#pragma once
+
+#include "pal.h"
+
+// Layout of the binary log written by the GPU profiler when GpuProfilerConfig.LogFormat is GpuProfilerLogFormatBinary.
+// The file is consumed offline by tools/gpuProfilerTools/binaryLogToCsv.py, which must be kept in sync with this file.
+//
+// A log file holds every item logged by a single queue.  It starts with a BinaryLogHeader followed by a string table,
+// then any number of blocks.  Each block is a BinaryLogBlockHeader followed by one array per column (each holding
+// rowCount values of that column's width, in BinaryLogColumn order), followed by the block's string heap.  Storing
+// the data by column lets the writer append rows without formatting anything and keeps similar values adjacent.
+
+namespace Pal
+{
+namespace GpuProfiler
+{
+
+constexpr uint32 BinaryLogMagic      = 0x424C5047; // 'GPLB'
+constexpr uint32 BinaryLogBlockMagic = 0x4B4C4247; // 'GBLK'
+constexpr uint32 BinaryLogVersion    = 1;
+
+// Maximum number of rows the writer will buffer before emitting a block.
+constexpr uint32 BinaryLogMaxBlockRows = 1024;
+
+// Value stored in the comment column of rows which have no comment.
+constexpr uint32 BinaryLogNoString = UINT32_MAX;
+
+// Fixed file header.  All multi-byte values are little-endian.
+struct BinaryLogHeader
+{
+    uint32 magic;             // BinaryLogMagic.
+    uint32 version;           // BinaryLogVersion.
+    uint64 timestampFreq;     // GPU timestamp frequency in Hz.
+    uint32 deviceId;          // Device index.
+    uint32 engineIndex;       // Engine instance.
+    uint32 queueId;           // Queue ID.
+    uint32 flags;             // Mask of BinaryLogHeaderFlags.
+    uint32 numPipelineStats;  // Number of pipeline stats columns (zero if pipeline stats aren't recorded).
+    uint32 numPerfCounters;   // Number of global perf counter columns.
+    uint32 numQueueCallIds;   // Number of queue call names in the string table.
+    uint32 numCmdBufCallIds;  // Number of command buffer call names in the string table.
+    uint32 stringTableSize;   // Size in bytes of the string table that immediately follows this header.
+    uint32 reserved;
+};
+
+// The string table holds, in order, null-terminated strings for: the engine type name, each QueueCallId name, each
+// CmdBufCallId name, then each global perf counter name.
+
+enum BinaryLogHeaderFlags : uint32
+{
+    BinaryLogFullPipelineHash = 0x1, // The PipelineUnique column should be reported.
+    BinaryLogThreadTrace      = 0x2, // Thread traces were enabled; the CSV header gets a ThreadTraceId column.
+};
+
+struct BinaryLogBlockHeader
+{
+    uint32 magic;             // BinaryLogBlockMagic.
+    uint32 rowCount;          // Number of rows in each column array.
+    uint32 stringHeapSize;    // Size in bytes of the string heap following the column arrays.
+    uint32 reserved;
+};
+
+// Fixed columns, in storage order.  The pipeline stats columns (if any) and perf counter columns (if any) follow
+// these, each 8 bytes wide.
+enum class BinaryLogColumn : uint32
+{
+    FrameId = 0,    // uint32
+    RowFlags,       // uint32, BinaryLogRowFlags
+    CallId,         // uint32, QueueCallId or CmdBufCallId depending on the item type
+    CmdBufIndex,    // uint32
+    TraceValue,     // uint32, meaning depends on the trace status in RowFlags
+    Count0,         // uint32, vertex count or thread group count
+    Count1,         // uint32, instance count
+    Comment,        // uint32, offset into the block's string heap or BinaryLogNoString
+    StartClock,     // uint64
+    EndClock,       // uint64
+    ApiPsoHash,     // uint64
+    PipelineStable, // uint64
+    PipelineUnique, // uint64
+    ShaderHash0Hi,  // uint64, VS or CS
+    ShaderHash0Lo,  // uint64
+    ShaderHash1Hi,  // uint64, HS
+    ShaderHash1Lo,  // uint64
+    ShaderHash2Hi,  // uint64, DS
+    ShaderHash2Lo,  // uint64
+    ShaderHash3Hi,  // uint64, GS
+    ShaderHash3Lo,  // uint64
+    ShaderHash4Hi,  // uint64, PS
+    ShaderHash4Lo,  // uint64
+    Count
+};
+
+constexpr uint32 BinaryLogFirst64BitColumn = static_cast<uint32>(BinaryLogColumn::StartClock);
+constexpr uint32 BinaryLogNumFixedColumns  = static_cast<uint32>(BinaryLogColumn::Count);
+
+enum BinaryLogRowFlags : uint32
+{
+    BinaryLogRowTypeMask        = 0x3,   // LogItemType of the row.
+    BinaryLogRowNested          = 0x4,   // Command buffer call made inside a nested command buffer.
+    BinaryLogRowDraw            = 0x8,
+    BinaryLogRowDispatch        = 0x10,
+    BinaryLogRowBarrier         = 0x20,
+    BinaryLogRowComment         = 0x40,
+    BinaryLogRowTimestamps      = 0x80,  // StartClock and EndClock are valid.
+    BinaryLogRowHideElapsed     = 0x100, // Timestamps are valid but the elapsed time shouldn't be reported.
+    BinaryLogRowPipelineStats   = 0x200, // The pipeline stats columns are valid.
+    BinaryLogRowPerfCounters    = 0x400, // The perf counter columns are valid.
+    BinaryLogRowTraceShift      = 12,    // Bits [15:12] hold a BinaryLogTraceStatus.
+    BinaryLogRowTraceMask       = 0xF000,
+};
+
+// Describes the contents of the trace column for a row.
+enum BinaryLogTraceStatus : uint32
+{
+    BinaryLogTraceNone = 0,          // Nothing to report.
+    BinaryLogTraceValue,             // TraceValue holds the thread trace ID or RGP frame number.
+    BinaryLogTraceRgpNeedsFrame,     // RGP output requires frame granularity.
+    BinaryLogTraceOutOfMemory,       // The perf experiment ran out of memory.
+    BinaryLogTraceUnsupported,       // Thread traces are unsupported on this command buffer.
+    BinaryLogTraceOmitted,           // The row has no trace column at all.
+};
+
+} // GpuProfiler
+} // Pal
@@ -2905,6 +2905,20 @@ uint32 CmdBuffer::GetEmbeddedDataLimit() const
     return NextLayer()->GetEmbeddedDataLimit();
 }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+// =====================================================================================================================
+// The recorded commands are replayed into a different target command buffer at submit time, so the values written by
+// this command buffer's next layer are never executed and patching them would have no effect.
+Result CmdBuffer::PatchUserData(
+    PipelineBindPoint bindPoint,
+    uint32            firstEntry,
+    uint32            entryCount,
+    const uint32*     pEntryValues)
+{
+    return Result::ErrorUnavailable;
+}
+#endif
+
 // =====================================================================================================================
 uint32* CmdBuffer::CmdAllocateEmbeddedData(
     uint32   sizeInDwords,
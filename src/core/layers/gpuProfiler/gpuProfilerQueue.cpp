@@ -38,6 +38,9 @@ namespace Pal
 namespace GpuProfiler
 {
 
+// Timeout value which makes ConditionVariable::Wait() wait forever.
+constexpr uint32 InfiniteWait = 0xFFFFFFFF;
+
 // =====================================================================================================================
 Queue::Queue(
     IQueue*    pNextQueue,
@@ -66,11 +69,19 @@ Queue::Queue(
     m_numReportedPerfCounters(0),
     m_availableFences(static_cast<Platform*>(pDevice->GetPlatform())),
     m_pendingSubmits(static_cast<Platform*>(pDevice->GetPlatform())),
+    m_retiringSubmits(static_cast<Platform*>(pDevice->GetPlatform())),
     m_profilingModeEnabled(false),
     m_logItems(static_cast<Platform*>(pDevice->GetPlatform())),
+    m_logBatches(static_cast<Platform*>(pDevice->GetPlatform())),
+    m_logWorkerSleeping(0),
+    m_logBatchesQueued(0),
+    m_logBatchesRetired(0),
     m_curLogFrame(0),
     m_curLogCmdBufIdx(0),
-    m_curLogSqttIdx(0)
+    m_curLogSqttIdx(0),
+    m_pBinaryColumns(nullptr),
+    m_binaryRowCount(0),
+    m_binaryStrings(static_cast<Platform*>(pDevice->GetPlatform()))
 {
     memset(&m_nestedAllocatorCreateInfo, 0, sizeof(m_nestedAllocatorCreateInfo));
     memset(&m_gpaSessionSampleConfig,    0, sizeof(m_gpaSessionSampleConfig));
@@ -96,14 +107,55 @@ Queue::~Queue()
 {
     // Ensure all log items are flushed out before we shut down.
     WaitIdle();
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    // Fence callbacks which haven't run yet must not touch this queue once it's gone.  Every submit is idle now, so
+    // cancel them and poll those fences instead.
+    auto iter = m_pendingSubmits.Begin();
+    for (uint32 idx = 0; idx < m_pendingSubmits.NumElements(); ++idx, iter.Next())
+    {
+        PendingSubmitInfo*const pSubmitInfo = iter.Get();
+
+        if (pSubmitInfo->fenceCallback &&
+            (m_pDevice->UnregisterFenceCallback(pSubmitInfo->pFence,
+                                                &SubmitFenceCallback,
+                                                const_cast<uint32*>(&pSubmitInfo->fenceSignaled)) == Result::Success))
+        {
+            pSubmitInfo->fenceCallback = false;
+        }
+    }
+#endif
+
     ProcessIdleSubmits();
+
+    if (m_logWorker.IsCreated())
+    {
+        // The null batch tells the worker to exit once it has written out every batch queued before it.
+        LogBatch* pExitBatch = nullptr;
+        while (m_logBatches.Push(pExitBatch) == false)
+        {
+            YieldThread();
+        }
+
+        {
+            MutexAuto lock(&m_logWorkerLock);
+            m_logWorkerCond.WakeOne();
+        }
+
+        m_logWorker.Join();
+    }
+
+    RecycleRetiredSubmits();
     m_logFile.Close();
 
     PAL_ASSERT(m_busyCmdBufs.NumElements() == 0);
     PAL_ASSERT(m_busyNestedCmdBufs.NumElements() == 0);
     PAL_ASSERT(m_pendingSubmits.NumElements() == 0);
+    PAL_ASSERT(m_retiringSubmits.NumElements() == 0);
     PAL_ASSERT(m_busyGpaSessions.NumElements() == 0);
 
+    PAL_SAFE_FREE(m_pBinaryColumns, m_pDevice->GetPlatform());
+
     while (m_availableCmdBufs.NumElements() > 0)
     {
         TargetCmdBuffer* pCmdBuf = nullptr;
@@ -213,6 +265,27 @@ Result Queue::Init()
         m_numReportedPerfCounters = numGlobalPerfCounters;
     }
 
+    // Reading back results and writing the log is done by a worker thread so that it doesn't stall the application.
+    if (result == Result::Success)
+    {
+        result = m_logBatches.Init(MaxQueuedLogBatches);
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_logWorkerLock.Init();
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_logWorkerCond.Init();
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_logWorker.Begin(&LogWorkerThreadFunc, this);
+    }
+
     return result;
 }
 
@@ -238,7 +311,21 @@ Result Queue::InternalSubmit(
         AssociateFenceWithLastSubmit(m_nextSubmitInfo.pFence);
 
         // Track this submission so we know when we can reclaim the queue-owned command buffers and fence.
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+        if (m_pendingSubmits.PushBack(m_nextSubmitInfo) == Result::Success)
+        {
+            // Let the device tell us when this submit is idle instead of polling its fence.  Deque elements never move,
+            // so the callback can flag the pending submit directly.
+            PendingSubmitInfo*const pSubmitInfo = &m_pendingSubmits.Back();
+
+            pSubmitInfo->fenceCallback =
+                (m_pDevice->RegisterFenceCallback(pSubmitInfo->pFence,
+                                                  &SubmitFenceCallback,
+                                                  const_cast<uint32*>(&pSubmitInfo->fenceSignaled)) == Result::Success);
+        }
+#else
         m_pendingSubmits.PushBack(m_nextSubmitInfo);
+#endif
         memset(&m_nextSubmitInfo, 0, sizeof(PendingSubmitInfo));
     }
 
@@ -824,18 +911,122 @@ IFence* Queue::AcquireFence()
     return pFence;
 }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+// =====================================================================================================================
+// Called by the device once the fence of one of our tracked submits has been signaled.  This may run on another thread
+// so it only flags the submit as idle; ProcessIdleSubmits() does the rest.
+void PAL_STDCALL Queue::SubmitFenceCallback(
+    void*  pUserData,
+    Result result)
+{
+    if (result == Result::Success)
+    {
+        AtomicIncrement(static_cast<volatile uint32*>(pUserData));
+    }
+}
+#endif
+
+// =====================================================================================================================
+// Returns true if the given pending submit has completed.
+bool Queue::IsSubmitIdle(
+    const PendingSubmitInfo& submitInfo
+    ) const
+{
+    return submitInfo.fenceCallback ? (submitInfo.fenceSignaled != 0)
+                                    : (submitInfo.pFence->GetStatus() == Result::Success);
+}
+
 // =====================================================================================================================
 // Determine if any pending submits have completed, and perform accounting on busy/idle command buffers and fences.
 void Queue::ProcessIdleSubmits()
 {
-    while ((m_pendingSubmits.NumElements() > 0) &&
-           (m_pendingSubmits.Front().pFence->GetStatus() == Result::Success))
+    while ((m_pendingSubmits.NumElements() > 0) && IsSubmitIdle(m_pendingSubmits.Front()))
     {
         PendingSubmitInfo submitInfo = { };
         m_pendingSubmits.PopFront(&submitInfo);
 
-        // Output items from the log item queue that are now known to be idle.
-        OutputLogItemsToFile(submitInfo.logItemCount);
+        // Hand the log items that are now known to be idle off to the log worker thread.
+        QueueLogItems(submitInfo.logItemCount);
+
+        // The fence isn't referenced by the log items so it can be recycled right away.  Everything else must wait
+        // until the worker is finished with this submit's log items.
+        m_pDevice->ResetFences(1, &submitInfo.pFence);
+        m_availableFences.PushBack(submitInfo.pFence);
+
+        submitInfo.pFence     = nullptr;
+        submitInfo.logBatchId = m_logBatchesQueued;
+        m_retiringSubmits.PushBack(submitInfo);
+    }
+
+    RecycleRetiredSubmits();
+}
+
+// =====================================================================================================================
+// Copies the first count items in the m_logItems deque into a new batch and queues it to the log worker thread.
+void Queue::QueueLogItems(
+    uint32 count)
+{
+    PAL_ASSERT(count <= m_logItems.NumElements());
+
+    if (count > 0)
+    {
+        LogBatch* pBatch = static_cast<LogBatch*>(PAL_MALLOC(sizeof(LogBatch) + (count * sizeof(LogItem)),
+                                                             m_pDevice->GetPlatform(),
+                                                             AllocInternal));
+
+        if (pBatch != nullptr)
+        {
+            pBatch->pLogItems    = static_cast<LogItem*>(VoidPtrInc(pBatch, sizeof(LogBatch)));
+            pBatch->logItemCount = count;
+
+            for (uint32 i = 0; i < count; i++)
+            {
+                m_logItems.PopFront(&pBatch->pLogItems[i]);
+            }
+
+            // If the worker is this far behind there's not much we can do except give it some time to catch up.
+            while (m_logBatches.Push(pBatch) == false)
+            {
+                YieldThread();
+            }
+
+            m_logBatchesQueued++;
+
+            // Pushing the batch was a full barrier, so either we see that the worker is going to sleep or it sees our
+            // batch before it does.
+            if (AtomicAdd(&m_logWorkerSleeping, 0) != 0)
+            {
+                MutexAuto lock(&m_logWorkerLock);
+                m_logWorkerCond.WakeOne();
+            }
+        }
+        else
+        {
+            // We can't log these items but we still need to remove them from the deque to keep it in sync with the
+            // pending submits.
+            PAL_ALERT_ALWAYS();
+
+            for (uint32 i = 0; i < count; i++)
+            {
+                LogItem logItem = { };
+                m_logItems.PopFront(&logItem);
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Recycles the command buffers and GpaSessions of any retiring submits whose log items have been fully processed by
+// the log worker thread.
+void Queue::RecycleRetiredSubmits()
+{
+    const uint32 logBatchesRetired = AtomicAdd(&m_logBatchesRetired, 0);
+
+    while ((m_retiringSubmits.NumElements() > 0) &&
+           (static_cast<int32>(m_retiringSubmits.Front().logBatchId - logBatchesRetired) <= 0))
+    {
+        PendingSubmitInfo submitInfo = { };
+        m_retiringSubmits.PopFront(&submitInfo);
 
         for (uint32 i = 0; i < submitInfo.cmdBufCount; i++)
         {
@@ -870,9 +1061,56 @@ void Queue::ProcessIdleSubmits()
             pGpaSession->Reset();
             m_availableGpaSessions.PushBack(pGpaSession);
         }
+    }
+}
 
-        m_pDevice->ResetFences(1, &submitInfo.pFence);
-        m_availableFences.PushBack(submitInfo.pFence);
+// =====================================================================================================================
+void Queue::LogWorkerThreadFunc(
+    void* pParameter)
+{
+    static_cast<Queue*>(pParameter)->LogWorkerLoop();
+}
+
+// =====================================================================================================================
+// Main loop of the log worker thread: writes out each queued batch of log items, sleeping when there are none.
+void Queue::LogWorkerLoop()
+{
+    bool exit = false;
+
+    while (exit == false)
+    {
+        LogBatch* pBatch = nullptr;
+
+        if (m_logBatches.Pop(&pBatch))
+        {
+            if (pBatch != nullptr)
+            {
+                OutputLogItemsToFile(pBatch->pLogItems, pBatch->logItemCount);
+                PAL_SAFE_FREE(pBatch, m_pDevice->GetPlatform());
+
+                // This releases the batch's command buffers and GpaSessions back to the submitting thread.
+                AtomicIncrement(&m_logBatchesRetired);
+            }
+            else
+            {
+                exit = true;
+            }
+        }
+        else
+        {
+            MutexAuto lock(&m_logWorkerLock);
+
+            // Incrementing the flag is a full barrier, so either the submitting thread sees that we're going to sleep
+            // and wakes us or we see its batch here.
+            AtomicIncrement(&m_logWorkerSleeping);
+
+            if (m_logBatches.IsEmpty())
+            {
+                m_logWorkerCond.Wait(&m_logWorkerLock, InfiniteWait);
+            }
+
+            AtomicDecrement(&m_logWorkerSleeping);
+        }
     }
 }
 
@@ -27,10 +27,16 @@
 
 #include "core/layers/decorators.h"
 #include "core/layers/functionIds.h"
+#include "palBufferedFile.h"
+#include "palConditionVariable.h"
 #include "palDeque.h"
 #include "palFile.h"
 #include "palGpaSession.h"
 #include "palLinearAllocator.h"
+#include "palMutex.h"
+#include "palSpscQueue.h"
+#include "palThread.h"
+#include "palVector.h"
 
 namespace Pal
 {
@@ -44,6 +50,9 @@ class TargetCmdBuffer;
 
 static constexpr size_t MaxCommentLength = 512;
 
+// Number of pipeline statistics values logged for each call when pipeline stats are recorded.
+static constexpr uint32 NumPipelineStats = 11;
+
 // Identifies whether a specific LogItem corresponds to a queue call (Submit(), Present(), etc.), a command buffer
 // call (CmdDrawIndexed(), CmdCopyImage(), etc.), or a full frame.
 enum LogItemType : uint32
@@ -215,6 +224,10 @@ private:
     IFence* AcquireFence();
     void ProcessIdleSubmits();
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    static void PAL_STDCALL SubmitFenceCallback(void* pUserData, Result result);
+#endif
+
     Result InternalSubmit(
         const SubmitInfo& submitInfo,
         bool              releaseObjects);
@@ -223,7 +236,14 @@ private:
 
     void LogQueueCall(QueueCallId callId);
 
-    void OutputLogItemsToFile(size_t count);
+    void QueueLogItems(uint32 count);
+    void RecycleRetiredSubmits();
+
+    static void LogWorkerThreadFunc(void* pParameter);
+    void LogWorkerLoop();
+
+    void OutputLogItemsToFile(const LogItem* pLogItems, uint32 count);
+    void BeginLogFrame(uint32 frameId);
     void OpenLogFile(uint32 frameId);
     void OpenSqttFile(
         uint32 shaderEngineId,
@@ -231,7 +251,7 @@ private:
         uint32 drawId,
         Util::File* pFile,
         const LogItem& logItem);
-    void OpenSpmFile(Util::File* pFile, const LogItem& logItem);
+    void OpenSpmFile(Util::BufferedFile* pFile, const LogItem& logItem);
     void OutputRgpFile(const GpuUtil::GpaSession& gpaSession, uint32 gpaSampleId);
     void OutputQueueCallToFile(const LogItem& logItem);
     void OutputCmdBufCallToFile(const LogItem& logItem, const char* pNestedCmdBufPrefix);
@@ -242,6 +262,19 @@ private:
     void OutputGlobalPerfCountersToFile(const LogItem& logItem);
     void OutputTraceDataToFile(const LogItem& logItem);
 
+    void   OpenBinaryLogFile();
+    void   AppendBinaryLogRow(const LogItem& logItem, bool nested);
+    uint32 AppendBinaryLogString(const char* pString);
+    void   EmitBinaryLogBlock();
+    uint32 NumBinaryLog64BitColumns() const;
+
+    // Helpers which read back the results of a single log item, shared by the CSV and binary writers.
+    bool   ReadTimestamps(const LogItem& logItem, uint64* pTimestamps) const;
+    bool   ReadPipelineStats(const LogItem& logItem, uint64* pPipelineStats) const;
+    bool   ReadGlobalPerfCounters(const LogItem& logItem, uint64* pCounters) const;
+    bool   HideElapsedTime(const LogItem& logItem) const;
+    uint32 OutputTraceData(const LogItem& logItem, uint32* pTraceValue);
+
     void ProfilingClockMode(bool enable);
 
     Device*const     m_pDevice;
@@ -285,21 +318,33 @@ private:
     Util::Deque<IFence*, Platform>              m_availableFences;
 
     // Tracks a list of pending (not retired yet) submits on this queue.  When the corresponding pFence object is
-    // signaled, we know we can:
+    // signaled (as reported by SubmitFenceCallback, or by polling it if the callback couldn't be registered), we know
+    // we can:
     //     - Process logItemCount items in m_logItems - all timestamps, queries, etc. are idle and ready to be logged.
-    //     - Reclaim the first cmdBufCount/gpuMemCount/etc. entries in each of the "m_busyFoo" deques.
     //     - Reclaim that fence as available.
+    //     - Once the log worker has processed those items, reclaim the first cmdBufCount/gpuMemCount/etc. entries in
+    //       each of the "m_busyFoo" deques.
     struct PendingSubmitInfo
     {
-        IFence* pFence;
-        uint32  cmdBufCount;
-        uint32  nestedCmdBufCount;
-        uint32  gpuMemCount;
-        uint32  logItemCount;
-        uint32  gpaSessionCount;
+        IFence*         pFence;
+        bool            fenceCallback;      // Completion of this submit is reported through fenceSignaled.
+        volatile uint32 fenceSignaled;      // Set by SubmitFenceCallback.
+        uint32          cmdBufCount;
+        uint32          nestedCmdBufCount;
+        uint32          gpuMemCount;
+        uint32          logItemCount;
+        uint32          gpaSessionCount;
+        uint32          logBatchId;         // Value m_logBatchesRetired must reach before the resources above may be
+                                            // reused.
     };
     Util::Deque<PendingSubmitInfo, Platform> m_pendingSubmits;
 
+    bool IsSubmitIdle(const PendingSubmitInfo& submitInfo) const;
+
+    // Submits which the GPU has finished but whose log items may still be read by the log worker thread.  Their
+    // command buffers (which own barrier comment strings) and GpaSessions can't be recycled until the worker is done.
+    Util::Deque<PendingSubmitInfo, Platform> m_retiringSubmits;
+
     // Tracks resources that have been acquired and log items that have been added since the last tracked submit.  This
     // structure will be pushed onto the back of m_pendingSubmits on the next tracked submit.
     PendingSubmitInfo                 m_nextSubmitInfo;
@@ -307,14 +352,40 @@ private:
     bool                              m_profilingModeEnabled;
 
     Util::Deque<LogItem, Platform>    m_logItems;         // List of outstanding calls waiting to be logged.
-    Util::File                        m_logFile;          // File logging is currently outputted to (changes per frame).
-    uint32                            m_curLogFrame;      // Used to determine when a new frame is started and a new log
-                                                          // file should be opened.
-    uint32                            m_curLogCmdBufIdx;  // Current command buffer index for the frame being logged.
-    uint32                            m_curLogSqttIdx;    // Current SQ thread trace index for the cmdbuf being logged.
-
     LogItem                           m_perFrameLogItem;  // Log item used when the profiling granularity is per frame.
 
+    // Log items of idle submits are copied into a LogBatch and handed to a worker thread which reads back their
+    // results and writes them to the log, so the submitting thread never waits on the log.
+    struct LogBatch
+    {
+        LogItem* pLogItems;
+        uint32   logItemCount;
+    };
+
+    // The submitting thread yields if the worker falls this many batches behind.
+    static constexpr uint32 MaxQueuedLogBatches = 256;
+
+    Util::Thread                          m_logWorker;
+    Util::SpscQueue<LogBatch*, Platform>  m_logBatches;         // A null entry tells the worker to exit.
+    Util::Mutex                           m_logWorkerLock;
+    Util::ConditionVariable               m_logWorkerCond;      // Signaled when a batch is queued to a sleeping worker.
+    volatile uint32                       m_logWorkerSleeping;
+    uint32                                m_logBatchesQueued;   // Only accessed by the submitting thread.
+    volatile uint32                       m_logBatchesRetired;  // Only incremented by the worker thread.
+
+    // Everything below is only accessed by the log worker thread once it has been started.
+    Util::BufferedFile                 m_logFile;          // File logging is currently outputted to (changes per frame
+                                                           // for the CSV log format).
+    uint32                             m_curLogFrame;      // Used to determine when a new frame is started and a new
+                                                           // log file should be opened.
+    uint32                             m_curLogCmdBufIdx;  // Current command buffer index for the frame being logged.
+    uint32                             m_curLogSqttIdx;    // Current SQ thread trace index for the cmdbuf being logged.
+
+    // Column arrays of the binary log block being built, see gpuProfilerBinaryLog.h.
+    uint8*                             m_pBinaryColumns;
+    uint32                             m_binaryRowCount;
+    Util::Vector<char, 1024, Platform> m_binaryStrings;   // String heap of the binary log block being built.
+
     PAL_DISALLOW_DEFAULT_CTOR(Queue);
     PAL_DISALLOW_COPY_AND_ASSIGN(Queue);
 };
@@ -24,6 +24,7 @@
  **********************************************************************************************************************/
 
 #include "core/layers/functionIds.h"
+#include "core/layers/gpuProfiler/gpuProfilerBinaryLog.h"
 #include "core/layers/gpuProfiler/gpuProfilerCmdBuffer.h"
 #include "core/layers/gpuProfiler/gpuProfilerDevice.h"
 #include "core/layers/gpuProfiler/gpuProfilerPlatform.h"
@@ -56,13 +57,21 @@ constexpr const char* EngineTypeStrings[] =
 
 static_assert(ArrayLen(EngineTypeStrings) == EngineTypeCount, "Missing entry in EngineTypeStrings.");
 
+// Index of a column within the 32-bit or 64-bit portion of a binary log row.
+constexpr uint32 Column32(BinaryLogColumn column) { return static_cast<uint32>(column); }
+constexpr uint32 Column64(BinaryLogColumn column) { return static_cast<uint32>(column) - BinaryLogFirst64BitColumn; }
+
+constexpr uint32 NumFixed64BitColumns = BinaryLogNumFixedColumns - BinaryLogFirst64BitColumn;
+
 // =====================================================================================================================
-// Writes .csv entries to file corresponding to the first count items in the m_logItems deque.  The caller guarantees
-// that all of these calls are idle.
+// Writes log entries corresponding to a batch of log items.  The caller guarantees that all of these calls are idle.
+// This is only called by the log worker thread.
 void Queue::OutputLogItemsToFile(
-    size_t count)
+    const LogItem* pLogItems,
+    uint32         count)
 {
-    PAL_ASSERT(count <= m_logItems.NumElements());
+    const bool binaryLog = (m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerConfig.logFormat ==
+                            GpuProfilerLogFormatBinary);
 
     // Log items from a nested command buffer are flattened so that they appear the same as regular command buffer
     // calls.  activeCmdBufs tracks how many "open" command buffers there are - 0 during queue calls, 1 inside a submit,
@@ -73,8 +82,7 @@ void Queue::OutputLogItemsToFile(
 
     for (uint32 i = 0; i < count; i++)
     {
-        LogItem logItem = { };
-        m_logItems.PopFront(&logItem);
+        const LogItem& logItem = pLogItems[i];
 
         // The fence bundled to this submit wave should promise GpaSession ready.
         PAL_ASSERT((logItem.pGpaSession == nullptr) || logItem.pGpaSession->IsReady());
@@ -89,20 +97,23 @@ void Queue::OutputLogItemsToFile(
                 m_curLogSqttIdx = 0;
             }
 
-            // Add a "- " before command buffer calls made in a nested command buffer to differentiate them from calls
-            // made in the root command buffer.
-            const char* pNestedCmdBufPrefix = (activeCmdBufs == 2) ? "- " : "";
-
             // If we have received a command buffer call without having received a queue call for this frame,
             // we are using the dynamic start/stop of GPU profiling.  Open a new log file in this case.
             if ((m_logFile.IsOpen() == false) || (m_curLogFrame != logItem.frameId))
             {
-                OpenLogFile(logItem.frameId);
-                m_curLogFrame = logItem.frameId;
-                m_curLogCmdBufIdx = 0;
+                BeginLogFrame(logItem.frameId);
             }
 
-            OutputCmdBufCallToFile(logItem, pNestedCmdBufPrefix);
+            if (binaryLog)
+            {
+                AppendBinaryLogRow(logItem, (activeCmdBufs == 2));
+            }
+            else
+            {
+                // Add a "- " before command buffer calls made in a nested command buffer to differentiate them from
+                // calls made in the root command buffer.
+                OutputCmdBufCallToFile(logItem, (activeCmdBufs == 2) ? "- " : "");
+            }
 
             if (logItem.cmdBufCall.callId == CmdBufCallId::End)
             {
@@ -115,23 +126,70 @@ void Queue::OutputLogItemsToFile(
             // If this is the first queue call for a new frame, open a new log file.
             if ((m_logFile.IsOpen() == false) || (m_curLogFrame != logItem.frameId))
             {
-                OpenLogFile(logItem.frameId);
-                m_curLogFrame = logItem.frameId;
-                m_curLogCmdBufIdx = 0;
+                BeginLogFrame(logItem.frameId);
             }
 
-            OutputQueueCallToFile(logItem);
+            if (binaryLog)
+            {
+                AppendBinaryLogRow(logItem, false);
+            }
+            else
+            {
+                OutputQueueCallToFile(logItem);
+            }
         }
         else if (logItem.type == Frame)
         {
             m_curLogFrame = logItem.frameId;
-            OutputFrameToFile(logItem);
+
+            if (binaryLog)
+            {
+                if (m_logFile.IsOpen() == false)
+                {
+                    OpenBinaryLogFile();
+                }
+
+                AppendBinaryLogRow(logItem, false);
+            }
+            else
+            {
+                OutputFrameToFile(logItem);
+            }
         }
     }
 
+    if (binaryLog)
+    {
+        EmitBinaryLogBlock();
+    }
+
     // Flush any buffered log writes to disk.  This is helpful for examining log files while an app is running or
-    // dealing with app/driver crashes after the captured frame.
-    m_logFile.Flush();
+    // dealing with app/driver crashes after the captured frame.  The individual Put*() calls above don't check their
+    // results because the file remembers the first error, which is reported here.
+    const Result result = m_logFile.Flush();
+    PAL_ALERT_MSG(result != Result::Success, "Failed to write the GPU profiler log");
+}
+
+// =====================================================================================================================
+// Starts logging items for a new frame.  The CSV log gets a new file for every frame while the binary log records the
+// frame ID of each row and keeps a single file open.
+void Queue::BeginLogFrame(
+    uint32 frameId)
+{
+    if (m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerConfig.logFormat == GpuProfilerLogFormatBinary)
+    {
+        if (m_logFile.IsOpen() == false)
+        {
+            OpenBinaryLogFile();
+        }
+    }
+    else
+    {
+        OpenLogFile(frameId);
+    }
+
+    m_curLogFrame     = frameId;
+    m_curLogCmdBufIdx = 0;
 }
 
 // =====================================================================================================================
@@ -160,7 +218,8 @@ void Queue::OpenLogFile(
              m_engineIndex,
              m_queueId);
 
-    Result result = m_logFile.Open(&tempString[0], FileAccessWrite);
+    // The file is written by a background thread so that the log worker only pays for formatting.
+    Result result = m_logFile.Open(&tempString[0], FileAccessWrite, BufferedFile::DefaultBufferSize, true);
     PAL_ASSERT(result == Result::Success);
 
     // Write the CSV column headers to the newly opened file.
@@ -185,16 +244,17 @@ void Queue::OpenLogFile(
     {
         for (uint32 i = 0; i < numGlobalPerfCounters; i++)
         {
-            m_logFile.Printf("%s,", &pPerfCounters[i].name[0]);
+            m_logFile.PutString(&pPerfCounters[i].name[0]);
+            m_logFile.PutChar(',');
         }
     }
 
     if (m_pDevice->IsThreadTraceEnabled())
     {
-        m_logFile.Printf("ThreadTraceId,");
+        m_logFile.PutString("ThreadTraceId,");
     }
 
-    m_logFile.Printf("\n");
+    m_logFile.PutChar('\n');
 }
 
 // =====================================================================================================================
@@ -277,7 +337,7 @@ void Queue::OpenSqttFile(
 // =====================================================================================================================
 // Opens a .csv file for writing spm trace data, mainly used for ThreadTraceViewer.
 void Queue::OpenSpmFile(
-    Util::File*    pFile,
+    BufferedFile*  pFile,
     const LogItem& logItem)
 {
     const auto& settings = m_pDevice->GetPlatform()->PlatformSettings();
@@ -398,19 +458,20 @@ void Queue::OutputQueueCallToFile(
 {
     PAL_ASSERT(logItem.type == QueueCall);
 
-    m_logFile.Printf("%s,,,,,,,,,,,,,,,,", QueueCallIdStrings[static_cast<uint32>(logItem.queueCall.callId)]);
+    m_logFile.PutString(QueueCallIdStrings[static_cast<uint32>(logItem.queueCall.callId)]);
+    m_logFile.PutString(",,,,,,,,,,,,,,,,");
 
     if (m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerConfig.recordPipelineStats)
     {
-        m_logFile.Printf(",,,,,,,,,,,");
+        m_logFile.PutString(",,,,,,,,,,,");
     }
 
     for (uint32 i = 0; i < m_numReportedPerfCounters; i++)
     {
-        m_logFile.Printf(",");
+        m_logFile.PutChar(',');
     }
 
-    m_logFile.Printf("\n");
+    m_logFile.PutChar('\n');
 }
 
 //======================================================================================================================
@@ -432,10 +493,12 @@ void Queue::OutputCmdBufCallToFile(
     const auto& settings   = m_pDevice->GetPlatform()->PlatformSettings();
     const auto& cmdBufItem = logItem.cmdBufCall;
 
-    m_logFile.Printf(",%d,%s%s,",
-                     m_curLogCmdBufIdx,
-                     pNestedCmdBufPrefix,
-                     CmdBufCallIdStrings[static_cast<uint32>(cmdBufItem.callId)]);
+    m_logFile.PutChar(',');
+    m_logFile.PutUint(m_curLogCmdBufIdx);
+    m_logFile.PutChar(',');
+    m_logFile.PutString(pNestedCmdBufPrefix);
+    m_logFile.PutString(CmdBufCallIdStrings[static_cast<uint32>(cmdBufItem.callId)]);
+    m_logFile.PutChar(',');
 
     OutputTimestampsToFile(logItem);
 
@@ -443,59 +506,68 @@ void Queue::OutputCmdBufCallToFile(
     if (cmdBufItem.flags.draw || cmdBufItem.flags.dispatch
     )
     {
-        m_logFile.Printf("0x%016llx,0x%016llx",
-                         cmdBufItem.draw.apiPsoHash,
-                         cmdBufItem.draw.pipelineInfo.internalPipelineHash.stable);
+        m_logFile.PutString("0x");
+        m_logFile.PutHex(cmdBufItem.draw.apiPsoHash, 16);
+        m_logFile.PutString(",0x");
+        m_logFile.PutHex(cmdBufItem.draw.pipelineInfo.internalPipelineHash.stable, 16);
 
         if (settings.gpuProfilerConfig.useFullPipelineHash)
         {
-            m_logFile.Printf("-0x%016llx", cmdBufItem.draw.pipelineInfo.internalPipelineHash.unique);
+            m_logFile.PutString("-0x");
+            m_logFile.PutHex(cmdBufItem.draw.pipelineInfo.internalPipelineHash.unique, 16);
         }
 
         if (cmdBufItem.flags.draw)
         {
-            m_logFile.Printf(",0x%016llx%016llx,0x%016llx%016llx,0x%016llx%016llx,"
-                             "0x%016llx%016llx,0x%016llx%016llx,%u,%u,,",
-                             cmdBufItem.draw.pipelineInfo.shader[VsIdx].hash.upper,
-                             cmdBufItem.draw.pipelineInfo.shader[VsIdx].hash.lower,
-                             cmdBufItem.draw.pipelineInfo.shader[HsIdx].hash.upper,
-                             cmdBufItem.draw.pipelineInfo.shader[HsIdx].hash.lower,
-                             cmdBufItem.draw.pipelineInfo.shader[DsIdx].hash.upper,
-                             cmdBufItem.draw.pipelineInfo.shader[DsIdx].hash.lower,
-                             cmdBufItem.draw.pipelineInfo.shader[GsIdx].hash.upper,
-                             cmdBufItem.draw.pipelineInfo.shader[GsIdx].hash.lower,
-                             cmdBufItem.draw.pipelineInfo.shader[PsIdx].hash.upper,
-                             cmdBufItem.draw.pipelineInfo.shader[PsIdx].hash.lower,
-                             cmdBufItem.draw.vertexCount,
-                             cmdBufItem.draw.instanceCount);
+            constexpr uint32 GfxShaderIdx[] = { VsIdx, HsIdx, DsIdx, GsIdx, PsIdx };
+
+            for (uint32 i = 0; i < ArrayLen(GfxShaderIdx); i++)
+            {
+                const ShaderHash& hash = cmdBufItem.draw.pipelineInfo.shader[GfxShaderIdx[i]].hash;
+
+                m_logFile.PutString(",0x");
+                m_logFile.PutHex(hash.upper, 16);
+                m_logFile.PutHex(hash.lower, 16);
+            }
+
+            m_logFile.PutChar(',');
+            m_logFile.PutUint(cmdBufItem.draw.vertexCount);
+            m_logFile.PutChar(',');
+            m_logFile.PutUint(cmdBufItem.draw.instanceCount);
+            m_logFile.PutString(",,");
         }
         else if (cmdBufItem.flags.dispatch)
         {
-            m_logFile.Printf(",0x%016llx%016llx,,,,,%u,,,",
-                             cmdBufItem.draw.pipelineInfo.shader[CsIdx].hash.upper,
-                             cmdBufItem.draw.pipelineInfo.shader[CsIdx].hash.lower,
-                             cmdBufItem.dispatch.threadGroupCount);
+            m_logFile.PutString(",0x");
+            m_logFile.PutHex(cmdBufItem.draw.pipelineInfo.shader[CsIdx].hash.upper, 16);
+            m_logFile.PutHex(cmdBufItem.draw.pipelineInfo.shader[CsIdx].hash.lower, 16);
+            m_logFile.PutString(",,,,,");
+            m_logFile.PutUint(cmdBufItem.dispatch.threadGroupCount);
+            m_logFile.PutString(",,,");
         }
     }
     else if (cmdBufItem.flags.barrier)
     {
-        m_logFile.Printf(",,,,,,,,,\"%s\",",
-                         (cmdBufItem.barrier.pComment != nullptr) ? cmdBufItem.barrier.pComment : "");
+        m_logFile.PutString(",,,,,,,,,\"");
+        m_logFile.PutString((cmdBufItem.barrier.pComment != nullptr) ? cmdBufItem.barrier.pComment : "");
+        m_logFile.PutString("\",");
     }
     else if (cmdBufItem.flags.comment)
     {
-        m_logFile.Printf(",,,,,,,,,\"%s\",", cmdBufItem.comment.string);
+        m_logFile.PutString(",,,,,,,,,\"");
+        m_logFile.PutString(cmdBufItem.comment.string);
+        m_logFile.PutString("\",");
     }
     else
     {
-        m_logFile.Printf(",,,,,,,,,,");
+        m_logFile.PutString(",,,,,,,,,,");
     }
 
     OutputPipelineStatsToFile(logItem);
     OutputGlobalPerfCountersToFile(logItem);
     OutputTraceDataToFile(logItem);
 
-    m_logFile.Printf("\n");
+    m_logFile.PutChar('\n');
 }
 
 //======================================================================================================================
@@ -512,7 +584,7 @@ void Queue::OutputFrameToFile(
                  "%s/frameLog.csv",
                  m_pDevice->GetPlatform()->LogDirPath());
 
-        Result result = m_logFile.Open(&tempString[0], FileAccessWrite);
+        Result result = m_logFile.Open(&tempString[0], FileAccessWrite, BufferedFile::DefaultBufferSize, true);
         PAL_ASSERT(result == Result::Success);
 
         // Write the CSV column headers to the newly opened file.
@@ -526,103 +598,442 @@ void Queue::OutputFrameToFile(
         {
             for (uint32 i = 0; i < numGlobalPerfCounters; i++)
             {
-                m_logFile.Printf("%s,", &pPerfCounters[i].name[0]);
+                m_logFile.PutString(&pPerfCounters[i].name[0]);
+                m_logFile.PutChar(',');
             }
         }
 
         if (m_pDevice->IsThreadTraceEnabled())
         {
-            m_logFile.Printf("ThreadTraceId,");
+            m_logFile.PutString("ThreadTraceId,");
         }
 
-        m_logFile.Printf("\n");
+        m_logFile.PutChar('\n');
     }
 
-    m_logFile.Printf("%u,", logItem.frameId);
+    m_logFile.PutUint(logItem.frameId);
+    m_logFile.PutChar(',');
 
     OutputTimestampsToFile(logItem);
     OutputGlobalPerfCountersToFile(logItem);
     OutputTraceDataToFile(logItem);
 
-    m_logFile.Printf("\n");
-    m_logFile.Flush();
+    m_logFile.PutChar('\n');
+
+    const Result result = m_logFile.Flush();
+    PAL_ALERT_MSG(result != Result::Success, "Failed to write the GPU profiler log");
 }
 
 // =====================================================================================================================
-// Output the portion of a .csv with the start/end clock values and time elapsed.  Shared code by all profile
-// granularities.
-void Queue::OutputTimestampsToFile(
-    const LogItem& logItem)
+// Returns the total number of 64-bit columns in each binary log row.
+uint32 Queue::NumBinaryLog64BitColumns() const
 {
-    if (HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Timing))
+    const bool recordPipelineStats = m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerConfig.recordPipelineStats;
+
+    return NumFixed64BitColumns + (recordPipelineStats ? NumPipelineStats : 0) + m_numReportedPerfCounters;
+}
+
+// =====================================================================================================================
+// Opens the binary log file for this queue and writes its header.  Unlike the CSV log, a single binary log file holds
+// every frame; binaryLogToCsv.py splits it back up into the usual per-frame .csv files.
+void Queue::OpenBinaryLogFile()
+{
+    const auto& settings = m_pDevice->GetPlatform()->PlatformSettings();
+
+    Result result = Result::Success;
+
+    if (m_pBinaryColumns == nullptr)
     {
-        uint64 pResult[2] = {};
-        Result result     = logItem.pGpaSession->GetResults(logItem.gpaSampleIdTs,
-                                                            nullptr,
-                                                            pResult);
+        const size_t rowSize = (BinaryLogFirst64BitColumn * sizeof(uint32)) +
+                               (NumBinaryLog64BitColumns() * sizeof(uint64));
 
-        m_logFile.Printf("%llu,%llu,", pResult[0], pResult[1]);
+        m_pBinaryColumns = static_cast<uint8*>(PAL_MALLOC(BinaryLogMaxBlockRows * rowSize,
+                                                          m_pDevice->GetPlatform(),
+                                                          AllocInternal));
+        m_binaryRowCount = 0;
 
-        bool hideElapsedTime =
-            (m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerPerfCounterConfig.granularity ==
-                GpuProfilerGranularityDraw) &&
-            (logItem.type == LogItemType::CmdBufferCall) &&
-            (logItem.cmdBufCall.callId == CmdBufCallId::Begin);
+        if (m_pBinaryColumns == nullptr)
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+    }
 
-        // Print the elapsed time for this call if pre-call/post-call timestamps were inserted.
-        if (!hideElapsedTime)
+    // Build a file name for this queue's log file.  It will have the pattern gpuProfilerDevBEngCD-EE.gpbin, using the
+    // same naming scheme as the .csv files.
+    const char* pEngineName = EngineTypeStrings[static_cast<uint32>(m_engineType)];
+
+    char logFilePath[512];
+    Snprintf(&logFilePath[0],
+             sizeof(logFilePath),
+             "%s/gpuProfilerDev%uEng%s%u-%02u.gpbin",
+             m_pDevice->GetPlatform()->LogDirPath(),
+             m_pDevice->Id(),
+             pEngineName,
+             m_engineIndex,
+             m_queueId);
+
+    if (result == Result::Success)
+    {
+        result = m_logFile.Open(&logFilePath[0],
+                                FileAccessWrite | FileAccessBinary,
+                                BufferedFile::DefaultBufferSize,
+                                true);
+    }
+    PAL_ASSERT(result == Result::Success);
+
+    if (result == Result::Success)
+    {
+        const uint32       numQueueCallIds  = static_cast<uint32>(QueueCallId::Count);
+        const uint32       numCmdBufCallIds = static_cast<uint32>(CmdBufCallId::Count);
+        const PerfCounter* pPerfCounters    = m_pDevice->GlobalPerfCounters();
+
+        size_t stringTableSize = strlen(pEngineName) + 1;
+
+        for (uint32 i = 0; i < numQueueCallIds; i++)
         {
-            const double tsDiff   = static_cast<double>(pResult[1] - pResult[0]);
-            const double timeInUs = 1000000 * tsDiff / m_pDevice->TimestampFreq();
+            stringTableSize += strlen(QueueCallIdStrings[i]) + 1;
+        }
 
-            m_logFile.Printf("%.2lf,", timeInUs);
+        for (uint32 i = 0; i < numCmdBufCallIds; i++)
+        {
+            stringTableSize += strlen(CmdBufCallIdStrings[i]) + 1;
         }
-        else
+
+        for (uint32 i = 0; i < m_numReportedPerfCounters; i++)
+        {
+            stringTableSize += strlen(&pPerfCounters[i].name[0]) + 1;
+        }
+
+        BinaryLogHeader header = {};
+        header.magic            = BinaryLogMagic;
+        header.version          = BinaryLogVersion;
+        header.timestampFreq    = m_pDevice->TimestampFreq();
+        header.deviceId         = m_pDevice->Id();
+        header.engineIndex      = m_engineIndex;
+        header.queueId          = m_queueId;
+        header.numPipelineStats = settings.gpuProfilerConfig.recordPipelineStats ? NumPipelineStats : 0;
+        header.numPerfCounters  = m_numReportedPerfCounters;
+        header.numQueueCallIds  = numQueueCallIds;
+        header.numCmdBufCallIds = numCmdBufCallIds;
+        header.stringTableSize  = static_cast<uint32>(stringTableSize);
+
+        if (settings.gpuProfilerConfig.useFullPipelineHash)
+        {
+            header.flags |= BinaryLogFullPipelineHash;
+        }
+
+        if (m_pDevice->IsThreadTraceEnabled())
+        {
+            header.flags |= BinaryLogThreadTrace;
+        }
+
+        m_logFile.Write(&header, sizeof(header));
+        m_logFile.Write(pEngineName, strlen(pEngineName) + 1);
+
+        for (uint32 i = 0; i < numQueueCallIds; i++)
+        {
+            m_logFile.Write(QueueCallIdStrings[i], strlen(QueueCallIdStrings[i]) + 1);
+        }
+
+        for (uint32 i = 0; i < numCmdBufCallIds; i++)
+        {
+            m_logFile.Write(CmdBufCallIdStrings[i], strlen(CmdBufCallIdStrings[i]) + 1);
+        }
+
+        for (uint32 i = 0; i < m_numReportedPerfCounters; i++)
         {
-            m_logFile.Printf(",");
+            m_logFile.Write(&pPerfCounters[i].name[0], strlen(&pPerfCounters[i].name[0]) + 1);
         }
     }
-    else
+}
+
+// =====================================================================================================================
+// Reads back the results of a single log item and appends them as a new row of the binary log block being built.  No
+// text formatting is done here; that is left to the offline exporter.
+void Queue::AppendBinaryLogRow(
+    const LogItem& logItem,
+    bool           nested)   // True if this call was made in a nested command buffer.
+{
+    if (m_pBinaryColumns != nullptr)
     {
-        m_logFile.Printf(",,,");
+        if (m_binaryRowCount == BinaryLogMaxBlockRows)
+        {
+            EmitBinaryLogBlock();
+        }
+
+        constexpr uint32 CsIdx = static_cast<uint32>(ShaderType::Compute);
+        constexpr uint32 VsIdx = static_cast<uint32>(ShaderType::Vertex);
+        constexpr uint32 HsIdx = static_cast<uint32>(ShaderType::Hull);
+        constexpr uint32 DsIdx = static_cast<uint32>(ShaderType::Domain);
+        constexpr uint32 GsIdx = static_cast<uint32>(ShaderType::Geometry);
+        constexpr uint32 PsIdx = static_cast<uint32>(ShaderType::Pixel);
+
+        constexpr uint32 GfxShaderIdx[] = { VsIdx, HsIdx, DsIdx, GsIdx, PsIdx };
+
+        const uint32 numPipelineStats =
+            m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerConfig.recordPipelineStats ? NumPipelineStats : 0;
+
+        uint32 values32[BinaryLogFirst64BitColumn] = {};
+        uint64 values64[NumFixed64BitColumns]      = {};
+        uint64 pipelineStats[NumPipelineStats]     = {};
+        uint32 rowFlags                            = static_cast<uint32>(logItem.type);
+        uint32 traceStatus                         = BinaryLogTraceOmitted;
+
+        AutoBuffer<uint64, 128, PlatformDecorator> perfCounters(m_numReportedPerfCounters, m_pDevice->GetPlatform());
+        PAL_ASSERT(perfCounters.Capacity() >= m_numReportedPerfCounters);
+
+        values32[Column32(BinaryLogColumn::FrameId)]     = logItem.frameId;
+        values32[Column32(BinaryLogColumn::CmdBufIndex)] = m_curLogCmdBufIdx;
+        values32[Column32(BinaryLogColumn::Comment)]     = BinaryLogNoString;
+
+        if (logItem.type == QueueCall)
+        {
+            values32[Column32(BinaryLogColumn::CallId)] = static_cast<uint32>(logItem.queueCall.callId);
+        }
+        else
+        {
+            if (logItem.type == CmdBufferCall)
+            {
+                const auto& cmdBufItem = logItem.cmdBufCall;
+
+                values32[Column32(BinaryLogColumn::CallId)] = static_cast<uint32>(cmdBufItem.callId);
+                rowFlags |= nested ? BinaryLogRowNested : 0;
+
+                if (cmdBufItem.flags.draw || cmdBufItem.flags.dispatch)
+                {
+                    const PipelineInfo& pipelineInfo = cmdBufItem.draw.pipelineInfo;
+
+                    values64[Column64(BinaryLogColumn::ApiPsoHash)]     = cmdBufItem.draw.apiPsoHash;
+                    values64[Column64(BinaryLogColumn::PipelineStable)] = pipelineInfo.internalPipelineHash.stable;
+                    values64[Column64(BinaryLogColumn::PipelineUnique)] = pipelineInfo.internalPipelineHash.unique;
+
+                    if (cmdBufItem.flags.draw)
+                    {
+                        rowFlags |= BinaryLogRowDraw;
+
+                        for (uint32 i = 0; i < ArrayLen(GfxShaderIdx); i++)
+                        {
+                            const ShaderHash& hash = pipelineInfo.shader[GfxShaderIdx[i]].hash;
+                            const uint32      col  = Column64(BinaryLogColumn::ShaderHash0Hi) + (i * 2);
+
+                            values64[col]     = hash.upper;
+                            values64[col + 1] = hash.lower;
+                        }
+
+                        values32[Column32(BinaryLogColumn::Count0)] = cmdBufItem.draw.vertexCount;
+                        values32[Column32(BinaryLogColumn::Count1)] = cmdBufItem.draw.instanceCount;
+                    }
+                    else
+                    {
+                        rowFlags |= BinaryLogRowDispatch;
+
+                        values64[Column64(BinaryLogColumn::ShaderHash0Hi)] = pipelineInfo.shader[CsIdx].hash.upper;
+                        values64[Column64(BinaryLogColumn::ShaderHash0Lo)] = pipelineInfo.shader[CsIdx].hash.lower;
+                        values32[Column32(BinaryLogColumn::Count0)]        = cmdBufItem.dispatch.threadGroupCount;
+                    }
+                }
+                else if (cmdBufItem.flags.barrier)
+                {
+                    rowFlags |= BinaryLogRowBarrier;
+                    values32[Column32(BinaryLogColumn::Comment)] =
+                        AppendBinaryLogString((cmdBufItem.barrier.pComment != nullptr) ? cmdBufItem.barrier.pComment
+                                                                                        : "");
+                }
+                else if (cmdBufItem.flags.comment)
+                {
+                    rowFlags |= BinaryLogRowComment;
+                    values32[Column32(BinaryLogColumn::Comment)] = AppendBinaryLogString(cmdBufItem.comment.string);
+                }
+
+                if ((numPipelineStats > 0) && ReadPipelineStats(logItem, &pipelineStats[0]))
+                {
+                    rowFlags |= BinaryLogRowPipelineStats;
+                }
+            }
+
+            uint64 timestamps[2] = {};
+            if (ReadTimestamps(logItem, &timestamps[0]))
+            {
+                rowFlags |= BinaryLogRowTimestamps;
+                rowFlags |= HideElapsedTime(logItem) ? BinaryLogRowHideElapsed : 0;
+
+                values64[Column64(BinaryLogColumn::StartClock)] = timestamps[0];
+                values64[Column64(BinaryLogColumn::EndClock)]   = timestamps[1];
+            }
+
+            if (ReadGlobalPerfCounters(logItem, &perfCounters[0]))
+            {
+                rowFlags |= BinaryLogRowPerfCounters;
+            }
+            else
+            {
+                memset(&perfCounters[0], 0, sizeof(uint64) * m_numReportedPerfCounters);
+            }
+
+            traceStatus = OutputTraceData(logItem, &values32[Column32(BinaryLogColumn::TraceValue)]);
+        }
+
+        values32[Column32(BinaryLogColumn::RowFlags)] = rowFlags | (traceStatus << BinaryLogRowTraceShift);
+
+        // Scatter the row into the column arrays.
+        const uint32 row = m_binaryRowCount++;
+
+        uint32* pColumn32 = reinterpret_cast<uint32*>(m_pBinaryColumns);
+        for (uint32 i = 0; i < BinaryLogFirst64BitColumn; i++)
+        {
+            pColumn32[(i * BinaryLogMaxBlockRows) + row] = values32[i];
+        }
+
+        uint64* pColumn64 = reinterpret_cast<uint64*>(pColumn32 + (BinaryLogFirst64BitColumn * BinaryLogMaxBlockRows));
+        for (uint32 i = 0; i < NumFixed64BitColumns; i++)
+        {
+            pColumn64[(i * BinaryLogMaxBlockRows) + row] = values64[i];
+        }
+
+        pColumn64 += NumFixed64BitColumns * BinaryLogMaxBlockRows;
+        for (uint32 i = 0; i < numPipelineStats; i++)
+        {
+            pColumn64[(i * BinaryLogMaxBlockRows) + row] = pipelineStats[i];
+        }
+
+        pColumn64 += numPipelineStats * BinaryLogMaxBlockRows;
+        for (uint32 i = 0; i < m_numReportedPerfCounters; i++)
+        {
+            pColumn64[(i * BinaryLogMaxBlockRows) + row] = perfCounters[i];
+        }
     }
 }
 
 // =====================================================================================================================
-// Output pipeline stats to file.  Only supported by draw/cmdbuf granularities.
-void Queue::OutputPipelineStatsToFile(
-    const LogItem& logItem)
+// Copies a string into the string heap of the binary log block being built and returns its offset in the heap.
+uint32 Queue::AppendBinaryLogString(
+    const char* pString)
 {
-    if (HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Query))
+    const uint32 offset = m_binaryStrings.NumElements();
+
+    // Copy the null terminator too.
+    do
     {
-        uint64 pipelineStats[11] = {};
-        size_t pipelineStatsSize = sizeof(pipelineStats);
-        const Result result = logItem.pGpaSession->GetResults(logItem.gpaSampleIdQuery,
-                                                              &pipelineStatsSize,
-                                                              pipelineStats);
+        m_binaryStrings.PushBack(*pString);
+    } while (*(pString++) != '\0');
 
-        PAL_ASSERT(result == Result::Success);
-        PAL_ASSERT(pipelineStatsSize == sizeof(pipelineStats));
+    return offset;
+}
 
-        // PAL hardcodes the layout of the return pipeline stats values based on the client, leading to different
-        // versions of this code to a uniform log layout.
-        m_logFile.Printf("%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,", pipelineStats[0],
-                         pipelineStats[1], pipelineStats[2], pipelineStats[3], pipelineStats[4], pipelineStats[5],
-                         pipelineStats[6], pipelineStats[7], pipelineStats[8], pipelineStats[9], pipelineStats[10]);
+// =====================================================================================================================
+// Writes the binary log block being built to the log file with a single vectored write and starts a new block.
+void Queue::EmitBinaryLogBlock()
+{
+    if ((m_binaryRowCount > 0) && m_logFile.IsOpen())
+    {
+        const uint32 num64BitColumns = NumBinaryLog64BitColumns();
+        const uint32 maxSpans        = 2 + BinaryLogFirst64BitColumn + num64BitColumns;
+
+        AutoBuffer<FileSpan, 64, PlatformDecorator> spans(maxSpans, m_pDevice->GetPlatform());
+
+        if (spans.Capacity() >= maxSpans)
+        {
+            BinaryLogBlockHeader header = {};
+            header.magic          = BinaryLogBlockMagic;
+            header.rowCount       = m_binaryRowCount;
+            header.stringHeapSize = m_binaryStrings.NumElements();
+
+            uint32 spanCount = 0;
+            spans[spanCount].pData  = &header;
+            spans[spanCount++].size = sizeof(header);
+
+            // Only the first rowCount entries of each column array are valid.
+            const uint8* pColumn = m_pBinaryColumns;
+            for (uint32 i = 0; i < BinaryLogFirst64BitColumn; i++)
+            {
+                spans[spanCount].pData  = pColumn;
+                spans[spanCount++].size = m_binaryRowCount * sizeof(uint32);
+                pColumn += BinaryLogMaxBlockRows * sizeof(uint32);
+            }
+
+            for (uint32 i = 0; i < num64BitColumns; i++)
+            {
+                spans[spanCount].pData  = pColumn;
+                spans[spanCount++].size = m_binaryRowCount * sizeof(uint64);
+                pColumn += BinaryLogMaxBlockRows * sizeof(uint64);
+            }
+
+            if (header.stringHeapSize > 0)
+            {
+                spans[spanCount].pData  = m_binaryStrings.Data();
+                spans[spanCount++].size = header.stringHeapSize;
+            }
+
+            m_logFile.WriteVectored(&spans[0], spanCount);
+        }
     }
-    else if (m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerConfig.recordPipelineStats)
+
+    m_binaryRowCount = 0;
+    m_binaryStrings.Clear();
+}
+
+// =====================================================================================================================
+// Reads back the begin/end timestamps of a log item.  Returns false if the log item has no timestamps.
+bool Queue::ReadTimestamps(
+    const LogItem& logItem,
+    uint64*        pTimestamps // [out] Array of two timestamps.
+    ) const
+{
+    const bool valid = HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Timing);
+
+    if (valid)
+    {
+        logItem.pGpaSession->GetResults(logItem.gpaSampleIdTs, nullptr, pTimestamps);
+    }
+
+    return valid;
+}
+
+// =====================================================================================================================
+// Returns true if the elapsed time between a log item's timestamps is meaningless and shouldn't be reported.
+bool Queue::HideElapsedTime(
+    const LogItem& logItem
+    ) const
+{
+    return (m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerPerfCounterConfig.granularity ==
+                GpuProfilerGranularityDraw) &&
+           (logItem.type == LogItemType::CmdBufferCall) &&
+           (logItem.cmdBufCall.callId == CmdBufCallId::Begin);
+}
+
+// =====================================================================================================================
+// Reads back the pipeline stats of a log item.  Returns false if the log item has no pipeline stats.
+bool Queue::ReadPipelineStats(
+    const LogItem& logItem,
+    uint64*        pPipelineStats // [out] Array of NumPipelineStats values.
+    ) const
+{
+    const bool valid = HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Query);
+
+    if (valid)
     {
-        m_logFile.Printf(",,,,,,,,,,,");
+        size_t       pipelineStatsSize = NumPipelineStats * sizeof(uint64);
+        const Result result            = logItem.pGpaSession->GetResults(logItem.gpaSampleIdQuery,
+                                                                         &pipelineStatsSize,
+                                                                         pPipelineStats);
+
+        PAL_ASSERT(result == Result::Success);
+        PAL_ASSERT(pipelineStatsSize == (NumPipelineStats * sizeof(uint64)));
     }
+
+    return valid;
 }
 
 // =====================================================================================================================
-// Dump the enabled global perf counters to file.  Shared code between draw/cmdbuf and per-frame profile granularities.
-void Queue::OutputGlobalPerfCountersToFile(
-    const LogItem& logItem)
+// Reads back the global perf counters of a log item, summing the results of all instances of each counter.  Returns
+// false if the log item has no perf counter results.
+bool Queue::ReadGlobalPerfCounters(
+    const LogItem& logItem,
+    uint64*        pCounters // [out] Array of m_numReportedPerfCounters values.
+    ) const
 {
-    const PerfCounter* pGlobalPerfCounters   = m_pDevice->GlobalPerfCounters();
-    const uint32       numGlobalPerfCounters = m_pDevice->NumGlobalPerfCounters();
+    const uint32 numGlobalPerfCounters = m_pDevice->NumGlobalPerfCounters();
+    bool         valid                 = false;
 
     if ((numGlobalPerfCounters > 0) && HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Cumulative))
     {
@@ -646,57 +1057,165 @@ void Queue::OutputGlobalPerfCountersToFile(
         if (result == Result::Success)
         {
             result = logItem.pGpaSession->GetResults(logItem.gpaSampleId,
-                                                             &dataSize,
-                                                             pResult);
+                                                     &dataSize,
+                                                     pResult);
         }
 
         if (result == Result::Success)
         {
-            AutoBuffer<uint64, 128, PlatformDecorator> data(m_numReportedPerfCounters, m_pDevice->GetPlatform());
-            PAL_ASSERT(data.Capacity() >= m_numReportedPerfCounters);
-
             // Zero out the reported value for each counter.  The results from each instance of that counter will be
             // accumulated into this array.
-
             const PerfCounter* pPerfCounters = m_pDevice->GlobalPerfCounters();
             uint32 pidIndex = 0;
 
             for (uint32 i = 0; i < numGlobalPerfCounters; i++)
             {
-                data[i] = 0;
+                pCounters[i] = 0;
                 for (uint32 j = 0; j < pPerfCounters[i].instanceCount; j++)
                 {
-                    data[i] += static_cast<uint64*>(pResult)[pidIndex++];
+                    pCounters[i] += static_cast<uint64*>(pResult)[pidIndex++];
                 }
             }
 
             PAL_ASSERT(pidIndex == m_gpaSessionSampleConfig.perfCounters.numCounters);
 
-            PAL_SAFE_FREE(pResult, m_pDevice->GetPlatform());
+            valid = true;
+        }
 
-            // Output into .csv file.
-            for (uint32 i = 0; i < m_numReportedPerfCounters; i++)
-            {
-                m_logFile.Printf("%llu,", data[i]);
-            }
+        PAL_SAFE_FREE(pResult, m_pDevice->GetPlatform());
+    }
+
+    return valid;
+}
+
+// =====================================================================================================================
+// Output the portion of a .csv with the start/end clock values and time elapsed.  Shared code by all profile
+// granularities.
+void Queue::OutputTimestampsToFile(
+    const LogItem& logItem)
+{
+    uint64 timestamps[2] = {};
+
+    if (ReadTimestamps(logItem, &timestamps[0]))
+    {
+        m_logFile.PutUint(timestamps[0]);
+        m_logFile.PutChar(',');
+        m_logFile.PutUint(timestamps[1]);
+        m_logFile.PutChar(',');
+
+        // Print the elapsed time for this call if pre-call/post-call timestamps were inserted.
+        if (HideElapsedTime(logItem) == false)
+        {
+            const double tsDiff   = static_cast<double>(timestamps[1] - timestamps[0]);
+            const double timeInUs = 1000000 * tsDiff / m_pDevice->TimestampFreq();
+
+            m_logFile.PutFloat(timeInUs, 2);
+            m_logFile.PutChar(',');
+        }
+        else
+        {
+            m_logFile.PutChar(',');
+        }
+    }
+    else
+    {
+        m_logFile.PutString(",,,");
+    }
+}
+
+// =====================================================================================================================
+// Output pipeline stats to file.  Only supported by draw/cmdbuf granularities.
+void Queue::OutputPipelineStatsToFile(
+    const LogItem& logItem)
+{
+    uint64 pipelineStats[NumPipelineStats] = {};
+
+    if (ReadPipelineStats(logItem, &pipelineStats[0]))
+    {
+        // PAL hardcodes the layout of the return pipeline stats values based on the client, leading to different
+        // versions of this code to a uniform log layout.
+        for (uint32 i = 0; i < NumPipelineStats; i++)
+        {
+            m_logFile.PutUint(pipelineStats[i]);
+            m_logFile.PutChar(',');
+        }
+    }
+    else if (m_pDevice->GetPlatform()->PlatformSettings().gpuProfilerConfig.recordPipelineStats)
+    {
+        m_logFile.PutString(",,,,,,,,,,,");
+    }
+}
+
+// =====================================================================================================================
+// Dump the enabled global perf counters to file.  Shared code between draw/cmdbuf and per-frame profile granularities.
+void Queue::OutputGlobalPerfCountersToFile(
+    const LogItem& logItem)
+{
+    AutoBuffer<uint64, 128, PlatformDecorator> data(m_numReportedPerfCounters, m_pDevice->GetPlatform());
+    PAL_ASSERT(data.Capacity() >= m_numReportedPerfCounters);
+
+    if (ReadGlobalPerfCounters(logItem, &data[0]))
+    {
+        for (uint32 i = 0; i < m_numReportedPerfCounters; i++)
+        {
+            m_logFile.PutUint(data[i]);
+            m_logFile.PutChar(',');
         }
     }
     else
     {
         for (uint32 i = 0; i < m_numReportedPerfCounters; i++)
         {
-            m_logFile.Printf(",");
+            m_logFile.PutChar(',');
         }
     }
 }
 
 // =====================================================================================================================
-// Dumps the SQ thread trace data and/or spm trace data from this experiment out to file.
+// Outputs the trace column of a log item to the .csv file, dumping its trace data to separate files along the way.
 void Queue::OutputTraceDataToFile(
     const LogItem& logItem)
+{
+    uint32 traceValue = 0;
+
+    switch (OutputTraceData(logItem, &traceValue))
+    {
+    case BinaryLogTraceValue:
+        m_logFile.PutUint(traceValue);
+        m_logFile.PutChar(',');
+        break;
+    case BinaryLogTraceRgpNeedsFrame:
+        m_logFile.PutString("USE FRAME-GRANULARITY FOR RGP,");
+        break;
+    case BinaryLogTraceOutOfMemory:
+        // TODO: this error is set under none case yet.
+        // GpaSession::BeginSample hits an ASSERT if this error happens.
+        m_logFile.PutString("ERROR: OUT OF MEMORY,");
+        break;
+    case BinaryLogTraceUnsupported:
+        m_logFile.PutString("ERROR: THREAD TRACE UNSUPPORTED,");
+        break;
+    case BinaryLogTraceOmitted:
+        break;
+    case BinaryLogTraceNone:
+    default:
+        m_logFile.PutChar(',');
+        break;
+    }
+}
+
+// =====================================================================================================================
+// Dumps the SQ thread trace data and/or spm trace data from this experiment out to file.  Returns the
+// BinaryLogTraceStatus describing what should be reported in the log's trace column.
+uint32 Queue::OutputTraceData(
+    const LogItem& logItem,
+    uint32*        pTraceValue) // [out] Thread trace ID or frame number, if BinaryLogTraceValue is returned.
 {
     const auto& settings = m_pDevice->GetPlatform()->PlatformSettings();
 
+    // Some trace modes don't report anything in the trace column.
+    uint32 status = BinaryLogTraceOmitted;
+
     if ((m_pDevice->NumGlobalPerfCounters() == 0) &&
         (m_pDevice->IsSpmTraceEnabled() || m_pDevice->IsThreadTraceEnabled()) &&
         (HasValidGpaSample(&logItem, GpuUtil::GpaSampleType::Trace)))
@@ -708,11 +1227,12 @@ void Queue::OutputTraceDataToFile(
                 GpuProfilerGranularity::GpuProfilerGranularityFrame)
             {
                 OutputRgpFile(*logItem.pGpaSession, logItem.gpaSampleId);
-                m_logFile.Printf("%u,", m_curLogFrame);
+                *pTraceValue = m_curLogFrame;
+                status       = BinaryLogTraceValue;
             }
             else
             {
-                m_logFile.Printf("USE FRAME-GRANULARITY FOR RGP,");
+                status = BinaryLogTraceRgpNeedsFrame;
             }
         }
         else if (m_pDevice->GetProfilerMode() == GpuProfilerTraceEnabledTtv)
@@ -778,7 +1298,8 @@ void Queue::OutputTraceDataToFile(
                         pDesc = static_cast<const SqttFileChunkSqttDesc*>(VoidPtrInc(pResult, offset));
                     }
 
-                    m_logFile.Printf("%u,", m_curLogSqttIdx++);
+                    *pTraceValue = m_curLogSqttIdx++;
+                    status       = BinaryLogTraceValue;
                 }
 
                 // Spm trace chunk: Begin output of Spm trace data as a separate .csv file
@@ -810,7 +1331,7 @@ void Queue::OutputTraceDataToFile(
                         const auto* pCounterInfo = static_cast<const SpmCounterInfo*>(VoidPtrInc(pResult, offset));
                         offset += pSpmDbChunk->numSpmCounterInfo * sizeof(*pCounterInfo);
 
-                        File spmFile;
+                        BufferedFile spmFile;
                         OpenSpmFile(&spmFile, logItem);
 
                         if (pSpmDbChunk->numTimestamps > 0)
@@ -839,7 +1360,8 @@ void Queue::OutputTraceDataToFile(
                         {
                             // Write the raw sample timestamps so that the ThreadTraceViewer can correlate the SPM
                             // timeline to the SQTT timeline.
-                            spmFile.Printf("%llu,", pTimestamp[sample]);
+                            spmFile.PutUint(pTimestamp[sample]);
+                            spmFile.PutChar(',');
 
                             uint32 counterIdx = 0;
                             for (uint32 i = 0; i < m_pDevice->NumStreamingPerfCounters(); i++)
@@ -851,12 +1373,16 @@ void Queue::OutputTraceDataToFile(
                                     const auto*  pData = static_cast<const uint16*>(VoidPtrInc(pResult, offsetToCntr));
                                     sumAll += pData[sample];
                                 }
-                                spmFile.Printf("%u,", sumAll);
+                                spmFile.PutUint(sumAll);
+                                spmFile.PutChar(',');
                             }
 
                             PAL_ASSERT(counterIdx == m_gpaSessionSampleConfig.perfCounters.numCounters);
-                            spmFile.Printf("\n");
+                            spmFile.PutChar('\n');
                         }
+
+                        const Result flushResult = spmFile.Flush();
+                        PAL_ALERT_MSG(flushResult != Result::Success, "Failed to write the SPM trace file");
                     }
                 }
             }
@@ -866,18 +1392,18 @@ void Queue::OutputTraceDataToFile(
     }
     else if (logItem.errors.perfExpOutOfMemory != 0)
     {
-        // TODO: this error is set under none case yet.
-        // GpaSession::BeginSample hits an ASSERT if this error happens.
-        m_logFile.Printf("ERROR: OUT OF MEMORY,");
+        status = BinaryLogTraceOutOfMemory;
     }
     else if (logItem.errors.perfExpUnsupported != 0)
     {
-        m_logFile.Printf("ERROR: THREAD TRACE UNSUPPORTED,");
+        status = BinaryLogTraceUnsupported;
     }
     else
     {
-        m_logFile.Printf(",");
+        status = BinaryLogTraceNone;
     }
+
+    return status;
 }
 
 } // GpuProfiler
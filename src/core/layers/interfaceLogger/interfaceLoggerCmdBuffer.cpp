@@ -47,25 +47,81 @@ CmdBuffer::CmdBuffer(
     :
     CmdBufferDecorator(pNextCmdBuffer, pDevice),
     m_pPlatform(static_cast<Platform*>(pDevice->GetPlatform())),
-    m_objectId(objectId)
+    m_objectId(objectId),
+    m_funcTablePreset(0)
 {
-    m_funcTable.pfnCmdSetUserData[static_cast<uint32>(PipelineBindPoint::Compute)]  = CmdSetUserDataCs;
-    m_funcTable.pfnCmdSetUserData[static_cast<uint32>(PipelineBindPoint::Graphics)] = CmdSetUserDataGfx;
+    UpdateFuncTable();
+}
+
+// =====================================================================================================================
+// Only intercepts the function table calls which the active logging preset will actually log; the others are sent
+// straight to the next layer so that they don't pay for timestamps and a LogBeginFunc call which would log nothing.
+// The table is only rebuilt at Begin() so any calls recorded after a preset change but before the next Begin() are
+// logged according to the old preset.
+void CmdBuffer::UpdateFuncTable()
+{
+    const uint32 preset = m_pPlatform->ActivePreset();
+
+    SetForwardingFuncTable();
+
+    if (m_pPlatform->IsFuncLogged(preset, InterfaceFunc::CmdBufferCmdSetUserData))
+    {
+        m_funcTable.pfnCmdSetUserData[static_cast<uint32>(PipelineBindPoint::Compute)]  = CmdSetUserDataCs;
+        m_funcTable.pfnCmdSetUserData[static_cast<uint32>(PipelineBindPoint::Graphics)] = CmdSetUserDataGfx;
+    }
+
+    if (m_pPlatform->IsFuncLogged(preset, InterfaceFunc::CmdBufferCmdDraw))
+    {
+        m_funcTable.pfnCmdDraw = CmdDraw;
+    }
+
+    if (m_pPlatform->IsFuncLogged(preset, InterfaceFunc::CmdBufferCmdDrawOpaque))
+    {
+        m_funcTable.pfnCmdDrawOpaque = CmdDrawOpaque;
+    }
+
+    if (m_pPlatform->IsFuncLogged(preset, InterfaceFunc::CmdBufferCmdDrawIndexed))
+    {
+        m_funcTable.pfnCmdDrawIndexed = CmdDrawIndexed;
+    }
 
-    m_funcTable.pfnCmdDraw                      = CmdDraw;
-    m_funcTable.pfnCmdDrawOpaque                = CmdDrawOpaque;
-    m_funcTable.pfnCmdDrawIndexed               = CmdDrawIndexed;
-    m_funcTable.pfnCmdDrawIndirectMulti         = CmdDrawIndirectMulti;
-    m_funcTable.pfnCmdDrawIndexedIndirectMulti  = CmdDrawIndexedIndirectMulti;
-    m_funcTable.pfnCmdDispatch                  = CmdDispatch;
-    m_funcTable.pfnCmdDispatchIndirect          = CmdDispatchIndirect;
-    m_funcTable.pfnCmdDispatchOffset            = CmdDispatchOffset;
+    if (m_pPlatform->IsFuncLogged(preset, InterfaceFunc::CmdBufferCmdDrawIndirectMulti))
+    {
+        m_funcTable.pfnCmdDrawIndirectMulti = CmdDrawIndirectMulti;
+    }
+
+    if (m_pPlatform->IsFuncLogged(preset, InterfaceFunc::CmdBufferCmdDrawIndexedIndirectMulti))
+    {
+        m_funcTable.pfnCmdDrawIndexedIndirectMulti = CmdDrawIndexedIndirectMulti;
+    }
+
+    if (m_pPlatform->IsFuncLogged(preset, InterfaceFunc::CmdBufferCmdDispatch))
+    {
+        m_funcTable.pfnCmdDispatch = CmdDispatch;
+    }
+
+    if (m_pPlatform->IsFuncLogged(preset, InterfaceFunc::CmdBufferCmdDispatchIndirect))
+    {
+        m_funcTable.pfnCmdDispatchIndirect = CmdDispatchIndirect;
+    }
+
+    if (m_pPlatform->IsFuncLogged(preset, InterfaceFunc::CmdBufferCmdDispatchOffset))
+    {
+        m_funcTable.pfnCmdDispatchOffset = CmdDispatchOffset;
+    }
+
+    m_funcTablePreset = preset;
 }
 
 // =====================================================================================================================
 Result CmdBuffer::Begin(
     const CmdBufferBuildInfo& info)
 {
+    if (m_pPlatform->ActivePreset() != m_funcTablePreset)
+    {
+        UpdateFuncTable();
+    }
+
     BeginFuncInfo funcInfo;
     funcInfo.funcId       = InterfaceFunc::CmdBufferBegin;
     funcInfo.objectId     = m_objectId;
@@ -150,6 +206,48 @@ uint32 CmdBuffer::GetEmbeddedDataLimit() const
     return m_pNextLayer->GetEmbeddedDataLimit();
 }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+// =====================================================================================================================
+Result CmdBuffer::PatchUserData(
+    PipelineBindPoint bindPoint,
+    uint32            firstEntry,
+    uint32            entryCount,
+    const uint32*     pEntryValues)
+{
+    BeginFuncInfo funcInfo;
+    funcInfo.funcId       = InterfaceFunc::CmdBufferPatchUserData;
+    funcInfo.objectId     = m_objectId;
+    funcInfo.preCallTime  = m_pPlatform->GetTime();
+    const Result result   = m_pNextLayer->PatchUserData(bindPoint, firstEntry, entryCount, pEntryValues);
+    funcInfo.postCallTime = m_pPlatform->GetTime();
+
+    LogContext* pLogContext = nullptr;
+    if (m_pPlatform->LogBeginFunc(funcInfo, &pLogContext))
+    {
+        pLogContext->BeginInput();
+        pLogContext->KeyAndEnum("bindPoint", bindPoint);
+        pLogContext->KeyAndValue("firstEntry", firstEntry);
+        pLogContext->KeyAndBeginList("values", false);
+
+        for (uint32 idx = 0; (pEntryValues != nullptr) && (idx < entryCount); ++idx)
+        {
+            pLogContext->Value(pEntryValues[idx]);
+        }
+
+        pLogContext->EndList();
+        pLogContext->EndInput();
+
+        pLogContext->BeginOutput();
+        pLogContext->KeyAndEnum("result", result);
+        pLogContext->EndOutput();
+
+        m_pPlatform->LogEndFunc(pLogContext);
+    }
+
+    return result;
+}
+#endif
+
 // =====================================================================================================================
 void CmdBuffer::CmdBindPipeline(
     const PipelineBindParams& params)
@@ -52,6 +52,13 @@ public:
         ICmdAllocator* pCmdAllocator,
         bool           returnGpuMemory) override;
     virtual uint32 GetEmbeddedDataLimit() const override;
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    virtual Result PatchUserData(
+        PipelineBindPoint bindPoint,
+        uint32            firstEntry,
+        uint32            entryCount,
+        const uint32*     pEntryValues) override;
+#endif
     virtual void CmdBindPipeline(
         const PipelineBindParams& params) override;
     virtual void CmdBindMsaaState(
@@ -489,6 +496,8 @@ public:
 private:
     virtual ~CmdBuffer() { }
 
+    void UpdateFuncTable();
+
     static void PAL_STDCALL CmdSetUserDataCs(
         ICmdBuffer*   pCmdBuffer,
         uint32        firstEntry,
@@ -553,6 +562,7 @@ private:
 
     Platform*const m_pPlatform;
     const uint32   m_objectId;
+    uint32         m_funcTablePreset; // The logging preset m_funcTable was last built for.
 
     PAL_DISALLOW_DEFAULT_CTOR(CmdBuffer);
     PAL_DISALLOW_COPY_AND_ASSIGN(CmdBuffer);
@@ -77,6 +77,9 @@ enum class InterfaceFunc : uint32
     CmdBufferBegin,
     CmdBufferEnd,
     CmdBufferReset,
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    CmdBufferPatchUserData,
+#endif
     CmdBufferCmdBindPipeline,
     CmdBufferCmdBindMsaaState,
     CmdBufferCmdBindColorBlendState,
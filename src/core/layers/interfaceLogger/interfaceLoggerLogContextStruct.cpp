@@ -640,6 +640,13 @@ void LogContext::Struct(
         Value("disallowNestedLaunchViaIb2");
     }
 
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    if (value.flags.enableUserDataPatching)
+    {
+        Value("enableUserDataPatching");
+    }
+#endif
+
 #if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 533
     if (value.flags.enableExecutionMarkerSupport)
     {
@@ -670,6 +677,10 @@ void LogContext::Struct(
 #if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 533
     KeyAndValue("execMarkerClientHandle", value.execMarkerClientHandle);
 #endif
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    KeyAndValue("patchableUserDataFirstEntry", value.patchableUserDataFirstEntry);
+    KeyAndValue("patchableUserDataEntryCount", value.patchableUserDataEntryCount);
+#endif
 
     EndMap();
 }
@@ -2031,12 +2042,24 @@ void LogContext::Struct(
         Value("enableSvmMode");
     }
 
+    if (value.flags.enableAllocProfiler)
+    {
+        Value("enableAllocProfiler");
+    }
+
+    if (value.flags.enableSlabAllocator)
+    {
+        Value("enableSlabAllocator");
+    }
+
     EndList();
     KeyAndValue("settingsPath", value.pSettingsPath);
     KeyAndEnum("nullGpuId", value.nullGpuId);
     KeyAndValue("apiMajorVer", value.apiMajorVer);
     KeyAndValue("apiMinorVer", value.apiMinorVer);
     KeyAndValue("maxSvmSize", value.maxSvmSize);
+    KeyAndValue("allocProfilerSampleInterval", static_cast<uint64>(value.allocProfilerSampleInterval));
+    KeyAndValue("slabAllocatorMemoryCeiling", static_cast<uint64>(value.slabAllocatorMemoryCeiling));
     EndMap();
 }
 
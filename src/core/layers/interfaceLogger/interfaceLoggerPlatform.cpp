@@ -61,6 +61,9 @@ static constexpr FuncLoggingTableEntry FuncLoggingTable[] =
     { InterfaceFunc::CmdBufferBegin,                                (CmdBuild)            },
     { InterfaceFunc::CmdBufferEnd,                                  (CmdBuild)            },
     { InterfaceFunc::CmdBufferReset,                                (CmdBuild)            },
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 549
+    { InterfaceFunc::CmdBufferPatchUserData,                        (CmdBuild)            },
+#endif
     { InterfaceFunc::CmdBufferCmdBindPipeline,                      (CmdBuild)            },
     { InterfaceFunc::CmdBufferCmdBindMsaaState,                     (CmdBuild)            },
     { InterfaceFunc::CmdBufferCmdBindColorBlendState,               (CmdBuild)            },
@@ -640,6 +643,15 @@ bool Platform::LogBeginFunc(
     return canLog;
 }
 
+// =====================================================================================================================
+bool Platform::IsFuncLogged(
+    uint32        preset,
+    InterfaceFunc funcId
+    ) const
+{
+    return (m_loggingPresets[preset] & FuncLoggingTable[static_cast<uint32>(funcId)].logFlagMask) != 0;
+}
+
 // =====================================================================================================================
 void Platform::LogEndFunc(
     LogContext* pContext)
@@ -104,6 +104,10 @@ public:
     bool LogBeginFunc(const BeginFuncInfo& info, LogContext** ppContext);
     void LogEndFunc(LogContext* pContext);
 
+    // Returns the index of the active logging preset and whether the given preset logs calls to the given function.
+    uint32 ActivePreset() const { return m_activePreset; }
+    bool IsFuncLogged(uint32 preset, InterfaceFunc funcId) const;
+
     // Returns a new object ID for an object of the given type. Note that AtomicIncrement returns the result of the
     // increment so we must subtract one to get the ID for the current object.
     uint32 NewObjectId(InterfaceObject objectType)
@@ -27,6 +27,7 @@
 #include "core/layers/pm4Instrumentor/pm4InstrumentorDevice.h"
 #include "core/layers/pm4Instrumentor/pm4InstrumentorPlatform.h"
 #include "core/layers/pm4Instrumentor/pm4InstrumentorQueue.h"
+#include "palSysUtil.h"
 #include "palVectorImpl.h"
 
 using namespace Util;
@@ -43,6 +44,9 @@ CmdBuffer::CmdBuffer(
     const CmdBufferCreateInfo& createInfo)
     :
     CmdBufferFwdDecorator(pNextCmdBuffer, pDevice),
+    m_pPlatform(static_cast<Platform*>(pDevice->GetPlatform())),
+    m_callStartTime(0),
+    m_callAllocCount(0),
     m_shRegs(static_cast<Platform*>(pDevice->GetPlatform())),
     m_ctxRegs(static_cast<Platform*>(pDevice->GetPlatform()))
 {
@@ -73,10 +77,39 @@ void CmdBuffer::ResetStatistics()
     m_ctxRegBase = 0;
 }
 
+// =====================================================================================================================
+// Returns the CPU time histogram bucket for a call which took the given number of ticks.
+static uint32 CpuTimeBucket(
+    uint64 ticks)
+{
+    uint32 bucket = 0;
+
+    if (ticks < CpuTimeSubBuckets)
+    {
+        bucket = static_cast<uint32>(ticks);
+    }
+    else
+    {
+        // Split the range between this power of two and the next into CpuTimeSubBuckets buckets using the bits
+        // immediately below the most significant one.
+        const uint32 log2      = Log2(ticks);
+        const uint32 shift     = (log2 - CpuTimeSubBucketsLog2);
+        const uint32 subBucket = static_cast<uint32>(ticks >> shift) & (CpuTimeSubBuckets - 1);
+
+        bucket = ((shift + 1) << CpuTimeSubBucketsLog2) + subBucket;
+    }
+
+    return Min(bucket, NumCpuTimeBuckets - 1);
+}
+
 // =====================================================================================================================
 void CmdBuffer::PreCall()
 {
     m_stats.commandBufferSize = GetNextLayer()->GetUsedSize(CmdAllocType::CommandDataAlloc);
+    m_callAllocCount          = Platform::ThreadAllocCount();
+
+    // Start timing last so that the instrumentation's own overhead isn't measured.
+    m_callStartTime = GetPerfCpuTime();
 }
 
 // =====================================================================================================================
@@ -97,10 +130,28 @@ void CmdBuffer::PreDrawCall()
 void CmdBuffer::PostCall(
     CmdBufCallId callId)
 {
+    const int64   endTime    = GetPerfCpuTime();
     const gpusize currentLen = GetNextLayer()->GetUsedSize(CmdAllocType::CommandDataAlloc);
+    const gpusize cmdSize    = (currentLen - m_stats.commandBufferSize);
+    const uint64  allocCount = (Platform::ThreadAllocCount() - m_callAllocCount);
 
     ++m_stats.call[static_cast<uint32>(callId)].count;
-    m_stats.call[static_cast<uint32>(callId)].cmdSize += (currentLen - m_stats.commandBufferSize);
+    m_stats.call[static_cast<uint32>(callId)].cmdSize += cmdSize;
+
+    // Command buffers may be recorded on any thread, so the CPU time goes into the calling thread's statistics.
+    CpuTimeStatistics*const pCpuTimes = m_pPlatform->ThreadCpuTimes();
+
+    if (pCpuTimes != nullptr)
+    {
+        const uint64      ticks = static_cast<uint64>(endTime - m_callStartTime);
+        CpuTimeData*const pData = &pCpuTimes->call[static_cast<uint32>(callId)];
+
+        pData->totalTicks += ticks;
+        pData->cmdSize    += cmdSize;
+        pData->allocCount += allocCount;
+        pData->count++;
+        pData->histogram[CpuTimeBucket(ticks)]++;
+    }
 }
 
 // =====================================================================================================================
@@ -163,6 +214,14 @@ void CmdBuffer::PostDrawCall(
         ++m_stats.internalEvent[Id].count;
         m_stats.internalEvent[Id].cmdSize += m_validationData.pipelineCmdSize;
     }
+
+    if (m_validationData.pipelineDeltaCmdSize > 0)
+    {
+        constexpr uint32 Id = static_cast<uint32>(InternalEventId::PipelineDeltaValidationGfx);
+
+        ++m_stats.internalEvent[Id].count;
+        m_stats.internalEvent[Id].cmdSize += m_validationData.pipelineDeltaCmdSize;
+    }
 }
 
 // =====================================================================================================================
@@ -35,6 +35,7 @@ namespace Pm4Instrumentor
 {
 
 class Device;
+class Platform;
 
 // =====================================================================================================================
 // Pm4Instrumentor layer implementation of ICmdBuffer.  Accumulates statistics while recording commands.
@@ -582,7 +583,11 @@ private:
         uint32      yDim,
         uint32      zDim);
 
+    Platform*const  m_pPlatform;
+
     Pm4Statistics  m_stats;
+    int64          m_callStartTime;  // CPU time at which the current call was passed to the next layer.
+    uint64         m_callAllocCount; // The calling thread's system memory allocation count when the call began.
 
     RegisterInfoVector  m_shRegs;
     RegisterInfoVector  m_ctxRegs;
@@ -27,7 +27,9 @@
 #include "core/layers/pm4Instrumentor/pm4InstrumentorCmdBuffer.h"
 #include "core/layers/pm4Instrumentor/pm4InstrumentorDevice.h"
 #include "core/layers/pm4Instrumentor/pm4InstrumentorPlatform.h"
+#include "palFile.h"
 #include "palSysUtil.h"
+#include "palVectorImpl.h"
 
 using namespace Util;
 
@@ -36,6 +38,94 @@ namespace Pal
 namespace Pm4Instrumentor
 {
 
+// Tracks the client's allocation callbacks while they're wrapped by CountingAlloc() and CountingFree().  Each thread's
+// allocation count is stored directly in its thread-local value for counterKey so that counting never allocates.
+struct AllocCounter
+{
+    AllocCallbacks  clientCb;
+    ThreadLocalKey  counterKey;
+    volatile uint32 state;      // One of the AllocCounterState values.
+};
+
+enum AllocCounterState : uint32
+{
+    AllocCounterUninitialized = 0,
+    AllocCounterInitializing  = 1,
+    AllocCounterReady         = 2,
+};
+
+// The counter is shared by every platform in the process; only the first platform's callbacks are ever wrapped.
+static AllocCounter g_allocCounter = {};
+
+// =====================================================================================================================
+static void* PAL_STDCALL CountingAlloc(
+    void*           pClientData,
+    size_t          size,
+    size_t          alignment,
+    SystemAllocType allocType)
+{
+    const auto*const pCounter = static_cast<const AllocCounter*>(pClientData);
+    const uintptr_t  count    = reinterpret_cast<uintptr_t>(GetThreadLocalValue(pCounter->counterKey));
+
+    SetThreadLocalValue(pCounter->counterKey, reinterpret_cast<void*>(count + 1));
+
+    return pCounter->clientCb.pfnAlloc(pCounter->clientCb.pClientData, size, alignment, allocType);
+}
+
+// =====================================================================================================================
+static void PAL_STDCALL CountingFree(
+    void* pClientData,
+    void* pMem)
+{
+    const auto*const pCounter = static_cast<const AllocCounter*>(pClientData);
+
+    pCounter->clientCb.pfnFree(pCounter->clientCb.pClientData, pMem);
+}
+
+// =====================================================================================================================
+// Replaces the given allocation callbacks with ones which count every allocation made on each thread before passing
+// it on to the original callbacks.  This must be done before the core platform is created so that every allocation
+// PAL makes is counted.  The callbacks are left untouched if a different set of callbacks has already been wrapped.
+void Platform::WrapAllocCallbacks(
+    AllocCallbacks* pAllocCb)
+{
+    if (AtomicCompareAndSwap(&g_allocCounter.state, AllocCounterUninitialized, AllocCounterInitializing) ==
+        AllocCounterUninitialized)
+    {
+        g_allocCounter.clientCb = *pAllocCb;
+
+        // The key is never deleted because allocations may be counted until the last platform is destroyed.
+        const Result result = CreateThreadLocalKey(&g_allocCounter.counterKey);
+
+        AtomicExchange(&g_allocCounter.state,
+                       (result == Result::Success) ? AllocCounterReady : AllocCounterUninitialized);
+    }
+
+    if ((g_allocCounter.state == AllocCounterReady)                   &&
+        (g_allocCounter.clientCb.pfnAlloc    == pAllocCb->pfnAlloc)   &&
+        (g_allocCounter.clientCb.pfnFree     == pAllocCb->pfnFree)    &&
+        (g_allocCounter.clientCb.pClientData == pAllocCb->pClientData))
+    {
+        pAllocCb->pClientData = &g_allocCounter;
+        pAllocCb->pfnAlloc    = CountingAlloc;
+        pAllocCb->pfnFree     = CountingFree;
+    }
+}
+
+// =====================================================================================================================
+// Returns the number of system memory allocations the calling thread has made through the wrapped callbacks.
+uint64 Platform::ThreadAllocCount()
+{
+    uint64 count = 0;
+
+    if (g_allocCounter.state == AllocCounterReady)
+    {
+        count = reinterpret_cast<uintptr_t>(GetThreadLocalValue(g_allocCounter.counterKey));
+    }
+
+    return count;
+}
+
 // =====================================================================================================================
 static void PAL_STDCALL Pm4InstrumentorCb(
     void*                   pPrivateData,
@@ -107,8 +197,292 @@ Platform::Platform(
     bool                        enabled)
     :
     PlatformDecorator(allocCb, Pm4InstrumentorCb, enabled, enabled, pNextPlatform),
-    m_frameCount(0)
+    m_frameCount(0),
+    m_cpuTimesKey(),
+    m_cpuTimesKeyValid(false),
+    m_threadCpuTimes(this),
+    m_pMergedCpuTimes(nullptr),
+    m_cpuTimesDumpInterval(0),
+    m_lastCpuTimesDump(0)
+{
+}
+
+// =====================================================================================================================
+Platform::~Platform()
 {
+    if (m_pMergedCpuTimes != nullptr)
+    {
+        MergeCpuTimes();
+        DumpCpuTimes();
+
+        PAL_SAFE_FREE(m_pMergedCpuTimes, this);
+    }
+
+    for (uint32 i = 0; i < m_threadCpuTimes.NumElements(); ++i)
+    {
+        PAL_FREE(m_threadCpuTimes.At(i), this);
+    }
+
+    if (m_cpuTimesKeyValid)
+    {
+        DeleteThreadLocalKey(m_cpuTimesKey);
+    }
+}
+
+// =====================================================================================================================
+Result Platform::Init()
+{
+    Result result = PlatformDecorator::Init();
+
+    if (m_layerEnabled)
+    {
+        if (result == Result::Success)
+        {
+            result = m_cpuTimesLock.Init();
+        }
+
+        if (result == Result::Success)
+        {
+            result             = CreateThreadLocalKey(&m_cpuTimesKey);
+            m_cpuTimesKeyValid = (result == Result::Success);
+        }
+
+        if (result == Result::Success)
+        {
+            m_pMergedCpuTimes = static_cast<CpuTimeStatistics*>(
+                PAL_CALLOC(sizeof(CpuTimeStatistics), this, AllocInternal));
+
+            result = (m_pMergedCpuTimes != nullptr) ? Result::Success : Result::ErrorOutOfMemory;
+        }
+
+        if (result == Result::Success)
+        {
+            const auto& settings = PlatformSettings().pm4InstrumentorConfig;
+
+            if (settings.dumpMode == Pm4InstrumentorDumpQueueSubmit)
+            {
+                m_cpuTimesDumpInterval = (GetPerfFrequency() * settings.dumpInterval);
+                m_lastCpuTimesDump     = GetPerfCpuTime();
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void Platform::NotifyPresentOcurred()
+{
+    AtomicIncrement(&m_frameCount);
+
+    if (m_pMergedCpuTimes != nullptr)
+    {
+        MutexAuto lock(&m_cpuTimesLock);
+
+        MergeCpuTimes();
+
+        if (m_cpuTimesDumpInterval > 0)
+        {
+            const int64 currentCounter = GetPerfCpuTime();
+            if ((currentCounter - m_lastCpuTimesDump) >= m_cpuTimesDumpInterval)
+            {
+                DumpCpuTimes();
+                m_lastCpuTimesDump = currentCounter;
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Allocates the calling thread's CPU time statistics and registers them so that they can be merged later.
+CpuTimeStatistics* Platform::CreateThreadCpuTimes()
+{
+    auto* pCpuTimes = static_cast<CpuTimeStatistics*>(PAL_CALLOC(sizeof(CpuTimeStatistics), this, AllocInternal));
+
+    if (pCpuTimes != nullptr)
+    {
+        MutexAuto lock(&m_cpuTimesLock);
+
+        Result result = m_threadCpuTimes.PushBack(pCpuTimes);
+
+        if (result == Result::Success)
+        {
+            result = SetThreadLocalValue(m_cpuTimesKey, pCpuTimes);
+
+            if (result != Result::Success)
+            {
+                m_threadCpuTimes.PopBack(nullptr);
+            }
+        }
+
+        if (result != Result::Success)
+        {
+            PAL_SAFE_FREE(pCpuTimes, this);
+        }
+    }
+
+    return pCpuTimes;
+}
+
+// =====================================================================================================================
+// Sums every thread's CPU time statistics into m_pMergedCpuTimes. The caller must hold m_cpuTimesLock unless no other
+// threads can be recording.
+//
+// The per-thread statistics only ever grow and are read here while their owners may still be adding to them. Every
+// field is a naturally aligned integer so reads can't tear; at worst a call recorded during the merge is only partly
+// accounted for until the next merge.
+void Platform::MergeCpuTimes()
+{
+    memset(m_pMergedCpuTimes, 0, sizeof(CpuTimeStatistics));
+
+    for (uint32 i = 0; i < m_threadCpuTimes.NumElements(); ++i)
+    {
+        const CpuTimeStatistics& threadCpuTimes = *m_threadCpuTimes.At(i);
+
+        for (uint32 callId = 0; callId < NumCallIds; ++callId)
+        {
+            const CpuTimeData& src  = threadCpuTimes.call[callId];
+            CpuTimeData*const  pDst = &m_pMergedCpuTimes->call[callId];
+
+            if (src.count > 0)
+            {
+                pDst->totalTicks += src.totalTicks;
+                pDst->cmdSize    += src.cmdSize;
+                pDst->allocCount += src.allocCount;
+                pDst->count      += src.count;
+
+                for (uint32 bucket = 0; bucket < NumCpuTimeBuckets; ++bucket)
+                {
+                    pDst->histogram[bucket] += src.histogram[bucket];
+                }
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Returns the largest tick count which falls into the given CPU time histogram bucket.
+static uint64 CpuTimeBucketUpperBound(
+    uint32 bucket)
+{
+    uint64 upperBound = bucket;
+
+    if (bucket >= CpuTimeSubBuckets)
+    {
+        const uint32 log2      = (bucket >> CpuTimeSubBucketsLog2) + (CpuTimeSubBucketsLog2 - 1);
+        const uint32 subBucket = (bucket & (CpuTimeSubBuckets - 1));
+        const uint32 shift     = (log2 - CpuTimeSubBucketsLog2);
+
+        upperBound = ((static_cast<uint64>(CpuTimeSubBuckets + subBucket + 1) << shift) - 1);
+    }
+
+    return upperBound;
+}
+
+// =====================================================================================================================
+// Returns an upper bound on the given percentile of a CPU time histogram, in ticks.
+static uint64 CpuTimePercentile(
+    const CpuTimeData& data,
+    uint32             percentile)
+{
+    // The rank of the sample at the given percentile, rounded up.
+    const uint64 rank = ((static_cast<uint64>(data.count) * percentile) + 99) / 100;
+
+    uint64 seen   = 0;
+    uint32 bucket = 0;
+
+    for (; bucket < (NumCpuTimeBuckets - 1); ++bucket)
+    {
+        seen += data.histogram[bucket];
+
+        if (seen >= rank)
+        {
+            break;
+        }
+    }
+
+    return CpuTimeBucketUpperBound(bucket);
+}
+
+// =====================================================================================================================
+// Dumps the merged CPU time statistics to a file in .csv format. The caller must hold m_cpuTimesLock unless no other
+// threads can be recording.
+void Platform::DumpCpuTimes()
+{
+    const auto& settings = PlatformSettings().pm4InstrumentorConfig;
+
+    char* pExecName = nullptr;
+    char  execNameAndPath[512];
+    if (GetExecutableName(&execNameAndPath[0], &pExecName, sizeof(execNameAndPath)) != Result::Success)
+    {
+        Strncpy(&execNameAndPath[0], "Unknown-App", sizeof(execNameAndPath));
+        pExecName = &execNameAndPath[0];
+    }
+
+    char fileName[MaxPathStrLen << 1] = {};
+    Snprintf(&fileName[0],
+             sizeof(fileName),
+             "%s/%s__CpuTime-%s",
+             &settings.logDirectory[0],
+             pExecName,
+             &settings.filenameSuffix[0]);
+
+    File logFile;
+    if (logFile.Open(&fileName[0], FileAccessWrite) == Result::Success)
+    {
+        // Report times in nanoseconds regardless of the resolution of the CPU clock.
+        const double nsPerTick = 1000000000.0 / static_cast<double>(GetPerfFrequency());
+
+        logFile.Printf("Operation,Count,Total Bytes,Total CPU Time (us),Mean (ns),P50 (ns),P99 (ns),ns per DWORD,"
+                       "DWORDs per Call,Allocations,Allocations per Call,Allocations per Frame\n\n");
+
+        if (m_frameCount != 0)
+        {
+            logFile.Printf("Frames,%d\n\n", m_frameCount);
+        }
+
+        for (uint32 i = 0; i < NumCallIds; ++i)
+        {
+            const CpuTimeData& data = m_pMergedCpuTimes->call[i];
+            if (data.count == 0)
+            {
+                continue; // Skip calls which were never hit.
+            }
+
+            const double totalNs   = nsPerTick * data.totalTicks;
+            const double cmdDwords = static_cast<double>(data.cmdSize / sizeof(uint32));
+
+            logFile.Printf("%s,%d,%llu,%.3f,%.1f,%.0f,%.0f,",
+                           CmdBufCallIdStrings[i],
+                           data.count,
+                           data.cmdSize,
+                           totalNs / 1000.0,
+                           totalNs / data.count,
+                           nsPerTick * CpuTimePercentile(data, 50),
+                           nsPerTick * CpuTimePercentile(data, 99));
+
+            // Calls which didn't write any commands don't have a meaningful cost per DWORD.
+            if (cmdDwords > 0.0)
+            {
+                logFile.Printf("%.2f", totalNs / cmdDwords);
+            }
+
+            logFile.Printf(",%.1f,%llu,%.2f,",
+                           cmdDwords / data.count,
+                           data.allocCount,
+                           static_cast<double>(data.allocCount) / data.count);
+
+            // Allocations per frame are only meaningful if the application presented.
+            if (m_frameCount != 0)
+            {
+                logFile.Printf("%.2f\n", static_cast<double>(data.allocCount) / m_frameCount);
+            }
+            else
+            {
+                logFile.Printf("\n");
+            }
+        }
+    } // If log file was opened
 }
 
 // =====================================================================================================================
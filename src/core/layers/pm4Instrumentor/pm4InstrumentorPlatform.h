@@ -26,7 +26,10 @@
 #pragma once
 
 #include "core/layers/decorators.h"
+#include "core/layers/pm4Instrumentor/pm4InstrumentorQueue.h"
 #include "palMutex.h"
+#include "palThread.h"
+#include "palVector.h"
 
 namespace Pal
 {
@@ -55,15 +58,43 @@ public:
         void*    pStorage[MaxScreens],
         IScreen* pScreens[MaxScreens]) override;
 
-    void NotifyPresentOcurred() { Util::AtomicIncrement(&m_frameCount); }
+    virtual Result Init() override;
+
+    static void WrapAllocCallbacks(Util::AllocCallbacks* pAllocCb);
+    static uint64 ThreadAllocCount();
+
+    void NotifyPresentOcurred();
 
     uint32 FrameCount() const { return m_frameCount; }
 
+    // Returns the calling thread's CPU time statistics, creating them on the thread's first call.  Returns null if
+    // they couldn't be allocated.
+    CpuTimeStatistics* ThreadCpuTimes()
+    {
+        void*const pCpuTimes = Util::GetThreadLocalValue(m_cpuTimesKey);
+        return (pCpuTimes != nullptr) ? static_cast<CpuTimeStatistics*>(pCpuTimes) : CreateThreadCpuTimes();
+    }
+
 private:
-    virtual ~Platform() { }
+    virtual ~Platform();
+
+    CpuTimeStatistics* CreateThreadCpuTimes();
+    void MergeCpuTimes();
+    void DumpCpuTimes();
 
     uint32  m_frameCount;
 
+    // Each thread which records command buffers accumulates its own CPU time statistics so that recording never
+    // contends on shared data.  The per-thread statistics are merged at frame boundaries and when the platform is
+    // destroyed.
+    Util::ThreadLocalKey                          m_cpuTimesKey;
+    bool                                          m_cpuTimesKeyValid;
+    Util::Mutex                                   m_cpuTimesLock;     // Protects the members below.
+    Util::Vector<CpuTimeStatistics*, 8, Platform> m_threadCpuTimes;
+    CpuTimeStatistics*                            m_pMergedCpuTimes;
+    int64                                         m_cpuTimesDumpInterval;
+    int64                                         m_lastCpuTimesDump;
+
     PAL_DISALLOW_DEFAULT_CTOR(Platform);
     PAL_DISALLOW_COPY_AND_ASSIGN(Platform);
 };
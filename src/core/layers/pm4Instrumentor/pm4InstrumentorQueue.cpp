@@ -70,6 +70,7 @@ static const char* InternalEventIdToString(
         "ValidateGraphicsUserData()",   // UserDataValidationGfx
         "ValidateComputePipeline",      // PipelineValidationCs
         "ValidateGraphicsPipeline",     // PipelineValidationGfx
+        "ValidateGraphicsPipeline (Delta)", // PipelineDeltaValidationGfx
         "ValidateDispatch()",           // MiscDispatchValidation
         "ValidateDraw()",               // MiscDrawValidation
     };
@@ -50,6 +50,7 @@ enum class InternalEventId : uint32
 
     PipelineValidationCs,   // Dispatch-time validation of pipeline state
     PipelineValidationGfx,  // Draw-time validation of pipeline state
+    PipelineDeltaValidationGfx, // Draw-time validation of pipeline state which only wrote a register delta
 
     MiscDispatchValidation, // All Dispatch-time validation which doesn't fall into the above buckets
     MiscDrawValidation,     // All Draw-time validation which doesn't fall into the above buckets
@@ -87,6 +88,30 @@ struct RegisterInfo
 
 typedef Util::Vector<RegisterInfo, 1u, Platform>  RegisterInfoVector;
 
+// CPU time histograms are log-bucketed: values below CpuTimeSubBuckets ticks each get their own bucket, and the range
+// between each pair of higher powers of two is split into CpuTimeSubBuckets equal buckets.  This bounds the error of
+// a reported percentile to 25% of its value while keeping the histograms small enough to keep one per thread.
+constexpr uint32 CpuTimeSubBucketsLog2 = 2;
+constexpr uint32 CpuTimeSubBuckets     = (1u << CpuTimeSubBucketsLog2);
+constexpr uint32 NumCpuTimeBuckets     = 128;
+
+// CPU time statistics for a single command buffer call.
+struct CpuTimeData
+{
+    uint64  totalTicks;                     // Total CPU time spent in this entry point, in GetPerfCpuTime() ticks.
+    gpusize cmdSize;                        // Total size of PM4 commands written by the timed calls.
+    uint64  allocCount;                     // Total number of system memory allocations made by the timed calls.
+    uint32  count;                          // Number of timed calls.
+    uint32  histogram[NumCpuTimeBuckets];   // Number of calls which took each bucket's range of CPU time.
+};
+
+// Contains CPU time statistics for every command buffer call, either gathered by a single thread or merged from all of
+// the threads which have recorded command buffers.
+struct CpuTimeStatistics
+{
+    CpuTimeData call[NumCallIds];
+};
+
 // =====================================================================================================================
 // Pm4Instrumentor layer implementation of IQueue.  Accumulates stats from each submitted command buffer and dumps them
 // to a log file.
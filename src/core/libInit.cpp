@@ -44,6 +44,8 @@
 #include "core/layers/pm4Instrumentor/pm4InstrumentorPlatform.h"
 #endif
 
+#include "palAllocProfiler.h"
+#include "palSlabAllocator.h"
 #include "addrinterface.h"
 #include "vaminterface.h"
 
@@ -146,11 +148,47 @@ Result PAL_STDCALL CreatePlatform(
         allocCb = *createInfo.pAllocCb;
     }
 
+    Util::SlabAllocator* pSlabAllocator = nullptr;
+    Util::AllocProfiler* pAllocProfiler = nullptr;
+
+    if ((result == Result::Success) && createInfo.flags.enableSlabAllocator)
+    {
+        // The slab allocator sits directly on top of the client's callbacks so that the profiler and instrumentor below
+        // still see every allocation PAL makes.  Without it, allocations go straight to the client.
+        result = Util::SlabAllocator::Create(allocCb, createInfo.slabAllocatorMemoryCeiling, &pSlabAllocator);
+
+        if (result == Result::Success)
+        {
+            pSlabAllocator->GetAllocCallbacks(&allocCb);
+        }
+    }
+
+    if ((result == Result::Success) && createInfo.flags.enableAllocProfiler)
+    {
+        // The profiler must see every allocation PAL makes, so it wraps the callbacks before anything is allocated.
+        result = Util::AllocProfiler::Create(allocCb, createInfo.allocProfilerSampleInterval, &pAllocProfiler);
+
+        if (result == Result::Success)
+        {
+            pAllocProfiler->GetAllocCallbacks(&allocCb);
+        }
+    }
+
+#if PAL_BUILD_PM4_INSTRUMENTOR
+    if ((result == Result::Success) && createInfo.flags.enablePm4AllocCounts)
+    {
+        // Every allocation must go through the instrumentor's counting callbacks so that it can report allocations per
+        // command buffer call.  The layer's settings aren't known yet, so the client opts in when it enables the layer.
+        Pm4Instrumentor::Platform::WrapAllocCallbacks(&allocCb);
+    }
+#endif
+
     // NOTE: If a specific layer is being built we must always create a Platform decorator for that layer.
     //       This avoids a rather difficult issue where we need to place the IPlatform the client uses at the beginning
     //       of the memory they allocate (or we could have an issue when they go to free that memory). It is easier to
     //       just create the Platform decorator for every layer and make it the responsibility of the layer to
-    //       understand when it is enabled or disabled.
+    //       understand when it is enabled or disabled. A disabled layer must not wrap the devices it enumerates, so
+    //       none of the objects created from those devices pay for the layer's presence.
 #if PAL_BUILD_INTERFACE_LOGGER
     pPlacementAddr = Util::VoidPtrInc(pPlacementAddr, sizeof(InterfaceLogger::Platform));
 #endif
@@ -174,6 +212,24 @@ Result PAL_STDCALL CreatePlatform(
         result = Platform::Create(createInfo, allocCb, pPlacementAddr, &pCorePlatform);
     }
 
+    if (result == Result::Success)
+    {
+        // The core platform owns the allocation wrappers from here on and destroys them after everything else.
+        pCorePlatform->SetAllocWrappers(pSlabAllocator, pAllocProfiler);
+    }
+    else
+    {
+        if (pAllocProfiler != nullptr)
+        {
+            pAllocProfiler->Destroy();
+        }
+
+        if (pSlabAllocator != nullptr)
+        {
+            pSlabAllocator->Destroy();
+        }
+    }
+
     IPlatform* pCurPlatform = pCorePlatform;
 
 #if PAL_BUILD_PM4_INSTRUMENTOR
@@ -2732,6 +2732,26 @@ Result Device::ResetSyncObject(
     return result;
 }
 
+// =====================================================================================================================
+// Call amdgpu to signal syncobj fences from the CPU
+Result Device::SignalSyncObject(
+    const uint32* pFences,
+    uint32        fenceCount
+    ) const
+{
+    Result result = Result::Unsupported;
+
+    if (m_drmProcs.pfnAmdgpuCsSyncobjSignalisValid())
+    {
+        result = CheckResult(m_drmProcs.pfnAmdgpuCsSyncobjSignal(m_hDevice,
+                                                                 pFences,
+                                                                 fenceCount),
+                             Result::ErrorInvalidValue);
+    }
+
+    return result;
+}
+
 // =====================================================================================================================
 // Call amdgpu to read the value of a register.
 Result Device::ReadRegisters(
@@ -579,6 +579,10 @@ public:
         const uint32* pFences,
         uint32        fenceCount) const;
 
+    Result SignalSyncObject(
+        const uint32* pFences,
+        uint32        fenceCount) const;
+
     bool IsInitialSignaledSyncobjSemaphoreSupported() const
         { return m_syncobjSupportState.initialSignaledSyncobjSemaphore == 1; }
 
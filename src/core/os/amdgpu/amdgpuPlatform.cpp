@@ -73,7 +73,7 @@ void Platform::Destroy()
 {
     TearDownDevices();
 
-    this->~Platform();
+    Pal::Platform::Destroy();
 }
 
 // =====================================================================================================================
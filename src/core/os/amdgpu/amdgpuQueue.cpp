@@ -40,6 +40,7 @@
 #include "palDequeImpl.h"
 #include "palListImpl.h"
 #include "palHashMapImpl.h"
+#include "palHashSetImpl.h"
 #include "palVectorImpl.h"
 
 #include <climits>
@@ -405,6 +406,12 @@ Result Queue::RemapVirtualMemoryPages(
     {
         result = Result::ErrorInvalidPointer;
     }
+    else
+    {
+        // The remapping is applied immediately, so any submits held back by submit coalescing must go out first to
+        // keep them ordered before it.
+        result = FlushCoalescedSubmits();
+    }
 
     for (uint32 idx = 0; ((idx < rangeCount) && (result == Result::Success)); ++idx)
     {
@@ -574,7 +581,10 @@ Result Queue::OsSubmit(
     }
     else
     {
-        result = UpdateResourceList(submitInfo.pGpuMemoryRefs, submitInfo.gpuMemRefCount);
+        result = UpdateResourceList(submitInfo.pGpuMemoryRefs,
+                                    submitInfo.gpuMemRefCount,
+                                    submitInfo.cmdBufferCount,
+                                    submitInfo.ppCmdBuffers);
     }
 
     if (result == Result::Success)
@@ -1038,10 +1048,13 @@ Result Queue::DoAssociateFenceWithLastSubmit(
 }
 
 // =====================================================================================================================
-// Updates the resource list with all GPU memory allocations which will participate in a submission to amdgpu.
+// Updates the resource list with all GPU memory allocations which will participate in a submission to amdgpu. This
+// includes the memory references tracked by any command buffers built with the trackMemoryReferences flag.
 Result Queue::UpdateResourceList(
     const GpuMemoryRef* pMemRefList,
-    size_t              memRefCount)
+    size_t              memRefCount,
+    uint32              cmdBufferCount,
+    ICmdBuffer*const*   ppCmdBuffers)
 {
     InternalMemMgr*const pMemMgr = m_pDevice->MemMgr();
 
@@ -1050,13 +1063,26 @@ Result Queue::UpdateResourceList(
     // if the allocation is always resident, Pal doesn't need to build up the allocation list.
     if (m_pDevice->Settings().alwaysResident == false)
     {
-        // Serialize access to internalMgr and queue memory list
-        RWLockAuto<RWLock::ReadOnly> lockMgr(pMemMgr->GetRefListLock());
+        size_t trackedRefCount = 0;
+        for (uint32 idx = 0; idx < cmdBufferCount; ++idx)
+        {
+            const auto*const pCmdBuffer = static_cast<const Pal::CmdBuffer*>(ppCmdBuffers[idx]);
+
+            if (pCmdBuffer->TracksMemRefs())
+            {
+                trackedRefCount += pCmdBuffer->MemRefs().GetNumEntries();
+            }
+        }
+
+        // The internal memory manager's reference list is read lock-free; the read scope only keeps the memory we
+        // see alive until we're done. Access to the queue memory list is serialized by its lock.
+        RefListReadScope             memMgrReadScope(pMemMgr);
         RWLockAuto<RWLock::ReadOnly> lock(&m_globalRefLock);
 
         const bool reuseResourceList = (m_globalRefDirty == false)                               &&
                                        (pMemMgr->ReferenceWatermark() == m_internalMgrTimestamp) &&
                                        (memRefCount == 0)                                        &&
+                                       (trackedRefCount == 0)                                    &&
                                        (m_appMemRefCount == 0)                                   &&
                                        (m_hResourceList != nullptr)                              &&
                                        (m_pDevice->Settings().allocationListReusable);
@@ -1130,14 +1156,31 @@ Result Queue::UpdateResourceList(
                 }
             }
 
-            // Finally, add all of the application's submission memory references.
+            // Finally, add all of the application's submission memory references and the references tracked by the
+            // command buffers. Each command buffer's set is already deduplicated; duplicates between command buffers
+            // or with the other lists are harmless.
             if (result == Result::Success)
             {
-                m_appMemRefCount = memRefCount;
+                m_appMemRefCount = static_cast<uint32>(memRefCount + trackedRefCount);
                 for (size_t idx = 0; ((idx < memRefCount) && (result == Result::_Success)); ++idx)
                 {
                     result = AppendResourceToList(static_cast<GpuMemory*>(pMemRefList[idx].pGpuMemory));
                 }
+
+                for (uint32 idx = 0; ((idx < cmdBufferCount) && (trackedRefCount > 0)); ++idx)
+                {
+                    const auto*const pCmdBuffer = static_cast<const Pal::CmdBuffer*>(ppCmdBuffers[idx]);
+
+                    if (pCmdBuffer->TracksMemRefs())
+                    {
+                        auto iter = pCmdBuffer->MemRefs().Begin();
+                        while ((iter.Get() != nullptr) && (result == Result::_Success))
+                        {
+                            result = AppendResourceToList(static_cast<const GpuMemory*>(iter.Get()->key));
+                            iter.Next();
+                        }
+                    }
+                }
             }
 
             if ((result == Result::Success) && (m_numResourcesInList > 0))
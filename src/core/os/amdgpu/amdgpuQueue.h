@@ -172,7 +172,9 @@ protected:
 private:
     Result UpdateResourceList(
         const GpuMemoryRef*    pMemRefList,
-        size_t                 memRefCount);
+        size_t                 memRefCount,
+        uint32                 cmdBufferCount,
+        ICmdBuffer*const*      ppCmdBuffers);
 
     Result AppendResourceToList(
         const GpuMemory* pGpuMemory);
@@ -235,7 +237,8 @@ private:
     bool                  m_globalRefDirty;       // Indicates m_globalRefMap has changed since the last submit.
     Util::RWLock          m_globalRefLock;        // Protect m_globalRefMap from muli-thread access.
     uint32                m_internalMgrTimestamp; // Store timestamp of internal memory mgr.
-    uint32                m_appMemRefCount;       // Store count of application's submission memory references.
+    uint32                m_appMemRefCount;       // Store count of application's submission memory references,
+                                                  // including those tracked by the submitted command buffers.
     bool                  m_pendingWait;          // Queue needs a dummy submission between wait and signal.
     CmdUploadRing*        m_pCmdUploadRing;       // Uploads gfxip command streams to a large local memory buffer.
 
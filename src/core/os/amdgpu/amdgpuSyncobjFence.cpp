@@ -259,6 +259,15 @@ Result SyncobjFence::Reset()
     return result;
 }
 
+// =====================================================================================================================
+// Signals the sync object from the CPU, waking any thread waiting on this fence.
+Result SyncobjFence::Signal()
+{
+    m_fenceState.neverSubmitted = 0;
+
+    return m_device.SignalSyncObject(&m_fenceSyncObject, 1);
+}
+
 // =====================================================================================================================
 // use WaitForSyncobjFences with setting timeout = 0
 bool SyncobjFence::IsSyncobjSignaled(
@@ -72,6 +72,8 @@ public:
 
     virtual Result Reset() override;
 
+    virtual Result Signal() override;
+
     virtual Result GetStatus() const override;
 
     amdgpu_syncobj_handle SyncObjHandle() const { return m_fenceSyncObject; }
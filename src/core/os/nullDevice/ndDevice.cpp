@@ -369,7 +369,7 @@ Result Device::CreateFence(
 {
     PAL_ASSERT((pPlacementAddr != nullptr) && (ppFence != nullptr));
 
-    Fence* pFence = PAL_PLACEMENT_NEW(pPlacementAddr) Fence();
+    Fence* pFence = PAL_PLACEMENT_NEW(pPlacementAddr) Fence(*this);
 
     // Set needsEvent argument to true - all client-created fences require event objects to support the
     // IDevice::WaitForFences interface.
@@ -396,7 +396,7 @@ Result Device::OpenFence(
 {
     PAL_ASSERT((pPlacementAddr != nullptr) && (ppFence != nullptr));
 
-    Fence* pFence = PAL_PLACEMENT_NEW(pPlacementAddr) Fence();
+    Fence* pFence = PAL_PLACEMENT_NEW(pPlacementAddr) Fence(*this);
 
     Result result = pFence->OpenHandle(openInfo);
 
@@ -1410,7 +1410,14 @@ Result Device::OpenExternalSharedImage(
 // function can only be destroyed or deinitialized on Device destruction.
 Result Device::OsEarlyInit()
 {
-    return Result::Success;
+    Result result = m_fenceLock.Init();
+
+    if (result == Result::Success)
+    {
+        result = m_fenceSignaledCond.Init();
+    }
+
+    return result;
 }
 
 // =====================================================================================================================
@@ -26,6 +26,8 @@
 #pragma once
 
 #include "core/device.h"
+#include "palConditionVariable.h"
+#include "palMutex.h"
 #include "palPlatform.h"
 
 namespace Pal
@@ -118,6 +120,11 @@ public:
         void*                pPlacementAddr,
         IFence**             ppFence) const override;
 
+    // All of this device's fences share one lock and condition variable so that fence waits can sleep until a fence is
+    // signaled.
+    Util::Mutex*             FenceLock() const { return &m_fenceLock; }
+    Util::ConditionVariable* FenceSignaledCond() const { return &m_fenceSignaledCond; }
+
     // NOTE: Part of the public IDevice interface.
     virtual Result WaitForSemaphores(
         uint32                       semaphoreCount,
@@ -406,6 +413,9 @@ private:
 
     const NullIdLookup&  m_nullIdLookup;
 
+    mutable Util::Mutex             m_fenceLock;
+    mutable Util::ConditionVariable m_fenceSignaledCond;
+
     PAL_DISALLOW_DEFAULT_CTOR(Device);
     PAL_DISALLOW_COPY_AND_ASSIGN(Device);
 };
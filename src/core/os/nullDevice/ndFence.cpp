@@ -24,6 +24,7 @@
  **********************************************************************************************************************/
 
 #include "ndFence.h"
+#include "palSysUtil.h"
 
 using namespace Util;
 
@@ -49,13 +50,39 @@ OsExternalHandle Fence::ExportExternalHandle(
 #endif
 }
 
+// =====================================================================================================================
+// Updates the signaled state under the device's fence lock and wakes up anyone waiting on it.
+void Fence::SetSignaled(
+    bool signaled)
+{
+    MutexAuto lock(m_device.FenceLock());
+
+    m_signaled = signaled ? 1 : 0;
+
+    if (signaled)
+    {
+        m_device.FenceSignaledCond()->WakeAll();
+    }
+}
+
 // =====================================================================================================================
 Result Fence::Reset()
 {
+    SetSignaled(false);
+
     return Result::Success;
 }
 
 // =====================================================================================================================
+Result Fence::Signal()
+{
+    SetSignaled(true);
+
+    return Result::Success;
+}
+
+// =====================================================================================================================
+// Sleeps until any or all of the fences are signaled or the timeout expires.
 Result Fence::WaitForFences(
     const Pal::Device&      device,
     uint32                  fenceCount,
@@ -63,7 +90,52 @@ Result Fence::WaitForFences(
     bool                    waitAll,
     uint64                  timeout) const
 {
-    return Result::Success;
+    constexpr uint64 NsPerSec    = 1000 * 1000 * 1000;
+    constexpr uint64 NsPerMs     = 1000 * 1000;
+    constexpr uint32 WaitForever = UINT32_MAX;
+
+    const auto&  nullDevice = static_cast<const Device&>(device);
+    const uint64 frequency  = static_cast<uint64>(GetPerfFrequency());
+    const int64  startTime  = GetPerfCpuTime();
+
+    MutexAuto lock(nullDevice.FenceLock());
+
+    Result result = Result::NotReady;
+
+    while (result == Result::NotReady)
+    {
+        uint32 numSignaled = 0;
+
+        for (uint32 idx = 0; idx < fenceCount; ++idx)
+        {
+            numSignaled += static_cast<const Fence*>(ppFenceList[idx])->m_signaled;
+        }
+
+        if (waitAll ? (numSignaled == fenceCount) : (numSignaled > 0))
+        {
+            result = Result::Success;
+        }
+        else
+        {
+            const uint64 elapsedTicks = static_cast<uint64>(GetPerfCpuTime() - startTime);
+            const uint64 elapsedNs    = ((elapsedTicks / frequency) * NsPerSec) +
+                                        (((elapsedTicks % frequency) * NsPerSec) / frequency);
+
+            if (elapsedNs >= timeout)
+            {
+                result = Result::Timeout;
+            }
+            else
+            {
+                const uint64 remainingMs = RoundUpQuotient(timeout - elapsedNs, NsPerMs);
+
+                nullDevice.FenceSignaledCond()->Wait(nullDevice.FenceLock(),
+                                                     static_cast<uint32>(Min<uint64>(remainingMs, WaitForever)));
+            }
+        }
+    }
+
+    return result;
 }
 
 } //NullDevice
@@ -36,28 +36,31 @@ namespace NullDevice
 {
 
 // =====================================================================================================================
-// Null device flavor of the Fence class.
+// Null device flavor of the Fence class. Null submissions complete as soon as they're made, so a fence is signaled
+// unless it has been reset and not submitted or signaled since.
 class Fence : public Pal::Fence
 {
 public:
-    Fence() {}
+    explicit Fence(const Device& device) : m_device(device), m_signaled(1) {}
     virtual ~Fence() {}
 
     virtual Result Init(
         const FenceCreateInfo& createInfo) override;
 
     // NOTE: Part of the public IFence interface.
-    virtual Result GetStatus() const override { return Result::Success; }
+    virtual Result GetStatus() const override { return (m_signaled != 0) ? Result::Success : Result::NotReady; }
 
     virtual Result OpenHandle(const FenceOpenInfo& openInfo) override { return Result::Unsupported; }
 
     virtual OsExternalHandle ExportExternalHandle(
         const FenceExportInfo& exportInfo) const override;
 
-    virtual void AssociateWithContext(Pal::SubmissionContext* pContext) override {}
+    virtual void AssociateWithContext(Pal::SubmissionContext* pContext) override { SetSignaled(true); }
 
     virtual Result Reset() override;
 
+    virtual Result Signal() override;
+
     virtual Result WaitForFences(
         const Pal::Device&      device,
         uint32                  fenceCount,
@@ -66,7 +69,12 @@ public:
         uint64                  timeout) const override;
 
 private:
+    void SetSignaled(bool signaled);
+
+    const Device&   m_device;
+    volatile uint32 m_signaled;
 
+    PAL_DISALLOW_DEFAULT_CTOR(Fence);
     PAL_DISALLOW_COPY_AND_ASSIGN(Fence);
 };
 
@@ -45,7 +45,7 @@ public:
     Platform(const PlatformCreateInfo& createInfo, const Util::AllocCallbacks& allocCb);
     virtual ~Platform() {}
 
-    virtual void Destroy() override { this->~Platform(); }
+    virtual void Destroy() override { Pal::Platform::Destroy(); }
 
     static Platform* CreateInstance(
         const PlatformCreateInfo&   createInfo,
@@ -106,14 +106,14 @@ Result Queue::OsWaitIdle()
 
 // =====================================================================================================================
 // Updates page mappings for one or more virtual GPU memory allocations.  But we don't have any page tables to bother
-// updating.
+// updating, so the fence can be signaled right away.
 Result Queue::RemapVirtualMemoryPages(
     uint32                         rangeCount,
     const VirtualMemoryRemapRange* pRangeList,
     bool                           doNotWait,
     IFence*                        pFence)
 {
-    return Result::Success;
+    return (pFence != nullptr) ? static_cast<Fence*>(pFence)->Signal() : Result::Success;
 }
 
 // =====================================================================================================================
@@ -27,8 +27,10 @@
 #include "core/platform.h"
 #include "core/settingsLoader.h"
 #include "core/os/nullDevice/ndPlatform.h"
+#include "palAllocProfiler.h"
 #include "palAssert.h"
 #include "palDbgPrint.h"
+#include "palSlabAllocator.h"
 #include "palSysMemory.h"
 
 #if PAL_BUILD_LAYERS
@@ -100,7 +102,9 @@ Platform::Platform(
     m_svmRangeStart(0),
     m_maxSvmSize(createInfo.maxSvmSize),
     m_logCb(),
-    m_eventProvider(this)
+    m_eventProvider(this),
+    m_pAllocProfiler(nullptr),
+    m_pSlabAllocator(nullptr)
 {
     memset(&m_pDevice[0], 0, sizeof(m_pDevice));
     memset(&m_properties, 0, sizeof(m_properties));
@@ -140,6 +144,27 @@ Platform::~Platform()
 #endif
 }
 
+// =====================================================================================================================
+// Destroys the platform and then the allocation wrappers it owns, which must outlive every allocation freed by the
+// platform's destructors.  Destroying the slab allocator returns all of its slabs to the client.
+void Platform::Destroy()
+{
+    Util::AllocProfiler*const pAllocProfiler = m_pAllocProfiler;
+    Util::SlabAllocator*const pSlabAllocator = m_pSlabAllocator;
+
+    this->~Platform();
+
+    if (pAllocProfiler != nullptr)
+    {
+        pAllocProfiler->Destroy();
+    }
+
+    if (pSlabAllocator != nullptr)
+    {
+        pSlabAllocator->Destroy();
+    }
+}
+
 // =====================================================================================================================
 // Creates and initializes the Platform singleton instance. This may result in additional DLL's being loaded (for
 // obtaining pointers to OS thunks on Windows, etc.) so it is very unsafe to call this from within a client driver's
@@ -316,6 +341,46 @@ Result Platform::GetProperties(
     return result;
 }
 
+// =====================================================================================================================
+Result Platform::WriteAllocProfilerReport(
+    const char* pFilename)
+{
+    Result result = Result::ErrorInvalidPointer;
+
+    if (m_pAllocProfiler == nullptr)
+    {
+        result = Result::ErrorUnavailable;
+    }
+    else if (pFilename != nullptr)
+    {
+        result = m_pAllocProfiler->WriteReport(pFilename);
+    }
+
+    return result;
+}
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 550
+// =====================================================================================================================
+Result Platform::GetSlabAllocatorStats(
+    Util::SlabAllocatorStats* pStats)
+{
+    Result result = Result::ErrorInvalidPointer;
+
+    if (m_pSlabAllocator == nullptr)
+    {
+        result = Result::ErrorUnavailable;
+    }
+    else if (pStats != nullptr)
+    {
+        m_pSlabAllocator->GetStats(pStats);
+
+        result = Result::Success;
+    }
+
+    return result;
+}
+#endif
+
 // =====================================================================================================================
 // Helper method which destroys all previously enumerated devices.
 void Platform::TearDownDevices()
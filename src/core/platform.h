@@ -49,6 +49,12 @@ namespace DevDriver
     }
 }
 
+namespace Util
+{
+class AllocProfiler;
+class SlabAllocator;
+}
+
 namespace Pal
 {
 
@@ -78,6 +84,9 @@ class Platform : public IPlatform
 public:
     virtual ~Platform();
 
+    // Part of the IDestroyable public interface.  OS-specific platforms which override this must finish by calling it.
+    virtual void Destroy() override;
+
     static size_t GetSize();
     static Result Create(
         const PlatformCreateInfo&   createInfo,
@@ -112,6 +121,14 @@ public:
     virtual Result GetProperties(
         PlatformProperties* pProperties) override;
 
+    virtual Result WriteAllocProfilerReport(
+        const char* pFilename) override;
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 550
+    virtual Result GetSlabAllocatorStats(
+        Util::SlabAllocatorStats* pStats) override;
+#endif
+
     Result ReEnumerateDevices();
 
     Device* GetDevice(uint32 index) const
@@ -165,6 +182,11 @@ public:
     void EnableEventLoggingToFile();
     void DisableEventLoggingToFile() { m_eventProvider.DisableFileLogging(); }
 
+    // Hands ownership of the objects which wrap this platform's allocation callbacks to the platform.  Either may be
+    // null.
+    void SetAllocWrappers(Util::SlabAllocator* pSlabAllocator, Util::AllocProfiler* pAllocProfiler)
+        { m_pSlabAllocator = pSlabAllocator; m_pAllocProfiler = pAllocProfiler; }
+
 protected:
     Platform(const PlatformCreateInfo& createInfo, const Util::AllocCallbacks& allocCb);
 
@@ -264,6 +286,12 @@ private:
     Util::LogCallbackInfo  m_logCb;
     EventProvider          m_eventProvider;
 
+    // Objects which wrap this platform's allocation callbacks: the profiler samples allocations and passes them on to
+    // the slab allocator, which serves small ones from slabs.  They're destroyed after the rest of the platform, in
+    // that order, since every allocation made through them must be freed first.
+    Util::AllocProfiler*   m_pAllocProfiler;
+    Util::SlabAllocator*   m_pSlabAllocator;
+
     PAL_DISALLOW_COPY_AND_ASSIGN(Platform);
 };
 
@@ -26,6 +26,7 @@
 #include "core/cmdBuffer.h"
 #include "core/fence.h"
 #include "core/cmdStream.h"
+#include "core/cmdStreamFlightRecorder.h"
 #include "core/device.h"
 #include "core/engine.h"
 #include "core/fence.h"
@@ -85,6 +86,9 @@ Queue::Queue(
     m_stalled(false),
     m_pWaitingSemaphore(nullptr),
     m_batchedSubmissionCount(0),
+    m_submitCoalesceLimit(pDevice->Settings().submitCoalesceLimit),
+    m_coalescedSubmitCount(0),
+    m_coalescedCmdBuffers(pDevice->GetPlatform()),
     m_batchedCmds(pDevice->GetPlatform()),
     m_deviceMembershipNode(this),
     m_engineMembershipNode(this),
@@ -344,6 +348,115 @@ Result Queue::Init(
     return result;
 }
 
+// =====================================================================================================================
+// Submits the client's command buffers, or holds them back to be merged with later submits if submit coalescing is
+// enabled.
+// NOTE: Part of the public IQueue interface.
+Result Queue::Submit(
+    const SubmitInfo& submitInfo)
+{
+    Result result = Result::Success;
+
+    if (CanCoalesceSubmit(submitInfo))
+    {
+        result = CoalesceSubmit(submitInfo);
+    }
+    else
+    {
+        result = FlushCoalescedSubmits();
+
+        if (result == Result::Success)
+        {
+            result = SubmitInternal(submitInfo, false);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Returns true if this submit only consists of command buffers, so it can be merged with the neighboring submits
+// without changing its meaning. Empty submits and submits with a fence are used by the client (and by PAL, e.g., the
+// present scheduler) to learn when earlier work is done, so they are never held back.
+bool Queue::CanCoalesceSubmit(
+    const SubmitInfo& submitInfo
+    ) const
+{
+    return (m_submitCoalesceLimit > 1)                  &&
+           (m_ifhMode == IfhModeDisabled)               &&
+           (submitInfo.cmdBufferCount       > 0)        &&
+           (submitInfo.pFence               == nullptr) &&
+           (submitInfo.pCmdBufInfoList      == nullptr) &&
+           (submitInfo.gpuMemRefCount       == 0)       &&
+           (submitInfo.doppRefCount         == 0)       &&
+           (submitInfo.externPhysMemCount   == 0)       &&
+           (submitInfo.blockIfFlippingCount == 0);
+}
+
+// =====================================================================================================================
+// Appends the submit's command buffers to the list of coalesced command buffers. The list is flushed as one submit
+// once it holds SubmitCoalesceLimit client submits. Validation is done up-front so that the client sees errors from the
+// offending submit.
+Result Queue::CoalesceSubmit(
+    const SubmitInfo& submitInfo)
+{
+    Result result = ValidateSubmit(submitInfo);
+
+    for (uint32 idx = 0; (result == Result::Success) && (idx < submitInfo.cmdBufferCount); ++idx)
+    {
+        ICmdBuffer*const pCmdBuffer = submitInfo.ppCmdBuffers[idx];
+
+        // The same command buffer can't appear twice in one submit (it may be chained to the next command buffer), so
+        // flush what we have if it has already been collected.
+        for (uint32 prevIdx = 0; prevIdx < m_coalescedCmdBuffers.NumElements(); ++prevIdx)
+        {
+            if (m_coalescedCmdBuffers.At(prevIdx) == pCmdBuffer)
+            {
+                result = FlushCoalescedSubmits();
+                break;
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            result = m_coalescedCmdBuffers.PushBack(pCmdBuffer);
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        m_coalescedSubmitCount++;
+
+        if (m_coalescedSubmitCount >= m_submitCoalesceLimit)
+        {
+            result = FlushCoalescedSubmits();
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Submits all coalesced command buffers as a single submit.
+Result Queue::FlushCoalescedSubmits()
+{
+    Result result = Result::Success;
+
+    if (m_coalescedCmdBuffers.NumElements() > 0)
+    {
+        SubmitInfo submitInfo     = {};
+        submitInfo.cmdBufferCount = m_coalescedCmdBuffers.NumElements();
+        submitInfo.ppCmdBuffers   = m_coalescedCmdBuffers.Data();
+
+        result = SubmitInternal(submitInfo, false);
+    }
+
+    m_coalescedCmdBuffers.Clear();
+    m_coalescedSubmitCount = 0;
+
+    return result;
+}
+
 // =====================================================================================================================
 // Submits a set of command buffers for execution on this Queue.
 Result Queue::SubmitInternal(
@@ -380,6 +493,13 @@ Result Queue::SubmitInternal(
     }
 #endif
 
+    CmdStreamFlightRecorder*const pFlightRecorder = m_pDevice->FlightRecorder();
+
+    if ((result == Result::Success) && (pFlightRecorder != nullptr))
+    {
+        pFlightRecorder->RecordSubmit(*this, submitInfo, internalSubmitInfo);
+    }
+
     if (result == Result::Success)
     {
         if (m_ifhMode == IfhModeDisabled)
@@ -414,6 +534,10 @@ Result Queue::SubmitInternal(
     {
         m_pQueueContext->PostProcessSubmit();
     }
+    else if ((result == Result::ErrorDeviceLost) && (pFlightRecorder != nullptr))
+    {
+        pFlightRecorder->DumpOnDeviceLost("device lost on submit");
+    }
 
     return result;
 }
@@ -452,7 +576,7 @@ void Queue::DumpCmdToFile(
         constexpr uint32 MaxFilenameLength = 512;
 
         char filename[MaxFilenameLength] = {};
-        File logFile;
+        BufferedFile logFile;
 
         // Multiple submissions of one frame
         if (m_lastFrameCnt == frameCnt)
@@ -710,7 +834,8 @@ void Queue::DestroyTrackedCmdBuffer(
 // NOTE: Part of the public IQueue interface.
 Result Queue::WaitIdle()
 {
-    Result result = Result::Success;
+    // Any coalesced submits must reach the OS before we can wait for them.
+    Result result = FlushCoalescedSubmits();
 
     // If this queue is blocked by a semaphore, this will spin loop until all batched submissions have been processed.
     while (m_batchedSubmissionCount > 0)
@@ -721,7 +846,9 @@ Result Queue::WaitIdle()
 
     // When we get here, all batched operations (if there were any) have been processed, so wait for the OS-specific
     // Queue to become idle.
-    return OsWaitIdle();
+    const Result waitResult = OsWaitIdle();
+
+    return (result == Result::Success) ? waitResult : result;
 }
 
 // =====================================================================================================================
@@ -735,11 +862,16 @@ Result Queue::SignalQueueSemaphoreInternal(
 {
     QueueSemaphore*const pSemaphore = static_cast<QueueSemaphore*>(pQueueSemaphore);
 
-    Result result = Result::Success;
+    // The signal must follow any coalesced submits, otherwise a queue waiting on it could run ahead of their work.
+    Result result = postBatching ? Result::Success : FlushCoalescedSubmits();
 
     // Either signal the semaphore immediately, or enqueue it for later, depending on whether or not we are stalled
     // and/or the caller is a function after the batching logic and thus must execute immediately.
-    if (postBatching || (m_stalled == false))
+    if (result != Result::Success)
+    {
+        // Nothing else to do.
+    }
+    else if (postBatching || (m_stalled == false))
     {
         // The Semaphore object is responsible for notifying any stalled Queues which may get released by this signal
         // operation.
@@ -781,11 +913,16 @@ Result Queue::WaitQueueSemaphoreInternal(
 {
     QueueSemaphore*const pSemaphore = static_cast<QueueSemaphore*>(pQueueSemaphore);
 
-    Result result = Result::Success;
+    // Coalesced submits were issued before this wait so they must not be held back by it.
+    Result result = postBatching ? Result::Success : FlushCoalescedSubmits();
 
     // Either wait on the semaphore immediately, or enqueue it for later, depending on whether or not we are stalled
     // and/or the caller is a function after the batching logic and thus must execute immediately.
-    if (postBatching || (m_stalled == false))
+    if (result != Result::Success)
+    {
+        // Nothing else to do.
+    }
+    else if (postBatching || (m_stalled == false))
     {
         // If this Queue isn't stalled yet, we can execute the wait immediately (which, of course, could stall
         // this Queue).
@@ -823,11 +960,15 @@ Result Queue::PresentDirectInternal(
     const PresentDirectInfo& presentInfo,
     bool                     isClientPresent)
 {
-
-    Result result = Result::Success;
+    // The presented image may have been rendered by coalesced submits.
+    Result result = FlushCoalescedSubmits();
 
     // Check if our queue supports the given present mode.
-    if (IsPresentModeSupported(presentInfo.presentMode) == false)
+    if (result != Result::Success)
+    {
+        // Nothing else to do.
+    }
+    else if (IsPresentModeSupported(presentInfo.presentMode) == false)
     {
         if ((presentInfo.presentMode == PresentMode::Windowed) && (m_pDevice->IsMasterGpu() == false))
         {
@@ -895,7 +1036,8 @@ Result Queue::PresentDirectInternal(
 Result Queue::PresentSwapChain(
     const PresentSwapChainInfo& presentInfo)
 {
-    Result result = Result::Success;
+    // The presented image may have been rendered by coalesced submits.
+    Result result = FlushCoalescedSubmits();
 
     const auto*const  pSrcImage       = static_cast<const Image*>(presentInfo.pSrcImage);
     const Image*const pPresentedImage =
@@ -905,7 +1047,11 @@ Result Queue::PresentSwapChain(
 
     // Validate the present info. If this succeeds we must always call into the swap chain to release ownership of the
     // image index. Otherwise, the application will deadlock on AcquireNextImage at some point in the future.
-    if ((pSrcImage == nullptr) || (pSwapChain == nullptr))
+    if (result != Result::Success)
+    {
+        // Nothing else to do.
+    }
+    else if ((pSrcImage == nullptr) || (pSwapChain == nullptr))
     {
         result = Result::ErrorInvalidPointer;
     }
@@ -1026,9 +1172,10 @@ Result Queue::DelayAfterVsync(
 Result Queue::AssociateFenceWithLastSubmit(
     IFence* pFence)
 {
-    Result result = Result::ErrorInvalidPointer;
+    // The client's last submit may still be held back by submit coalescing.
+    Result result = (pFence != nullptr) ? FlushCoalescedSubmits() : Result::ErrorInvalidPointer;
 
-    if (pFence != nullptr)
+    if (result == Result::Success)
     {
         auto*const pCoreFence = static_cast<Fence*>(pFence);
 
@@ -30,6 +30,7 @@
 #include "palDeque.h"
 #include "palIntrusiveList.h"
 #include "palMutex.h"
+#include "palVector.h"
 
 namespace Pal
 {
@@ -174,8 +175,7 @@ public:
     virtual Result Init(void* pContextPlacementAddr);
 
     // NOTE: Part of the public IQueue interface.
-    virtual Result Submit(const SubmitInfo& submitInfo) override
-        { return SubmitInternal(submitInfo, false); }
+    virtual Result Submit(const SubmitInfo& submitInfo) override;
 
     // A special version of Submit with PAL-internal arguments.
     Result SubmitInternal(const SubmitInfo& submitInfo, bool postBatching);
@@ -293,6 +293,10 @@ protected:
 
     Result SubmitFence(IFence* pFence);
 
+    // Submits any command buffers held back by submit coalescing. Every queue operation which must be ordered after
+    // previous submits has to call this first.
+    Result FlushCoalescedSubmits();
+
     bool IsMinClockRequired() const { return false; }
 
 #if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 518
@@ -352,6 +356,8 @@ private:
 #endif
 
     Result ValidateSubmit(const SubmitInfo& submitInfo) const;
+    bool   CanCoalesceSubmit(const SubmitInfo& submitInfo) const;
+    Result CoalesceSubmit(const SubmitInfo& submitInfo);
     Result EnqueueSubmit(
         const SubmitInfo&         submitInfo,
         const InternalSubmitInfo& internalSubmitInfo);
@@ -382,6 +388,12 @@ private:
 
     volatile uint32   m_batchedSubmissionCount; // How many batched submissions will be sent to OS layer later on.
 
+    // When SubmitCoalesceLimit is greater than one, the command buffers of simple client submits are collected here
+    // and sent to SubmitInternal() together to save per-submit kernel overhead.
+    const uint32                            m_submitCoalesceLimit;
+    uint32                                  m_coalescedSubmitCount;
+    Util::Vector<ICmdBuffer*, 16, Platform> m_coalescedCmdBuffers;
+
     Util::Deque<BatchedQueueCmdData, Platform>  m_batchedCmds;
     Util::Mutex                                 m_batchedCmdsLock;
 
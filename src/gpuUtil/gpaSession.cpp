@@ -40,6 +40,7 @@
 #include "palVectorImpl.h"
 #include "sqtt_file_format.h"
 #include <ctime>
+#include <cstdlib>
 
 using namespace Pal;
 
@@ -419,13 +420,10 @@ GpaSession::GpaSession(
     m_busyLocalInvisGpuMem(m_pPlatform),
     m_sampleItemArray(m_pPlatform),
     m_pAvailablePerfExpMem(pAvailablePerfExpMem),
-    m_registeredPipelines(512, m_pPlatform),
-    m_registeredApiPsos(512, m_pPlatform),
+    m_pRegistrationShards(nullptr),
     m_codeObjectRecordsCache(m_pPlatform),
     m_curCodeObjectRecords(m_pPlatform),
-    m_codeObjectLoadEventRecordsCache(m_pPlatform),
     m_curCodeObjectLoadEventRecords(m_pPlatform),
-    m_psoCorrelationRecordsCache(m_pPlatform),
     m_curPsoCorrelationRecords(m_pPlatform),
     m_shaderRecordsCache(m_pPlatform),
     m_curShaderRecords(m_pPlatform),
@@ -558,6 +556,74 @@ GpaSession::~GpaSession()
 
         PAL_SAFE_FREE(shaderRecord.pRecord, m_pPlatform);
     }
+
+    DestroyRegistrationShards();
+}
+
+// =====================================================================================================================
+GpaSession::RegistrationShard::RegistrationShard(
+    GpaAllocator* pAllocator)
+    :
+    registeredPipelines(64, pAllocator),
+    registeredApiPsos(64, pAllocator),
+    loadEventRecords(pAllocator),
+    psoCorrelationRecords(pAllocator)
+{
+}
+
+// =====================================================================================================================
+// Allocates and initializes the pipeline registration shards.
+Result GpaSession::InitRegistrationShards()
+{
+    Result result = Result::ErrorOutOfMemory;
+
+    const size_t shardBytes = sizeof(RegistrationShard) * RegistrationShardCount;
+
+    m_pRegistrationShards = static_cast<RegistrationShard*>(PAL_MALLOC(shardBytes,
+                                                                       m_pPlatform,
+                                                                       Util::SystemAllocType::AllocInternal));
+
+    if (m_pRegistrationShards != nullptr)
+    {
+        result = Result::Success;
+
+        for (uint32 i = 0; i < RegistrationShardCount; ++i)
+        {
+            PAL_PLACEMENT_NEW(&m_pRegistrationShards[i]) RegistrationShard(m_pPlatform);
+        }
+
+        for (uint32 i = 0; (result == Result::Success) && (i < RegistrationShardCount); ++i)
+        {
+            RegistrationShard*const pShard = &m_pRegistrationShards[i];
+
+            result = pShard->lock.Init();
+
+            if (result == Result::Success)
+            {
+                result = pShard->registeredPipelines.Init();
+            }
+            if (result == Result::Success)
+            {
+                result = pShard->registeredApiPsos.Init();
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void GpaSession::DestroyRegistrationShards()
+{
+    if (m_pRegistrationShards != nullptr)
+    {
+        for (uint32 i = 0; i < RegistrationShardCount; ++i)
+        {
+            m_pRegistrationShards[i].~RegistrationShard();
+        }
+
+        PAL_SAFE_FREE(m_pRegistrationShards, m_pPlatform);
+    }
 }
 
 // =====================================================================================================================
@@ -584,13 +650,10 @@ GpaSession::GpaSession(
     m_busyLocalInvisGpuMem(m_pPlatform),
     m_sampleItemArray(m_pPlatform),
     m_pAvailablePerfExpMem(src.m_pAvailablePerfExpMem),
-    m_registeredPipelines(512, m_pPlatform),
-    m_registeredApiPsos(512, m_pPlatform),
+    m_pRegistrationShards(nullptr),
     m_codeObjectRecordsCache(m_pPlatform),
     m_curCodeObjectRecords(m_pPlatform),
-    m_codeObjectLoadEventRecordsCache(m_pPlatform),
     m_curCodeObjectLoadEventRecords(m_pPlatform),
-    m_psoCorrelationRecordsCache(m_pPlatform),
     m_curPsoCorrelationRecords(m_pPlatform),
     m_shaderRecordsCache(m_pPlatform),
     m_curShaderRecords(m_pPlatform),
@@ -656,9 +719,9 @@ Result GpaSession::Init()
         CmdAllocatorCreateInfo createInfo = { };
         createInfo.flags.threadSafe       = 1;
 
-        // Reasonable constants for allocation and suballocation sizes
-        constexpr size_t CmdAllocSize = 2 * 1024 * 1024;
-        constexpr size_t CmdSubAllocSize = 64 * 1024;
+        // Each timing command buffer only writes a single timestamp, so the smallest legal suballocation is plenty.
+        constexpr size_t CmdAllocSize = 256 * 1024;
+        constexpr size_t CmdSubAllocSize = 4 * 1024;
 
         createInfo.allocInfo[CommandDataAlloc].allocHeap      = GpuHeapGartUswc;
         createInfo.allocInfo[CommandDataAlloc].allocSize      = CmdAllocSize;
@@ -714,11 +777,7 @@ Result GpaSession::Init()
     }
     if (result == Result::Success)
     {
-        result = m_registeredPipelines.Init();
-    }
-    if (result == Result::Success)
-    {
-        result = m_registeredApiPsos.Init();
+        result = InitRegistrationShards();
     }
 
     // CopySession specific work
@@ -748,12 +807,16 @@ Result GpaSession::Init()
                 m_codeObjectRecordsCache.PushBack(*iter.Get());
             }
 
-            // Copy code object load event database from srcSession
-            for (auto iter = m_pSrcSession->m_codeObjectLoadEventRecordsCache.Begin();
-                 iter.Get() != nullptr;
-                 iter.Next())
+            // Copy code object load event database from srcSession.
+            for (uint32 i = 0; i < RegistrationShardCount; ++i)
             {
-                m_codeObjectLoadEventRecordsCache.PushBack(*iter.Get());
+                RegistrationShard*const pSrcShard = &m_pSrcSession->m_pRegistrationShards[i];
+                Util::MutexAuto         shardLock(&pSrcShard->lock);
+
+                for (auto iter = pSrcShard->loadEventRecords.Begin(); iter.Get() != nullptr; iter.Next())
+                {
+                    m_pRegistrationShards[i].loadEventRecords.PushBack(*iter.Get());
+                }
             }
 
             // Copy shader ISA database from srcSession
@@ -827,9 +890,9 @@ Pal::Result GpaSession::RegisterTimedQueue(
         // Create a new TimedQueueState struct
         // Pack all the required data into one chunk of memory to avoid handling multiple cases of memory allocation
         // failure.
-        const Pal::gpusize cmdBufferListSize = sizeof(Util::Deque<Pal::ICmdBuffer*, GpaAllocator>);
+        const Pal::gpusize slotBlockListSize = sizeof(Util::Vector<TimedQueueSlotBlock*, 4, GpaAllocator>);
         TimedQueueState* pTimedQueueState = static_cast<TimedQueueState*>(
-            PAL_CALLOC(sizeof(TimedQueueState) + (cmdBufferListSize * 2) + fenceSize,
+            PAL_CALLOC(sizeof(TimedQueueState) + slotBlockListSize + fenceSize,
                        m_pPlatform,
                        Util::AllocObject));
 
@@ -841,26 +904,21 @@ Pal::Result GpaSession::RegisterTimedQueue(
             pTimedQueueState->queueType = pQueue->Type();
             pTimedQueueState->engineType = pQueue->GetEngineType();
             pTimedQueueState->valid = true;
-            pTimedQueueState->pAvailableCmdBuffers =
+            pTimedQueueState->nextSlot = 0;
+            pTimedQueueState->pSlotBlocks =
                 PAL_PLACEMENT_NEW(Util::VoidPtrInc(pTimedQueueState, sizeof(TimedQueueState)))
-                Util::Deque<Pal::ICmdBuffer*, GpaAllocator>(m_pPlatform);
-
-            pTimedQueueState->pBusyCmdBuffers =
-                PAL_PLACEMENT_NEW(Util::VoidPtrInc(pTimedQueueState->pAvailableCmdBuffers, cmdBufferListSize))
-                Util::Deque<Pal::ICmdBuffer*, GpaAllocator>(m_pPlatform);
+                Util::Vector<TimedQueueSlotBlock*, 4, GpaAllocator>(m_pPlatform);
 
             Pal::FenceCreateInfo createInfo = {};
             createInfo.flags.signaled       = 1;
             result = m_pDevice->CreateFence(createInfo,
-                                            Util::VoidPtrInc(pTimedQueueState->pBusyCmdBuffers, cmdBufferListSize),
+                                            Util::VoidPtrInc(pTimedQueueState->pSlotBlocks, slotBlockListSize),
                                             &pTimedQueueState->pFence);
 
-            // Preallocate some command buffers to reduce the latency of the first trace.
-            constexpr uint32 NumPreallocatedCmdBuffers = 8;
-
+            // Preallocate the first block of timing slots to reduce the latency of the first trace.
             if (result == Result::Success)
             {
-                result = PreallocateTimedQueueCmdBuffers(pTimedQueueState, NumPreallocatedCmdBuffers);
+                result = GrowTimedQueueSlots(pTimedQueueState);
             }
 
             if (result == Result::Success)
@@ -899,6 +957,7 @@ Pal::Result GpaSession::UnregisterTimedQueue(
 
         // Reset + Destroy the fence, then invalidate the pointer.
         PAL_ASSERT(pQueueState->pFence->GetStatus() == Result::Success);
+        UntrackTimedQueueFence(pQueueState);
         result = m_pDevice->ResetFences(1, &pQueueState->pFence);
         PAL_ASSERT(result == Pal::Result::Success);
         pQueueState->pFence->Destroy();
@@ -908,21 +967,11 @@ Pal::Result GpaSession::UnregisterTimedQueue(
 
     if (result == Result::Success)
     {
-        // Move all cmdbuffers into the available list
-        result = RecycleTimedQueueCmdBuffers(pQueueState);
-        PAL_ASSERT(result == Pal::Result::Success);
-
-        // Destroy all measurement command buffers
-        while (pQueueState->pAvailableCmdBuffers->NumElements() > 0)
+        // Destroy all measurement command buffers. The timestamp memory is kept until the queue state is destroyed
+        // because the current session's results may still need to read it.
+        for (uint32 blockIndex = 0; blockIndex < pQueueState->pSlotBlocks->NumElements(); ++blockIndex)
         {
-            Pal::ICmdBuffer* pCmdBuffer = nullptr;
-            result = pQueueState->pAvailableCmdBuffers->PopFront(&pCmdBuffer);
-            PAL_ASSERT(result == Pal::Result::Success);
-
-            PAL_ASSERT(pCmdBuffer != nullptr);
-
-            pCmdBuffer->Destroy();
-            PAL_SAFE_FREE(pCmdBuffer, m_pPlatform);
+            DestroyTimedQueueSlotCmdBuffers(pQueueState->pSlotBlocks->At(blockIndex));
         }
     }
     return result;
@@ -945,178 +994,79 @@ Pal::Result GpaSession::TimedSubmit(
         result = FindTimedQueue(pQueue, &pQueueState, &queueIndex);
     }
 
-    if (result == Pal::Result::Success)
+    if ((result == Pal::Result::Success) &&
+        (HasFreeTimedQueueSlots(pQueueState, submitInfo.cmdBufferCount) == false))
     {
-        // Acquire command buffers
-        const uint32 numCmdBuffersRequired = (submitInfo.cmdBufferCount + 1);
+        // The timestamp ring has reached its size limit for this session, so submit the work without timing it.
+        result = pQueue->Submit(submitInfo);
+    }
+    else if (result == Pal::Result::Success)
+    {
+        Util::Vector<Pal::ICmdBuffer*, 24, GpaAllocator>   patchedCmdBufferList(m_pPlatform);
+        Util::Vector<Pal::CmdBufInfo, 24, GpaAllocator>    patchedCmdBufInfoList(m_pPlatform);
+        Util::Vector<TimedQueueEventItem, 8, GpaAllocator> timedQueueEvents(m_pPlatform);
 
-        Util::Vector<Pal::ICmdBuffer*, 8, GpaAllocator> cmdBufferList(m_pPlatform);
+        // Sample the current cpu time before gathering the timing command buffers.
+        const uint64 cpuTimestamp = static_cast<uint64>(Util::GetPerfCpuTime());
 
-        for (uint32 cmdBufIndex = 0; cmdBufIndex < numCmdBuffersRequired; ++cmdBufIndex)
+        // Each command buffer is bracketed by the prerecorded command buffers of its own timing slot. Submissions to a
+        // queue are externally synchronized, so the queue's slots can be acquired without taking any locks.
+        for (uint32 cmdBufIndex = 0; cmdBufIndex < submitInfo.cmdBufferCount; ++cmdBufIndex)
         {
-            Pal::ICmdBuffer* pCmdBuffer = nullptr;
-            result = AcquireTimedQueueCmdBuffer(pQueueState, &pCmdBuffer);
+            TimedQueueSlotBlock* pBlock         = nullptr;
+            uint32               slotIndex      = 0;
+            Pal::ICmdBuffer*     pPreCmdBuffer  = nullptr;
+            Pal::ICmdBuffer*     pPostCmdBuffer = nullptr;
+
+            result = AcquireTimedQueueSlot(pQueueState, &pBlock, &slotIndex);
 
             if (result == Pal::Result::Success)
             {
-                result = cmdBufferList.PushBack(pCmdBuffer);
+                result = GetTimedQueueSlotCmdBuffer(pQueueState, pBlock, slotIndex, false, &pPreCmdBuffer);
             }
 
-            if (result != Pal::Result::Success)
+            if (result == Pal::Result::Success)
             {
-                break;
+                result = GetTimedQueueSlotCmdBuffer(pQueueState, pBlock, slotIndex, true, &pPostCmdBuffer);
             }
-        }
-
-        Util::Vector<GpuMemoryInfo, 8, GpaAllocator> timestampMemoryInfoList(m_pPlatform);
-        Util::Vector<Pal::gpusize, 8, GpaAllocator> timestampMemoryOffsetList(m_pPlatform);
-
-        if (result == Pal::Result::Success)
-        {
-            // Acquire timestamp memory
-            const uint32 numTimestampsRequired = (2 * submitInfo.cmdBufferCount);
 
-            for (uint32 timestampIndex = 0; timestampIndex < numTimestampsRequired; ++timestampIndex)
+            // If this submit contains command buffer info structs, we need to insert dummy structs for each of the
+            // timing command buffers.
+            if ((result == Pal::Result::Success) && (submitInfo.pCmdBufInfoList != nullptr))
             {
-                GpuMemoryInfo memoryInfo = {};
-                Pal::gpusize memoryOffset = 0;
+                Pal::CmdBufInfo dummyCmdBufInfo = {};
+                dummyCmdBufInfo.isValid = 0;
 
-                result = AcquireGpuMem(sizeof(uint64),
-                                       m_timestampAlignment,
-                                       Pal::GpuHeapGartCacheable,
-                                       &memoryInfo,
-                                       &memoryOffset);
+                result = patchedCmdBufInfoList.PushBack(dummyCmdBufInfo);
 
                 if (result == Pal::Result::Success)
                 {
-                    result = timestampMemoryInfoList.PushBack(memoryInfo);
+                    result = patchedCmdBufInfoList.PushBack(submitInfo.pCmdBufInfoList[cmdBufIndex]);
                 }
 
                 if (result == Pal::Result::Success)
                 {
-                    result = timestampMemoryOffsetList.PushBack(memoryOffset);
-                }
-
-                if (result != Pal::Result::Success)
-                {
-                    break;
+                    result = patchedCmdBufInfoList.PushBack(dummyCmdBufInfo);
                 }
             }
-        }
-
-        if (result == Pal::Result::Success)
-        {
-            Util::Vector<Pal::ICmdBuffer*, 8, GpaAllocator> patchedCmdBufferList(m_pPlatform);
-            Util::Vector<Pal::CmdBufInfo, 8, GpaAllocator> patchedCmdBufInfoList(m_pPlatform);
 
-            for (uint32 cmdBufIndex = 0; cmdBufIndex < submitInfo.cmdBufferCount; ++cmdBufIndex)
+            if (result == Pal::Result::Success)
             {
-                const Pal::uint32 baseIndex                   = cmdBufIndex * 2;
-                const GpuMemoryInfo* pPreTimestampMemoryInfo  = &timestampMemoryInfoList.At(baseIndex);
-                const GpuMemoryInfo* pPostTimestampMemoryInfo = &timestampMemoryInfoList.At(baseIndex + 1);
-                const Pal::gpusize preTimestampOffset         = timestampMemoryOffsetList.At(baseIndex);
-                const Pal::gpusize postTimestampOffset        = timestampMemoryOffsetList.At(baseIndex + 1);
-
-                Pal::ICmdBuffer* pPreCmdBuffer  = cmdBufferList.At(cmdBufIndex);
-                Pal::ICmdBuffer* pCurCmdBuffer  = submitInfo.ppCmdBuffers[cmdBufIndex];
-                Pal::ICmdBuffer* pPostCmdBuffer = cmdBufferList.At(cmdBufIndex + 1);
-
-                // Sample the current cpu time before building the timing command buffers.
-                const uint64 cpuTimestamp = static_cast<uint64>(Util::GetPerfCpuTime());
-
-                // Pre Command Buffer
-
-                Pal::CmdBufferBuildInfo buildInfo     = {};
-                buildInfo.flags.optimizeOneTimeSubmit = 1;
-
-                // Only the first cmdbuffer needs to begin the pre-cmdbuffer.
-                if (result == Pal::Result::Success)
-                {
-                    if (cmdBufIndex == 0)
-                    {
-                        result = pPreCmdBuffer->Begin(buildInfo);
-                    }
-                }
-
-                if (result == Pal::Result::Success)
-                {
-                    // The gpu memory pointer should never be null.
-                    PAL_ASSERT(pPreTimestampMemoryInfo->pGpuMemory != nullptr);
-
-                    pPreCmdBuffer->CmdWriteTimestamp(Pal::HwPipeTop,
-                                                     *pPreTimestampMemoryInfo->pGpuMemory,
-                                                     preTimestampOffset);
-
-                    result = pPreCmdBuffer->End();
-                }
-
-                // Post Command Buffer
-
-                if (result == Pal::Result::Success)
-                {
-                    result = pPostCmdBuffer->Begin(buildInfo);
-                }
-
-                if (result == Pal::Result::Success)
-                {
-                    // The gpu memory pointer should never be null.
-                    PAL_ASSERT(pPostTimestampMemoryInfo->pGpuMemory != nullptr);
-
-                    pPostCmdBuffer->CmdWriteTimestamp(Pal::HwPipeBottom,
-                                                      *pPostTimestampMemoryInfo->pGpuMemory,
-                                                      postTimestampOffset);
-
-                    // Only the last cmdbuffer needs to end the post-cmdbuffer.
-                    if (cmdBufIndex == (submitInfo.cmdBufferCount - 1))
-                    {
-                        result = pPostCmdBuffer->End();
-                    }
-                }
-
-                // If this submit contains command buffer info structs, we need to insert dummy structs for each of
-                // the timing command buffers.
-                if (submitInfo.pCmdBufInfoList != nullptr)
-                {
-                    Pal::CmdBufInfo dummyCmdBufInfo = {};
-                    dummyCmdBufInfo.isValid = 0;
-
-                    // We only need to add a dummy command buffer info struct before the real one if this is the first
-                    // command buffer in the list.
-                    if ((result == Pal::Result::Success) && (cmdBufIndex == 0))
-                    {
-                        result = patchedCmdBufInfoList.PushBack(dummyCmdBufInfo);
-                    }
-
-                    if (result == Pal::Result::Success)
-                    {
-                        result = patchedCmdBufInfoList.PushBack(submitInfo.pCmdBufInfoList[cmdBufIndex]);
-                    }
-
-                    if (result == Pal::Result::Success)
-                    {
-                        result = patchedCmdBufInfoList.PushBack(dummyCmdBufInfo);
-                    }
-                }
-
-                if (result == Pal::Result::Success)
-                {
-                    // Only the first cmdbuffer needs to add the pre-cmdbuffer.
-                    if (cmdBufIndex == 0)
-                    {
-                        result = patchedCmdBufferList.PushBack(pPreCmdBuffer);
-                    }
-                }
+                result = patchedCmdBufferList.PushBack(pPreCmdBuffer);
+            }
 
-                if (result == Pal::Result::Success)
-                {
-                    result = patchedCmdBufferList.PushBack(pCurCmdBuffer);
-                }
+            if (result == Pal::Result::Success)
+            {
+                result = patchedCmdBufferList.PushBack(submitInfo.ppCmdBuffers[cmdBufIndex]);
+            }
 
-                if (result == Pal::Result::Success)
-                {
-                    result = patchedCmdBufferList.PushBack(pPostCmdBuffer);
-                }
+            if (result == Pal::Result::Success)
+            {
+                result = patchedCmdBufferList.PushBack(pPostCmdBuffer);
+            }
 
+            if (result == Pal::Result::Success)
+            {
                 TimedQueueEventItem timedQueueEvent = {};
                 timedQueueEvent.eventType           = TimedQueueEventType::Submit;
                 timedQueueEvent.cpuTimestamp        = cpuTimestamp;
@@ -1130,45 +1080,59 @@ Pal::Result GpaSession::TimedSubmit(
                 timedQueueEvent.queueIndex               = queueIndex;
                 timedQueueEvent.frameIndex               = timedSubmitInfo.frameIndex;
                 timedQueueEvent.submitSubIndex           = cmdBufIndex;
-                timedQueueEvent.gpuTimestamps.memInfo[0] = *pPreTimestampMemoryInfo;
-                timedQueueEvent.gpuTimestamps.memInfo[1] = *pPostTimestampMemoryInfo;
-                timedQueueEvent.gpuTimestamps.offsets[0] = preTimestampOffset;
-                timedQueueEvent.gpuTimestamps.offsets[1] = postTimestampOffset;
-
-                if (result == Pal::Result::Success)
-                {
-                    Util::MutexAuto eventsLock(&m_queueEventsLock);
-                    result = m_queueEvents.PushBack(timedQueueEvent);
-                }
+                timedQueueEvent.gpuTimestamps.memInfo[0] = pBlock->memInfo;
+                timedQueueEvent.gpuTimestamps.memInfo[1] = pBlock->memInfo;
+                timedQueueEvent.gpuTimestamps.offsets[0] = TimedQueueSlotOffset(slotIndex, false);
+                timedQueueEvent.gpuTimestamps.offsets[1] = TimedQueueSlotOffset(slotIndex, true);
 
-                if (result != Pal::Result::Success)
-                {
-                    break;
-                }
+                result = timedQueueEvents.PushBack(timedQueueEvent);
             }
 
-            if (result == Pal::Result::Success)
+            if (result != Pal::Result::Success)
             {
-                result = m_pDevice->ResetFences(1, &pQueueState->pFence);
+                break;
             }
+        }
 
-            if (result == Pal::Result::Success)
-            {
-                Pal::SubmitInfo patchedSubmitInfo = submitInfo;
-                patchedSubmitInfo.cmdBufferCount = patchedCmdBufferList.NumElements();
-                patchedSubmitInfo.ppCmdBuffers = &patchedCmdBufferList.At(0);
+        if (result == Pal::Result::Success)
+        {
+            UntrackTimedQueueFence(pQueueState);
+            result = m_pDevice->ResetFences(1, &pQueueState->pFence);
+        }
 
-                if (submitInfo.pCmdBufInfoList != nullptr)
-                {
-                    patchedSubmitInfo.pCmdBufInfoList = &patchedCmdBufInfoList.At(0);
-                }
+        if (result == Pal::Result::Success)
+        {
+            Pal::SubmitInfo patchedSubmitInfo = submitInfo;
+            patchedSubmitInfo.cmdBufferCount = patchedCmdBufferList.NumElements();
+            patchedSubmitInfo.ppCmdBuffers = &patchedCmdBufferList.At(0);
 
-                result = pQueue->Submit(patchedSubmitInfo);
+            if (submitInfo.pCmdBufInfoList != nullptr)
+            {
+                patchedSubmitInfo.pCmdBufInfoList = &patchedCmdBufInfoList.At(0);
             }
 
-            if (result == Pal::Result::Success)
+            result = pQueue->Submit(patchedSubmitInfo);
+        }
+
+        if (result == Pal::Result::Success)
+        {
+            result = pQueue->AssociateFenceWithLastSubmit(pQueueState->pFence);
+        }
+
+        if (result == Pal::Result::Success)
+        {
+            TrackTimedQueueFence(pQueueState);
+        }
+
+        if (result == Pal::Result::Success)
+        {
+            Util::MutexAuto eventsLock(&m_queueEventsLock);
+
+            for (uint32 eventIndex = 0;
+                 (result == Pal::Result::Success) && (eventIndex < timedQueueEvents.NumElements());
+                 ++eventIndex)
             {
-                result = pQueue->AssociateFenceWithLastSubmit(pQueueState->pFence);
+                result = m_queueEvents.PushBack(timedQueueEvents.At(eventIndex));
             }
         }
     }
@@ -1272,50 +1236,29 @@ Pal::Result GpaSession::TimedQueuePresent(
         result = FindTimedQueue(pQueue, &pQueueState, &queueIndex);
     }
 
-    // Sample the current cpu time before building the command buffer.
-    const uint64 cpuTimestamp = static_cast<uint64>(Util::GetPerfCpuTime());
+    // Presents are simply not measured once the timestamp ring has reached its size limit for this session.
+    const bool isMeasured = (result == Pal::Result::Success) && HasFreeTimedQueueSlots(pQueueState, 1);
 
-    // Acquire a measurement command buffer
-    Pal::ICmdBuffer* pCmdBuffer = nullptr;
-    if (result == Pal::Result::Success)
-    {
-        result = AcquireTimedQueueCmdBuffer(pQueueState, &pCmdBuffer);
-    }
-
-    // Acquire memory for the timestamp and a fence to track when the queue semaphore operation completes.
-    GpuMemoryInfo timestampMemoryInfo   = { };
-    Pal::gpusize  timestampMemoryOffset = 0;
-    if (result == Pal::Result::Success)
-    {
-        result = AcquireGpuMem(sizeof(uint64),
-                               m_timestampAlignment,
-                               Pal::GpuHeapGartCacheable,
-                               &timestampMemoryInfo,
-                               &timestampMemoryOffset);
-    }
+    // Sample the current cpu time before acquiring the command buffer.
+    const uint64 cpuTimestamp = static_cast<uint64>(Util::GetPerfCpuTime());
 
-    // Begin the measurement command buffer
-    if (result == Pal::Result::Success)
+    // Acquire a timing slot; its top-of-pipe timestamp command buffer measures the present.
+    TimedQueueSlotBlock* pBlock     = nullptr;
+    uint32               slotIndex  = 0;
+    Pal::ICmdBuffer*     pCmdBuffer = nullptr;
+    if (isMeasured)
     {
-        Pal::CmdBufferBuildInfo buildInfo     = {};
-        buildInfo.flags.optimizeOneTimeSubmit = 1;
-
-        result = pCmdBuffer->Begin(buildInfo);
+        result = AcquireTimedQueueSlot(pQueueState, &pBlock, &slotIndex);
     }
 
-    // Record the commands for the measurement buffer and close it
-    if (result == Pal::Result::Success)
+    if (isMeasured && (result == Pal::Result::Success))
     {
-        // The gpu memory pointer should never be null.
-        PAL_ASSERT(timestampMemoryInfo.pGpuMemory != nullptr);
-
-        pCmdBuffer->CmdWriteTimestamp(Pal::HwPipeTop, *timestampMemoryInfo.pGpuMemory, timestampMemoryOffset);
-
-        result = pCmdBuffer->End();
+        result = GetTimedQueueSlotCmdBuffer(pQueueState, pBlock, slotIndex, false, &pCmdBuffer);
     }
 
-    if (result == Pal::Result::Success)
+    if (isMeasured && (result == Pal::Result::Success))
     {
+        UntrackTimedQueueFence(pQueueState);
         result = m_pDevice->ResetFences(1, &pQueueState->pFence);
     }
 
@@ -1330,7 +1273,12 @@ Pal::Result GpaSession::TimedQueuePresent(
         result = pQueue->Submit(submitInfo);
     }
 
-    if (result == Pal::Result::Success)
+    if (isMeasured && (result == Pal::Result::Success))
+    {
+        TrackTimedQueueFence(pQueueState);
+    }
+
+    if (isMeasured && (result == Pal::Result::Success))
     {
         // Build the timed queue event struct and add it to our queue events list.
         TimedQueueEventItem timedQueueEvent      = {};
@@ -1338,8 +1286,8 @@ Pal::Result GpaSession::TimedQueuePresent(
         timedQueueEvent.cpuTimestamp             = cpuTimestamp;
         timedQueueEvent.apiId                    = timedPresentInfo.presentID;
         timedQueueEvent.queueIndex               = queueIndex;
-        timedQueueEvent.gpuTimestamps.memInfo[0] = timestampMemoryInfo;
-        timedQueueEvent.gpuTimestamps.offsets[0] = timestampMemoryOffset;
+        timedQueueEvent.gpuTimestamps.memInfo[0] = pBlock->memInfo;
+        timedQueueEvent.gpuTimestamps.offsets[0] = TimedQueueSlotOffset(slotIndex, false);
 
         Util::MutexAuto eventsLock(&m_queueEventsLock);
         result = m_queueEvents.PushBack(timedQueueEvent);
@@ -1598,6 +1546,20 @@ Result GpaSession::End(
             }
         }
 
+        // Merge the load events and PSO correlations recorded by each registration shard.
+        MergeLoadEventRecords();
+
+        for (uint32 i = 0; i < RegistrationShardCount; ++i)
+        {
+            RegistrationShard*const pShard = &m_pRegistrationShards[i];
+            Util::MutexAuto         shardLock(&pShard->lock);
+
+            for (auto iter = pShard->psoCorrelationRecords.Begin(); iter.Get() != nullptr; iter.Next())
+            {
+                m_curPsoCorrelationRecords.PushBack(*iter.Get());
+            }
+        }
+
         // Copy all entries in the code object cache into the current code object records list.
         // Make sure to acquire the pipeline registration lock while we perform this operation to prevent new pipelines
         // from being added to the cache.
@@ -1606,14 +1568,6 @@ Result GpaSession::End(
         {
             m_curCodeObjectRecords.PushBack(*iter.Get());
         }
-        for (auto iter = m_codeObjectLoadEventRecordsCache.Begin(); iter.Get() != nullptr; iter.Next())
-        {
-            m_curCodeObjectLoadEventRecords.PushBack(*iter.Get());
-        }
-        for (auto iter = m_psoCorrelationRecordsCache.Begin(); iter.Get() != nullptr; iter.Next())
-        {
-            m_curPsoCorrelationRecords.PushBack(*iter.Get());
-        }
 
         // Copy all entries in the shader record cache into the current shader records list.
         for (auto iter = m_shaderRecordsCache.Begin(); iter.Get() != nullptr; iter.Next())
@@ -1972,7 +1926,11 @@ bool GpaSession::IsReady() const
             const TimedQueueState* pQueueState = m_timedQueuesArray.At(queueIndex);
             if (pQueueState->pFence != nullptr)
             {
-                if (pQueueState->pFence->GetStatus() == Pal::Result::NotReady)
+                const bool isBusy = pQueueState->fenceCallback
+                                    ? (pQueueState->fenceSignaled == 0)
+                                    : (pQueueState->pFence->GetStatus() == Pal::Result::NotReady);
+
+                if (isBusy)
                 {
                     isReady = false;
                     break;
@@ -2093,7 +2051,6 @@ Result GpaSession::Reset()
     {
         m_queueEvents.Clear();
         m_timestampCalibrations.Clear();
-        result = m_pCmdAllocator->Reset();
     }
 
     if (result == Pal::Result::Success)
@@ -2419,104 +2376,224 @@ Pal::Result GpaSession::CreateCmdBufferForQueue(
 }
 
 // =====================================================================================================================
-// Acquires a command buffer from the TimedQueueState's command buffer pool
-Pal::Result GpaSession::AcquireTimedQueueCmdBuffer(
-    TimedQueueState*  pQueueState,
-    Pal::ICmdBuffer** ppCmdBuffer)
+// Adds a block of timing slots to the end of pQueueState's timestamp ring. The block's timestamps are backed by a
+// single perma-resident, perma-mapped allocation so the results can be read back in bulk.
+Pal::Result GpaSession::GrowTimedQueueSlots(
+    TimedQueueState* pQueueState)
 {
-    Pal::Result result = Pal::Result::ErrorInvalidPointer;
+    Pal::Result result = Pal::Result::ErrorOutOfMemory;
 
-    if ((pQueueState != nullptr) && (ppCmdBuffer != nullptr))
+    TimedQueueSlotBlock* pBlock = static_cast<TimedQueueSlotBlock*>(PAL_CALLOC(sizeof(TimedQueueSlotBlock),
+                                                                               m_pPlatform,
+                                                                               Util::AllocObject));
+    void* pMemory = nullptr;
+
+    if (pBlock != nullptr)
     {
-        if (pQueueState->pAvailableCmdBuffers->NumElements() > 0)
+        const gpusize pageSize = m_deviceProps.gpuMemoryProperties.fragmentSize;
+
+        GpuMemoryCreateInfo createInfo = {};
+        createInfo.size      = Util::Pow2Align(TimedQueueSlotOffset(TimedQueueSlotsPerBlock, false), pageSize);
+        createInfo.alignment = pageSize;
+        createInfo.vaRange   = VaRange::Default;
+        createInfo.heapCount = 1;
+        createInfo.heaps[0]  = GpuHeapGartCacheable;
+        createInfo.priority  = GpuMemPriority::Normal;
+
+        pMemory = PAL_MALLOC(m_pDevice->GetGpuMemorySize(createInfo, nullptr),
+                             m_pPlatform,
+                             Util::SystemAllocType::AllocObject);
+
+        if (pMemory != nullptr)
         {
-            // Use an idle cmdbuffer from the pool if available.
-            result = pQueueState->pAvailableCmdBuffers->PopFront(ppCmdBuffer);
+            result = m_pDevice->CreateGpuMemory(createInfo, pMemory, &pBlock->memInfo.pGpuMemory);
         }
-        else
+    }
+
+    if (result == Pal::Result::Success)
+    {
+        // Like the rest of GpaSession's Gpu memory, the timestamp memory is perma-resident.
+        GpuMemoryRef memRef = {};
+        memRef.pGpuMemory   = pBlock->memInfo.pGpuMemory;
+
+        result = m_pDevice->AddGpuMemoryReferences(1, &memRef, nullptr, GpuMemoryRefCantTrim);
+
+        if (result != Pal::Result::Success)
         {
-            // No cmdbuffers are currently idle (or possibly none exist at all) - allocate a new cmdbuffer.
-            result = CreateCmdBufferForQueue(pQueueState->pQueue, ppCmdBuffer);
+            pBlock->memInfo.pGpuMemory->Destroy();
+            pBlock->memInfo.pGpuMemory = nullptr;
         }
+    }
+
+    if (result == Pal::Result::Success)
+    {
+        pMemory = nullptr;
+        result  = pBlock->memInfo.pGpuMemory->Map(&pBlock->memInfo.pCpuAddr);
 
         if (result == Pal::Result::Success)
         {
-            result = pQueueState->pBusyCmdBuffers->PushBack(*ppCmdBuffer);
-            PAL_ASSERT(result == Pal::Result::Success);
+            result = pQueueState->pSlotBlocks->PushBack(pBlock);
+        }
+
+        if (result != Pal::Result::Success)
+        {
+            DestroyTimedQueueSlotBlock(pBlock);
+            pBlock = nullptr;
         }
     }
 
+    if (result != Pal::Result::Success)
+    {
+        PAL_SAFE_FREE(pMemory, m_pPlatform);
+        PAL_SAFE_FREE(pBlock, m_pPlatform);
+    }
+
     return result;
 }
 
 // =====================================================================================================================
-// Recycles busy command buffers in pQueueState
-// It is the caller's responsibility to ensure that the command buffers are completed before calling this function
-Pal::Result GpaSession::RecycleTimedQueueCmdBuffers(
-    TimedQueueState* pQueueState)
+// Acquires the next unused timing slot of pQueueState, growing its timestamp ring if every slot has been used in the
+// current session. Slots are only recycled by ResetTimedQueueState(), once the GPU is done with the whole session;
+// callers must check HasFreeTimedQueueSlots() first so that the ring never grows past its size limit. Submissions
+// to a queue are externally synchronized, so the ring is only ever touched by one thread at a time.
+Pal::Result GpaSession::AcquireTimedQueueSlot(
+    TimedQueueState*      pQueueState,
+    TimedQueueSlotBlock** ppBlock,
+    uint32*               pSlotIndex)
 {
-    Pal::Result result = Pal::Result::Success;
-    while (pQueueState->pBusyCmdBuffers->NumElements() > 0)
+    Pal::Result  result     = Pal::Result::Success;
+    const uint32 blockIndex = pQueueState->nextSlot / TimedQueueSlotsPerBlock;
+
+    PAL_ASSERT(blockIndex < TimedQueueMaxSlotBlocks);
+
+    if (blockIndex == pQueueState->pSlotBlocks->NumElements())
     {
-        Pal::ICmdBuffer* pCmdBuffer = nullptr;
+        result = GrowTimedQueueSlots(pQueueState);
+    }
 
-        result = pQueueState->pBusyCmdBuffers->PopFront(&pCmdBuffer);
-        PAL_ASSERT(result == Pal::Result::Success);
+    if (result == Pal::Result::Success)
+    {
+        *ppBlock    = pQueueState->pSlotBlocks->At(blockIndex);
+        *pSlotIndex = pQueueState->nextSlot % TimedQueueSlotsPerBlock;
 
-        result = pQueueState->pAvailableCmdBuffers->PushBack(pCmdBuffer);
-        PAL_ASSERT(result == Pal::Result::Success);
+        pQueueState->nextSlot++;
     }
 
     return result;
 }
 
 // =====================================================================================================================
-// Preallocates a fixed number of command buffers for pQueueState and adds them to the command buffer pool
-Pal::Result GpaSession::PreallocateTimedQueueCmdBuffers(
-    TimedQueueState * pQueueState,
-    uint32            numCmdBuffers)
+// Returns the command buffer which writes one of the timestamps of a timing slot. The command buffer is recorded the
+// first time it is needed and is resubmitted unchanged by every later use of the slot.
+Pal::Result GpaSession::GetTimedQueueSlotCmdBuffer(
+    TimedQueueState*     pQueueState,
+    TimedQueueSlotBlock* pBlock,
+    uint32               slotIndex,
+    bool                 isPostTimestamp,
+    Pal::ICmdBuffer**    ppCmdBuffer)
 {
+    Pal::ICmdBuffer** ppSlotCmdBuffer = isPostTimestamp ? &pBlock->pPostCmdBuffers[slotIndex]
+                                                        : &pBlock->pPreCmdBuffers[slotIndex];
     Pal::Result result = Pal::Result::Success;
 
-    for (uint32 cmdBufIndex = 0; cmdBufIndex < numCmdBuffers; ++cmdBufIndex)
+    if (*ppSlotCmdBuffer == nullptr)
     {
         Pal::ICmdBuffer* pCmdBuffer = nullptr;
         result = CreateCmdBufferForQueue(pQueueState->pQueue, &pCmdBuffer);
 
         if (result == Pal::Result::Success)
         {
-            result = pQueueState->pAvailableCmdBuffers->PushBack(pCmdBuffer);
-            if (result != Pal::Result::Success)
+            // The command buffer is submitted once per session, so it must not be optimized for a single submit.
+            Pal::CmdBufferBuildInfo buildInfo = {};
+            result = pCmdBuffer->Begin(buildInfo);
+
+            if (result == Pal::Result::Success)
+            {
+                pCmdBuffer->CmdWriteTimestamp(isPostTimestamp ? Pal::HwPipeBottom : Pal::HwPipeTop,
+                                              *pBlock->memInfo.pGpuMemory,
+                                              TimedQueueSlotOffset(slotIndex, isPostTimestamp));
+
+                result = pCmdBuffer->End();
+            }
+
+            if (result == Pal::Result::Success)
+            {
+                *ppSlotCmdBuffer = pCmdBuffer;
+            }
+            else
             {
                 pCmdBuffer->Destroy();
                 PAL_SAFE_FREE(pCmdBuffer, m_pPlatform);
-                break;
             }
         }
-        else
+    }
+
+    if (result == Pal::Result::Success)
+    {
+        *ppCmdBuffer = *ppSlotCmdBuffer;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Destroys the timestamp command buffers of every slot in pBlock
+void GpaSession::DestroyTimedQueueSlotCmdBuffers(
+    TimedQueueSlotBlock* pBlock)
+{
+    for (uint32 slotIndex = 0; slotIndex < TimedQueueSlotsPerBlock; ++slotIndex)
+    {
+        if (pBlock->pPreCmdBuffers[slotIndex] != nullptr)
         {
-            break;
+            pBlock->pPreCmdBuffers[slotIndex]->Destroy();
+            PAL_SAFE_FREE(pBlock->pPreCmdBuffers[slotIndex], m_pPlatform);
+        }
+
+        if (pBlock->pPostCmdBuffers[slotIndex] != nullptr)
+        {
+            pBlock->pPostCmdBuffers[slotIndex]->Destroy();
+            PAL_SAFE_FREE(pBlock->pPostCmdBuffers[slotIndex], m_pPlatform);
         }
     }
+}
 
-    return result;
+// =====================================================================================================================
+// Destroys pBlock along with its timestamp memory and command buffers
+void GpaSession::DestroyTimedQueueSlotBlock(
+    TimedQueueSlotBlock* pBlock)
+{
+    DestroyTimedQueueSlotCmdBuffers(pBlock);
+    DestroyGpuMemoryInfo(&pBlock->memInfo);
+
+    PAL_SAFE_FREE(pBlock, m_pPlatform);
 }
 
 // =====================================================================================================================
-// Resets all per session state in pQueueState
+// Resets all per session state in pQueueState. The GPU must be done with the previous session by now, so every slot in
+// the timestamp ring can be reused; their command buffers are still valid since the timestamp addresses never change.
+// Blocks which the previous session didn't need are released so that one heavy session doesn't pin its timestamp memory
+// and command buffers for the lifetime of the GpaSession.
 Pal::Result GpaSession::ResetTimedQueueState(
     TimedQueueState* pQueueState)
 {
-    Pal::Result result = RecycleTimedQueueCmdBuffers(pQueueState);
-    PAL_ASSERT(result == Pal::Result::Success);
+    const uint32 usedBlocks = Util::Max(Util::RoundUpQuotient(pQueueState->nextSlot, TimedQueueSlotsPerBlock), 1u);
 
-    for (auto iter = pQueueState->pAvailableCmdBuffers->Begin(); iter.Get() != nullptr; iter.Next())
+    // Only free memory once the queue's last timed submit is known to have retired.
+    const bool isIdle = pQueueState->fenceCallback
+                        ? (pQueueState->fenceSignaled != 0)
+                        : (pQueueState->pFence->GetStatus() != Pal::Result::NotReady);
+
+    while (isIdle && (pQueueState->pSlotBlocks->NumElements() > usedBlocks))
     {
-        result = (*iter.Get())->Reset(m_pCmdAllocator, true);
-        PAL_ASSERT(result == Pal::Result::Success);
+        TimedQueueSlotBlock* pBlock = nullptr;
+        pQueueState->pSlotBlocks->PopBack(&pBlock);
+
+        DestroyTimedQueueSlotBlock(pBlock);
     }
 
-    return result;
+    pQueueState->nextSlot = 0;
+
+    return Pal::Result::Success;
 }
 
 // =====================================================================================================================
@@ -2524,30 +2601,18 @@ Pal::Result GpaSession::ResetTimedQueueState(
 void GpaSession::DestroyTimedQueueState(
     TimedQueueState* pQueueState)
 {
-    // Move all cmdbuffers into the available list
-    Pal::Result result = RecycleTimedQueueCmdBuffers(pQueueState);
-    PAL_ASSERT(result == Pal::Result::Success);
-
-    // Destroy all measurement command buffers
-    while (pQueueState->pAvailableCmdBuffers->NumElements() > 0)
+    // Destroy the timestamp ring along with all measurement command buffers
+    for (uint32 blockIndex = 0; blockIndex < pQueueState->pSlotBlocks->NumElements(); ++blockIndex)
     {
-        Pal::ICmdBuffer* pCmdBuffer = nullptr;
-        result = pQueueState->pAvailableCmdBuffers->PopFront(&pCmdBuffer);
-        PAL_ASSERT(result == Pal::Result::Success);
-
-        PAL_ASSERT(pCmdBuffer != nullptr);
-
-        pCmdBuffer->Destroy();
-        PAL_SAFE_FREE(pCmdBuffer, m_pPlatform);
+        DestroyTimedQueueSlotBlock(pQueueState->pSlotBlocks->At(blockIndex));
     }
 
-    // Destroy the command buffer arrays
-    pQueueState->pAvailableCmdBuffers->~Deque();
-    pQueueState->pBusyCmdBuffers->~Deque();
+    pQueueState->pSlotBlocks->~Vector();
 
     // Destroy the fence
     if (pQueueState->pFence != nullptr)
     {
+        UntrackTimedQueueFence(pQueueState);
         pQueueState->pFence->Destroy();
     }
 
@@ -2555,134 +2620,212 @@ void GpaSession::DestroyTimedQueueState(
     PAL_SAFE_FREE(pQueueState, m_pPlatform);
 }
 
+// =====================================================================================================================
+// Asks the device to flag pQueueState once the fence of its last submit has been signaled.
+void GpaSession::TrackTimedQueueFence(
+    TimedQueueState* pQueueState)
+{
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    PAL_ASSERT(pQueueState->fenceCallback == false);
+
+    pQueueState->fenceSignaled = 0;
+    pQueueState->fenceCallback =
+        (m_pDevice->RegisterFenceCallback(pQueueState->pFence, &TimedQueueFenceCallback, pQueueState) ==
+         Pal::Result::Success);
+#endif
+}
+
+// =====================================================================================================================
+// Cancels the callback registered by TrackTimedQueueFence(), if it hasn't been invoked yet.
+void GpaSession::UntrackTimedQueueFence(
+    TimedQueueState* pQueueState)
+{
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+    if (pQueueState->fenceCallback)
+    {
+        m_pDevice->UnregisterFenceCallback(pQueueState->pFence, &TimedQueueFenceCallback, pQueueState);
+        pQueueState->fenceCallback = false;
+    }
+#endif
+}
+
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION >= 548
+// =====================================================================================================================
+// Called by the device, possibly on another thread, once a timed queue's fence has been signaled.  Errors also end the
+// wait, just like they do when the fence is polled.
+void PAL_STDCALL GpaSession::TimedQueueFenceCallback(
+    void*       pUserData,
+    Pal::Result result)
+{
+    Util::AtomicIncrement(&static_cast<TimedQueueState*>(pUserData)->fenceSignaled);
+}
+#endif
+
+// =====================================================================================================================
+// Returns the hash which identifies unique pipelines registered with a GpaSession.
+static uint64 PipelineRegistrationHash(
+    const PipelineInfo& pipeInfo)
+{
+#if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 476
+    return pipeInfo.palRuntimeHash;
+#else
+    return pipeInfo.internalPipelineHash.unique;
+#endif
+}
+
 // =====================================================================================================================
 // Registers a pipeline with the GpaSession. Returns AlreadyExists on duplicate PAL pipeline.
+//
+// Registration only takes the locks of the shards which own the pipeline's hash and API PSO hash. The binary and shader
+// ISA of a newly registered pipeline are copied after its shard lock is released, so the pipeline may be destroyed at
+// any time after this returns.
 Result GpaSession::RegisterPipeline(
     const IPipeline*             pPipeline,
     const RegisterPipelineInfo&  clientInfo)
 {
     PAL_ASSERT(pPipeline != nullptr);
-    const PipelineInfo& pipeInfo = pPipeline->GetInfo();
+    const PipelineInfo& pipeInfo     = pPipeline->GetInfo();
+    const uint64        pipelineHash = PipelineRegistrationHash(pipeInfo);
 
     // Even if the pipeline was already previously encountered, we still want to record every time it gets loaded.
     Result result = AddCodeObjectLoadEvent(pPipeline, CodeObjectLoadEventType::LoadToGpuMemory);
 
-    m_registerPipelineLock.LockForWrite();
-
-    if ((result == Result::Success)  &&
-        (clientInfo.apiPsoHash != 0) &&
-        (m_registeredApiPsos.Contains(clientInfo.apiPsoHash) == false))
+    if ((result == Result::Success) && (clientInfo.apiPsoHash != 0))
     {
-        // Record a (many-to-one) mapping of API PSO hash -> internal pipeline hash so they can be correlated.
-        PsoCorrelationRecord record = { };
-        record.apiPsoHash           = clientInfo.apiPsoHash;
-        record.internalPipelineHash = pipeInfo.internalPipelineHash;
-        result = m_psoCorrelationRecordsCache.PushBack(record);
+        RegistrationShard*const pShard = GetRegistrationShard(clientInfo.apiPsoHash);
+        Util::MutexAuto         shardLock(&pShard->lock);
 
-        if (result == Result::Success)
+        if (pShard->registeredApiPsos.Contains(clientInfo.apiPsoHash) == false)
         {
-            result = m_registeredApiPsos.Insert(clientInfo.apiPsoHash);
+            // Record a (many-to-one) mapping of API PSO hash -> internal pipeline hash so they can be correlated.
+            PsoCorrelationRecord record = { };
+            record.apiPsoHash           = clientInfo.apiPsoHash;
+            record.internalPipelineHash = pipeInfo.internalPipelineHash;
+            result = pShard->psoCorrelationRecords.PushBack(record);
+
+            if (result == Result::Success)
+            {
+                result = pShard->registeredApiPsos.Insert(clientInfo.apiPsoHash);
+            }
         }
     }
 
     if (result == Result::Success)
     {
-#if PAL_CLIENT_INTERFACE_MAJOR_VERSION < 476
-        result = m_registeredPipelines.Contains(pipeInfo.palRuntimeHash) ? Result::AlreadyExists :
-                 m_registeredPipelines.Insert(pipeInfo.palRuntimeHash);
-#else
-        result = m_registeredPipelines.Contains(pipeInfo.internalPipelineHash.unique) ? Result::AlreadyExists :
-                 m_registeredPipelines.Insert(pipeInfo.internalPipelineHash.unique);
-#endif
-    }
+        RegistrationShard*const pShard = GetRegistrationShard(pipelineHash);
+        Util::MutexAuto         shardLock(&pShard->lock);
 
-    m_registerPipelineLock.UnlockForWrite();
+        result = pShard->registeredPipelines.Contains(pipelineHash) ? Result::AlreadyExists :
+                 pShard->registeredPipelines.Insert(pipelineHash);
+    }
 
     if (result == Result::Success)
     {
         // Cache the pipeline binary in GpaSession-owned memory.
-        SqttCodeObjectDatabaseRecord record = {};
+        result = CachePipelineBinary(pPipeline);
 
-        void* pCodeObjectRecord = nullptr;
+        if (result != Result::Success)
+        {
+            // Forget the pipeline so that registering it again retries caching its binary instead of reporting that
+            // it already exists without ever having been recorded.
+            RegistrationShard*const pShard = GetRegistrationShard(pipelineHash);
+            Util::MutexAuto         shardLock(&pShard->lock);
 
-        result = pPipeline->GetPipelineElf(&record.recordSize, nullptr);
+            pShard->registeredPipelines.Erase(pipelineHash);
+        }
+    }
 
-        if (result == Result::Success)
-        {
-            PAL_ASSERT(record.recordSize != 0);
+    return result;
+}
 
-            // Pad the record size to the nearest multiple of 4 bytes per the RGP file format spec.
-            record.recordSize = Util::RoundUpToMultiple(record.recordSize, 4U);
+// =====================================================================================================================
+// Unregisters a pipeline with the GpaSession.
+Result GpaSession::UnregisterPipeline(
+    const IPipeline* pPipeline)
+{
+    return AddCodeObjectLoadEvent(pPipeline, CodeObjectLoadEventType::UnloadFromGpuMemory);
+}
 
-            // Allocate space to store all the information for one record.
-            pCodeObjectRecord = PAL_MALLOC((sizeof(SqttCodeObjectDatabaseRecord) + record.recordSize),
-                                           m_pPlatform,
-                                           Util::SystemAllocType::AllocInternal);
+// =====================================================================================================================
+// Caches the pipeline binary and shader ISA of a newly registered pipeline in GpaSession-owned memory.
+Result GpaSession::CachePipelineBinary(
+    const IPipeline* pPipeline)
+{
+    const PipelineInfo& pipeInfo = pPipeline->GetInfo();
 
-            if (pCodeObjectRecord != nullptr)
-            {
-                // Write the record header.
-                memcpy(pCodeObjectRecord, &record, sizeof(record));
+    SqttCodeObjectDatabaseRecord record = {};
 
-                // Write the pipeline binary.
-                result = pPipeline->GetPipelineElf(&record.recordSize,
-                                                   Util::VoidPtrInc(pCodeObjectRecord, sizeof(record)));
+    void* pCodeObjectRecord = nullptr;
 
-                if (result != Result::Success)
-                {
-                    // Deallocate if some error occurred.
-                    PAL_SAFE_FREE(pCodeObjectRecord, m_pPlatform)
-                }
-            }
-            else
-            {
-                result = Result::ErrorOutOfMemory;
-            }
-        }
+    Result result = pPipeline->GetPipelineElf(&record.recordSize, nullptr);
+
+    if (result == Result::Success)
+    {
+        PAL_ASSERT(record.recordSize != 0);
 
-        // Local copy of shader data that will later be copied into the shaderRecords list under lock.
-        ShaderRecord pShaderRecords[NumShaderTypes];
-        uint32 numShaders = 0;
+        // Pad the record size to the nearest multiple of 4 bytes per the RGP file format spec.
+        record.recordSize = Util::RoundUpToMultiple(record.recordSize, 4U);
 
-        for (uint32 i = 0; ((i < NumShaderTypes) && (result == Result::Success)); ++i)
+        // Allocate space to store all the information for one record.
+        pCodeObjectRecord = PAL_MALLOC((sizeof(SqttCodeObjectDatabaseRecord) + record.recordSize),
+                                       m_pPlatform,
+                                       Util::SystemAllocType::AllocInternal);
+
+        if (pCodeObjectRecord != nullptr)
         {
-            // Extract shader data from the pipeline.
-            // The upper 64-bits of the shader hash can be 0 when 64-bit CRCs are used
-            if (ShaderHashIsNonzero(pipeInfo.shader[i].hash))
-            {
-                result = CreateShaderRecord(static_cast<ShaderType>(i), pPipeline, &pShaderRecords[numShaders]);
-                PAL_ASSERT(result == Result::Success);
+            // Write the record header.
+            memcpy(pCodeObjectRecord, &record, sizeof(record));
 
-                ++numShaders;
+            // Write the pipeline binary.
+            result = pPipeline->GetPipelineElf(&record.recordSize,
+                                               Util::VoidPtrInc(pCodeObjectRecord, sizeof(record)));
+
+            if (result != Result::Success)
+            {
+                // Deallocate if some error occurred.
+                PAL_SAFE_FREE(pCodeObjectRecord, m_pPlatform)
             }
         }
+        else
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+    }
 
-        if (result == Result::Success)
+    // Local copy of shader data that will later be copied into the shaderRecords list under lock.
+    ShaderRecord pShaderRecords[NumShaderTypes];
+    uint32 numShaders = 0;
+
+    for (uint32 i = 0; ((i < NumShaderTypes) && (result == Result::Success)); ++i)
+    {
+        // Extract shader data from the pipeline.
+        // The upper 64-bits of the shader hash can be 0 when 64-bit CRCs are used
+        if (ShaderHashIsNonzero(pipeInfo.shader[i].hash))
         {
-            m_registerPipelineLock.LockForWrite();
+            result = CreateShaderRecord(static_cast<ShaderType>(i), pPipeline, &pShaderRecords[numShaders]);
+            PAL_ASSERT(result == Result::Success);
 
-            m_codeObjectRecordsCache.PushBack(static_cast<SqttCodeObjectDatabaseRecord*>(pCodeObjectRecord));
+            ++numShaders;
+        }
+    }
 
-            for (uint32 i = 0; ((result == Result::Success) && (i < numShaders)); ++i)
-            {
-                result = m_shaderRecordsCache.PushBack(pShaderRecords[i]);
-            }
+    if (result == Result::Success)
+    {
+        m_registerPipelineLock.LockForWrite();
 
-            m_registerPipelineLock.UnlockForWrite();
+        m_codeObjectRecordsCache.PushBack(static_cast<SqttCodeObjectDatabaseRecord*>(pCodeObjectRecord));
+
+        for (uint32 i = 0; ((result == Result::Success) && (i < numShaders)); ++i)
+        {
+            result = m_shaderRecordsCache.PushBack(pShaderRecords[i]);
         }
+
+        m_registerPipelineLock.UnlockForWrite();
     }
 
     return result;
 }
 
-// =====================================================================================================================
-// Unregisters a pipeline with the GpaSession.
-Result GpaSession::UnregisterPipeline(
-    const IPipeline* pPipeline)
-{
-    return AddCodeObjectLoadEvent(pPipeline, CodeObjectLoadEventType::UnloadFromGpuMemory);
-}
-
 // =====================================================================================================================
 // Helper function to add a new code object load event record.
 Result GpaSession::AddCodeObjectLoadEvent(
@@ -2710,16 +2853,64 @@ Result GpaSession::AddCodeObjectLoadEvent(
         record.eventType      = eventType;
         record.baseAddress    = (gpuSubAlloc.pGpuMemory->Desc().gpuVirtAddr + gpuSubAlloc.offset);
         record.codeObjectHash = { info.internalPipelineHash.stable, info.internalPipelineHash.unique };
-        record.timestamp      = static_cast<uint64>(Util::GetPerfCpuTime());
 
-        m_registerPipelineLock.LockForWrite();
-        result = m_codeObjectLoadEventRecordsCache.PushBack(record);
-        m_registerPipelineLock.UnlockForWrite();
+        // Events are buffered in the pipeline's own shard; each shard's events are in timestamp order because the
+        // timestamp is taken under its lock. They're merged by timestamp at the end of a trace.
+        RegistrationShard*const pShard = GetRegistrationShard(PipelineRegistrationHash(info));
+        Util::MutexAuto         shardLock(&pShard->lock);
+
+        record.timestamp = static_cast<uint64>(Util::GetPerfCpuTime());
+        result           = pShard->loadEventRecords.PushBack(record);
     }
 
     return result;
 }
 
+// =====================================================================================================================
+// qsort() comparison which orders load event records by increasing timestamp.
+int GpaSession::CompareLoadEventTimestamps(
+    const void* pLhs,
+    const void* pRhs)
+{
+    const uint64 lhs = static_cast<const CodeObjectLoadEventRecord*>(pLhs)->timestamp;
+    const uint64 rhs = static_cast<const CodeObjectLoadEventRecord*>(pRhs)->timestamp;
+
+    return (lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0);
+}
+
+// =====================================================================================================================
+// Merges the load event records of all registration shards into m_curCodeObjectLoadEventRecords in timestamp order.
+void GpaSession::MergeLoadEventRecords()
+{
+    Util::Vector<CodeObjectLoadEventRecord, 64, GpaAllocator> records(m_pPlatform);
+    Result result = Result::Success;
+
+    for (uint32 i = 0; i < RegistrationShardCount; ++i)
+    {
+        RegistrationShard*const pShard = &m_pRegistrationShards[i];
+        Util::MutexAuto         shardLock(&pShard->lock);
+
+        for (auto iter = pShard->loadEventRecords.Begin(); (result == Result::Success) && (iter.Get() != nullptr);
+             iter.Next())
+        {
+            result = records.PushBack(*iter.Get());
+        }
+    }
+
+    if (records.NumElements() > 1)
+    {
+        qsort(&records.At(0), records.NumElements(), sizeof(CodeObjectLoadEventRecord), CompareLoadEventTimestamps);
+    }
+
+    for (uint32 i = 0; i < records.NumElements(); ++i)
+    {
+        m_curCodeObjectLoadEventRecords.PushBack(records.At(i));
+    }
+
+    // Out of memory only loses load events; the trace itself is still valid.
+    PAL_ALERT(result != Result::Success);
+}
+
 // =====================================================================================================================
 // Helper function to import one sample item from a source session to copy session.
 Result GpaSession::ImportSampleItem(
@@ -0,0 +1,507 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "palAllocProfiler.h"
+#include "palFile.h"
+#include "palHashMapImpl.h"
+#include "palMutex.h"
+#include "palSysUtil.h"
+#include "palThread.h"
+#include <cmath>
+#include <cstdlib>
+
+namespace Util
+{
+
+// Information about a single sampled allocation, kept until the allocation is freed.
+struct AllocProfiler::SampleRecord
+{
+    uint64          stackHash;  // Identifies the call site: a hash of the frames and allocation type.
+    size_t          size;
+    double          weight;     // Estimated number of allocated bytes this sample stands for.
+    SystemAllocType allocType;
+    uint32          numFrames;
+    void*           frames[AllocProfiler::MaxStackFrames];
+};
+
+// Estimated live allocations of one call site, gathered while writing a report.
+struct CallSiteStats
+{
+    double          bytes;
+    double          count;
+    uint32          samples;
+    SystemAllocType allocType;
+    uint32          numFrames;
+    void*const*     pFrames;   // Stack of any one of the call site's samples.
+};
+
+typedef HashMap<uint64, CallSiteStats, ForwardAllocator> CallSiteMap;
+
+// =====================================================================================================================
+static uint32 AddrBucket(
+    const void* pMem,
+    uint32      numBuckets)
+{
+    // Fibonacci hashing; allocations are at least 8-byte aligned so the low bits carry no information.
+    return static_cast<uint32>(((reinterpret_cast<uintptr_t>(pMem) >> 3) * 0x9E3779B97F4A7C15ull) >> 52) &
+           (numBuckets - 1);
+}
+
+// =====================================================================================================================
+AllocProfiler::AllocProfiler(
+    const AllocCallbacks& clientCb,
+    const AllocCallbacks& internalCb,
+    size_t                sampleInterval)
+    :
+    m_clientCb(clientCb),
+    m_internalCb(internalCb),
+    m_allocator(internalCb),
+    m_sampleInterval(static_cast<double>((sampleInterval != 0) ? sampleInterval : DefaultSampleInterval)),
+    m_keyCreated(false),
+    m_rngSequence(static_cast<uint64>(GetPerfCpuTime()))
+{
+    memset(const_cast<uint32*>(&m_bucketCounts[0]), 0, sizeof(m_bucketCounts));
+    memset(&m_pShards[0], 0, sizeof(m_pShards));
+}
+
+// =====================================================================================================================
+AllocProfiler::~AllocProfiler()
+{
+    for (uint32 shard = 0; shard < NumSampleShards; ++shard)
+    {
+        if (m_pShards[shard] != nullptr)
+        {
+            // Any records left behind belong to allocations which were leaked by the profiler's owner.
+            PAL_ALERT(m_pShards[shard]->GetNumEntries() != 0);
+
+            for (auto iter = m_pShards[shard]->Begin(); iter.Get() != nullptr; iter.Next())
+            {
+                m_internalCb.pfnFree(m_internalCb.pClientData, iter.Get()->value);
+            }
+
+            PAL_SAFE_DELETE(m_pShards[shard], &m_allocator);
+        }
+    }
+
+    if (m_keyCreated)
+    {
+        DeleteThreadLocalKey(m_countdownKey);
+    }
+}
+
+// =====================================================================================================================
+Result AllocProfiler::Init()
+{
+    Result result = CreateThreadLocalKey(&m_countdownKey);
+    m_keyCreated  = (result == Result::Success);
+
+    for (uint32 shard = 0; (result == Result::Success) && (shard < NumSampleShards); ++shard)
+    {
+        result = m_shardLocks[shard].Init();
+
+        if (result == Result::Success)
+        {
+            m_pShards[shard] = PAL_NEW(SampleMap, &m_allocator, AllocInternal)(64, &m_allocator);
+            result = (m_pShards[shard] != nullptr) ? m_pShards[shard]->Init() : Result::ErrorOutOfMemory;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result AllocProfiler::Create(
+    const AllocCallbacks& clientCb,
+    size_t                sampleInterval,
+    AllocProfiler**       ppProfiler)
+{
+    PAL_ASSERT(ppProfiler != nullptr);
+
+    AllocCallbacks internalCb = {};
+    Result         result     = OsInitDefaultAllocCallbacks(&internalCb);
+
+    AllocProfiler* pProfiler = nullptr;
+    if (result == Result::Success)
+    {
+        ForwardAllocator allocator(internalCb);
+        pProfiler = PAL_NEW(AllocProfiler, &allocator, AllocInternal)(clientCb, internalCb, sampleInterval);
+        result    = (pProfiler != nullptr) ? pProfiler->Init() : Result::ErrorOutOfMemory;
+    }
+
+    if (result == Result::Success)
+    {
+        *ppProfiler = pProfiler;
+    }
+    else if (pProfiler != nullptr)
+    {
+        pProfiler->Destroy();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void AllocProfiler::Destroy()
+{
+    ForwardAllocator allocator(m_internalCb);
+    PAL_DELETE_THIS(AllocProfiler, &allocator);
+}
+
+// =====================================================================================================================
+void AllocProfiler::GetAllocCallbacks(
+    AllocCallbacks* pAllocCb)
+{
+    PAL_ASSERT(pAllocCb != nullptr);
+
+    pAllocCb->pClientData = this;
+    pAllocCb->pfnAlloc    = ProfilingAlloc;
+    pAllocCb->pfnFree     = ProfilingFree;
+}
+
+// =====================================================================================================================
+// Draws the number of bytes until the next sample from an exponential distribution, which makes samples a Poisson
+// process over the stream of allocated bytes.
+size_t AllocProfiler::NextSampleInterval()
+{
+    // SplitMix64 turns consecutive sequence values into well-distributed random bits.
+    uint64 bits = AtomicAdd64(&m_rngSequence, 0x9E3779B97F4A7C15ull);
+    bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ull;
+    bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBull;
+    bits =  bits ^ (bits >> 31);
+
+    // A uniform value in (0, 1].
+    const double uniform  = static_cast<double>((bits >> 11) + 1) * (1.0 / 9007199254740992.0);
+    const double interval = -std::log(uniform) * m_sampleInterval;
+
+    // Clamp to avoid overflowing the countdown; such intervals are vanishingly unlikely anyway.
+    return static_cast<size_t>(Min(Max(interval, 1.0), static_cast<double>(UINT32_MAX)));
+}
+
+// =====================================================================================================================
+// Captures the stack of a newly sampled allocation and adds it to the live samples.
+void AllocProfiler::RecordSample(
+    const void*     pMem,
+    size_t          size,
+    SystemAllocType allocType)
+{
+    SampleRecord*const pRecord = static_cast<SampleRecord*>(
+        m_internalCb.pfnAlloc(m_internalCb.pClientData, sizeof(SampleRecord), alignof(SampleRecord), AllocInternal));
+
+    if (pRecord != nullptr)
+    {
+        // Skip this function and ProfilingAlloc().
+        pRecord->numFrames = CaptureStackFrames(&pRecord->frames[0], MaxStackFrames, 2);
+        pRecord->size      = size;
+        pRecord->allocType = allocType;
+
+        // A sample of size s is taken with probability 1 - e^(-s/interval), so it stands for s divided by that.
+        pRecord->weight = static_cast<double>(size) / -std::expm1(-static_cast<double>(size) / m_sampleInterval);
+
+        // 64-bit FNV-1a over the frame addresses and allocation type.
+        uint64 hash = 0xCBF29CE484222325ull ^ static_cast<uint64>(allocType);
+        for (uint32 frame = 0; frame < pRecord->numFrames; ++frame)
+        {
+            hash = (hash ^ static_cast<uint64>(reinterpret_cast<uintptr_t>(pRecord->frames[frame]))) *
+                   0x100000001B3ull;
+        }
+        pRecord->stackHash = hash;
+
+        const uint32 bucket = AddrBucket(pMem, NumAddrBuckets);
+        const uint32 shard  = (bucket % NumSampleShards);
+
+        MutexAuto lock(&m_shardLocks[shard]);
+
+        if (m_pShards[shard]->Insert(pMem, pRecord) == Result::Success)
+        {
+            AtomicIncrement(&m_bucketCounts[bucket]);
+        }
+        else
+        {
+            // Dropping a sample only makes the estimates slightly low.
+            m_internalCb.pfnFree(m_internalCb.pClientData, pRecord);
+        }
+    }
+}
+
+// =====================================================================================================================
+void* PAL_STDCALL AllocProfiler::ProfilingAlloc(
+    void*           pClientData,
+    size_t          size,
+    size_t          alignment,
+    SystemAllocType allocType)
+{
+    AllocProfiler*const pThis = static_cast<AllocProfiler*>(pClientData);
+
+    void*const pMem = pThis->m_clientCb.pfnAlloc(pThis->m_clientCb.pClientData, size, alignment, allocType);
+
+    if (pMem != nullptr)
+    {
+        // A countdown of zero means that this thread hasn't allocated anything yet.
+        size_t countdown = reinterpret_cast<size_t>(GetThreadLocalValue(pThis->m_countdownKey));
+
+        if (countdown == 0)
+        {
+            countdown = pThis->NextSampleInterval();
+        }
+
+        if (size >= countdown)
+        {
+            pThis->RecordSample(pMem, size, allocType);
+            countdown = pThis->NextSampleInterval();
+        }
+        else
+        {
+            countdown -= size;
+        }
+
+        SetThreadLocalValue(pThis->m_countdownKey, reinterpret_cast<void*>(countdown));
+    }
+
+    return pMem;
+}
+
+// =====================================================================================================================
+void PAL_STDCALL AllocProfiler::ProfilingFree(
+    void* pClientData,
+    void* pMem)
+{
+    AllocProfiler*const pThis = static_cast<AllocProfiler*>(pClientData);
+
+    const uint32 bucket = AddrBucket(pMem, NumAddrBuckets);
+
+    // The allocation can't be sampled concurrently with its own free, so an unlocked read is enough here.  The record
+    // must be removed before the memory is freed, or another thread could be handed the same address and sample it.
+    if ((pMem != nullptr) && (pThis->m_bucketCounts[bucket] != 0))
+    {
+        const uint32  shard   = (bucket % NumSampleShards);
+        SampleRecord* pRecord = nullptr;
+
+        {
+            MutexAuto lock(&pThis->m_shardLocks[shard]);
+
+            SampleRecord**const ppRecord = pThis->m_pShards[shard]->FindKey(pMem);
+
+            if (ppRecord != nullptr)
+            {
+                pRecord = *ppRecord;
+                pThis->m_pShards[shard]->Erase(pMem);
+                AtomicDecrement(&pThis->m_bucketCounts[bucket]);
+            }
+        }
+
+        if (pRecord != nullptr)
+        {
+            pThis->m_internalCb.pfnFree(pThis->m_internalCb.pClientData, pRecord);
+        }
+    }
+
+    pThis->m_clientCb.pfnFree(pThis->m_clientCb.pClientData, pMem);
+}
+
+// =====================================================================================================================
+static const char* AllocTypeName(
+    SystemAllocType allocType)
+{
+    const char* pName = "Unknown";
+
+    switch (allocType)
+    {
+    case AllocObject:
+        pName = "AllocObject";
+        break;
+    case AllocInternal:
+        pName = "AllocInternal";
+        break;
+    case AllocInternalTemp:
+        pName = "AllocInternalTemp";
+        break;
+    case AllocInternalShader:
+        pName = "AllocInternalShader";
+        break;
+    default:
+        break;
+    }
+
+    return pName;
+}
+
+// =====================================================================================================================
+// qsort() comparison which orders call sites by decreasing estimated live bytes.
+static int CompareCallSites(
+    const void* pLhs,
+    const void* pRhs)
+{
+    const double lhsBytes = (*static_cast<const CallSiteMap::Entry*const*>(pLhs))->value.bytes;
+    const double rhsBytes = (*static_cast<const CallSiteMap::Entry*const*>(pRhs))->value.bytes;
+
+    return (lhsBytes < rhsBytes) ? 1 : ((lhsBytes > rhsBytes) ? -1 : 0);
+}
+
+// =====================================================================================================================
+// Writes the estimated live allocations of every call site to the report.  All shard locks must be held because the
+// call sites point at live sample records.
+static Result WriteCallSites(
+    ForwardAllocator*  pAllocator,
+    const CallSiteMap& callSites,
+    File*              pFile)
+{
+    const uint32 numCallSites = callSites.GetNumEntries();
+    auto**       ppSorted     = (numCallSites > 0)
+        ? PAL_NEW_ARRAY(const CallSiteMap::Entry*, numCallSites, pAllocator, AllocInternalTemp)
+        : nullptr;
+
+    Result result = ((numCallSites == 0) || (ppSorted != nullptr)) ? Result::Success : Result::ErrorOutOfMemory;
+
+    if (result == Result::Success)
+    {
+        uint32 index = 0;
+        for (auto iter = callSites.Begin(); iter.Get() != nullptr; iter.Next())
+        {
+            ppSorted[index++] = iter.Get();
+        }
+
+        qsort(ppSorted, numCallSites, sizeof(ppSorted[0]), CompareCallSites);
+
+        pFile->Printf("\nEstimated live bytes by call site:\n");
+
+        char frameName[512];
+        for (uint32 site = 0; site < numCallSites; ++site)
+        {
+            const CallSiteStats& stats = ppSorted[site]->value;
+
+            pFile->Printf("\n#%u: %.0f bytes in %.0f allocations (%s, %u samples)\n",
+                          site,
+                          stats.bytes,
+                          stats.count,
+                          AllocTypeName(stats.allocType),
+                          stats.samples);
+
+            for (uint32 frame = 0; frame < stats.numFrames; ++frame)
+            {
+                DescribeCodeAddress(stats.pFrames[frame], frameName, sizeof(frameName));
+                pFile->Printf("    %2u: %s\n", frame, frameName);
+            }
+        }
+    }
+
+    PAL_SAFE_DELETE_ARRAY(ppSorted, pAllocator);
+
+    return result;
+}
+
+// =====================================================================================================================
+Result AllocProfiler::WriteReport(
+    const char* pFilename)
+{
+    File   file;
+    Result result = file.Open(pFilename, FileAccessWrite);
+
+    if (result == Result::Success)
+    {
+        // Call sites are keyed by stack hash.  They are gathered in the profiler's own memory so that writing the
+        // report doesn't sample anything or wait on a shard lock it holds.
+        CallSiteMap callSites(1024, &m_allocator);
+        result = callSites.Init();
+
+        double typeBytes[4] = {};
+        double typeCount[4] = {};
+        uint32 numSamples   = 0;
+
+        // Every shard stays locked until the report is written, so no call site's example record can be freed.
+        for (uint32 shard = 0; shard < NumSampleShards; ++shard)
+        {
+            m_shardLocks[shard].Lock();
+        }
+
+        for (uint32 shard = 0; (result == Result::Success) && (shard < NumSampleShards); ++shard)
+        {
+            for (auto iter = m_pShards[shard]->Begin(); iter.Get() != nullptr; iter.Next())
+            {
+                const SampleRecord& record = *iter.Get()->value;
+                const double        count  = (record.weight / static_cast<double>(record.size));
+
+                // SystemAllocType values are consecutive, starting at AllocObject.
+                const uint32 typeIndex = Min(static_cast<uint32>(record.allocType - AllocObject), 3u);
+                typeBytes[typeIndex] += record.weight;
+                typeCount[typeIndex] += count;
+                ++numSamples;
+
+                bool           existed = false;
+                CallSiteStats* pStats  = nullptr;
+                result = callSites.FindAllocate(record.stackHash, &existed, &pStats);
+
+                if (result == Result::Success)
+                {
+                    if (existed == false)
+                    {
+                        memset(pStats, 0, sizeof(*pStats));
+                        pStats->allocType = record.allocType;
+                        pStats->numFrames = record.numFrames;
+                        pStats->pFrames   = &record.frames[0];
+                    }
+
+                    pStats->bytes += record.weight;
+                    pStats->count += count;
+                    ++pStats->samples;
+                }
+            }
+        }
+
+        if (result == Result::Success)
+        {
+            file.Printf("Sampling allocation profile\n");
+            file.Printf("Sample interval: %.0f bytes\n", m_sampleInterval);
+            file.Printf("Live samples:    %u\n", numSamples);
+            file.Printf("\nEstimated live bytes by allocation type:\n");
+
+            double totalBytes = 0.0;
+            double totalCount = 0.0;
+            for (uint32 typeIndex = 0; typeIndex < 4; ++typeIndex)
+            {
+                file.Printf("    %-20s %16.0f bytes in %12.0f allocations\n",
+                            AllocTypeName(static_cast<SystemAllocType>(AllocObject + typeIndex)),
+                            typeBytes[typeIndex],
+                            typeCount[typeIndex]);
+
+                totalBytes += typeBytes[typeIndex];
+                totalCount += typeCount[typeIndex];
+            }
+            file.Printf("    %-20s %16.0f bytes in %12.0f allocations\n", "Total", totalBytes, totalCount);
+
+            result = WriteCallSites(&m_allocator, callSites, &file);
+        }
+
+        for (uint32 shard = 0; shard < NumSampleShards; ++shard)
+        {
+            m_shardLocks[shard].Unlock();
+        }
+
+        file.Close();
+    }
+
+    return result;
+}
+
+} // Util
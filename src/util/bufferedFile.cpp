@@ -0,0 +1,937 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "palAssert.h"
+#include "palBufferedFile.h"
+#include "palConditionVariable.h"
+#include "palInlineFuncs.h"
+#include "palMutex.h"
+#include "palSysMemory.h"
+#include "palThread.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace Util
+{
+
+// Passed to ConditionVariable::Wait to sleep until signaled.
+constexpr uint32 InfiniteWait = 0xFFFFFFFF;
+
+// Payloads at least this fraction of the staging buffer size bypass the staging buffer and are written directly.
+constexpr size_t DirectWriteDivisor = 4;
+
+// Pairs of decimal digits for every value in [0, 99], used to convert two digits per division.
+static const char DigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Powers of ten used to scale the fractional part of floating-point values on the fast path.
+static const uint64 PowersOfTen[] =
+{
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+};
+
+// Largest magnitude handled by the PutFloat fast path; larger values would lose integer precision once scaled.
+constexpr double MaxFastFloat = 1e15;
+
+// State of the write-behind thread shared by every BufferedFile which uses asynchronous flushing.  Files hand their
+// full staging buffers to the thread by appending themselves to a singly-linked queue.
+struct WriteBehindQueue
+{
+    WriteBehindQueue()
+        :
+        initResult(Result::Success),
+        refCount(0),
+        pHead(nullptr),
+        pTail(nullptr),
+        exitThread(false)
+    {
+        initResult = lock.Init();
+
+        if (initResult == Result::Success)
+        {
+            initResult = lifetimeLock.Init();
+        }
+
+        if (initResult == Result::Success)
+        {
+            initResult = workCond.Init();
+        }
+
+        if (initResult == Result::Success)
+        {
+            initResult = idleCond.Init();
+        }
+    }
+
+    Result            initResult;   // Result of initializing the synchronization primitives below.
+    Mutex             lock;         // Protects the queue and the pending state of every file.
+    Mutex             lifetimeLock; // Serializes starting and stopping the thread; never taken by the thread itself.
+    ConditionVariable workCond;     // Signaled when a buffer is queued or the thread should exit.
+    ConditionVariable idleCond;     // Signaled whenever the thread finishes writing a buffer.
+    Thread            thread;
+    uint32            refCount;     // Number of BufferedFile objects using the thread.
+    BufferedFile*     pHead;        // Oldest file waiting for its pending buffer to be written.
+    BufferedFile*     pTail;        // Newest file waiting for its pending buffer to be written.
+    bool              exitThread;
+};
+
+// =====================================================================================================================
+// Returns the process-wide write-behind queue.  It is created on first use and destroyed when the driver is unloaded.
+static WriteBehindQueue* GetWriteBehindQueue()
+{
+    static WriteBehindQueue s_writeBehindQueue;
+
+    return &s_writeBehindQueue;
+}
+
+// =====================================================================================================================
+// Formats value in decimal into the end of a buffer of at least 20 characters.  Returns the number of digits written;
+// the digits occupy the last N bytes of the buffer.
+static uint32 FormatDecimal(
+    uint64 value,
+    char*  pBufferEnd)  // [out] One past the last byte of the output buffer.
+{
+    char* pOut = pBufferEnd;
+
+    while (value >= 100)
+    {
+        const uint32 pair = static_cast<uint32>(value % 100) * 2;
+        value /= 100;
+
+        *(--pOut) = DigitPairs[pair + 1];
+        *(--pOut) = DigitPairs[pair];
+    }
+
+    if (value >= 10)
+    {
+        const uint32 pair = static_cast<uint32>(value) * 2;
+        *(--pOut) = DigitPairs[pair + 1];
+        *(--pOut) = DigitPairs[pair];
+    }
+    else
+    {
+        *(--pOut) = static_cast<char>('0' + value);
+    }
+
+    return static_cast<uint32>(pBufferEnd - pOut);
+}
+
+// =====================================================================================================================
+BufferedFile::BufferedFile()
+    :
+    m_fd(-1),
+    m_bufferSize(0),
+    m_allocSize(0),
+    m_activeBuffer(0),
+    m_usedSize(0),
+    m_ioResult(Result::Success),
+    m_asyncFlush(false),
+    m_pPendingData(nullptr),
+    m_pendingSize(0),
+    m_pNextPending(nullptr)
+{
+    for (uint32 idx = 0; idx < NumBuffers; ++idx)
+    {
+        m_pBuffers[idx] = nullptr;
+    }
+}
+
+// =====================================================================================================================
+BufferedFile::~BufferedFile()
+{
+    Close();
+
+    if (m_asyncFlush)
+    {
+        ReleaseWriteBehindThread();
+    }
+
+    if (m_pBuffers[0] != nullptr)
+    {
+        const Result result = VirtualRelease(m_pBuffers[0], m_allocSize);
+        PAL_ASSERT(result == Result::Success);
+    }
+}
+
+// =====================================================================================================================
+// Takes a reference on the shared write-behind thread, starting it if this is the first asynchronous file.
+Result BufferedFile::AcquireWriteBehindThread()
+{
+    WriteBehindQueue*const pQueue = GetWriteBehindQueue();
+    Result                 result = pQueue->initResult;
+
+    if (result == Result::Success)
+    {
+        MutexAuto lifetimeLock(&pQueue->lifetimeLock);
+        MutexAuto lock(&pQueue->lock);
+
+        if (pQueue->refCount == 0)
+        {
+            pQueue->exitThread = false;
+            result = pQueue->thread.Begin(&WriteBehindThreadFunc, pQueue);
+        }
+
+        if (result == Result::Success)
+        {
+            pQueue->refCount++;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Drops a reference on the shared write-behind thread, stopping it once the last asynchronous file is gone.  The caller
+// must not have any buffer still queued.
+void BufferedFile::ReleaseWriteBehindThread()
+{
+    WriteBehindQueue*const pQueue = GetWriteBehindQueue();
+    MutexAuto              lifetimeLock(&pQueue->lifetimeLock);
+
+    pQueue->lock.Lock();
+
+    PAL_ASSERT(pQueue->refCount > 0);
+    const bool stopThread = (--pQueue->refCount == 0);
+
+    if (stopThread)
+    {
+        pQueue->exitThread = true;
+        pQueue->workCond.WakeOne();
+    }
+
+    pQueue->lock.Unlock();
+
+    if (stopThread)
+    {
+        // The lifetime lock keeps other files from restarting the thread until it has been joined.
+        pQueue->thread.Join();
+    }
+}
+
+// =====================================================================================================================
+// Allocates the staging buffers and takes a reference on the write-behind thread the first time the file is opened.
+Result BufferedFile::InitBuffers(
+    size_t bufferSize,
+    bool   asyncFlush)
+{
+    Result result = Result::Success;
+
+    if (m_pBuffers[0] == nullptr)
+    {
+        // Use whole pages so that the staging buffers can be committed straight from the OS.
+        m_bufferSize = Pow2Align(Max<size_t>(bufferSize, 1), VirtualPageSize());
+        m_asyncFlush = asyncFlush;
+
+        const size_t totalSize = m_bufferSize * (m_asyncFlush ? NumBuffers : 1);
+        void*        pMemory   = nullptr;
+
+        result = VirtualReserve(totalSize, &pMemory);
+
+        if (result == Result::Success)
+        {
+            result = VirtualCommit(pMemory, totalSize);
+
+            if (result == Result::Success)
+            {
+                m_pBuffers[0] = static_cast<char*>(pMemory);
+                m_pBuffers[1] = m_asyncFlush ? (m_pBuffers[0] + m_bufferSize) : nullptr;
+                m_allocSize   = totalSize;
+            }
+            else
+            {
+                VirtualRelease(pMemory, totalSize);
+            }
+        }
+
+        if ((result == Result::Success) && m_asyncFlush)
+        {
+            result = AcquireWriteBehindThread();
+
+            if (result != Result::Success)
+            {
+                // Fall back to synchronous flushing rather than failing the open outright.
+                PAL_ALERT_ALWAYS();
+                m_pBuffers[1] = nullptr;
+                m_asyncFlush  = false;
+                result        = Result::Success;
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Opens a file stream for write or append access.
+Result BufferedFile::Open(
+    const char* pFilename,    // Name of file to open.
+    uint32      accessFlags,  // ORed mask of FileAccessMode values describing how the file will be used.
+    size_t      bufferSize,   // Size of each staging buffer in bytes.
+    bool        asyncFlush)   // If true, full staging buffers are written by a background thread.
+{
+    Result result = Result::Success;
+
+    if (m_fd >= 0)
+    {
+        result = Result::ErrorUnavailable;
+    }
+    else if (pFilename == nullptr)
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else if (((accessFlags & ~FileAccessBinary) != FileAccessWrite) &&
+             ((accessFlags & ~FileAccessBinary) != FileAccessAppend))
+    {
+        // Binary and text modes are identical on the platforms we support, so the binary flag is ignored.
+        PAL_ASSERT_ALWAYS();
+        result = Result::ErrorInvalidFlags;
+    }
+
+    if (result == Result::Success)
+    {
+        result = InitBuffers(bufferSize, asyncFlush);
+    }
+
+    if (result == Result::Success)
+    {
+        result = OpenFile(pFilename, accessFlags);
+    }
+
+    if (result == Result::Success)
+    {
+        m_activeBuffer = 0;
+        m_usedSize     = 0;
+        m_ioResult     = Result::Success;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes any staged data to disk and closes the file handle if still open.
+void BufferedFile::Close()
+{
+    if (m_fd >= 0)
+    {
+        SubmitActiveBuffer();
+        WaitForIdle();
+
+        CloseFile();
+    }
+}
+
+// =====================================================================================================================
+// Writes the active staging buffer to disk, or hands it to the flush thread and switches to the other buffer.
+Result BufferedFile::SubmitActiveBuffer()
+{
+    Result result = Result::Success;
+
+    if (m_usedSize > 0)
+    {
+        if (m_asyncFlush)
+        {
+            // The other buffer must be completely written before we can start filling it again.
+            WaitForIdle();
+
+            WriteBehindQueue*const pQueue = GetWriteBehindQueue();
+            MutexAuto              lock(&pQueue->lock);
+
+            m_pPendingData = m_pBuffers[m_activeBuffer];
+            m_pendingSize  = m_usedSize;
+            m_pNextPending = nullptr;
+
+            if (pQueue->pTail != nullptr)
+            {
+                pQueue->pTail->m_pNextPending = this;
+            }
+            else
+            {
+                pQueue->pHead = this;
+            }
+
+            pQueue->pTail = this;
+            pQueue->workCond.WakeOne();
+
+            m_activeBuffer = (m_activeBuffer + 1) % NumBuffers;
+        }
+        else
+        {
+            const FileSpan span = { m_pBuffers[m_activeBuffer], m_usedSize };
+            result = WriteSpans(&span, 1);
+
+            RecordIoResult(result);
+        }
+
+        m_usedSize = 0;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Remembers result if it is the first I/O error since the last Flush().
+void BufferedFile::RecordIoResult(
+    Result result)
+{
+    if (m_asyncFlush)
+    {
+        GetWriteBehindQueue()->lock.Lock();
+    }
+
+    if (m_ioResult == Result::Success)
+    {
+        m_ioResult = result;
+    }
+
+    if (m_asyncFlush)
+    {
+        GetWriteBehindQueue()->lock.Unlock();
+    }
+}
+
+// =====================================================================================================================
+// Blocks until the write-behind thread has finished writing any buffer this file handed off to it.
+void BufferedFile::WaitForIdle()
+{
+    if (m_asyncFlush)
+    {
+        WriteBehindQueue*const pQueue = GetWriteBehindQueue();
+        MutexAuto              lock(&pQueue->lock);
+
+        while (m_pPendingData != nullptr)
+        {
+            pQueue->idleCond.Wait(&pQueue->lock, InfiniteWait);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Finds at least size bytes of free staging space.  The caller must Commit() what it actually uses.  If handing off the
+// current buffer fails its contents are dropped, the error is returned and the space is still valid.
+Result BufferedFile::Reserve(
+    size_t size,
+    char** ppSpace)  // [out] Start of the free staging space.
+{
+    PAL_ASSERT(size <= m_bufferSize);
+
+    Result result = Result::Success;
+
+    if ((m_usedSize + size) > m_bufferSize)
+    {
+        result = SubmitActiveBuffer();
+    }
+
+    *ppSpace = m_pBuffers[m_activeBuffer] + m_usedSize;
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes a stream of bytes to the file.
+Result BufferedFile::Write(
+    const void* pBuffer,     // [in] Buffer to write to the file.
+    size_t      bufferSize)  // Size of the buffer in bytes.
+{
+    Result result = Result::Success;
+
+    if (m_fd < 0)
+    {
+        result = Result::ErrorUnavailable;
+    }
+    else if (pBuffer == nullptr)
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else if (bufferSize == 0)
+    {
+        result = Result::ErrorInvalidValue;
+    }
+    else
+    {
+        const FileSpan span = { pBuffer, bufferSize };
+        result = WriteVectored(&span, 1);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes a list of byte streams to the file.  Small spans are copied into the staging buffer; if any large span is
+// present, the staged data and all of the spans are written together with a single vectored write.
+Result BufferedFile::WriteVectored(
+    const FileSpan* pSpans,
+    uint32          spanCount)
+{
+    Result result = Result::Success;
+
+    if (m_fd < 0)
+    {
+        result = Result::ErrorUnavailable;
+    }
+    else if ((pSpans == nullptr) && (spanCount > 0))
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else
+    {
+        size_t totalSize = 0;
+        for (uint32 idx = 0; idx < spanCount; ++idx)
+        {
+            totalSize += pSpans[idx].size;
+        }
+
+        if (totalSize < (m_bufferSize / DirectWriteDivisor))
+        {
+            for (uint32 idx = 0; (idx < spanCount) && (result == Result::Success); ++idx)
+            {
+                if (pSpans[idx].size > 0)
+                {
+                    char* pSpace = nullptr;
+                    result = Reserve(pSpans[idx].size, &pSpace);
+
+                    if (result == Result::Success)
+                    {
+                        memcpy(pSpace, pSpans[idx].pData, pSpans[idx].size);
+                        Commit(pSpans[idx].size);
+                    }
+                }
+            }
+        }
+        else
+        {
+            // Anything previously handed to the flush thread must land on disk before this data does.
+            WaitForIdle();
+
+            constexpr uint32 MaxSpans = 16;
+            FileSpan         spans[MaxSpans];
+            uint32           count    = 0;
+
+            if (m_usedSize > 0)
+            {
+                spans[count].pData = m_pBuffers[m_activeBuffer];
+                spans[count].size  = m_usedSize;
+                ++count;
+            }
+
+            for (uint32 idx = 0; (idx < spanCount) && (result == Result::Success); ++idx)
+            {
+                spans[count++] = pSpans[idx];
+
+                if ((count == MaxSpans) || ((idx + 1) == spanCount))
+                {
+                    result = WriteSpans(&spans[0], count);
+                    count  = 0;
+                }
+            }
+
+            m_usedSize = 0;
+
+            RecordIoResult(result);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Prints a formatted string to the file.
+Result BufferedFile::Printf(
+    const char* pFormatStr,  // Printf-style format string.
+    ...)                     // Printf-style argument list.
+{
+    va_list argList;
+    va_start(argList, pFormatStr);
+    const Result result = VPrintf(pFormatStr, argList);
+    va_end(argList);
+
+    return result;
+}
+
+// =====================================================================================================================
+// Prints a formatted string to the file.  The string is formatted directly into the staging buffer when it fits.
+Result BufferedFile::VPrintf(
+    const char* pFormatStr,  // Printf-style format string.
+    va_list     argList)     // Pre-started variable argument list.
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_fd >= 0)
+    {
+        result = Result::Success;
+
+        va_list argListCopy;
+        va_copy(argListCopy, argList);
+
+        // vsnprintf always needs room for the null terminator even though we never write it to the file.
+        size_t available = m_bufferSize - m_usedSize;
+        int32  length    = vsnprintf(m_pBuffers[m_activeBuffer] + m_usedSize, available, pFormatStr, argList);
+
+        if (length < 0)
+        {
+            result = Result::ErrorUnknown;
+        }
+        else if (static_cast<size_t>(length) < available)
+        {
+            Commit(length);
+        }
+        else if (static_cast<size_t>(length) < m_bufferSize)
+        {
+            // It didn't fit in the space left over but will fit in an empty buffer.
+            result = SubmitActiveBuffer();
+
+            if (result == Result::Success)
+            {
+                length = vsnprintf(m_pBuffers[m_activeBuffer], m_bufferSize, pFormatStr, argListCopy);
+                Commit(length);
+            }
+        }
+        else
+        {
+            // Too large to stage at all; let the C runtime write it directly after the data that precedes it.
+            result = SubmitActiveBuffer();
+            WaitForIdle();
+
+            if (result == Result::Success)
+            {
+                result = WriteFormatted(pFormatStr, argListCopy);
+                RecordIoResult(result);
+            }
+        }
+
+        va_end(argListCopy);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes a single character to the file.
+Result BufferedFile::PutChar(
+    char c)
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_fd >= 0)
+    {
+        char* pSpace = nullptr;
+        result = Reserve(1, &pSpace);
+
+        if (result == Result::Success)
+        {
+            *pSpace = c;
+            Commit(1);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes a null-terminated string to the file.
+Result BufferedFile::PutString(
+    const char* pString)
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (pString == nullptr)
+    {
+        result = Result::ErrorInvalidPointer;
+    }
+    else if (m_fd >= 0)
+    {
+        const FileSpan span = { pString, strlen(pString) };
+        result = WriteVectored(&span, 1);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes an unsigned integer in decimal.
+Result BufferedFile::PutUint(
+    uint64 value)
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_fd >= 0)
+    {
+        char         digits[20];
+        const uint32 length = FormatDecimal(value, &digits[0] + sizeof(digits));
+
+        char* pSpace = nullptr;
+        result = Reserve(length, &pSpace);
+
+        if (result == Result::Success)
+        {
+            memcpy(pSpace, &digits[sizeof(digits) - length], length);
+            Commit(length);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes a signed integer in decimal.
+Result BufferedFile::PutInt(
+    int64 value)
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_fd >= 0)
+    {
+        // Negate in unsigned arithmetic so that INT64_MIN is handled correctly.
+        const uint64 magnitude = (value < 0) ? (0 - static_cast<uint64>(value)) : static_cast<uint64>(value);
+
+        char   digits[21];
+        uint32 length = FormatDecimal(magnitude, &digits[0] + sizeof(digits));
+
+        if (value < 0)
+        {
+            digits[sizeof(digits) - (++length)] = '-';
+        }
+
+        char* pSpace = nullptr;
+        result = Reserve(length, &pSpace);
+
+        if (result == Result::Success)
+        {
+            memcpy(pSpace, &digits[sizeof(digits) - length], length);
+            Commit(length);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes an unsigned integer in zero-padded lowercase hexadecimal.
+Result BufferedFile::PutHex(
+    uint64 value,
+    uint32 minDigits)
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_fd >= 0)
+    {
+        constexpr uint32 MaxDigits = 16;
+
+        const uint32 significant = (value == 0) ? 1 : ((Log2(value) / 4) + 1);
+        const uint32 length      = Max(significant, Min(minDigits, MaxDigits));
+
+        char* pOut = nullptr;
+        result = Reserve(length, &pOut);
+
+        if (result == Result::Success)
+        {
+            for (uint32 idx = length; idx > 0; --idx)
+            {
+                pOut[idx - 1] = "0123456789abcdef"[value & 0xF];
+                value >>= 4;
+            }
+
+            Commit(length);
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes a floating-point value in fixed-point notation.  Values small enough to be scaled into a 64-bit integer are
+// formatted without the C runtime; the result matches printf's "%.*f" under the default rounding mode.
+Result BufferedFile::PutFloat(
+    double value,
+    uint32 fracDigits)
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_fd >= 0)
+    {
+        const double magnitude = std::fabs(value);
+
+        if ((std::isfinite(value) == false)           ||
+            (fracDigits >= ArrayLen(PowersOfTen))     ||
+            ((magnitude * PowersOfTen[fracDigits]) >= MaxFastFloat))
+        {
+            result = Printf("%.*f", fracDigits, value);
+        }
+        else
+        {
+            const uint64 scale   = PowersOfTen[fracDigits];
+            const double product = magnitude * scale;
+            double       rounded = std::nearbyint(product);
+
+            // The product was itself rounded, which only matters if it landed exactly halfway between two integers.
+            // In that case the exact product decides which way to round, just like printf's exact decimal expansion.
+            const double tieDelta = product - rounded;
+            if ((tieDelta == 0.5) || (tieDelta == -0.5))
+            {
+                const double error = std::fma(magnitude, static_cast<double>(scale), -product);
+
+                if ((tieDelta > 0) && (error > 0))
+                {
+                    rounded += 1.0;
+                }
+                else if ((tieDelta < 0) && (error < 0))
+                {
+                    rounded -= 1.0;
+                }
+            }
+
+            const uint64 scaled = static_cast<uint64>(rounded);
+
+            // Like printf, negative values which round to zero still print their sign.
+            result = std::signbit(value) ? PutChar('-') : Result::Success;
+
+            if (result == Result::Success)
+            {
+                result = PutUint(scaled / scale);
+            }
+
+            if ((result == Result::Success) && (fracDigits > 0))
+            {
+                char   digits[20];
+                uint32 length = FormatDecimal(scaled % scale, &digits[0] + sizeof(digits));
+
+                char* pOut = nullptr;
+                result = Reserve(fracDigits + 1, &pOut);
+
+                if (result == Result::Success)
+                {
+                    pOut[0] = '.';
+                    memset(pOut + 1, '0', fracDigits - length);
+                    memcpy(pOut + 1 + (fracDigits - length), &digits[sizeof(digits) - length], length);
+                    Commit(fracDigits + 1);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes all staged data to the OS.  Returns the first error encountered since the previous Flush().
+Result BufferedFile::Flush()
+{
+    Result result = Result::ErrorUnavailable;
+
+    if (m_fd >= 0)
+    {
+        SubmitActiveBuffer();
+
+        if (m_asyncFlush)
+        {
+            GetWriteBehindQueue()->lock.Lock();
+        }
+
+        result     = m_ioResult;
+        m_ioResult = Result::Success;
+
+        if (m_asyncFlush)
+        {
+            GetWriteBehindQueue()->lock.Unlock();
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Writes the buffer this file handed off to the write-behind thread.  Called by the write-behind thread with the queue
+// lock held; the lock is dropped during the write so that other files can keep queueing buffers.
+void BufferedFile::WritePendingData()
+{
+    WriteBehindQueue*const pQueue = GetWriteBehindQueue();
+    const FileSpan         span   = { m_pPendingData, m_pendingSize };
+
+    pQueue->lock.Unlock();
+    const Result result = WriteSpans(&span, 1);
+    pQueue->lock.Lock();
+
+    if (m_ioResult == Result::Success)
+    {
+        m_ioResult = result;
+    }
+
+    m_pPendingData = nullptr;
+    m_pendingSize  = 0;
+}
+
+// =====================================================================================================================
+// Entry point of the shared write-behind thread.  Writes queued buffers in the order they were handed off until asked
+// to exit.
+void BufferedFile::WriteBehindThreadFunc(
+    void* pParameter)
+{
+    WriteBehindQueue*const pQueue = static_cast<WriteBehindQueue*>(pParameter);
+
+    pQueue->lock.Lock();
+
+    while (true)
+    {
+        while ((pQueue->pHead == nullptr) && (pQueue->exitThread == false))
+        {
+            pQueue->workCond.Wait(&pQueue->lock, InfiniteWait);
+        }
+
+        BufferedFile*const pFile = pQueue->pHead;
+
+        if (pFile != nullptr)
+        {
+            pQueue->pHead = pFile->m_pNextPending;
+
+            if (pQueue->pHead == nullptr)
+            {
+                pQueue->pTail = nullptr;
+            }
+
+            pFile->m_pNextPending = nullptr;
+            pFile->WritePendingData();
+
+            // Several files may be waiting on this condition, each for its own buffer.
+            pQueue->idleCond.WakeAll();
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    pQueue->lock.Unlock();
+}
+
+} // Util
@@ -0,0 +1,131 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "palAssert.h"
+#include "palBufferedFile.h"
+#include "palInlineFuncs.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace Util
+{
+
+// =====================================================================================================================
+// Opens the file descriptor backing the stream. The access flags have already been validated by Open().
+Result BufferedFile::OpenFile(
+    const char* pFilename,
+    uint32      accessFlags)
+{
+    Result result = Result::Success;
+
+    const int32 flags = ((accessFlags & FileAccessAppend) != 0) ? (O_WRONLY | O_CREAT | O_APPEND)
+                                                                : (O_WRONLY | O_CREAT | O_TRUNC);
+
+    m_fd = open(pFilename, flags | O_CLOEXEC, 0666);
+
+    if (m_fd < 0)
+    {
+        result = Result::ErrorUnknown;
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Closes the file descriptor backing the stream.
+void BufferedFile::CloseFile()
+{
+    close(m_fd);
+    m_fd = -1;
+}
+
+// =====================================================================================================================
+// Writes the given spans to the file descriptor, retrying partial and interrupted writes.  Called from either the
+// owning thread or the flush thread, but never both at once.
+Result BufferedFile::WriteSpans(
+    const FileSpan* pSpans,
+    uint32          spanCount)
+{
+    Result result = Result::Success;
+
+    constexpr uint32 MaxSpansPerCall = 64;
+    iovec            vectors[MaxSpansPerCall];
+
+    uint32 spanIdx    = 0;
+    size_t spanOffset = 0;
+
+    while ((spanIdx < spanCount) && (result == Result::Success))
+    {
+        // Gather as many of the remaining spans as will fit in one call.
+        uint32 vectorCount = 0;
+        for (uint32 idx = spanIdx; (idx < spanCount) && (vectorCount < MaxSpansPerCall); ++idx)
+        {
+            const size_t skip = (idx == spanIdx) ? spanOffset : 0;
+
+            vectors[vectorCount].iov_base = const_cast<void*>(VoidPtrInc(pSpans[idx].pData, skip));
+            vectors[vectorCount].iov_len  = pSpans[idx].size - skip;
+            ++vectorCount;
+        }
+
+        const ssize_t written = writev(m_fd, &vectors[0], static_cast<int32>(vectorCount));
+
+        if (written < 0)
+        {
+            if (errno != EINTR)
+            {
+                result = Result::ErrorUnknown;
+            }
+        }
+        else
+        {
+            // Advance past everything that was written; the OS may stop partway through any span.
+            size_t remaining = static_cast<size_t>(written);
+            while ((spanIdx < spanCount) && (remaining >= (pSpans[spanIdx].size - spanOffset)))
+            {
+                remaining -= (pSpans[spanIdx].size - spanOffset);
+                spanOffset = 0;
+                ++spanIdx;
+            }
+
+            spanOffset += remaining;
+        }
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+// Formats a string straight to the file descriptor; used for strings too large to stage.
+Result BufferedFile::WriteFormatted(
+    const char* pFormatStr,
+    va_list     argList)
+{
+    return (vdprintf(m_fd, pFormatStr, argList) < 0) ? Result::ErrorUnknown : Result::Success;
+}
+
+} // Util
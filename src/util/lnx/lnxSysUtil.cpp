@@ -32,6 +32,8 @@
 #include "palHashMapImpl.h"
 
 #include <cwchar>
+#include <dlfcn.h>
+#include <execinfo.h>
 #include <errno.h>
 #include <libgen.h>
 #include <linux/limits.h>
@@ -907,6 +909,62 @@ size_t DumpStackTrace(
     return 0;
 }
 
+// =====================================================================================================================
+uint32 CaptureStackFrames(
+    void**  ppFrames,
+    uint32  maxFrames,
+    uint32  skipFrames)
+{
+    constexpr uint32 MaxCapturedFrames = 64;
+    void*            pCaptured[MaxCapturedFrames];
+
+    // The first captured frame is this function's own, which is always skipped.
+    const uint32 numCaptured = static_cast<uint32>(backtrace(&pCaptured[0],
+                                                             static_cast<int>(Min(maxFrames + skipFrames + 1,
+                                                                                  MaxCapturedFrames))));
+    const uint32 firstFrame  = Min(skipFrames + 1, numCaptured);
+    const uint32 numFrames   = Min(numCaptured - firstFrame, maxFrames);
+
+    memcpy(ppFrames, &pCaptured[firstFrame], numFrames * sizeof(void*));
+
+    return numFrames;
+}
+
+// =====================================================================================================================
+void DescribeCodeAddress(
+    const void* pAddress,
+    char*       pOutput,
+    size_t      bufSize)
+{
+    Dl_info info = {};
+
+    // dladdr() doesn't allocate, unlike backtrace_symbols().
+    if ((dladdr(pAddress, &info) != 0) && (info.dli_fname != nullptr))
+    {
+        const char*const pModule = strrchr(info.dli_fname, '/');
+
+        if (info.dli_sname != nullptr)
+        {
+            Snprintf(pOutput, bufSize, "%s(%s+0x%zx) [%p]",
+                     (pModule != nullptr) ? (pModule + 1) : info.dli_fname,
+                     info.dli_sname,
+                     VoidPtrDiff(pAddress, info.dli_saddr),
+                     pAddress);
+        }
+        else
+        {
+            Snprintf(pOutput, bufSize, "%s(+0x%zx) [%p]",
+                     (pModule != nullptr) ? (pModule + 1) : info.dli_fname,
+                     VoidPtrDiff(pAddress, info.dli_fbase),
+                     pAddress);
+        }
+    }
+    else
+    {
+        Snprintf(pOutput, bufSize, "[%p]", pAddress);
+    }
+}
+
 // =====================================================================================================================
 void BeepSound(
     uint32 frequency,
@@ -0,0 +1,575 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "palSlabAllocator.h"
+#include "palInlineFuncs.h"
+#include "palMutex.h"
+#include "palThread.h"
+
+namespace Util
+{
+
+// Object sizes of the size classes.  Every size is a multiple of 16 so that objects are at least as aligned as the
+// default malloc alignment; objects are also aligned to every power of two which divides their size.
+constexpr uint32 SizeClassBytes[] = { 16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024 };
+
+// Free objects cached by a single thread.
+struct SlabAllocator::ThreadCache
+{
+    FreeObject*  pFreeLists[NumSizeClasses];
+    uint32       freeCounts[NumSizeClasses];
+    ThreadCache* pNext;                      // Next cache in the allocator's list of every cache.
+};
+
+// =====================================================================================================================
+SlabAllocator::SlabAllocator(
+    const AllocCallbacks& clientCb,
+    size_t                memoryCeiling)
+    :
+    m_clientCb(clientCb),
+    m_memoryCeiling((memoryCeiling != 0) ? memoryCeiling : DefaultMemoryCeiling),
+    m_keyCreated(false),
+    m_pSlabTable(nullptr),
+    m_slabTableMask(0),
+    m_passThrough(false),
+    m_pCacheList(nullptr),
+    m_slabBytes(0),
+    m_threadCacheCount(0),
+    m_refillCount(0),
+    m_flushCount(0),
+    m_fallbackAllocCount(0)
+{
+    static_assert(ArrayLen(SizeClassBytes) == NumSizeClasses, "Mismatched size class table!");
+    static_assert(SizeClassBytes[NumSizeClasses - 1] == MaxObjectSize, "The largest size class must be MaxObjectSize!");
+
+    uint32 sizeClass = 0;
+    for (uint32 lookup = 0; lookup < NumSizeLookups; ++lookup)
+    {
+        while (SizeClassBytes[sizeClass] < (lookup * SizeLookupGranularity))
+        {
+            ++sizeClass;
+        }
+        m_sizeLookup[lookup] = static_cast<uint8>(sizeClass);
+    }
+
+    for (uint32 idx = 0; idx < NumSizeClasses; ++idx)
+    {
+        // Move about 8 KB per batch, but at least a few objects for the largest classes.
+        m_batchSizes[idx] = Min(Max(8192u / SizeClassBytes[idx], 4u), 64u);
+
+        SizeClass*const pClass = &m_classes[idx];
+        pClass->pFreeList    = nullptr;
+        pClass->freeCount    = 0;
+        pClass->pCarveCursor = nullptr;
+        pClass->pCarveEnd    = nullptr;
+    }
+}
+
+// =====================================================================================================================
+// Frees every thread cache and returns every slab to the client's callbacks.
+SlabAllocator::~SlabAllocator()
+{
+    if (m_keyCreated)
+    {
+        DeleteThreadLocalKey(m_cacheKey);
+    }
+
+    while (m_pCacheList != nullptr)
+    {
+        ThreadCache*const pCache = m_pCacheList;
+        m_pCacheList = pCache->pNext;
+
+        m_clientCb.pfnFree(m_clientCb.pClientData, pCache);
+    }
+
+    if (m_pSlabTable != nullptr)
+    {
+        for (uint32 slot = 0; slot <= m_slabTableMask; ++slot)
+        {
+            const uintptr_t entry = m_pSlabTable[slot];
+
+            if (entry != 0)
+            {
+                m_clientCb.pfnFree(m_clientCb.pClientData, reinterpret_cast<void*>(entry & ~(SlabSize - 1)));
+            }
+        }
+
+        m_clientCb.pfnFree(m_clientCb.pClientData, const_cast<uintptr_t*>(m_pSlabTable));
+    }
+}
+
+// =====================================================================================================================
+Result SlabAllocator::Init()
+{
+    Result result = Result::Success;
+
+    for (uint32 idx = 0; (result == Result::Success) && (idx < NumSizeClasses); ++idx)
+    {
+        result = m_classes[idx].lock.Init();
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_slabLock.Init();
+    }
+
+    if (result == Result::Success)
+    {
+        result = m_cacheListLock.Init();
+    }
+
+    if (result == Result::Success)
+    {
+        // Keep the table at most half full, even if every byte under the ceiling is allocated as slabs.
+        const size_t maxSlabs  = (m_memoryCeiling / SlabSize);
+        const uint32 tableSize = Pow2Pad(static_cast<uint32>(Max<size_t>(2 * maxSlabs, 64)));
+
+        m_slabTableMask = (tableSize - 1);
+        m_pSlabTable    = static_cast<uintptr_t*>(m_clientCb.pfnAlloc(m_clientCb.pClientData,
+                                                                      tableSize * sizeof(uintptr_t),
+                                                                      alignof(uintptr_t),
+                                                                      AllocInternal));
+        if (m_pSlabTable != nullptr)
+        {
+            memset(const_cast<uintptr_t*>(m_pSlabTable), 0, tableSize * sizeof(uintptr_t));
+        }
+        else
+        {
+            result = Result::ErrorOutOfMemory;
+        }
+    }
+
+    if (result == Result::Success)
+    {
+        // No destructor is installed: a thread's cache lives until the allocator is destroyed, even if the thread
+        // exits first.
+        result       = CreateThreadLocalKey(&m_cacheKey);
+        m_keyCreated = (result == Result::Success);
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+Result SlabAllocator::Create(
+    const AllocCallbacks& clientCb,
+    size_t                memoryCeiling,
+    SlabAllocator**       ppAllocator)
+{
+    PAL_ASSERT(ppAllocator != nullptr);
+
+    ForwardAllocator     allocator(clientCb);
+    SlabAllocator*const  pAllocator = PAL_NEW(SlabAllocator, &allocator, AllocInternal)(clientCb, memoryCeiling);
+    Result               result     = (pAllocator != nullptr) ? pAllocator->Init() : Result::ErrorOutOfMemory;
+
+    if (result == Result::Success)
+    {
+        *ppAllocator = pAllocator;
+    }
+    else if (pAllocator != nullptr)
+    {
+        pAllocator->Destroy();
+    }
+
+    return result;
+}
+
+// =====================================================================================================================
+void SlabAllocator::Destroy()
+{
+    ForwardAllocator allocator(m_clientCb);
+    PAL_DELETE_THIS(SlabAllocator, &allocator);
+}
+
+// =====================================================================================================================
+void SlabAllocator::GetAllocCallbacks(
+    AllocCallbacks* pAllocCb)
+{
+    PAL_ASSERT(pAllocCb != nullptr);
+
+    pAllocCb->pClientData = this;
+    pAllocCb->pfnAlloc    = SlabAlloc;
+    pAllocCb->pfnFree     = SlabFree;
+}
+
+// =====================================================================================================================
+void SlabAllocator::GetStats(
+    SlabAllocatorStats* pStats
+    ) const
+{
+    PAL_ASSERT(pStats != nullptr);
+
+    pStats->memoryCeiling      = m_memoryCeiling;
+    pStats->slabBytes          = static_cast<size_t>(m_slabBytes);
+    pStats->threadCacheCount   = m_threadCacheCount;
+    pStats->refillCount        = m_refillCount;
+    pStats->flushCount         = m_flushCount;
+    pStats->fallbackAllocCount = m_fallbackAllocCount;
+    pStats->passThrough        = m_passThrough;
+}
+
+// =====================================================================================================================
+uint32 SlabAllocator::SlabTableSlot(
+    uintptr_t slabBase
+    ) const
+{
+    // Fibonacci hashing of the slab number.
+    return static_cast<uint32>(((slabBase / SlabSize) * 0x9E3779B97F4A7C15ull) >> 32) & m_slabTableMask;
+}
+
+// =====================================================================================================================
+// Returns the size class of the slab which holds the given memory, or NumSizeClasses if it isn't part of any slab.
+uint32 SlabAllocator::FindSlabSizeClass(
+    const void* pMem
+    ) const
+{
+    const uintptr_t slabBase  = reinterpret_cast<uintptr_t>(pMem) & ~(SlabSize - 1);
+    uint32          slot      = SlabTableSlot(slabBase);
+    uint32          sizeClass = NumSizeClasses;
+
+    // The table is never more than half full, so an empty slot is always found.
+    for (uintptr_t entry = m_pSlabTable[slot]; entry != 0; entry = m_pSlabTable[slot])
+    {
+        if ((entry & ~(SlabSize - 1)) == slabBase)
+        {
+            sizeClass = static_cast<uint32>(entry & (SlabSize - 1)) - 1;
+            break;
+        }
+
+        slot = (slot + 1) & m_slabTableMask;
+    }
+
+    return sizeClass;
+}
+
+// =====================================================================================================================
+// Returns the smallest size class which fits an allocation, or NumSizeClasses if no class fits.
+uint32 SlabAllocator::SizeClassIndex(
+    size_t size,
+    size_t alignment
+    ) const
+{
+    uint32 sizeClass = NumSizeClasses;
+
+    if (size <= MaxObjectSize)
+    {
+        sizeClass = m_sizeLookup[(size + SizeLookupGranularity - 1) / SizeLookupGranularity];
+
+        while ((sizeClass < NumSizeClasses) && ((SizeClassBytes[sizeClass] & (alignment - 1)) != 0))
+        {
+            ++sizeClass;
+        }
+    }
+
+    return sizeClass;
+}
+
+// =====================================================================================================================
+// Allocates a new slab for a size class and makes it the class's carve slab.  The class's lock must be held.  Returns
+// false if the memory ceiling has been reached or the slab couldn't be allocated.
+bool SlabAllocator::AllocSlab(
+    uint32 sizeClass)
+{
+    MutexAuto lock(&m_slabLock);
+
+    uint8* pSlab = nullptr;
+
+    if ((m_passThrough == false) && ((m_slabBytes + SlabSize) <= m_memoryCeiling))
+    {
+        pSlab = static_cast<uint8*>(m_clientCb.pfnAlloc(m_clientCb.pClientData, SlabSize, SlabSize, AllocInternal));
+    }
+
+    if ((pSlab != nullptr) && (IsPow2Aligned(reinterpret_cast<uintptr_t>(pSlab), SlabSize) == false))
+    {
+        // Frees find an object's slab by masking its address, so a slab must be aligned to its size. Callbacks which
+        // ignore the requested alignment won't honor it next time either, so stop allocating slabs altogether.
+        PAL_ALERT_ALWAYS();
+
+        m_clientCb.pfnFree(m_clientCb.pClientData, pSlab);
+        pSlab         = nullptr;
+        m_passThrough = true;
+    }
+
+    if (pSlab != nullptr)
+    {
+        const uintptr_t slabBase = reinterpret_cast<uintptr_t>(pSlab);
+        uint32          slot     = SlabTableSlot(slabBase);
+
+        while (m_pSlabTable[slot] != 0)
+        {
+            slot = (slot + 1) & m_slabTableMask;
+        }
+
+        // Readers only find this slot through objects handed out under a size class lock after this store.
+        m_pSlabTable[slot] = (slabBase | (sizeClass + 1));
+        m_slabBytes       += SlabSize;
+
+        const size_t objectSize = SizeClassBytes[sizeClass];
+        SizeClass*   pClass     = &m_classes[sizeClass];
+
+        pClass->pCarveCursor = pSlab;
+        pClass->pCarveEnd    = pSlab + ((SlabSize / objectSize) * objectSize);
+    }
+
+    return (pSlab != nullptr);
+}
+
+// =====================================================================================================================
+// Takes a single object straight from a size class's shared free list, or from new slab memory, for threads which
+// don't have a cache.  Returns null if the class is out of objects and no slab can be allocated.
+void* SlabAllocator::AllocShared(
+    uint32 sizeClass)
+{
+    SizeClass*const pClass  = &m_classes[sizeClass];
+    void*           pObject = nullptr;
+
+    MutexAuto lock(&pClass->lock);
+
+    if (pClass->pFreeList != nullptr)
+    {
+        pObject           = pClass->pFreeList;
+        pClass->pFreeList = pClass->pFreeList->pNext;
+        --pClass->freeCount;
+    }
+    else if ((pClass->pCarveCursor != pClass->pCarveEnd) || AllocSlab(sizeClass))
+    {
+        pObject               = pClass->pCarveCursor;
+        pClass->pCarveCursor += SizeClassBytes[sizeClass];
+    }
+
+    return pObject;
+}
+
+// =====================================================================================================================
+// Returns the calling thread's cache, creating it on the thread's first allocation.  Returns null if the thread has no
+// cache and one couldn't be created, either because MaxThreadCaches threads already have one or for lack of memory.
+SlabAllocator::ThreadCache* SlabAllocator::GetThreadCache()
+{
+    ThreadCache* pCache = static_cast<ThreadCache*>(GetThreadLocalValue(m_cacheKey));
+
+    if ((pCache == nullptr) && (m_threadCacheCount < MaxThreadCaches))
+    {
+        MutexAuto lock(&m_cacheListLock);
+
+        if (m_threadCacheCount < MaxThreadCaches)
+        {
+            pCache = static_cast<ThreadCache*>(m_clientCb.pfnAlloc(m_clientCb.pClientData,
+                                                                   sizeof(ThreadCache),
+                                                                   alignof(ThreadCache),
+                                                                   AllocInternal));
+        }
+
+        if (pCache != nullptr)
+        {
+            memset(pCache, 0, sizeof(*pCache));
+
+            if (SetThreadLocalValue(m_cacheKey, pCache) == Result::Success)
+            {
+                pCache->pNext = m_pCacheList;
+                m_pCacheList  = pCache;
+                AtomicIncrement(&m_threadCacheCount);
+            }
+            else
+            {
+                m_clientCb.pfnFree(m_clientCb.pClientData, pCache);
+                pCache = nullptr;
+            }
+        }
+    }
+
+    return pCache;
+}
+
+// =====================================================================================================================
+// Moves up to one batch of free objects from a size class's shared free list, or from new slab memory, into a thread
+// cache.
+void SlabAllocator::RefillThreadCache(
+    ThreadCache* pCache,
+    uint32       sizeClass)
+{
+    SizeClass*const pClass     = &m_classes[sizeClass];
+    const uint32    batchSize  = m_batchSizes[sizeClass];
+    const size_t    objectSize = SizeClassBytes[sizeClass];
+    uint32          moved      = 0;
+
+    MutexAuto lock(&pClass->lock);
+
+    while ((moved < batchSize) && (pClass->pFreeList != nullptr))
+    {
+        FreeObject*const pObject = pClass->pFreeList;
+        pClass->pFreeList = pObject->pNext;
+
+        pObject->pNext                  = pCache->pFreeLists[sizeClass];
+        pCache->pFreeLists[sizeClass]   = pObject;
+        ++moved;
+    }
+
+    pClass->freeCount -= moved;
+
+    while (moved < batchSize)
+    {
+        if ((pClass->pCarveCursor == pClass->pCarveEnd) && (AllocSlab(sizeClass) == false))
+        {
+            break;
+        }
+
+        FreeObject*const pObject = reinterpret_cast<FreeObject*>(pClass->pCarveCursor);
+        pClass->pCarveCursor += objectSize;
+
+        pObject->pNext                = pCache->pFreeLists[sizeClass];
+        pCache->pFreeLists[sizeClass] = pObject;
+        ++moved;
+    }
+
+    if (moved > 0)
+    {
+        pCache->freeCounts[sizeClass] += moved;
+        AtomicIncrement64(&m_refillCount);
+    }
+}
+
+// =====================================================================================================================
+// Returns the given number of free objects from a thread cache to the size class's shared free list.
+void SlabAllocator::FlushThreadCache(
+    ThreadCache* pCache,
+    uint32       sizeClass,
+    uint32       count)
+{
+    PAL_ASSERT(count <= pCache->freeCounts[sizeClass]);
+
+    SizeClass*const pClass = &m_classes[sizeClass];
+
+    // Unlink the objects from the cache before taking the lock.
+    FreeObject*const pFirst = pCache->pFreeLists[sizeClass];
+    FreeObject*      pLast  = pFirst;
+
+    for (uint32 idx = 1; idx < count; ++idx)
+    {
+        pLast = pLast->pNext;
+    }
+
+    pCache->pFreeLists[sizeClass]  = pLast->pNext;
+    pCache->freeCounts[sizeClass] -= count;
+
+    MutexAuto lock(&pClass->lock);
+
+    pLast->pNext       = pClass->pFreeList;
+    pClass->pFreeList  = pFirst;
+    pClass->freeCount += count;
+
+    AtomicIncrement64(&m_flushCount);
+}
+
+// =====================================================================================================================
+void* PAL_STDCALL SlabAllocator::SlabAlloc(
+    void*           pClientData,
+    size_t          size,
+    size_t          alignment,
+    SystemAllocType allocType)
+{
+    SlabAllocator*const pThis     = static_cast<SlabAllocator*>(pClientData);
+    const uint32        sizeClass = pThis->SizeClassIndex(size, alignment);
+    void*               pMem      = nullptr;
+
+    if (sizeClass < NumSizeClasses)
+    {
+        ThreadCache*const pCache = pThis->GetThreadCache();
+
+        if (pCache != nullptr)
+        {
+            if (pCache->freeCounts[sizeClass] == 0)
+            {
+                pThis->RefillThreadCache(pCache, sizeClass);
+            }
+
+            FreeObject*const pObject = pCache->pFreeLists[sizeClass];
+
+            if (pObject != nullptr)
+            {
+                pCache->pFreeLists[sizeClass] = pObject->pNext;
+                --pCache->freeCounts[sizeClass];
+                pMem = pObject;
+            }
+        }
+        else
+        {
+            pMem = pThis->AllocShared(sizeClass);
+        }
+    }
+
+    if (pMem == nullptr)
+    {
+        AtomicIncrement64(&pThis->m_fallbackAllocCount);
+        pMem = pThis->m_clientCb.pfnAlloc(pThis->m_clientCb.pClientData, size, alignment, allocType);
+    }
+
+    return pMem;
+}
+
+// =====================================================================================================================
+void PAL_STDCALL SlabAllocator::SlabFree(
+    void* pClientData,
+    void* pMem)
+{
+    SlabAllocator*const pThis     = static_cast<SlabAllocator*>(pClientData);
+    const uint32        sizeClass = (pMem != nullptr) ? pThis->FindSlabSizeClass(pMem) : NumSizeClasses;
+
+    if (sizeClass < NumSizeClasses)
+    {
+        FreeObject*const pObject = static_cast<FreeObject*>(pMem);
+
+        // Don't create a cache for a thread which only frees.
+        ThreadCache*const pCache = static_cast<ThreadCache*>(GetThreadLocalValue(pThis->m_cacheKey));
+
+        if (pCache != nullptr)
+        {
+            pObject->pNext                = pCache->pFreeLists[sizeClass];
+            pCache->pFreeLists[sizeClass] = pObject;
+
+            // Keep one batch in the cache so that alternating allocations and frees don't bounce a batch back and
+            // forth.
+            const uint32 batchSize = pThis->m_batchSizes[sizeClass];
+            if (++pCache->freeCounts[sizeClass] > (2 * batchSize))
+            {
+                pThis->FlushThreadCache(pCache, sizeClass, batchSize);
+            }
+        }
+        else
+        {
+            SizeClass*const pClass = &pThis->m_classes[sizeClass];
+            MutexAuto       lock(&pClass->lock);
+
+            pObject->pNext    = pClass->pFreeList;
+            pClass->pFreeList = pObject;
+            ++pClass->freeCount;
+        }
+    }
+    else
+    {
+        pThis->m_clientCb.pfnFree(pThis->m_clientCb.pClientData, pMem);
+    }
+}
+
+} // Util
@@ -0,0 +1,413 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/fence.h"
+#include "palDevice.h"
+#include "palFence.h"
+#include "palLib.h"
+#include "palPlatform.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Pal;
+
+namespace
+{
+
+// How long a test waits for the notifier before deciding that a callback was lost.
+constexpr std::chrono::seconds CallbackTimeout(10);
+
+// =====================================================================================================================
+// Records the order in which callbacks were invoked.
+struct CallbackLog
+{
+    std::mutex              lock;
+    std::condition_variable invoked;
+    std::vector<uint32>     order;
+
+    // Waits until at least count callbacks have been logged.
+    bool WaitForCount(
+        size_t count)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + CallbackTimeout;
+
+        std::unique_lock<std::mutex> guard(lock);
+        while ((order.size() < count) && (invoked.wait_until(guard, deadline) != std::cv_status::timeout))
+        {
+        }
+
+        return (order.size() >= count);
+    }
+};
+
+struct LoggedCallback
+{
+    CallbackLog* pLog;
+    uint32       id;
+    Result       result;
+};
+
+// =====================================================================================================================
+void PAL_STDCALL LogCallback(
+    void*  pUserData,
+    Result result)
+{
+    auto*const pCallback = static_cast<LoggedCallback*>(pUserData);
+
+    std::lock_guard<std::mutex> guard(pCallback->pLog->lock);
+    pCallback->result = result;
+    pCallback->pLog->order.push_back(pCallback->id);
+    pCallback->pLog->invoked.notify_all();
+}
+
+// =====================================================================================================================
+// A callback which blocks the notifier's thread until the test releases it.
+struct BlockingCallback
+{
+    std::mutex              lock;
+    std::condition_variable changed;
+    bool                    started;
+    bool                    released;
+    bool                    finished;
+};
+
+// =====================================================================================================================
+void PAL_STDCALL BlockCallback(
+    void*  pUserData,
+    Result result)
+{
+    auto*const pCallback = static_cast<BlockingCallback*>(pUserData);
+
+    std::unique_lock<std::mutex> guard(pCallback->lock);
+    pCallback->started = true;
+    pCallback->changed.notify_all();
+
+    while (pCallback->released == false)
+    {
+        pCallback->changed.wait(guard);
+    }
+
+    pCallback->finished = true;
+}
+
+// =====================================================================================================================
+// Waits until the blocking callback has started running.
+bool WaitForStart(
+    BlockingCallback* pCallback)
+{
+    const auto deadline = std::chrono::steady_clock::now() + CallbackTimeout;
+
+    std::unique_lock<std::mutex> guard(pCallback->lock);
+    while ((pCallback->started == false) && (pCallback->changed.wait_until(guard, deadline) != std::cv_status::timeout))
+    {
+    }
+
+    return pCallback->started;
+}
+
+// =====================================================================================================================
+// Unregisters a blocking callback on a separate thread and records what it saw when the unregistration returned.
+struct Unregistration
+{
+    IDevice*          pDevice;
+    const IFence*     pFence;
+    BlockingCallback* pCallback;
+    Result            result;
+    bool              finishedWhenReturned;
+    std::atomic<bool> returned;
+};
+
+// =====================================================================================================================
+void UnregisterBlockingCallback(
+    Unregistration* pUnregistration)
+{
+    pUnregistration->result = pUnregistration->pDevice->UnregisterFenceCallback(pUnregistration->pFence,
+                                                                                &BlockCallback,
+                                                                                pUnregistration->pCallback);
+
+    std::lock_guard<std::mutex> guard(pUnregistration->pCallback->lock);
+    pUnregistration->finishedWhenReturned = pUnregistration->pCallback->finished;
+    pUnregistration->returned             = true;
+}
+
+// =====================================================================================================================
+// A callback which unregisters another callback on the same fence, and then itself.
+struct UnregisteringCallback
+{
+    IDevice*        pDevice;
+    const IFence*   pFence;
+    LoggedCallback* pVictim;
+    LoggedCallback  logged;
+    Result          victimResult;
+    Result          selfResult;
+};
+
+// =====================================================================================================================
+void PAL_STDCALL UnregisterCallback(
+    void*  pUserData,
+    Result result)
+{
+    auto*const pCallback = static_cast<UnregisteringCallback*>(pUserData);
+
+    pCallback->victimResult = pCallback->pDevice->UnregisterFenceCallback(pCallback->pFence,
+                                                                          &LogCallback,
+                                                                          pCallback->pVictim);
+    pCallback->selfResult   = pCallback->pDevice->UnregisterFenceCallback(pCallback->pFence,
+                                                                          &UnregisterCallback,
+                                                                          pCallback);
+
+    LogCallback(&pCallback->logged, result);
+}
+
+// =====================================================================================================================
+// Runs the tests against a null device. Null submissions complete immediately, so a null fence is signaled unless it
+// has been reset; the tests reset their fences and then signal them from the CPU when they want the callbacks to run.
+class FenceNotifierTest : public ::testing::Test
+{
+protected:
+    FenceNotifierTest() : m_pPlatform(nullptr), m_pDevice(nullptr) {}
+
+    virtual void SetUp() override
+    {
+        m_platformMem.reset(new uint8[GetPlatformSize()]);
+
+        PlatformCreateInfo createInfo     = {};
+        createInfo.pSettingsPath          = "/etc/amd";
+        createInfo.flags.createNullDevice = 1;
+        createInfo.nullGpuId              = NullGpuId::Vega10;
+
+        ASSERT_EQ(CreatePlatform(createInfo, m_platformMem.get(), &m_pPlatform), Result::Success);
+
+        uint32   deviceCount = 0;
+        IDevice* devices[MaxDevices] = {};
+        ASSERT_EQ(m_pPlatform->EnumerateDevices(&deviceCount, devices), Result::Success);
+        ASSERT_GT(deviceCount, 0u);
+
+        m_pDevice = devices[0];
+        ASSERT_EQ(m_pDevice->CommitSettingsAndInit(), Result::Success);
+    }
+
+    virtual void TearDown() override
+    {
+        for (IFence* pFence : m_fences)
+        {
+            pFence->Destroy();
+        }
+
+        if (m_pPlatform != nullptr)
+        {
+            m_pPlatform->Destroy();
+        }
+    }
+
+    // Creates a fence which stays unsignaled until Signal() is called on it.
+    IFence* CreateUnsignaledFence()
+    {
+        m_fenceMem.emplace_back(new uint8[m_pDevice->GetFenceSize(nullptr)]);
+
+        const FenceCreateInfo createInfo = {};
+        IFence*               pFence     = nullptr;
+        EXPECT_EQ(m_pDevice->CreateFence(createInfo, m_fenceMem.back().get(), &pFence), Result::Success);
+
+        if (pFence != nullptr)
+        {
+            m_fences.push_back(pFence);
+            EXPECT_EQ(m_pDevice->ResetFences(1, &pFence), Result::Success);
+            EXPECT_EQ(pFence->GetStatus(), Result::NotReady);
+        }
+
+        return pFence;
+    }
+
+    static void Signal(
+        IFence* pFence)
+    {
+        EXPECT_EQ(static_cast<Pal::Fence*>(pFence)->Signal(), Result::Success);
+    }
+
+    std::unique_ptr<uint8[]>              m_platformMem;
+    IPlatform*                            m_pPlatform;
+    IDevice*                              m_pDevice;
+    std::vector<std::unique_ptr<uint8[]>> m_fenceMem;
+    std::vector<IFence*>                  m_fences;
+};
+
+} // anonymous namespace
+
+// =====================================================================================================================
+TEST_F(FenceNotifierTest, SignaledFenceInvokesCallbackImmediately)
+{
+    IFence* pFence = CreateUnsignaledFence();
+    ASSERT_NE(pFence, nullptr);
+    Signal(pFence);
+
+    CallbackLog    log;
+    LoggedCallback callback = { &log, 0, Result::NotReady };
+    ASSERT_EQ(m_pDevice->RegisterFenceCallback(pFence, &LogCallback, &callback), Result::Success);
+
+    // The callback must have run on this thread before the registration returned.
+    EXPECT_EQ(log.order.size(), 1u);
+    EXPECT_EQ(callback.result, Result::Success);
+}
+
+// =====================================================================================================================
+TEST_F(FenceNotifierTest, CallbacksRunInRegistrationOrder)
+{
+    constexpr uint32 NumCallbacks = 8;
+
+    IFence* pFences[2] = { CreateUnsignaledFence(), CreateUnsignaledFence() };
+    ASSERT_NE(pFences[0], nullptr);
+    ASSERT_NE(pFences[1], nullptr);
+
+    // Interleave the registrations across the two fences.
+    CallbackLog    log;
+    LoggedCallback callbacks[NumCallbacks] = {};
+    for (uint32 idx = 0; idx < NumCallbacks; ++idx)
+    {
+        callbacks[idx] = { &log, idx, Result::NotReady };
+        ASSERT_EQ(m_pDevice->RegisterFenceCallback(pFences[idx % 2], &LogCallback, &callbacks[idx]), Result::Success);
+    }
+
+    EXPECT_TRUE(log.order.empty());
+
+    // Only the second fence is signaled at first, so only its callbacks may run, in the order they were registered.
+    Signal(pFences[1]);
+    ASSERT_TRUE(log.WaitForCount(NumCallbacks / 2));
+
+    // While callbacks on the first fence are still waiting, a new callback on it has to wait behind them even though
+    // its fence will be signaled by the time it's registered.
+    Signal(pFences[0]);
+
+    LoggedCallback lateCallback = { &log, NumCallbacks, Result::NotReady };
+    ASSERT_EQ(m_pDevice->RegisterFenceCallback(pFences[0], &LogCallback, &lateCallback), Result::Success);
+    ASSERT_TRUE(log.WaitForCount(NumCallbacks + 1));
+
+    std::lock_guard<std::mutex> guard(log.lock);
+    const std::vector<uint32> expected = { 1, 3, 5, 7, 0, 2, 4, 6, NumCallbacks };
+    EXPECT_EQ(log.order, expected);
+
+    for (const LoggedCallback& callback : callbacks)
+    {
+        EXPECT_EQ(callback.result, Result::Success);
+    }
+}
+
+// =====================================================================================================================
+TEST_F(FenceNotifierTest, UnregisteredCallbackIsNeverInvoked)
+{
+    IFence* pFence = CreateUnsignaledFence();
+    ASSERT_NE(pFence, nullptr);
+
+    CallbackLog    log;
+    LoggedCallback cancelled = { &log, 0, Result::NotReady };
+    LoggedCallback kept      = { &log, 1, Result::NotReady };
+    ASSERT_EQ(m_pDevice->RegisterFenceCallback(pFence, &LogCallback, &cancelled), Result::Success);
+    ASSERT_EQ(m_pDevice->RegisterFenceCallback(pFence, &LogCallback, &kept), Result::Success);
+
+    EXPECT_EQ(m_pDevice->UnregisterFenceCallback(pFence, &LogCallback, &cancelled), Result::Success);
+    EXPECT_EQ(m_pDevice->UnregisterFenceCallback(pFence, &LogCallback, &cancelled), Result::NotFound);
+
+    Signal(pFence);
+    ASSERT_TRUE(log.WaitForCount(1));
+
+    // Once a callback has been invoked there's nothing left to unregister.
+    EXPECT_EQ(m_pDevice->UnregisterFenceCallback(pFence, &LogCallback, &kept), Result::NotFound);
+
+    std::lock_guard<std::mutex> guard(log.lock);
+    EXPECT_EQ(log.order, std::vector<uint32>(1, 1));
+    EXPECT_EQ(cancelled.result, Result::NotReady);
+}
+
+// =====================================================================================================================
+TEST_F(FenceNotifierTest, UnregisterWaitsForRunningCallback)
+{
+    IFence* pFence = CreateUnsignaledFence();
+    ASSERT_NE(pFence, nullptr);
+
+    BlockingCallback blocking = {};
+    ASSERT_EQ(m_pDevice->RegisterFenceCallback(pFence, &BlockCallback, &blocking), Result::Success);
+
+    Signal(pFence);
+    ASSERT_TRUE(WaitForStart(&blocking));
+
+    // Unregister from another thread while the callback is running; that must not return until the callback has.
+    Unregistration unregistration;
+    unregistration.pDevice              = m_pDevice;
+    unregistration.pFence               = pFence;
+    unregistration.pCallback            = &blocking;
+    unregistration.result               = Result::Success;
+    unregistration.finishedWhenReturned = false;
+    unregistration.returned             = false;
+
+    std::thread unregisterThread(&UnregisterBlockingCallback, &unregistration);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(unregistration.returned);
+
+    {
+        std::lock_guard<std::mutex> guard(blocking.lock);
+        blocking.released = true;
+        blocking.changed.notify_all();
+    }
+
+    unregisterThread.join();
+
+    EXPECT_EQ(unregistration.result, Result::NotFound);
+    EXPECT_TRUE(unregistration.finishedWhenReturned);
+}
+
+// =====================================================================================================================
+TEST_F(FenceNotifierTest, CallbackCanUnregisterCallbacks)
+{
+    IFence* pFence = CreateUnsignaledFence();
+    ASSERT_NE(pFence, nullptr);
+
+    CallbackLog           log;
+    LoggedCallback        victim       = { &log, 1, Result::NotReady };
+    LoggedCallback        last         = { &log, 2, Result::NotReady };
+    UnregisteringCallback unregisterer = { m_pDevice, pFence, &victim, { &log, 0, Result::NotReady },
+                                           Result::NotReady, Result::NotReady };
+
+    // All three complete together, so the victim has been collected by the notifier but not yet invoked when the first
+    // callback unregisters it.
+    ASSERT_EQ(m_pDevice->RegisterFenceCallback(pFence, &UnregisterCallback, &unregisterer), Result::Success);
+    ASSERT_EQ(m_pDevice->RegisterFenceCallback(pFence, &LogCallback, &victim), Result::Success);
+    ASSERT_EQ(m_pDevice->RegisterFenceCallback(pFence, &LogCallback, &last), Result::Success);
+
+    Signal(pFence);
+    ASSERT_TRUE(log.WaitForCount(2));
+
+    std::lock_guard<std::mutex> guard(log.lock);
+    const std::vector<uint32> expected = { 0, 2 };
+    EXPECT_EQ(log.order, expected);
+    EXPECT_EQ(unregisterer.victimResult, Result::Success);
+    EXPECT_EQ(unregisterer.selfResult,   Result::NotFound);
+}
@@ -0,0 +1,268 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "palFormatInfo.h"
+#include "palInlineFuncs.h"
+#include "palMath.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace Pal;
+
+namespace
+{
+
+constexpr SwizzledFormat SrgbFormat =
+{
+    ChNumFormat::X8Y8Z8W8_Srgb,
+    { ChannelSwizzle::X, ChannelSwizzle::Y, ChannelSwizzle::Z, ChannelSwizzle::W }
+};
+
+constexpr SwizzledFormat SharedExpFormat =
+{
+    ChNumFormat::X9Y9Z9E5_Float,
+    { ChannelSwizzle::X, ChannelSwizzle::Y, ChannelSwizzle::Z, ChannelSwizzle::One }
+};
+
+// =====================================================================================================================
+float BitsToFloat(
+    uint32 bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+// =====================================================================================================================
+bool IsNan(
+    uint32 bits)
+{
+    return ((bits & 0x7F800000) == 0x7F800000) && ((bits & 0x007FFFFF) != 0);
+}
+
+// =====================================================================================================================
+// The scalar sRGB encoding which the 8-bit threshold table has to reproduce exactly.
+uint32 ReferenceSrgbUnorm8(
+    float linear)
+{
+    return Util::Math::FloatToUFixed(Formats::LinearToGamma(linear), 0, 8, true);
+}
+
+// =====================================================================================================================
+// Encodes linear into the red, green and blue channels of an 8-bit sRGB color and checks all three against the
+// reference. Alpha is never gamma corrected, so it isn't interesting here.
+void ExpectSrgbMatches(
+    uint32 linearBits)
+{
+    const float  linear      = BitsToFloat(linearBits);
+    const float  colorIn[4]  = { linear, linear, linear, 1.0f };
+    uint32       colorOut[4] = {};
+    const uint32 expected    = ReferenceSrgbUnorm8(linear);
+
+    Formats::ConvertColor(SrgbFormat, colorIn, colorOut);
+
+    EXPECT_EQ(colorOut[0], expected) << "linear bits 0x" << std::hex << linearBits;
+    EXPECT_EQ(colorOut[1], expected) << "linear bits 0x" << std::hex << linearBits;
+    EXPECT_EQ(colorOut[2], expected) << "linear bits 0x" << std::hex << linearBits;
+}
+
+// =====================================================================================================================
+// The shared exponent encoding as it was computed with log2() and pow(), which the bit manipulation has to match.
+void ReferenceX9Y9Z9E5(
+    const float* pColorIn,
+    uint32*      pColorOut)
+{
+    constexpr int32 MantissaBits      = 9;
+    constexpr int32 ExponentBias      = 15;
+    constexpr int32 MaxBiasedExponent = 31;
+    constexpr int32 MantissaValues    = (1 << MantissaBits);
+
+    constexpr float SharedExpMax = ((MantissaValues - 1) * (1 << (MaxBiasedExponent - MantissaBits))) / MantissaValues;
+
+    const float redC   = Util::Max(0.f, Util::Min(SharedExpMax, pColorIn[0]));
+    const float greenC = Util::Max(0.f, Util::Min(SharedExpMax, pColorIn[1]));
+    const float blueC  = Util::Max(0.f, Util::Min(SharedExpMax, pColorIn[2]));
+    const float maxC   = Util::Max(Util::Max(redC, greenC), blueC);
+
+    int32 sharedExp = Util::Max(-ExponentBias - 1, static_cast<int32>(floor(log2(maxC)))) + 1 + ExponentBias;
+    float denom     = pow(2.0f, static_cast<float>(sharedExp - ExponentBias - MantissaBits));
+
+    if (static_cast<int32>(floor((maxC / denom) + 0.5f)) == MantissaValues)
+    {
+        denom *= 2;
+        sharedExp++;
+    }
+
+    pColorOut[0] = static_cast<uint32>(floor((redC   / denom) + 0.5f));
+    pColorOut[1] = static_cast<uint32>(floor((greenC / denom) + 0.5f));
+    pColorOut[2] = static_cast<uint32>(floor((blueC  / denom) + 0.5f));
+    pColorOut[3] = sharedExp;
+}
+
+// =====================================================================================================================
+void ExpectSharedExpMatches(
+    float red,
+    float green,
+    float blue)
+{
+    const float colorIn[4]  = { red, green, blue, 1.0f };
+    uint32      colorOut[4] = {};
+    uint32      expected[4] = {};
+
+    Formats::ConvertColor(SharedExpFormat, colorIn, colorOut);
+    ReferenceX9Y9Z9E5(colorIn, expected);
+
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(colorOut[i], expected[i]) << "channel " << i << " of (" << red << ", " << green << ", " << blue
+                                            << ")";
+    }
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+// Finds every step of the 8-bit sRGB encoding with the reference and checks the encoding right at the step and one ulp
+// below it, so that every entry of the threshold table is pinned to the exact float where the reference steps up.
+TEST(FormatInfoTest, SrgbUnorm8MatchesEveryStep)
+{
+    const uint32 oneBits = 0x3F800000;
+
+    for (uint32 step = 1; step <= 255; ++step)
+    {
+        // Binary search for the smallest non-negative float which the reference encodes to step. Non-negative floats
+        // sort the same way as their bit patterns.
+        uint32 low  = 0;
+        uint32 high = oneBits;
+
+        while (low < high)
+        {
+            const uint32 mid = low + ((high - low) / 2);
+
+            if (ReferenceSrgbUnorm8(BitsToFloat(mid)) >= step)
+            {
+                high = mid;
+            }
+            else
+            {
+                low = mid + 1;
+            }
+        }
+
+        ASSERT_EQ(ReferenceSrgbUnorm8(BitsToFloat(low)), step);
+        ASSERT_GT(low, 0u);
+
+        ExpectSrgbMatches(low);
+        ExpectSrgbMatches(low - 1);
+    }
+}
+
+// =====================================================================================================================
+// Sweeps the whole float range, including negatives, denormals, infinities and values above one. NaNs are checked
+// separately because the reference doesn't define their encoding.
+TEST(FormatInfoTest, SrgbUnorm8MatchesSweep)
+{
+    const uint32 stride = 4093;
+
+    for (uint64 bits = 0; bits <= UINT32_MAX; bits += stride)
+    {
+        if (IsNan(static_cast<uint32>(bits)) == false)
+        {
+            ExpectSrgbMatches(static_cast<uint32>(bits));
+        }
+    }
+
+    const uint32 specials[] = { 0x00000000, 0x80000000, 0x00000001, 0x3F800000, 0x3F800001, 0x7F800000, 0xFF800000 };
+    for (uint32 i = 0; i < sizeof(specials) / sizeof(specials[0]); ++i)
+    {
+        ExpectSrgbMatches(specials[i]);
+    }
+
+    // NaNs encode to zero, like negative values.
+    const float nan         = BitsToFloat(0x7FC00000);
+    const float colorIn[4]  = { nan, nan, nan, 1.0f };
+    uint32      colorOut[4] = {};
+
+    Formats::ConvertColor(SrgbFormat, colorIn, colorOut);
+
+    EXPECT_EQ(colorOut[0], 0u);
+    EXPECT_EQ(colorOut[1], 0u);
+    EXPECT_EQ(colorOut[2], 0u);
+}
+
+// =====================================================================================================================
+// Checks every float exponent with the mantissas on either side of the 9-bit rounding points, in each channel, against
+// the other two channels being zero, a fixed mid-range value and half of the tested value.
+TEST(FormatInfoTest, X9Y9Z9E5MatchesEveryExponent)
+{
+    const uint32 mantissas[] =
+    {
+        0x000000, 0x000001, 0x001FFF, 0x002000, 0x002001, 0x3FDFFF, 0x3FE000, 0x400000, 0x7FBFFF, 0x7FC000, 0x7FFFFF
+    };
+
+    std::vector<float> values;
+    for (uint32 exponent = 0; exponent < 255; ++exponent)
+    {
+        for (uint32 i = 0; i < sizeof(mantissas) / sizeof(mantissas[0]); ++i)
+        {
+            values.push_back(BitsToFloat((exponent << 23) | mantissas[i]));
+        }
+    }
+
+    values.push_back(BitsToFloat(0x7F800000));
+    values.push_back(-1.0f);
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        const float value    = values[i];
+        const float others[] = { 0.0f, 0.25f, value * 0.5f };
+
+        for (uint32 j = 0; j < sizeof(others) / sizeof(others[0]); ++j)
+        {
+            ExpectSharedExpMatches(value,     others[j], others[j]);
+            ExpectSharedExpMatches(others[j], value,     others[j]);
+            ExpectSharedExpMatches(others[j], others[j], value);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Sweeps the whole float range through the red channel.
+TEST(FormatInfoTest, X9Y9Z9E5MatchesSweep)
+{
+    const uint32 stride = 4093;
+
+    for (uint64 bits = 0; bits <= UINT32_MAX; bits += stride)
+    {
+        if (IsNan(static_cast<uint32>(bits)) == false)
+        {
+            ExpectSharedExpMatches(BitsToFloat(static_cast<uint32>(bits)), 0.25f, 0.0f);
+        }
+    }
+}
@@ -0,0 +1,494 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "core/hw/gfxip/gfx9/gfx9QueryResults.h"
+#include "gtest/gtest.h"
+#include <random>
+
+using namespace Pal;
+using namespace Pal::Gfx9;
+using namespace Util;
+
+namespace
+{
+
+// Largest number of RBs any gfx9 ASIC reports.
+constexpr uint32 MaxTotalRbs = 64;
+
+// Every combination of the flags which change how a slot is resolved, minus QueryResultWait which is tested separately
+// because it would spin forever on a slot which never becomes ready.
+constexpr uint32 NumFlagCombinations = 16;
+
+// =====================================================================================================================
+QueryResultFlags FlagCombination(
+    uint32 index)
+{
+    uint32 flags = 0;
+    flags |= (index & 1) ? QueryResult64Bit        : 0;
+    flags |= (index & 2) ? QueryResultAvailability : 0;
+    flags |= (index & 4) ? QueryResultPartial      : 0;
+    flags |= (index & 8) ? QueryResultAccumulate   : 0;
+
+    return static_cast<QueryResultFlags>(flags);
+}
+
+// =====================================================================================================================
+// The per-RB occlusion reduction which ComputeOcclusionResults replaced, kept verbatim as the reference.
+template <typename ResultUint>
+bool ReferenceOcclusionResults(
+    QueryResultFlags                         flags,
+    uint32                                   numTotalRbs,
+    bool                                     isBinary,
+    volatile const OcclusionQueryResultPair* pRbCounters,
+    ResultUint*                              pOutputBuffer)
+{
+    ResultUint result     = 0;
+    bool       queryReady = true;
+
+    for (uint32 idx = 0; idx < numTotalRbs; idx++)
+    {
+        bool countersReady = false;
+
+        do
+        {
+            countersReady = (pRbCounters[idx].begin.bits.valid == 1) && (pRbCounters[idx].end.bits.valid == 1);
+        }
+        while ((countersReady == false) && TestAnyFlagSet(flags, QueryResultWait));
+
+        if (countersReady)
+        {
+            result += static_cast<ResultUint>(pRbCounters[idx].end.bits.zPassData -
+                                              pRbCounters[idx].begin.bits.zPassData);
+        }
+
+        queryReady = queryReady && countersReady;
+    }
+
+    if (queryReady || TestAnyFlagSet(flags, QueryResultPartial))
+    {
+        if (TestAnyFlagSet(flags, QueryResultAccumulate))
+        {
+            result += pOutputBuffer[0];
+        }
+
+        pOutputBuffer[0] = isBinary ? (result != 0) : result;
+    }
+
+    if (TestAnyFlagSet(flags, QueryResultAvailability))
+    {
+        if (TestAnyFlagSet(flags, QueryResultAccumulate))
+        {
+            queryReady = queryReady && (pOutputBuffer[1] != 0);
+        }
+
+        pOutputBuffer[1] = queryReady;
+    }
+
+    return queryReady;
+}
+
+// The pipeline stats layout the reference reduction walks, in result order.  Each entry gives the stat's enable flag
+// and the QWORD offset of its counter in the hardware's begin or end block.
+struct StatLayout
+{
+    uint32 statFlag;
+    uint32 counterOffset;
+};
+
+constexpr StatLayout PipelineStatsLayout[PipelineStatsMaxNumCounters] =
+{
+    { QueryPipelineStatsIaVertices,    7  },
+    { QueryPipelineStatsIaPrimitives,  6  },
+    { QueryPipelineStatsVsInvocations, 3  },
+    { QueryPipelineStatsGsInvocations, 4  },
+    { QueryPipelineStatsGsPrimitives,  5  },
+    { QueryPipelineStatsCInvocations,  2  },
+    { QueryPipelineStatsCPrimitives,   1  },
+    { QueryPipelineStatsPsInvocations, 0  },
+    { QueryPipelineStatsHsInvocations, 8  },
+    { QueryPipelineStatsDsInvocations, 9  },
+    { QueryPipelineStatsCsInvocations, 10 },
+};
+
+// =====================================================================================================================
+// The per-counter pipeline stats reduction which ComputePipelineStatsResults replaced, kept verbatim as the reference.
+template <typename ResultUint>
+bool ReferencePipelineStatsResults(
+    QueryResultFlags       resultFlags,
+    uint32                 enableStatsFlags,
+    volatile const uint64* pBeginCounters,
+    volatile const uint64* pEndCounters,
+    ResultUint*            pOutputBuffer)
+{
+    ResultUint results[PipelineStatsMaxNumCounters] = {};
+    uint32     numStatsEnabled = 0;
+    bool       queryReady      = true;
+
+    for (uint32 layoutIdx = 0; layoutIdx < PipelineStatsMaxNumCounters; ++layoutIdx)
+    {
+        if (TestAnyFlagSet(enableStatsFlags, PipelineStatsLayout[layoutIdx].statFlag))
+        {
+            const uint32 counterOffset = PipelineStatsLayout[layoutIdx].counterOffset;
+            bool         countersReady = false;
+
+            do
+            {
+                countersReady = ((pBeginCounters[counterOffset] != PipelineStatsResetMemValue64) &&
+                                 (pEndCounters[counterOffset]   != PipelineStatsResetMemValue64));
+            }
+            while ((countersReady == false) && TestAnyFlagSet(resultFlags, QueryResultWait));
+
+            if (countersReady)
+            {
+                results[numStatsEnabled] = static_cast<ResultUint>(pEndCounters[counterOffset] -
+                                                                   pBeginCounters[counterOffset]);
+            }
+
+            queryReady = queryReady && countersReady;
+
+            numStatsEnabled++;
+        }
+    }
+
+    if (queryReady || TestAnyFlagSet(resultFlags, QueryResultPartial))
+    {
+        if (TestAnyFlagSet(resultFlags, QueryResultAccumulate))
+        {
+            for (uint32 idx = 0; idx < numStatsEnabled; ++idx)
+            {
+                results[idx] += pOutputBuffer[idx];
+            }
+        }
+
+        memcpy(pOutputBuffer, results, numStatsEnabled * sizeof(ResultUint));
+    }
+
+    if (TestAnyFlagSet(resultFlags, QueryResultAvailability))
+    {
+        if (TestAnyFlagSet(resultFlags, QueryResultAccumulate))
+        {
+            queryReady = queryReady && (pOutputBuffer[numStatsEnabled] != 0);
+        }
+
+        pOutputBuffer[numStatsEnabled] = queryReady;
+    }
+
+    return queryReady;
+}
+
+// How the counters of a generated slot are filled in.
+enum class SlotKind : uint32
+{
+    Ready,      // Every counter was written and end >= begin.
+    NotReady,   // Some counters were not written yet.
+    Wraparound, // Every counter was written but some wrapped around between begin and end.
+};
+
+// =====================================================================================================================
+// Fills an occlusion query slot with counters of the given kind.
+void FillOcclusionSlot(
+    std::mt19937_64*          pRng,
+    SlotKind                  kind,
+    uint32                    numTotalRbs,
+    OcclusionQueryResultPair* pRbCounters)
+{
+    constexpr uint64 DataMask  = (1ull << 63) - 1;
+    constexpr uint64 ValidMask = (1ull << 63);
+
+    for (uint32 idx = 0; idx < numTotalRbs; ++idx)
+    {
+        const uint64 begin = (*pRng)() & DataMask;
+        uint64       end   = (begin + ((*pRng)() & 0xFFFFFFFF)) & DataMask;
+
+        if ((kind == SlotKind::Wraparound) && (((*pRng)() & 1) != 0))
+        {
+            // The 63-bit counter rolled over between begin and end.
+            end = (*pRng)() & 0xFFFF;
+        }
+
+        pRbCounters[idx].begin.data = begin | ValidMask;
+        pRbCounters[idx].end.data   = end   | ValidMask;
+
+        if ((kind == SlotKind::NotReady) && (((*pRng)() % 4) == 0))
+        {
+            if (((*pRng)() & 1) != 0)
+            {
+                pRbCounters[idx].begin.data &= DataMask;
+            }
+            else
+            {
+                pRbCounters[idx].end.data &= DataMask;
+            }
+        }
+    }
+
+    if (kind == SlotKind::NotReady)
+    {
+        // Make sure at least one RB isn't ready.
+        pRbCounters[(*pRng)() % numTotalRbs].end.data &= DataMask;
+    }
+}
+
+// =====================================================================================================================
+// Resolves a slot with both the new and the reference reduction and checks that they agree.
+template <typename ResultUint>
+void CheckOcclusionSlot(
+    QueryResultFlags                flags,
+    uint32                          numTotalRbs,
+    bool                            isBinary,
+    const OcclusionQueryResultPair* pRbCounters,
+    uint64                          initialValue)
+{
+    ResultUint expected[2] = { static_cast<ResultUint>(initialValue), static_cast<ResultUint>(initialValue >> 1) };
+    ResultUint actual[2]   = { expected[0], expected[1] };
+
+    const bool expectedReady = ReferenceOcclusionResults(flags, numTotalRbs, isBinary, pRbCounters, &expected[0]);
+    const bool actualReady   = ComputeOcclusionResults(flags, numTotalRbs, isBinary, pRbCounters, &actual[0]);
+
+    EXPECT_EQ(expectedReady, actualReady);
+    EXPECT_EQ(expected[0], actual[0]);
+    EXPECT_EQ(expected[1], actual[1]);
+}
+
+// =====================================================================================================================
+void CheckOcclusionKind(
+    SlotKind kind)
+{
+    std::mt19937_64          rng(static_cast<uint64>(kind) + 1);
+    OcclusionQueryResultPair rbCounters[MaxTotalRbs] = {};
+
+    for (uint32 iteration = 0; iteration < 2000; ++iteration)
+    {
+        const uint32 numTotalRbs = 1 + static_cast<uint32>(rng() % MaxTotalRbs);
+        const bool   isBinary    = ((rng() & 1) != 0);
+        const uint64 initial     = rng();
+
+        FillOcclusionSlot(&rng, kind, numTotalRbs, &rbCounters[0]);
+
+        for (uint32 combo = 0; combo < NumFlagCombinations; ++combo)
+        {
+            const QueryResultFlags flags = FlagCombination(combo);
+
+            if (TestAnyFlagSet(flags, QueryResult64Bit))
+            {
+                CheckOcclusionSlot<uint64>(flags, numTotalRbs, isBinary, &rbCounters[0], initial);
+            }
+            else
+            {
+                CheckOcclusionSlot<uint32>(flags, numTotalRbs, isBinary, &rbCounters[0], initial);
+            }
+        }
+
+        if (kind != SlotKind::NotReady)
+        {
+            // QueryResultWait returns immediately when every counter is already valid.
+            const QueryResultFlags flags = static_cast<QueryResultFlags>(QueryResultWait | QueryResult64Bit);
+            CheckOcclusionSlot<uint64>(flags, numTotalRbs, isBinary, &rbCounters[0], initial);
+        }
+    }
+}
+
+// =====================================================================================================================
+// Fills the begin and end blocks of a pipeline stats slot with counters of the given kind.
+void FillPipelineStatsSlot(
+    std::mt19937_64* pRng,
+    SlotKind         kind,
+    uint64*          pBegin,
+    uint64*          pEnd)
+{
+    for (uint32 idx = 0; idx < PipelineStatsMaxNumCounters; ++idx)
+    {
+        pBegin[idx] = (*pRng)() >> 1;
+        pEnd[idx]   = pBegin[idx] + ((*pRng)() & 0xFFFFFFFFFF);
+
+        if ((kind == SlotKind::Wraparound) && (((*pRng)() & 1) != 0))
+        {
+            pBegin[idx] = PipelineStatsResetMemValue64 - ((*pRng)() & 0xFFFF) - 1;
+            pEnd[idx]   = (*pRng)() & 0xFFFF;
+        }
+        else if ((kind == SlotKind::NotReady) && (((*pRng)() % 3) == 0))
+        {
+            if (((*pRng)() & 1) != 0)
+            {
+                pBegin[idx] = PipelineStatsResetMemValue64;
+            }
+            else
+            {
+                pEnd[idx] = PipelineStatsResetMemValue64;
+            }
+        }
+    }
+
+    if (kind == SlotKind::NotReady)
+    {
+        // Make sure at least one counter isn't ready, whichever stats end up enabled.
+        for (uint32 idx = 0; idx < PipelineStatsMaxNumCounters; ++idx)
+        {
+            if (((*pRng)() % 4) == 0)
+            {
+                pEnd[idx] = PipelineStatsResetMemValue64;
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Resolves a slot with both the new and the reference reduction and checks that they agree.
+template <typename ResultUint>
+void CheckPipelineStatsSlot(
+    QueryResultFlags flags,
+    uint32           enabledStats,
+    const uint64*    pBegin,
+    const uint64*    pEnd,
+    uint64           initialValue)
+{
+    uint32 counterOffsets[PipelineStatsMaxNumCounters] = {};
+    uint32 numStatsEnabled = 0;
+
+    for (uint32 layoutIdx = 0; layoutIdx < PipelineStatsMaxNumCounters; ++layoutIdx)
+    {
+        if (TestAnyFlagSet(enabledStats, PipelineStatsLayout[layoutIdx].statFlag))
+        {
+            counterOffsets[numStatsEnabled++] = PipelineStatsLayout[layoutIdx].counterOffset;
+        }
+    }
+
+    ResultUint expected[PipelineStatsMaxNumCounters + 1];
+    ResultUint actual[PipelineStatsMaxNumCounters + 1];
+
+    for (uint32 idx = 0; idx <= PipelineStatsMaxNumCounters; ++idx)
+    {
+        expected[idx] = static_cast<ResultUint>(initialValue * (idx + 1));
+        actual[idx]   = expected[idx];
+    }
+
+    const bool expectedReady = ReferencePipelineStatsResults(flags, enabledStats, pBegin, pEnd, &expected[0]);
+    const bool actualReady   =
+        ComputePipelineStatsResults(flags, numStatsEnabled, &counterOffsets[0], pBegin, pEnd, &actual[0]);
+
+    EXPECT_EQ(expectedReady, actualReady);
+
+    for (uint32 idx = 0; idx <= PipelineStatsMaxNumCounters; ++idx)
+    {
+        EXPECT_EQ(expected[idx], actual[idx]) << "result " << idx << " of stats mask " << enabledStats;
+    }
+}
+
+// =====================================================================================================================
+void CheckPipelineStatsKind(
+    SlotKind kind)
+{
+    std::mt19937_64 rng(static_cast<uint64>(kind) + 100);
+    uint64          begin[PipelineStatsMaxNumCounters] = {};
+    uint64          end[PipelineStatsMaxNumCounters]   = {};
+
+    for (uint32 iteration = 0; iteration < 2000; ++iteration)
+    {
+        const uint32 enabledStats = 1 + static_cast<uint32>(rng() % QueryPipelineStatsAll);
+        const uint64 initial      = rng();
+
+        FillPipelineStatsSlot(&rng, kind, &begin[0], &end[0]);
+
+        for (uint32 combo = 0; combo < NumFlagCombinations; ++combo)
+        {
+            const QueryResultFlags flags = FlagCombination(combo);
+
+            if (TestAnyFlagSet(flags, QueryResult64Bit))
+            {
+                CheckPipelineStatsSlot<uint64>(flags, enabledStats, &begin[0], &end[0], initial);
+            }
+            else
+            {
+                CheckPipelineStatsSlot<uint32>(flags, enabledStats, &begin[0], &end[0], initial);
+            }
+        }
+
+        if (kind != SlotKind::NotReady)
+        {
+            const QueryResultFlags flags = static_cast<QueryResultFlags>(QueryResultWait | QueryResult64Bit);
+            CheckPipelineStatsSlot<uint64>(flags, enabledStats, &begin[0], &end[0], initial);
+        }
+    }
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+TEST(Gfx9QueryResults, OcclusionMatchesReferenceWhenReady)
+{
+    CheckOcclusionKind(SlotKind::Ready);
+}
+
+// =====================================================================================================================
+TEST(Gfx9QueryResults, OcclusionMatchesReferenceWhenNotReady)
+{
+    CheckOcclusionKind(SlotKind::NotReady);
+}
+
+// =====================================================================================================================
+TEST(Gfx9QueryResults, OcclusionMatchesReferenceOnWraparound)
+{
+    CheckOcclusionKind(SlotKind::Wraparound);
+}
+
+// =====================================================================================================================
+// Disabled RBs are initialized to valid with zero data and must not change the result.
+TEST(Gfx9QueryResults, OcclusionIgnoresDisabledRbs)
+{
+    constexpr uint64 ValidMask = (1ull << 63);
+
+    OcclusionQueryResultPair rbCounters[4] = {};
+    for (uint32 idx = 0; idx < 4; ++idx)
+    {
+        rbCounters[idx].begin.data = ValidMask;
+        rbCounters[idx].end.data   = ValidMask;
+    }
+
+    rbCounters[1].begin.data = ValidMask | 10;
+    rbCounters[1].end.data   = ValidMask | 35;
+
+    uint64 result[2] = {};
+    EXPECT_TRUE(ComputeOcclusionResults(QueryResultAvailability, 4, false, &rbCounters[0], &result[0]));
+    EXPECT_EQ(25u, result[0]);
+    EXPECT_EQ(1u,  result[1]);
+}
+
+// =====================================================================================================================
+TEST(Gfx9QueryResults, PipelineStatsMatchesReferenceWhenReady)
+{
+    CheckPipelineStatsKind(SlotKind::Ready);
+}
+
+// =====================================================================================================================
+TEST(Gfx9QueryResults, PipelineStatsMatchesReferenceWhenNotReady)
+{
+    CheckPipelineStatsKind(SlotKind::NotReady);
+}
+
+// =====================================================================================================================
+TEST(Gfx9QueryResults, PipelineStatsMatchesReferenceOnWraparound)
+{
+    CheckPipelineStatsKind(SlotKind::Wraparound);
+}
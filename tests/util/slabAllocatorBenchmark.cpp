@@ -0,0 +1,194 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+// Standalone benchmark which compares the cost of PAL-style small allocations made straight through a set of client
+// allocation callbacks against the same allocations made through a Util::SlabAllocator wrapping those callbacks.
+//
+// Each worker thread repeatedly allocates a batch of objects with sizes drawn from a fixed mix of small sizes and then
+// frees them, in allocation order for half of the rounds and in reverse order for the other half.  The benchmark
+// reports the average wall-clock time per allocation and free pair and the slab allocator's statistics.
+//
+// Usage: palSlabAllocatorBenchmark [rounds]
+
+#include "palSlabAllocator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace Util;
+
+namespace
+{
+
+constexpr size_t ObjectSizes[]  = { 16, 24, 40, 64, 96, 128, 200, 320, 512, 1000 };
+constexpr uint32 BatchSize      = 512;
+constexpr uint32 DefaultRounds  = 4000;
+constexpr uint32 ThreadCounts[] = { 1, 2, 4, 8 };
+
+// =====================================================================================================================
+void* PAL_STDCALL ClientAlloc(
+    void*           pClientData,
+    size_t          size,
+    size_t          alignment,
+    SystemAllocType allocType)
+{
+    void* pMem = nullptr;
+
+    if (posix_memalign(&pMem, (alignment < sizeof(void*)) ? sizeof(void*) : alignment, size) != 0)
+    {
+        pMem = nullptr;
+    }
+
+    return pMem;
+}
+
+// =====================================================================================================================
+void PAL_STDCALL ClientFree(
+    void* pClientData,
+    void* pMem)
+{
+    free(pMem);
+}
+
+// =====================================================================================================================
+void RunWorker(
+    const AllocCallbacks* pAllocCb,
+    uint32                rounds,
+    uint32                seed)
+{
+    void*  objects[BatchSize];
+    uint32 sizeIdx = seed;
+
+    for (uint32 round = 0; round < rounds; ++round)
+    {
+        for (uint32 idx = 0; idx < BatchSize; ++idx)
+        {
+            sizeIdx      = (sizeIdx * 1103515245u) + 12345u;
+            objects[idx] = pAllocCb->pfnAlloc(pAllocCb->pClientData,
+                                              ObjectSizes[(sizeIdx >> 16) % (sizeof(ObjectSizes) / sizeof(size_t))],
+                                              alignof(uint64),
+                                              AllocInternal);
+        }
+
+        if ((round & 1) == 0)
+        {
+            for (uint32 idx = 0; idx < BatchSize; ++idx)
+            {
+                pAllocCb->pfnFree(pAllocCb->pClientData, objects[idx]);
+            }
+        }
+        else
+        {
+            for (uint32 idx = BatchSize; idx > 0; --idx)
+            {
+                pAllocCb->pfnFree(pAllocCb->pClientData, objects[idx - 1]);
+            }
+        }
+    }
+}
+
+// =====================================================================================================================
+// Returns the average time in nanoseconds of one allocation and free pair made through the given callbacks.
+double Measure(
+    const AllocCallbacks& allocCb,
+    uint32                threadCount,
+    uint32                rounds)
+{
+    std::vector<std::thread> threads;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (uint32 idx = 0; idx < threadCount; ++idx)
+    {
+        threads.emplace_back(RunWorker, &allocCb, rounds, idx + 1);
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    const std::chrono::duration<double, std::nano> elapsed = (std::chrono::steady_clock::now() - start);
+
+    return elapsed.count() / (static_cast<double>(rounds) * BatchSize * threadCount);
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+int main(
+    int   argc,
+    char* argv[])
+{
+    const uint32 rounds = (argc > 1) ? static_cast<uint32>(strtoul(argv[1], nullptr, 10)) : DefaultRounds;
+
+    const AllocCallbacks clientCb = { nullptr, ClientAlloc, ClientFree };
+
+    int exitCode = 0;
+
+    printf("%8s %16s %16s %8s\n", "threads", "client ns/pair", "slab ns/pair", "speedup");
+
+    for (uint32 threadCount : ThreadCounts)
+    {
+        SlabAllocator* pSlabAllocator = nullptr;
+
+        if (SlabAllocator::Create(clientCb, 0, &pSlabAllocator) != Result::Success)
+        {
+            fprintf(stderr, "Failed to create the slab allocator.\n");
+            exitCode = 1;
+            break;
+        }
+
+        AllocCallbacks slabCb = {};
+        pSlabAllocator->GetAllocCallbacks(&slabCb);
+
+        // Warm up both paths so that neither pays for the first slabs or the C runtime's arenas.
+        Measure(clientCb, threadCount, 16);
+        Measure(slabCb, threadCount, 16);
+
+        const double clientNs = Measure(clientCb, threadCount, rounds);
+        const double slabNs   = Measure(slabCb, threadCount, rounds);
+
+        SlabAllocatorStats stats = {};
+        pSlabAllocator->GetStats(&stats);
+
+        printf("%8u %16.1f %16.1f %7.2fx   (slabs %zu KiB, refills %llu, flushes %llu, fallbacks %llu)\n",
+               threadCount,
+               clientNs,
+               slabNs,
+               clientNs / slabNs,
+               stats.slabBytes / 1024,
+               static_cast<unsigned long long>(stats.refillCount),
+               static_cast<unsigned long long>(stats.flushCount),
+               static_cast<unsigned long long>(stats.fallbackAllocCount));
+
+        pSlabAllocator->Destroy();
+    }
+
+    return exitCode;
+}
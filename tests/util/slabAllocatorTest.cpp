@@ -0,0 +1,159 @@
+/*
+ ***********************************************************************************************************************
+ *
+ *  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *
+ **********************************************************************************************************************/
+
+#include "palSlabAllocator.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstdlib>
+
+using namespace Util;
+
+namespace
+{
+
+// Client callbacks which count their live allocations and can be told to misalign every block they return.
+struct TestClient
+{
+    bool              misalign;
+    std::atomic<int>  liveAllocs;
+};
+
+// =====================================================================================================================
+void* PAL_STDCALL TestAlloc(
+    void*           pClientData,
+    size_t          size,
+    size_t          alignment,
+    SystemAllocType allocType)
+{
+    auto*const   pClient    = static_cast<TestClient*>(pClientData);
+    const size_t blockAlign = (alignment < 64) ? 64 : alignment;
+
+    // Over-allocate so that the block can be placed exactly 64 bytes past an alignment boundary when misaligning, with
+    // room to remember the raw allocation just in front of it.
+    uint8* pRaw = static_cast<uint8*>(malloc(size + (2 * blockAlign) + 64));
+    uint8* pMem = nullptr;
+
+    if (pRaw != nullptr)
+    {
+        const uintptr_t aligned = Pow2Align(reinterpret_cast<uintptr_t>(pRaw) + sizeof(void*), blockAlign);
+        pMem = reinterpret_cast<uint8*>(aligned + (pClient->misalign ? 64 : 0));
+
+        reinterpret_cast<void**>(pMem)[-1] = pRaw;
+        ++pClient->liveAllocs;
+    }
+
+    return pMem;
+}
+
+// =====================================================================================================================
+void PAL_STDCALL TestFree(
+    void* pClientData,
+    void* pMem)
+{
+    if (pMem != nullptr)
+    {
+        --static_cast<TestClient*>(pClientData)->liveAllocs;
+        free(reinterpret_cast<void**>(pMem)[-1]);
+    }
+}
+
+// =====================================================================================================================
+// Allocates and frees a batch of small objects through the slab allocator wrapping the given client and returns the
+// allocator's statistics from just before it was destroyed.
+SlabAllocatorStats AllocateSmallObjects(
+    TestClient* pClient,
+    uint32      count)
+{
+    const AllocCallbacks clientCb = { pClient, TestAlloc, TestFree };
+
+    SlabAllocator* pSlabAllocator = nullptr;
+    EXPECT_EQ(SlabAllocator::Create(clientCb, 0, &pSlabAllocator), Result::Success);
+
+    SlabAllocatorStats stats = {};
+
+    if (pSlabAllocator != nullptr)
+    {
+        AllocCallbacks slabCb = {};
+        pSlabAllocator->GetAllocCallbacks(&slabCb);
+
+        void* objects[64] = {};
+        EXPECT_LE(count, 64u);
+
+        for (uint32 idx = 0; idx < count; ++idx)
+        {
+            objects[idx] = slabCb.pfnAlloc(slabCb.pClientData, 48, alignof(uint64), AllocInternal);
+            EXPECT_NE(objects[idx], nullptr);
+
+            if (objects[idx] != nullptr)
+            {
+                memset(objects[idx], 0xCD, 48);
+            }
+        }
+
+        for (uint32 idx = 0; idx < count; ++idx)
+        {
+            slabCb.pfnFree(slabCb.pClientData, objects[idx]);
+        }
+
+        pSlabAllocator->GetStats(&stats);
+        pSlabAllocator->Destroy();
+    }
+
+    return stats;
+}
+
+} // anonymous namespace
+
+// =====================================================================================================================
+// Small allocations are served from slabs when the client honors the slab alignment.
+TEST(SlabAllocatorTest, AlignedSlabsServeSmallAllocations)
+{
+    TestClient client = {};
+    client.misalign   = false;
+
+    const SlabAllocatorStats stats    = AllocateSmallObjects(&client, 64);
+    const size_t             slabSize = SlabAllocator::SlabSize;
+
+    EXPECT_FALSE(stats.passThrough);
+    EXPECT_EQ(stats.slabBytes, slabSize);
+    EXPECT_EQ(stats.fallbackAllocCount, 0u);
+    EXPECT_EQ(client.liveAllocs.load(), 0);
+}
+
+// =====================================================================================================================
+// A misaligned slab is returned to the client and every allocation is passed on to the client from then on.
+TEST(SlabAllocatorTest, MisalignedSlabFallsBackToPassThrough)
+{
+    TestClient client = {};
+    client.misalign   = true;
+
+    const SlabAllocatorStats stats = AllocateSmallObjects(&client, 64);
+
+    EXPECT_TRUE(stats.passThrough);
+    EXPECT_EQ(stats.slabBytes, 0u);
+    EXPECT_EQ(stats.fallbackAllocCount, 64u);
+    EXPECT_EQ(client.liveAllocs.load(), 0);
+}
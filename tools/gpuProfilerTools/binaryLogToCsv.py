@@ -0,0 +1,327 @@
+##
+ #######################################################################################################################
+ #
+ #  Copyright (c) 2019 Advanced Micro Devices, Inc. All Rights Reserved.
+ #
+ #  Permission is hereby granted, free of charge, to any person obtaining a copy
+ #  of this software and associated documentation files (the "Software"), to deal
+ #  in the Software without restriction, including without limitation the rights
+ #  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ #  copies of the Software, and to permit persons to whom the Software is
+ #  furnished to do so, subject to the following conditions:
+ #
+ #  The above copyright notice and this permission notice shall be included in all
+ #  copies or substantial portions of the Software.
+ #
+ #  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ #  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ #  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ #  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ #  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ #  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ #  SOFTWARE.
+ #
+ #######################################################################################################################
+
+# Converts the binary logs written by the GPU profiler when GpuProfilerConfig.LogFormat is GpuProfilerLogFormatBinary
+# into the same per-frame .csv files it writes when the CSV log format is used, so they can be consumed by
+# timingReport.py and other existing tools.  The binary layout is described in
+# src/core/layers/gpuProfiler/gpuProfilerBinaryLog.h and must be kept in sync with this script.
+#
+# Usage: binaryLogToCsv.py <full path to log folder>
+
+import glob
+import os
+import struct
+import sys
+
+BinaryLogMagic      = 0x424C5047
+BinaryLogBlockMagic = 0x4B4C4247
+BinaryLogVersion    = 1
+
+HeaderFormat = "<IIQIIIIIIIIII"
+BlockFormat  = "<IIII"
+
+# BinaryLogHeaderFlags
+FullPipelineHash = 0x1
+ThreadTrace      = 0x2
+
+# BinaryLogColumn: number of 32-bit and 64-bit fixed columns.
+Num32BitColumns      = 8
+NumFixed64BitColumns = 15
+
+# Indices into the 32-bit columns.
+FrameIdCol     = 0
+RowFlagsCol    = 1
+CallIdCol      = 2
+CmdBufIndexCol = 3
+TraceValueCol  = 4
+Count0Col      = 5
+Count1Col      = 6
+CommentCol     = 7
+
+# Indices into the 64-bit columns.
+StartClockCol     = 0
+EndClockCol       = 1
+ApiPsoHashCol     = 2
+PipelineStableCol = 3
+PipelineUniqueCol = 4
+ShaderHashCol     = 5
+
+NoString = 0xFFFFFFFF
+
+# BinaryLogRowFlags
+RowTypeMask      = 0x3
+RowNested        = 0x4
+RowDraw          = 0x8
+RowDispatch      = 0x10
+RowBarrier       = 0x20
+RowComment       = 0x40
+RowTimestamps    = 0x80
+RowHideElapsed   = 0x100
+RowPipelineStats = 0x200
+RowPerfCounters  = 0x400
+RowTraceShift    = 12
+RowTraceMask     = 0xF000
+
+# LogItemType
+QueueCall     = 0
+CmdBufferCall = 1
+Frame         = 2
+
+# BinaryLogTraceStatus
+TraceNone          = 0
+TraceValue         = 1
+TraceRgpNeedsFrame = 2
+TraceOutOfMemory   = 3
+TraceUnsupported   = 4
+TraceOmitted       = 5
+
+NumPipelineStats = 11
+
+class LogInfo:
+    pass
+
+def ReadCString(data, offset):
+    end = data.index(b"\0", offset)
+    return (data[offset:end].decode("utf-8", "replace"), end + 1)
+
+def ReadHeader(data):
+    fields = struct.unpack_from(HeaderFormat, data, 0)
+    info = LogInfo()
+    (magic, version, info.tsFreq, info.deviceId, info.engineIndex, info.queueId, info.flags, info.numPipelineStats,
+     info.numPerfCounters, numQueueCallIds, numCmdBufCallIds, stringTableSize, reserved) = fields
+
+    if magic != BinaryLogMagic:
+        raise ValueError("not a GPU profiler binary log")
+    if version != BinaryLogVersion:
+        raise ValueError("unsupported binary log version {0}".format(version))
+
+    offset = struct.calcsize(HeaderFormat)
+    end    = offset + stringTableSize
+
+    (info.engineName, offset) = ReadCString(data, offset)
+
+    info.queueCallNames = []
+    for i in range(numQueueCallIds):
+        (name, offset) = ReadCString(data, offset)
+        info.queueCallNames.append(name)
+
+    info.cmdBufCallNames = []
+    for i in range(numCmdBufCallIds):
+        (name, offset) = ReadCString(data, offset)
+        info.cmdBufCallNames.append(name)
+
+    info.perfCounterNames = []
+    for i in range(info.numPerfCounters):
+        (name, offset) = ReadCString(data, offset)
+        info.perfCounterNames.append(name)
+
+    assert offset == end
+    return (info, end)
+
+# Yields (columns32, columns64, stringHeap, rowCount) for each block in the file.
+def ReadBlocks(info, data, offset):
+    num64BitColumns = NumFixed64BitColumns + info.numPipelineStats + info.numPerfCounters
+
+    while offset < len(data):
+        (magic, rowCount, stringHeapSize, reserved) = struct.unpack_from(BlockFormat, data, offset)
+        if magic != BinaryLogBlockMagic:
+            raise ValueError("corrupt block at offset {0}".format(offset))
+        offset += struct.calcsize(BlockFormat)
+
+        columns32 = []
+        for i in range(Num32BitColumns):
+            columns32.append(struct.unpack_from("<{0}I".format(rowCount), data, offset))
+            offset += 4 * rowCount
+
+        columns64 = []
+        for i in range(num64BitColumns):
+            columns64.append(struct.unpack_from("<{0}Q".format(rowCount), data, offset))
+            offset += 8 * rowCount
+
+        stringHeap = data[offset:offset + stringHeapSize]
+        offset += stringHeapSize
+
+        yield (columns32, columns64, stringHeap, rowCount)
+
+def FormatTimestamps(info, flags, columns64, row):
+    if flags & RowTimestamps:
+        start = columns64[StartClockCol][row]
+        end   = columns64[EndClockCol][row]
+        text  = "{0},{1},".format(start, end)
+        if flags & RowHideElapsed:
+            text += ","
+        else:
+            tsDiff = float((end - start) & 0xFFFFFFFFFFFFFFFF)
+            text  += "%.2f," % (1000000 * tsDiff / float(info.tsFreq))
+        return text
+    return ",,,"
+
+def FormatPerfCounters(info, flags, columns64, row):
+    if flags & RowPerfCounters:
+        first = NumFixed64BitColumns + info.numPipelineStats
+        return "".join("{0},".format(columns64[first + i][row]) for i in range(info.numPerfCounters))
+    return "," * info.numPerfCounters
+
+def FormatTrace(flags, columns32, row):
+    status = (flags & RowTraceMask) >> RowTraceShift
+    if status == TraceValue:
+        return "{0},".format(columns32[TraceValueCol][row])
+    elif status == TraceRgpNeedsFrame:
+        return "USE FRAME-GRANULARITY FOR RGP,"
+    elif status == TraceOutOfMemory:
+        return "ERROR: OUT OF MEMORY,"
+    elif status == TraceUnsupported:
+        return "ERROR: THREAD TRACE UNSUPPORTED,"
+    elif status == TraceOmitted:
+        return ""
+    return ","
+
+def FormatHash(value):
+    return "0x{0:016x}".format(value)
+
+def FormatQueueCall(info, columns32, row):
+    text  = info.queueCallNames[columns32[CallIdCol][row]]
+    text += ",,,,,,,,,,,,,,,,"
+    if info.numPipelineStats > 0:
+        text += ",,,,,,,,,,,"
+    text += "," * info.numPerfCounters
+    return text + "\n"
+
+def FormatCmdBufCall(info, columns32, columns64, stringHeap, row):
+    flags = columns32[RowFlagsCol][row]
+
+    text  = ",{0},".format(columns32[CmdBufIndexCol][row])
+    text += "- " if (flags & RowNested) else ""
+    text += info.cmdBufCallNames[columns32[CallIdCol][row]] + ","
+    text += FormatTimestamps(info, flags, columns64, row)
+
+    if flags & (RowDraw | RowDispatch):
+        text += FormatHash(columns64[ApiPsoHashCol][row])
+        text += "," + FormatHash(columns64[PipelineStableCol][row])
+        if info.flags & FullPipelineHash:
+            text += "-" + FormatHash(columns64[PipelineUniqueCol][row])
+        if flags & RowDraw:
+            for i in range(5):
+                text += ",0x{0:016x}{1:016x}".format(columns64[ShaderHashCol + (i * 2)][row],
+                                                     columns64[ShaderHashCol + (i * 2) + 1][row])
+            text += ",{0},{1},,".format(columns32[Count0Col][row], columns32[Count1Col][row])
+        else:
+            text += ",0x{0:016x}{1:016x}".format(columns64[ShaderHashCol][row], columns64[ShaderHashCol + 1][row])
+            text += ",,,,,{0},,,".format(columns32[Count0Col][row])
+    elif flags & (RowBarrier | RowComment):
+        comment = ""
+        if columns32[CommentCol][row] != NoString:
+            (comment, end) = ReadCString(stringHeap, columns32[CommentCol][row])
+        text += ",,,,,,,,,\"" + comment + "\","
+    else:
+        text += ",,,,,,,,,,"
+
+    if flags & RowPipelineStats:
+        text += "".join("{0},".format(columns64[NumFixed64BitColumns + i][row]) for i in range(info.numPipelineStats))
+    elif info.numPipelineStats > 0:
+        text += ",,,,,,,,,,,"
+
+    text += FormatPerfCounters(info, flags, columns64, row)
+    text += FormatTrace(flags, columns32, row)
+    return text + "\n"
+
+def FormatFrame(info, columns32, columns64, row):
+    flags = columns32[RowFlagsCol][row]
+    text  = "{0},".format(columns32[FrameIdCol][row])
+    text += FormatTimestamps(info, flags, columns64, row)
+    text += FormatPerfCounters(info, flags, columns64, row)
+    text += FormatTrace(flags, columns32, row)
+    return text + "\n"
+
+def FrameFileHeader(info):
+    header  = "Queue Call,CmdBuffer Index,CmdBuffer Call,Start Clock,End Clock,Time (us) " \
+              "[Frequency: {0}],PipelineHash,CompilerHash,VS/CS,HS,DS,GS,PS," \
+              "Verts/ThreadGroups,Instances,Comments,".format(info.tsFreq)
+    if info.numPipelineStats > 0:
+        header += "IaVertices,IaPrimitives,VsInvocations,GsInvocations," \
+                  "GsPrimitives,CInvocations,CPrimitives,PsInvocations," \
+                  "HsInvocations,DsInvocations,CsInvocations,"
+    header += "".join(name + "," for name in info.perfCounterNames)
+    if info.flags & ThreadTrace:
+        header += "ThreadTraceId,"
+    return header + "\n"
+
+def FrameLogHeader(info):
+    header  = "Frame #,Start Clock,End Clock,Time (us) [Frequency: {0}],".format(info.tsFreq)
+    header += "".join(name + "," for name in info.perfCounterNames)
+    if info.flags & ThreadTrace:
+        header += "ThreadTraceId,"
+    return header + "\n"
+
+def ConvertFile(path, outDir):
+    with open(path, "rb") as binFile:
+        data = binFile.read()
+
+    (info, offset) = ReadHeader(data)
+
+    outFiles = { }  # Frame number (or "frameLog") -> open file
+    rowCount = 0
+
+    try:
+        for (columns32, columns64, stringHeap, blockRows) in ReadBlocks(info, data, offset):
+            for row in range(blockRows):
+                rowType = columns32[RowFlagsCol][row] & RowTypeMask
+
+                if rowType == Frame:
+                    key = "frameLog"
+                    if not key in outFiles:
+                        outFiles[key] = open(os.path.join(outDir, "frameLog.csv"), "w")
+                        outFiles[key].write(FrameLogHeader(info))
+                    outFiles[key].write(FormatFrame(info, columns32, columns64, row))
+                else:
+                    key = columns32[FrameIdCol][row]
+                    if not key in outFiles:
+                        name = "frame{0:06d}Dev{1}Eng{2}{3}-{4:02d}.csv".format(key, info.deviceId, info.engineName,
+                                                                               info.engineIndex, info.queueId)
+                        outFiles[key] = open(os.path.join(outDir, name), "w")
+                        outFiles[key].write(FrameFileHeader(info))
+                    if rowType == QueueCall:
+                        outFiles[key].write(FormatQueueCall(info, columns32, row))
+                    else:
+                        outFiles[key].write(FormatCmdBufCall(info, columns32, columns64, stringHeap, row))
+                rowCount += 1
+    finally:
+        for outFile in outFiles.values():
+            outFile.close()
+
+    return (rowCount, len(outFiles))
+
+if len(sys.argv) != 2:
+    sys.exit("Usage: binaryLogToCsv.py <full path to log folder>")
+
+logDir = sys.argv[1]
+files  = glob.glob(os.path.join(logDir, "*.gpbin"))
+
+if len(files) == 0:
+    sys.exit("ERROR: Looking at directory <{0}> but cannot find any files that match the \"*.gpbin\" pattern.".format(logDir))
+
+for path in sorted(files):
+    (rowCount, fileCount) = ConvertFile(path, logDir)
+    print("{0}: {1} rows written to {2} .csv files.".format(os.path.basename(path), rowCount, fileCount))